@@ -1,18 +1,51 @@
 #include "APIManager.h"
 #include "ConfigManager.h"
 #include "WiFiManager.h"
+#include "HTTPBodyStream.h"
 #include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include "MetricsRegistry.h"
 #include <ArduinoJson.h>
-#include <base64.h>
+#include <mbedtls/base64.h>
 
 // ===== STATIC VARIABLES =====
 APIManager* APIManager::_instance = nullptr;
 HTTPClient APIManager::_httpClient;
 
+// Kept open across requests so each cycle does not pay a TLS handshake
+static WiFiClientSecure _secureClient;
+static bool _connectionReused = false;
+static WiFiClient _plainClient;
+static String _connectedHost;
+
 // ===== CONSTANTS =====
 #define API_TIMEOUT 10000  // 10 seconds
 #define MAX_RETRIES 3
-#define API_CACHE_DURATION 30000  // 30 seconds cache
+#define HEADER_ETAG "ETag"
+#define HEADER_LAST_MODIFIED "Last-Modified"
+#define HEADER_VERSION "X-Portfolio-Version"
+#define HEADER_DELTA "X-Portfolio-Delta"
+#define HEADER_TRANSFER_ENCODING "Transfer-Encoding"
+#define CONNECTION_IDLE_TIMEOUT 60000  // Drop the socket if unused for 1 minute
+#define ERROR_BODY_DRAIN_LIMIT 2048  // Error bodies up to this are read off to keep the socket
+#define API_URL_LENGTH 256
+#define API_SERVER_LENGTH 128
+#define API_CREDENTIAL_LENGTH 64
+#define API_AUTH_LENGTH 180             // Base64 of "user:pass" at the longest credentials
+
+// Rebuilt in place every request; reserved once, so steady state does not allocate
+static String _requestURL;
+static String _authHeader;
+static char _authSource[2 * API_CREDENTIAL_LENGTH];   // "user:pass" _authHeader was encoded from
+
+// Time to response headers; on a new connection this includes the TLS handshake
+static Metric* requestLatency() {
+    static Metric* fresh = MetricsRegistry::getInstance().histogram(
+        "api_request_seconds", "Time to API response headers", "connection=\"new\"");
+    static Metric* reused = MetricsRegistry::getInstance().histogram(
+        "api_request_seconds", "Time to API response headers", "connection=\"reused\"");
+    return _connectionReused ? reused : fresh;
+}
 
 // ===== CONSTRUCTOR/DESTRUCTOR =====
 APIManager::APIManager()
@@ -22,7 +55,9 @@ APIManager::APIManager()
       _apiErrorCount(0),
       _totalResponseTime(0),
       _averageResponseTime(0),
-      _cacheEnabled(true) {
+      _deltaEnabled(true),
+      _notModifiedCount(0),
+      _deltaCount(0) {
 }
 
 APIManager::~APIManager() {
@@ -36,7 +71,13 @@ bool APIManager::begin() {
     Serial.println("Initializing API Manager...");
     
     // Load configuration
-    _cacheEnabled = ConfigManager::getInstance().getBool("api_cache", true);
+    _deltaEnabled = ConfigManager::getInstance().getBool("api_delta", true);
+    
+    // No CA is configured; matches HTTPClient's default for https URLs
+    _secureClient.setInsecure();
+    
+    _requestURL.reserve(API_URL_LENGTH);
+    _authHeader.reserve(API_AUTH_LENGTH);
     
     _initialized = true;
     Serial.println("API Manager initialized");
@@ -44,9 +85,9 @@ bool APIManager::begin() {
     return true;
 }
 
-// ===== API CALL METHODS =====
-bool APIManager::fetchPortfolioData(const String& portfolioName, bool isExitMode, 
-                                   String& response, APIResponseInfo* responseInfo) {
+// ===== STREAMING API CALLS =====
+bool APIManager::fetchPortfolioStream(const String& portfolioName, uint8_t portfolio,
+                                     APIStreamHandler handler, APIResponseInfo* responseInfo) {
     if (!WiFiManager::getInstance().isConnected()) {
         Serial.println("Cannot fetch data: WiFi not connected");
         if (responseInfo) {
@@ -57,23 +98,52 @@ bool APIManager::fetchPortfolioData(const String& portfolioName, bool isExitMode
         return false;
     }
     
-    // Check cache first
-    String cacheKey = portfolioName + (isExitMode ? "_exit" : "_entry");
-    if (_cacheEnabled && isCacheValid(cacheKey)) {
-        response = getCachedResponse(cacheKey);
-        Serial.println("Using cached response for: " + portfolioName);
+    String& url = buildPortfolioURL(portfolioName);
+    
+    if (url.isEmpty()) {
+        Serial.println("API configuration incomplete");
         if (responseInfo) {
-            responseInfo->success = true;
-            responseInfo->fromCache = true;
+            responseInfo->success = false;
+            responseInfo->error = "API configuration incomplete";
         }
-        return true;
+        return false;
     }
     
-    // Build URL
-    String server = ConfigManager::getInstance().getAPIServer();
-    String username = ConfigManager::getInstance().getAPIUsername();
+    // Validators only apply to the portfolio they were received for
+    APIValidators& validators = _validators[portfolio < PORTFOLIO_MAX ? portfolio : PORTFOLIO_ENTRY];
+    if (validators.portfolio != portfolioName) {
+        validators = APIValidators();
+        validators.portfolio = portfolioName;
+    }
     
-    if (server.isEmpty() || username.isEmpty()) {
+    if (_deltaEnabled && !validators.version.isEmpty()) {
+        url += "&since=";
+        url += validators.version;
+    }
+    
+    Serial.print("Streaming ");
+    Serial.print(portfolioName);
+    Serial.print(" from: ");
+    Serial.println(url);
+    
+    return streamWithRetries(url, handler, responseInfo, validators);
+}
+
+bool APIManager::fetchPortfolios(const std::vector<String>& portfolioNames,
+                                 APIStreamHandler handler, APIResponseInfo* responseInfo) {
+    if (!WiFiManager::getInstance().isConnected()) {
+        Serial.println("Cannot fetch data: WiFi not connected");
+        if (responseInfo) {
+            responseInfo->success = false;
+            responseInfo->error = "WiFi not connected";
+            responseInfo->httpCode = 0;
+        }
+        return false;
+    }
+    
+    String& url = buildBatchURL(portfolioNames);
+    
+    if (url.isEmpty()) {
         Serial.println("API configuration incomplete");
         if (responseInfo) {
             responseInfo->success = false;
@@ -82,12 +152,30 @@ bool APIManager::fetchPortfolioData(const String& portfolioName, bool isExitMode
         return false;
     }
     
-    String url = server + "/api/device/portfolio/" + username + 
-                "?portfolio_name=" + portfolioName;
+    // One validator set covers the whole combination of portfolios
+    const char* key = url.c_str() + url.indexOf("?names=") + 7;
+    APIValidators& validators = _validators[VALIDATOR_BATCH];
+    if (validators.portfolio != key) {
+        validators = APIValidators();
+        validators.portfolio = key;
+    }
+    
+    if (_deltaEnabled && !validators.version.isEmpty()) {
+        url += "&since=";
+        url += validators.version;
+    }
+    
+    Serial.print("Streaming batched portfolios from: ");
+    Serial.println(url);
     
-    Serial.println("Fetching portfolio data from: " + url);
+    return streamWithRetries(url, handler, responseInfo, validators);
+}
+
+bool APIManager::streamWithRetries(const String& url, APIStreamHandler handler,
+                                   APIResponseInfo* responseInfo, APIValidators& validators) {
+    APIResponseInfo localInfo;
+    if (!responseInfo) responseInfo = &localInfo;
     
-    // Make API call with retries
     for (int attempt = 0; attempt < MAX_RETRIES; attempt++) {
         if (attempt > 0) {
             Serial.print("Retry attempt ");
@@ -95,92 +183,251 @@ bool APIManager::fetchPortfolioData(const String& portfolioName, bool isExitMode
             delay(1000 * attempt); // Exponential backoff
         }
         
-        if (makeAPICall(url, response, responseInfo)) {
-            // Cache the response
-            if (_cacheEnabled) {
-                cacheResponse(cacheKey, response);
-            }
+        if (makeStreamingAPICall(url, handler, responseInfo, &validators)) {
             return true;
         }
+        
+        // A body that was read but rejected will not improve on retry
+        if (responseInfo->httpCode == HTTP_CODE_OK) {
+            // Parse state is unknown, so the next request must be a full fetch
+            String portfolio = validators.portfolio;
+            validators = APIValidators();
+            validators.portfolio = portfolio;
+            break;
+        }
+        
+        // Endpoint not available on this server; caller falls back
+        if (responseInfo->httpCode == HTTP_CODE_NOT_FOUND) {
+            break;
+        }
     }
     
-    Serial.println("All API retries failed");
+    Serial.println("Streaming API call failed");
     return false;
 }
 
-bool APIManager::makeAPICall(const String& url, String& response, APIResponseInfo* responseInfo) {
+bool APIManager::makeStreamingAPICall(const String& url, APIStreamHandler handler,
+                                     APIResponseInfo* responseInfo,
+                                     APIValidators* validators) {
     unsigned long startTime = millis();
     
-    // Setup HTTP client
-    _httpClient.begin(url);
-    _httpClient.setTimeout(API_TIMEOUT);
-    _httpClient.setReuse(true);
+    if (!openConnection(url)) {
+        if (responseInfo) {
+            responseInfo->success = false;
+            responseInfo->error = "Invalid URL";
+        }
+        return false;
+    }
     
-    // Add headers
-    String authHeader = getAuthHeader();
-    _httpClient.addHeader("Authorization", authHeader);
+    _httpClient.addHeader("Authorization", getAuthHeader());
     _httpClient.addHeader("Content-Type", "application/json");
     _httpClient.addHeader("User-Agent", "PortfolioMonitor/4.5.3");
     
-    // Make request
-    int httpCode = _httpClient.GET();
-    unsigned long responseTime = millis() - startTime;
+    // Conditional request: the server answers 304 when nothing changed
+    if (validators) {
+        if (!validators->etag.isEmpty()) {
+            _httpClient.addHeader("If-None-Match", validators->etag);
+        }
+        if (!validators->lastModified.isEmpty()) {
+            _httpClient.addHeader("If-Modified-Since", validators->lastModified);
+        }
+    }
     
-    // Update statistics
-    updateStatistics(httpCode == 200, responseTime);
+    static const char* headerKeys[] = {HEADER_ETAG, HEADER_LAST_MODIFIED, HEADER_VERSION,
+                                       HEADER_DELTA, HEADER_TRANSFER_ENCODING};
+    _httpClient.collectHeaders(headerKeys, 5);
+    
+    int httpCode;
+    {
+        MetricTimer timer(requestLatency());
+        httpCode = _httpClient.GET();
+    }
     
-    // Process response
     if (responseInfo) {
         responseInfo->httpCode = httpCode;
-        responseInfo->responseTime = responseTime;
         responseInfo->fromCache = false;
+        responseInfo->notModified = false;
+        responseInfo->isDelta = false;
     }
     
-    if (httpCode == HTTP_CODE_OK) {
-        response = _httpClient.getString();
+    if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+        unsigned long responseTime = millis() - startTime;
+        updateStatistics(true, responseTime);
+        _notModifiedCount++;
         
         if (responseInfo) {
             responseInfo->success = true;
-            responseInfo->payloadSize = response.length();
+            responseInfo->notModified = true;
+            responseInfo->responseTime = responseTime;
+            responseInfo->payloadSize = 0;
         }
         
-        Serial.print("API call successful: ");
-        Serial.print(response.length());
-        Serial.println(" bytes received");
+        Serial.println("Portfolio not modified (304)");
         
         _httpClient.end();
         return true;
-    } else {
+    }
+    
+    if (httpCode != HTTP_CODE_OK) {
         String error = "HTTP Error: " + String(httpCode);
         if (httpCode <= 0) {
             error = "Connection failed: " + String(_httpClient.errorToString(httpCode));
         }
         
+        updateStatistics(false, millis() - startTime);
+        
         if (responseInfo) {
             responseInfo->success = false;
+            responseInfo->responseTime = millis() - startTime;
             responseInfo->error = error;
         }
         
         Serial.println("API call failed: " + error);
         
+        // An unread error body would desync the next response. A short one
+        // is read off instead, so e.g. the per-portfolio requests after a
+        // batched 404 do not pay a new TLS handshake.
+        int errorLength = httpCode > 0 ? _httpClient.getSize() : -1;
+        if (errorLength >= 0 && errorLength <= ERROR_BODY_DRAIN_LIMIT) {
+            HTTPBodyStream body(_httpClient.getStream(), false, errorLength);
+            if (body.drain()) {
+                _httpClient.end();
+                return false;
+            }
+        }
+        closeConnection();
+        return false;
+    }
+    
+    // The handler needs to know whether to merge or replace
+    bool isDelta = _httpClient.header(HEADER_DELTA) == "true";
+    if (responseInfo) {
+        responseInfo->isDelta = isDelta;
+    }
+    
+    // Body is consumed directly from the socket, bounded to this response
+    int contentLength = _httpClient.getSize();
+    bool chunked = _httpClient.header(HEADER_TRANSFER_ENCODING).equalsIgnoreCase("chunked");
+    HTTPBodyStream body(_httpClient.getStream(), chunked, contentLength);
+    
+    bool parsed = handler ? handler(body) : false;
+    unsigned long responseTime = millis() - startTime;
+    
+    updateStatistics(parsed, responseTime);
+    
+    // Only remember validators for bodies that were applied
+    if (parsed && validators) {
+        validators->etag = _httpClient.header(HEADER_ETAG);
+        validators->lastModified = _httpClient.header(HEADER_LAST_MODIFIED);
+        validators->version = _httpClient.header(HEADER_VERSION);
+        if (isDelta) _deltaCount++;
+    }
+    
+    if (responseInfo) {
+        responseInfo->success = parsed;
+        responseInfo->responseTime = responseTime;
+        responseInfo->payloadSize = body.getBytesRead();
+        if (!parsed) {
+            responseInfo->error = "Stream parse failed";
+        }
+    }
+    
+    Serial.print("Streamed response ");
+    Serial.print(parsed ? "parsed" : "rejected");
+    Serial.print(" in ");
+    Serial.println(formatResponseTime(responseTime));
+    
+    // Keep the connection only if it is positioned at the next response
+    if (parsed && body.drain()) {
         _httpClient.end();
+    } else {
+        closeConnection();
+    }
+    return parsed;
+}
+
+// ===== CONNECTION MANAGEMENT =====
+bool APIManager::openConnection(const String& url) {
+    bool secure = url.startsWith("https://");
+    WiFiClient& client = secure ? static_cast<WiFiClient&>(_secureClient) : _plainClient;
+    
+    // "scheme://host[:port]" identifies the connection
+    int hostEnd = url.indexOf('/', url.indexOf("//") + 2);
+    size_t hostLength = hostEnd > 0 ? hostEnd : url.length();
+    bool sameHost = _connectedHost.length() == hostLength &&
+                    strncmp(url.c_str(), _connectedHost.c_str(), hostLength) == 0;
+    
+    bool idle = millis() - _lastApiCallTime > CONNECTION_IDLE_TIMEOUT;
+    bool reused = client.connected() && sameHost && !idle;
+    
+    if (!reused) {
+        closeConnection();
+    }
+    
+    _httpClient.setReuse(true);
+    _httpClient.setTimeout(API_TIMEOUT);
+    if (!_httpClient.begin(client, url)) {
         return false;
     }
+    
+    if (!sameHost) {
+        _connectedHost = url.substring(0, hostLength);
+    }
+    _connectionReused = reused;
+    
+    static Metric* handshakes = MetricsRegistry::getInstance().counter(
+        "api_connections_total", "API requests by connection", "connection=\"new\"");
+    static Metric* reuses = MetricsRegistry::getInstance().counter(
+        "api_connections_total", "API requests by connection", "connection=\"reused\"");
+    
+    if (reused) {
+        stats.reusedConnections++;
+        MetricsRegistry::increment(reuses);
+    } else {
+        stats.handshakeCount++;
+        MetricsRegistry::increment(handshakes);
+    }
+    
+    return true;
+}
+
+void APIManager::closeConnection() {
+    _httpClient.end();
+    _secureClient.stop();
+    _plainClient.stop();
+    _connectedHost = "";
 }
 
 // ===== AUTHENTICATION =====
-String APIManager::getAuthHeader() {
-    String username = ConfigManager::getInstance().getAPIUsername();
-    String password = ConfigManager::getInstance().getAPIPassword();
-    
-    if (username.isEmpty() || password.isEmpty()) {
-        return "";
+const String& APIManager::getAuthHeader() {
+    char username[API_CREDENTIAL_LENGTH];
+    char password[API_CREDENTIAL_LENGTH];
+    ConfigManager::getInstance().getAPIUsername(username, sizeof(username));
+    ConfigManager::getInstance().getAPIPassword(password, sizeof(password));
+    
+    char source[sizeof(_authSource)];
+    if (!username[0] || !password[0]) {
+        source[0] = '\0';
+    } else {
+        snprintf(source, sizeof(source), "%s:%s", username, password);
     }
     
-    String auth = username + ":" + password;
-    String encoded = base64::encode(auth);
+    // Encoded again only when the credentials change
+    if (strcmp(source, _authSource) != 0) {
+        _authHeader = "";
+        if (source[0]) {
+            unsigned char encoded[API_AUTH_LENGTH];
+            size_t length = 0;
+            if (mbedtls_base64_encode(encoded, sizeof(encoded), &length,
+                                      (const unsigned char*)source, strlen(source)) == 0) {
+                _authHeader = "Basic ";
+                _authHeader += (const char*)encoded;
+            }
+        }
+        strlcpy(_authSource, source, sizeof(_authSource));
+    }
     
-    return "Basic " + encoded;
+    return _authHeader;
 }
 
 bool APIManager::testConnection(String& errorMessage) {
@@ -195,10 +442,10 @@ bool APIManager::testConnection(String& errorMessage) {
     // Build test URL
     String url = server + "/api/device/test";
     
-    String response;
+    // Streamed and discarded like any other body, on the kept-alive connection
     APIResponseInfo responseInfo;
     
-    if (makeAPICall(url, response, &responseInfo)) {
+    if (makeStreamingAPICall(url, [](Stream&) { return true; }, &responseInfo, nullptr)) {
         errorMessage = "Connection successful";
         return true;
     } else {
@@ -207,61 +454,52 @@ bool APIManager::testConnection(String& errorMessage) {
     }
 }
 
-// ===== CACHE MANAGEMENT =====
-void APIManager::cacheResponse(const String& key, const String& response) {
-    APICacheEntry entry;
-    entry.timestamp = millis();
-    entry.response = response;
-    
-    _apiCache[key] = entry;
-    
-    // Limit cache size
-    if (_apiCache.size() > 10) {
-        // Remove oldest entry
-        auto oldest = _apiCache.begin();
-        for (auto it = _apiCache.begin(); it != _apiCache.end(); ++it) {
-            if (it->second.timestamp < oldest->second.timestamp) {
-                oldest = it;
-            }
-        }
-        _apiCache.erase(oldest);
+// ===== VALIDATORS =====
+// Conditional-request validators are the only response cache: a 304 costs
+// no body and no parse, and a stale copy is never served
+void APIManager::clearCache() {
+    for (int i = 0; i < VALIDATOR_COUNT; i++) {
+        _validators[i] = APIValidators();
     }
+    Serial.println("API validators cleared, next fetch is a full response");
 }
 
-String APIManager::getCachedResponse(const String& key) {
-    auto it = _apiCache.find(key);
-    if (it != _apiCache.end()) {
-        return it->second.response;
+void APIManager::clearValidators(uint8_t portfolio) {
+    if (portfolio < PORTFOLIO_MAX) {
+        _validators[portfolio] = APIValidators();
     }
-    return "";
+    
+    // The batch response contains this portfolio too
+    _validators[VALIDATOR_BATCH] = APIValidators();
 }
 
-bool APIManager::isCacheValid(const String& key) {
-    auto it = _apiCache.find(key);
-    if (it != _apiCache.end()) {
-        return (millis() - it->second.timestamp) < API_CACHE_DURATION;
+void APIManager::setDeltaEnabled(bool enabled) {
+    _deltaEnabled = enabled;
+    ConfigManager::getInstance().setBool("api_delta", enabled);
+    
+    if (!enabled) {
+        // Drop versions so the next fetch is a full snapshot
+        for (int i = 0; i < VALIDATOR_COUNT; i++) {
+            _validators[i].version = "";
+        }
     }
-    return false;
-}
-
-void APIManager::clearCache() {
-    _apiCache.clear();
-    Serial.println("API cache cleared");
-}
-
-void APIManager::setCacheDuration(uint32_t duration) {
-    _cacheDuration = duration;
-    ConfigManager::getInstance().setUInt("api_cache_duration", duration);
 }
 
 // ===== STATISTICS =====
 void APIManager::updateStatistics(bool success, unsigned long responseTime) {
     _lastApiCallTime = millis();
     
+    static Metric* successes = MetricsRegistry::getInstance().counter(
+        "api_requests_total", "API requests by result", "result=\"success\"");
+    static Metric* errors = MetricsRegistry::getInstance().counter(
+        "api_requests_total", "API requests by result", "result=\"error\"");
+    
     if (success) {
         _apiSuccessCount++;
+        MetricsRegistry::increment(successes);
     } else {
         _apiErrorCount++;
+        MetricsRegistry::increment(errors);
     }
     
     // Update average response time
@@ -323,9 +561,15 @@ String APIManager::getStatusJSON() {
     doc["success_rate"] = getSuccessRate();
     doc["average_response_time"] = _averageResponseTime;
     doc["last_call_time"] = _lastApiCallTime;
-    doc["cache_enabled"] = _cacheEnabled;
-    doc["cache_size"] = _apiCache.size();
-    doc["cache_duration"] = _cacheDuration;
+    doc["delta_enabled"] = _deltaEnabled;
+    doc["not_modified_count"] = _notModifiedCount;
+    doc["delta_count"] = _deltaCount;
+    doc["handshake_count"] = stats.handshakeCount;
+    doc["reused_connections"] = stats.reusedConnections;
+    doc["connection_reuse_ratio"] = getConnectionReuseRatio();
+    doc["entry_version"] = _validators[PORTFOLIO_ENTRY].version;
+    doc["exit_version"] = _validators[PORTFOLIO_EXIT].version;
+    doc["batch_version"] = _validators[VALIDATOR_BATCH].version;
     
     // Configuration
     doc["config"]["server"] = ConfigManager::getInstance().getAPIServer();
@@ -357,12 +601,8 @@ void APIManager::handleWebRequest(const String& action, const String& params) {
     else if (action == "reset_stats") {
         resetStatistics();
     }
-    else if (action == "cache_duration") {
-        setCacheDuration(params.toInt());
-    }
-    else if (action == "toggle_cache") {
-        _cacheEnabled = !_cacheEnabled;
-        ConfigManager::getInstance().setBool("api_cache", _cacheEnabled);
+    else if (action == "toggle_delta") {
+        setDeltaEnabled(!_deltaEnabled);
     }
 }
 
@@ -402,32 +642,61 @@ void APIManager::printStatistics() {
     } else {
         Serial.println("Never");
     }
-    Serial.print("Cache Size: ");
-    Serial.println(_apiCache.size());
-    Serial.print("Cache Enabled: ");
-    Serial.println(_cacheEnabled ? "Yes" : "No");
+    Serial.print("TLS Handshakes: ");
+    Serial.println(stats.handshakeCount);
+    Serial.print("Connection Reuse: ");
+    Serial.print(getConnectionReuseRatio() * 100.0, 1);
+    Serial.println("%");
+    Serial.print("Not Modified (304): ");
+    Serial.println(_notModifiedCount);
     Serial.println("====================\n");
 }
 
-// ===== BATCH OPERATIONS =====
-bool APIManager::fetchAllData(String& entryResponse, String& exitResponse) {
-    String entryPortfolio = ConfigManager::getInstance().getEntryPortfolio();
-    String exitPortfolio = ConfigManager::getInstance().getExitPortfolio();
-    
-    bool entrySuccess = false;
-    bool exitSuccess = false;
-    
-    // Fetch entry data
-    if (!entryPortfolio.isEmpty()) {
-        entrySuccess = fetchPortfolioData(entryPortfolio, false, entryResponse);
+// ===== URL BUILDING =====
+// Both return the shared request URL; it is valid until the next build
+String& APIManager::buildPortfolioURL(const String& portfolioName) {
+    char server[API_SERVER_LENGTH];
+    char username[API_CREDENTIAL_LENGTH];
+    ConfigManager::getInstance().getAPIServer(server, sizeof(server));
+    ConfigManager::getInstance().getAPIUsername(username, sizeof(username));
+    
+    _requestURL = "";
+    if (!server[0] || !username[0]) {
+        return _requestURL;
     }
     
-    // Fetch exit data
-    if (!exitPortfolio.isEmpty()) {
-        exitSuccess = fetchPortfolioData(exitPortfolio, true, exitResponse);
+    _requestURL += server;
+    _requestURL += "/api/device/portfolio/";
+    _requestURL += username;
+    _requestURL += "?portfolio_name=";
+    _requestURL += portfolioName;
+    return _requestURL;
+}
+
+String& APIManager::buildBatchURL(const std::vector<String>& portfolioNames) {
+    char server[API_SERVER_LENGTH];
+    char username[API_CREDENTIAL_LENGTH];
+    ConfigManager::getInstance().getAPIServer(server, sizeof(server));
+    ConfigManager::getInstance().getAPIUsername(username, sizeof(username));
+    
+    _requestURL = "";
+    if (!server[0] || !username[0] || portfolioNames.empty()) {
+        return _requestURL;
     }
     
-    return entrySuccess || exitSuccess;
+    _requestURL += server;
+    _requestURL += "/api/device/portfolios/";
+    _requestURL += username;
+    _requestURL += "?names=";
+    
+    bool first = true;
+    for (const String& name : portfolioNames) {
+        if (name.isEmpty()) continue;
+        if (!first) _requestURL += ",";
+        _requestURL += name;
+        first = false;
+    }
+    return _requestURL;
 }
 
 // ===== ERROR HANDLING =====
@@ -462,8 +731,6 @@ String APIManager::getErrorMessage(int httpCode) {
 uint32_t APIManager::getSuccessCount() const { return _apiSuccessCount; }
 uint32_t APIManager::getErrorCount() const { return _apiErrorCount; }
 uint32_t APIManager::getAverageResponseTime() const { return _averageResponseTime; }
-bool APIManager::isCacheEnabled() const { return _cacheEnabled; }
-size_t APIManager::getCacheSize() const { return _apiCache.size(); }
 bool APIManager::isInitialized() const { return _initialized; }
 
 // ===== STATIC ACCESS =====
@@ -4,11 +4,31 @@
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
+#include <functional>
 #include "SystemConfig.h"
+#include "PortfolioTable.h"
 
 // Forward declarations
 struct SystemSettings;
 
+// Result details for a single API call
+struct APIResponseInfo {
+    bool success;
+    bool fromCache;
+    bool notModified;   // 304: local data is still current
+    bool isDelta;       // Body only carries positions changed since the last version
+    int httpCode;
+    unsigned long responseTime;
+    size_t payloadSize;
+    String error;
+    
+    APIResponseInfo() : success(false), fromCache(false), notModified(false),
+                        isDelta(false), httpCode(0), responseTime(0), payloadSize(0) {}
+};
+
+// Consumes a response body directly from the socket; returns false on parse failure
+typedef std::function<bool(Stream&)> APIStreamHandler;
+
 class APIManager {
 private:
     HTTPClient http;
@@ -44,22 +64,28 @@ private:
         unsigned long totalResponseTime;
         float averageResponseTime;
         size_t totalBytesReceived;
+        uint32_t handshakeCount;      // New TCP/TLS connections opened
+        uint32_t reusedConnections;   // Requests sent on a kept-alive connection
         
         APIStatistics() : totalRequests(0), successfulRequests(0),
                          failedRequests(0), timeoutErrors(0),
                          connectionErrors(0), httpErrors(0),
                          totalResponseTime(0), averageResponseTime(0),
-                         totalBytesReceived(0) {}
+                         totalBytesReceived(0), handshakeCount(0),
+                         reusedConnections(0) {}
     } stats;
     
-    // Cache management
-    struct APICache {
-        String data;
-        unsigned long timestamp;
-        unsigned long ttl; // Time to live in ms
-        
-        APICache() : timestamp(0), ttl(30000) {} // 30 seconds default
-    } cacheEntryMode1, cacheEntryMode2;
+    // Conditional request validators, per portfolio plus the batched request
+    enum { VALIDATOR_BATCH = PORTFOLIO_MAX, VALIDATOR_COUNT };
+    struct APIValidators {
+        String portfolio;
+        String etag;
+        String lastModified;
+        String version;     // Sent as ?since= for delta responses
+    } _validators[VALIDATOR_COUNT];
+    uint32_t _notModifiedCount;
+    uint32_t _deltaCount;
+    bool _deltaEnabled;
     
     // Error handling
     int lastErrorCode;
@@ -70,6 +96,8 @@ public:
     ~APIManager();
     
     // ===== INITIALIZATION =====
+    static APIManager& getInstance();
+    bool begin();
     void init(const SystemSettings& settings);
     bool isInitialized() const;
     void setServer(const String& server);
@@ -83,13 +111,22 @@ public:
     void setVerifySSL(bool verify);
     
     // ===== API REQUESTS =====
-    String fetchPortfolioData(byte mode);
-    String fetchPortfolioData(const String& portfolioName);
     String fetchMarketData(const String& symbol);
     String fetchMultipleSymbols(const std::vector<String>& symbols);
     String fetchHistoricalData(const String& symbol, const String& interval, 
                               int limit = 100);
     
+    // Portfolios are only ever streamed: the body is handed to the handler
+    // without buffering
+    bool fetchPortfolioStream(const String& portfolioName, uint8_t portfolio,
+                              APIStreamHandler handler,
+                              APIResponseInfo* responseInfo = nullptr);
+    
+    // Batched variant: one request returns {"portfolios": {"<name>": {...}, ...}}
+    bool fetchPortfolios(const std::vector<String>& portfolioNames,
+                         APIStreamHandler handler,
+                         APIResponseInfo* responseInfo = nullptr);
+    
     // ===== REQUEST METHODS =====
     String GET(const String& endpoint, const std::vector<String>& headers = {});
     String POST(const String& endpoint, const String& body, 
@@ -99,12 +136,9 @@ public:
     String DELETE(const String& endpoint, const std::vector<String>& headers = {});
     
     // ===== CACHE MANAGEMENT =====
-    void setCacheTTL(unsigned long ttl, byte mode = 0);
-    unsigned long getCacheTTL(byte mode) const;
-    bool isCacheValid(byte mode) const;
-    String getCachedData(byte mode) const;
-    void updateCache(byte mode, const String& data);
-    void clearCache(byte mode = 255); // 255 = clear all
+    void clearCache();
+    void clearValidators(uint8_t portfolio);
+    void setDeltaEnabled(bool enabled);
     
     // ===== AUTHENTICATION =====
     String generateAuthHeader();
@@ -124,6 +158,7 @@ public:
     float getSuccessRate() const;
     float getAverageResponseTime() const;
     size_t getTotalBytesReceived() const;
+    float getConnectionReuseRatio() const;
     
     // ===== REQUEST MONITORING =====
     bool isRequestInProgress() const;
@@ -132,7 +167,8 @@ public:
     
     // ===== UTILITY FUNCTIONS =====
     String buildURL(const String& endpoint);
-    String buildPortfolioURL(const String& portfolioName);
+    String& buildPortfolioURL(const String& portfolioName);
+    String& buildBatchURL(const std::vector<String>& portfolioNames);
     std::vector<String> getDefaultHeaders();
     
     String encodeURLParameters(const std::map<String, String>& params);
@@ -159,6 +195,11 @@ private:
                          const String& body = "", 
                          const std::vector<String>& headers = {});
     bool prepareRequest(const String& url);
+    bool streamWithRetries(const String& url, APIStreamHandler handler,
+                           APIResponseInfo* responseInfo, APIValidators& validators);
+    bool makeStreamingAPICall(const String& url, APIStreamHandler handler,
+                              APIResponseInfo* responseInfo,
+                              APIValidators* validators = nullptr);
     bool addHeaders(const std::vector<String>& headers);
     
     // Response handling
@@ -166,15 +207,14 @@ private:
     bool validateResponse(const String& response);
     bool handleErrorResponse(int httpCode);
     
-    // Cache operations
-    APICache* getCache(byte mode);
-    const APICache* getCache(byte mode) const;
-    bool shouldUseCache(byte mode) const;
-    
     // Authentication
     String getAuthToken();
     bool isTokenExpired() const;
     
+    // Persistent connection
+    bool openConnection(const String& url);
+    void closeConnection();
+    
     // SSL/TLS
     bool configureSSL();
     void setRootCA();
@@ -232,22 +272,10 @@ inline size_t APIManager::getTotalBytesReceived() const {
     return stats.totalBytesReceived;
 }
 
-inline unsigned long APIManager::getCacheTTL(byte mode) const {
-    const APICache* cache = getCache(mode);
-    return cache ? cache->ttl : 0;
-}
-
-inline bool APIManager::isCacheValid(byte mode) const {
-    const APICache* cache = getCache(mode);
-    if (!cache || cache->data.length() == 0) return false;
-    
-    unsigned long age = millis() - cache->timestamp;
-    return age < cache->ttl;
-}
-
-inline String APIManager::getCachedData(byte mode) const {
-    const APICache* cache = getCache(mode);
-    return cache ? cache->data : "";
+inline float APIManager::getConnectionReuseRatio() const {
+    uint32_t total = stats.handshakeCount + stats.reusedConnections;
+    if (total == 0) return 0.0;
+    return (float)stats.reusedConnections / total;
 }
 
 // Default configuration
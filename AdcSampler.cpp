@@ -0,0 +1,94 @@
+#include "AdcSampler.h"
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+AdcSampler::AdcSampler()
+    : _pin(0),
+      _alpha(ADC_SAMPLER_DEFAULT_ALPHA),
+      _timer(nullptr),
+      _head(0),
+      _filtered(0),
+      _median(0),
+      _sampleCount(0) {
+    memset(_window, 0, sizeof(_window));
+}
+
+AdcSampler::~AdcSampler() {
+    if (_timer) {
+        esp_timer_stop(_timer);
+        esp_timer_delete(_timer);
+    }
+}
+
+// ===== INITIALIZATION =====
+bool AdcSampler::begin(uint8_t pin, uint32_t intervalMs, float alpha) {
+    if (_timer) return true;
+
+    _pin = pin;
+    _alpha = alpha;
+
+    // Seed the window; analogReadMilliVolts() takes microseconds, no settling delay needed
+    for (int i = 0; i < ADC_SAMPLER_MEDIAN_WINDOW; i++) {
+        _window[i] = analogReadMilliVolts(_pin);
+    }
+    _head = 0;
+    _median = median();
+    _filtered = _median;
+    _sampleCount = ADC_SAMPLER_MEDIAN_WINDOW;
+
+    esp_timer_create_args_t args = {};
+    args.callback = &AdcSampler::timerCallback;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "adc_sampler";
+
+    if (esp_timer_create(&args, &_timer) != ESP_OK) {
+        Serial.println("Failed to create ADC sampler timer");
+        _timer = nullptr;
+        return false;
+    }
+
+    esp_timer_start_periodic(_timer, (uint64_t)intervalMs * 1000);
+    return true;
+}
+
+void AdcSampler::stop() {
+    if (_timer) {
+        esp_timer_stop(_timer);
+    }
+}
+
+// ===== SAMPLING =====
+void AdcSampler::timerCallback(void* arg) {
+    static_cast<AdcSampler*>(arg)->sample();
+}
+
+void AdcSampler::sample() {
+    _window[_head] = analogReadMilliVolts(_pin);
+    _head = (_head + 1) % ADC_SAMPLER_MEDIAN_WINDOW;
+
+    uint16_t value = median();
+    _median = value;
+    _filtered = _filtered + _alpha * (value - _filtered);
+    _sampleCount++;
+}
+
+uint16_t AdcSampler::median() const {
+    // Insertion sort of a copy; the window is a handful of values
+    uint16_t sorted[ADC_SAMPLER_MEDIAN_WINDOW];
+    for (int i = 0; i < ADC_SAMPLER_MEDIAN_WINDOW; i++) {
+        uint16_t value = _window[i];
+        int j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    return sorted[ADC_SAMPLER_MEDIAN_WINDOW / 2];
+}
+
+// ===== GETTERS =====
+bool AdcSampler::isRunning() const { return _timer != nullptr; }
+float AdcSampler::getMillivolts() const { return _filtered; }
+uint16_t AdcSampler::getMedianMillivolts() const { return _median; }
+uint32_t AdcSampler::getSampleCount() const { return _sampleCount; }
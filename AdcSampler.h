@@ -0,0 +1,46 @@
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#define ADC_SAMPLER_MEDIAN_WINDOW 5     // Odd; a single spike never reaches the output
+#define ADC_SAMPLER_DEFAULT_ALPHA 0.2
+
+// Background sampler for one ADC1 pin. An esp_timer takes one sample per
+// tick through analogReadMilliVolts(), which applies the eFuse calibration.
+// The median of the last few samples feeds an EMA, so readers get a
+// filtered value without ever waiting on the ADC.
+class AdcSampler {
+public:
+    AdcSampler();
+    ~AdcSampler();
+
+    // Initialization; fills the window synchronously so a value is ready on return
+    bool begin(uint8_t pin, uint32_t intervalMs, float alpha = ADC_SAMPLER_DEFAULT_ALPHA);
+    void stop();
+
+    // Readings, in millivolts at the pin
+    bool isRunning() const;
+    float getMillivolts() const;            // Median + EMA
+    uint16_t getMedianMillivolts() const;   // Latest median, unsmoothed
+    uint32_t getSampleCount() const;
+
+private:
+    static void timerCallback(void* arg);
+    void sample();
+    uint16_t median() const;
+
+    uint8_t _pin;
+    float _alpha;
+    esp_timer_handle_t _timer;
+
+    // Written only by the timer task; readers take single aligned words
+    uint16_t _window[ADC_SAMPLER_MEDIAN_WINDOW];
+    uint8_t _head;
+    volatile float _filtered;
+    volatile uint16_t _median;
+    volatile uint32_t _sampleCount;
+};
+
+#endif
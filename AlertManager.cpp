@@ -0,0 +1,274 @@
+#include "AlertManager.h"
+#include "BuzzerManager.h"
+#include "DisplayManager.h"
+#include "NumberFormat.h"
+#include <esp_heap_caps.h>
+
+// ===== CONSTANTS =====
+#define ALERT_HYSTERESIS_PERCENT 0.5    // Recovery needed before a level re-arms
+
+// ===== CONSTRUCTOR =====
+AlertManager::AlertManager()
+    : buzzerMgr(nullptr),
+      displayMgr(nullptr),
+      settings(nullptr),
+      lastPortfolioAlertTime(0),
+      enabled(true),
+      soundEnabled(true),
+      visualEnabled(true),
+      cooldownPeriod(300000),
+      alertPending(false),
+      historySequence(0),
+      subscribed(false) {
+    memset(portfolioLevel, 0, sizeof(portfolioLevel));
+    memset(&pendingAlert, 0, sizeof(pendingAlert));
+    memset(history, 0, sizeof(history));
+    memset(crossing, 0, sizeof(crossing));
+    portMUX_INITIALIZE(&alertLock);
+}
+
+// ===== INITIALIZATION =====
+void AlertManager::init(const SystemSettings& settings, BuzzerManager& buzzer,
+                        DisplayManager& display) {
+    this->settings = &settings;
+    buzzerMgr = &buzzer;
+    displayMgr = &display;
+    cooldownPeriod = settings.alertCooldown;
+
+    if (subscribed) return;
+
+    // Alerts are evaluated as the parser reports changes, not on a timer
+    subscribed = PositionEvents::getInstance().subscribe(positionEventHandler, this);
+}
+
+// ===== EVENT-DRIVEN EVALUATION =====
+void AlertManager::positionEventHandler(const PositionEvent& event, void* context) {
+    static_cast<AlertManager*>(context)->onPositionEvent(event);
+}
+
+void AlertManager::onPositionEvent(const PositionEvent& event) {
+    if (!enabled || !settings) return;
+
+    if (event.type == POSITION_EVENT_PARSED) {
+        evaluatePortfolio(event);
+        return;
+    }
+
+    if (event.symbolId >= SYMBOL_TABLE_CAPACITY || event.portfolio >= PORTFOLIO_MAX) return;
+
+    // Only portfolios that report positions get crossing state
+    CrossingState*& states = crossing[event.portfolio];
+    if (!states) {
+        uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+        states = (CrossingState*)heap_caps_calloc(SYMBOL_TABLE_CAPACITY, sizeof(CrossingState), caps);
+        if (!states) {
+            Serial.println("Alert state allocation failed");
+            return;
+        }
+    }
+
+    // New and removed positions start from a clean state
+    CrossingState& state = states[event.symbolId];
+    if (event.type == POSITION_EVENT_REMOVED || event.previousPrice == 0) {
+        memset(&state, 0, sizeof(state));
+        if (event.type == POSITION_EVENT_REMOVED) return;
+    }
+
+    if (event.isExitMode) {
+        evaluateExitPosition(event, state);
+    } else {
+        evaluatePosition(event, state);
+    }
+}
+
+int8_t AlertManager::getPositionLevel(float changePercent, int8_t current) const {
+    // Thresholds are losses (negative); a level is only left once the
+    // position has recovered past it by the hysteresis margin
+    float severe = settings->severeAlertThreshold;
+    float normal = settings->alertThreshold;
+
+    if (changePercent <= severe) return 2;
+    if (current == 2 && changePercent <= severe + ALERT_HYSTERESIS_PERCENT) return 2;
+    if (changePercent <= normal) return 1;
+    if (current >= 1 && changePercent <= normal + ALERT_HYSTERESIS_PERCENT) return 1;
+    return 0;
+}
+
+void AlertManager::evaluatePosition(const PositionEvent& event, CrossingState& state) {
+    int8_t level = getPositionLevel(event.changePercent, state.level);
+    if (level <= state.level) {
+        state.level = level;
+        return;
+    }
+
+    // Crossed a threshold outwards; kept pending while in cooldown
+    unsigned long now = millis();
+    if (state.lastAlertTime != 0 && now - state.lastAlertTime < (unsigned long)cooldownPeriod) return;
+
+    state.level = level;
+    state.lastAlertTime = now;
+    raiseAlert(level == 2 ? ALERT_SEVERE : ALERT_NORMAL, event, event.changePercent, level == 2);
+}
+
+void AlertManager::evaluateExitPosition(const PositionEvent& event, CrossingState& state) {
+    if (!settings->exitAlertEnabled || event.price <= 0) return;
+
+    if (state.referencePrice <= 0) {
+        state.referencePrice = event.price;
+        return;
+    }
+
+    float move = (event.price - state.referencePrice) / state.referencePrice * 100.0;
+    if (fabs(move) < settings->exitAlertPercent) return;
+
+    bool isProfit = event.isLong ? move > 0 : move < 0;
+    state.referencePrice = event.price;
+    state.lastAlertTime = millis();
+    raiseAlert(isProfit ? ALERT_EXIT_PROFIT : ALERT_EXIT_LOSS, event, move, false);
+}
+
+void AlertManager::evaluatePortfolio(const PositionEvent& event) {
+    if (event.portfolio >= PORTFOLIO_MAX) return;
+    int8_t& level = portfolioLevel[event.portfolio];
+    float threshold = settings->portfolioAlertThreshold;
+
+    if (event.portfolioPnlPercent > threshold + ALERT_HYSTERESIS_PERCENT) {
+        level = 0;
+    } else if (event.portfolioPnlPercent <= threshold && level == 0) {
+        level = 1;
+        lastPortfolioAlertTime = millis();
+        raiseAlert(ALERT_PORTFOLIO, event, event.portfolioPnlPercent, false);
+    }
+}
+
+// ===== ALERT TRIGGERING =====
+void AlertManager::raiseAlert(byte type, const PositionEvent& event, float changePercent, bool isSevere) {
+    stats.totalAlerts++;
+    if (isSevere) stats.severeAlerts++;
+    if (type == ALERT_PORTFOLIO) {
+        stats.portfolioAlerts++;
+    } else if (type == ALERT_EXIT_PROFIT || type == ALERT_EXIT_LOSS) {
+        stats.exitAlerts++;
+    } else {
+        stats.positionAlerts++;
+    }
+
+    // The sequencer plays from its own timer, so this never blocks the parser
+    if (soundEnabled && buzzerMgr) {
+        if (type == ALERT_PORTFOLIO) {
+            buzzerMgr->playPortfolioAlert();
+        } else if (type == ALERT_EXIT_PROFIT || type == ALERT_EXIT_LOSS) {
+            buzzerMgr->playExitAlert(type == ALERT_EXIT_PROFIT);
+        } else {
+            buzzerMgr->playAlert(event.isLong, isSevere);
+        }
+    }
+
+    addToHistory(type, event, changePercent, isSevere);
+
+    if (!visualEnabled) return;
+
+    // The display belongs to the display task; hand the alert over
+    portENTER_CRITICAL(&alertLock);
+    pendingAlert.type = type;
+    pendingAlert.mode = event.isExitMode ? 1 : 0;
+    pendingAlert.portfolio = event.portfolio;
+    strlcpy(pendingAlert.symbol, event.symbol ? event.symbol : "PORTFOLIO", sizeof(pendingAlert.symbol));
+    pendingAlert.price = event.price;
+    pendingAlert.changePercent = changePercent;
+    pendingAlert.isLong = event.isLong;
+    pendingAlert.isSevere = isSevere;
+    alertPending = true;
+    portEXIT_CRITICAL(&alertLock);
+}
+
+// ===== ALERT HISTORY =====
+void AlertManager::addToHistory(byte type, const PositionEvent& event, float changePercent, bool isSevere) {
+    portENTER_CRITICAL(&alertLock);
+    historySequence++;
+    AlertRecord& record = history[historySequence % ALERT_HISTORY_SIZE];
+    record.sequence = historySequence;
+    record.type = type;
+    record.portfolio = event.portfolio;
+    record.isExitMode = event.isExitMode;
+    strlcpy(record.symbol, event.symbol ? event.symbol : "PORTFOLIO", sizeof(record.symbol));
+    record.price = event.price;
+    record.changePercent = changePercent;
+    record.isLong = event.isLong;
+    record.isSevere = isSevere;
+    record.alertTime = millis();
+    portEXIT_CRITICAL(&alertLock);
+}
+
+int AlertManager::getAlertsSince(uint32_t sequence, AlertRecord* alerts, int maxAlerts) const {
+    int count = 0;
+
+    portENTER_CRITICAL(&alertLock);
+    uint32_t oldest = historySequence >= ALERT_HISTORY_SIZE ? historySequence - ALERT_HISTORY_SIZE + 1 : 1;
+    uint32_t next = max(sequence + 1, oldest);
+    for (; next <= historySequence && count < maxAlerts; next++) {
+        alerts[count++] = history[next % ALERT_HISTORY_SIZE];
+    }
+    portEXIT_CRITICAL(&alertLock);
+
+    return count;
+}
+
+uint32_t AlertManager::getAlertSequence() const {
+    portENTER_CRITICAL(&alertLock);
+    uint32_t sequence = historySequence;
+    portEXIT_CRITICAL(&alertLock);
+    return sequence;
+}
+
+// ===== ALERT PROCESSING =====
+const char* AlertManager::getAlertTitle(byte type) {
+    switch (type) {
+        case ALERT_SEVERE: return "SEVERE ALERT";
+        case ALERT_PORTFOLIO: return "PORTFOLIO ALERT";
+        case ALERT_EXIT_PROFIT: return "EXIT PROFIT";
+        case ALERT_EXIT_LOSS: return "EXIT LOSS";
+        default: return "PRICE ALERT";
+    }
+}
+
+void AlertManager::updateAlertDisplay() {
+    if (!alertPending || !displayMgr) return;
+
+    PendingAlert alert;
+    portENTER_CRITICAL(&alertLock);
+    alert = pendingAlert;
+    alertPending = false;
+    portEXIT_CRITICAL(&alertLock);
+
+    currentAlert.active = true;
+    currentAlert.mode = alert.mode;
+    currentAlert.portfolio = alert.portfolio;
+    currentAlert.symbol = alert.symbol;
+    currentAlert.title = getAlertTitle(alert.type);
+    char message[NUMBER_TEXT_LENGTH];
+    NumberFormat::format(message, sizeof(message), alert.changePercent, NumberSpecs::RATIO);
+    currentAlert.message = message;
+    currentAlert.price = alert.price;
+    currentAlert.isLong = alert.isLong;
+    currentAlert.isSevere = alert.isSevere;
+    currentAlert.startTime = millis();
+    currentAlert.acknowledged = false;
+
+    displayMgr->showAlertScreen(currentAlert.title, currentAlert.symbol, currentAlert.message,
+                                currentAlert.price, currentAlert.isSevere, currentAlert.mode,
+                                currentAlert.portfolio);
+}
+
+// ===== ALERT MANAGEMENT =====
+void AlertManager::resetAll() {
+    for (int i = 0; i < PORTFOLIO_MAX; i++) {
+        if (crossing[i]) {
+            memset(crossing[i], 0, SYMBOL_TABLE_CAPACITY * sizeof(CrossingState));
+        }
+    }
+    memset(portfolioLevel, 0, sizeof(portfolioLevel));
+
+    alertPending = false;
+    currentAlert = AlertState();
+}
@@ -3,18 +3,35 @@
 
 #include <Arduino.h>
 #include "SystemConfig.h"
+#include "SymbolTable.h"
+#include "PositionEvents.h"
+#include "PortfolioTable.h"
 
 // Forward declarations
 class BuzzerManager;
-class CryptoData;
 class DisplayManager;
 struct SystemSettings;
 
+#define ALERT_HISTORY_SIZE 32           // Recent alerts kept for the web API and push channel
+
+// One raised alert, as kept in the history ring
+struct AlertRecord {
+    uint32_t sequence;                  // Increments per alert, starting at 1
+    byte type;                          // AlertType
+    uint8_t portfolio;                  // Row in the portfolio table
+    bool isExitMode;                    // Alert style of that portfolio
+    char symbol[SYMBOL_NAME_LENGTH];    // "PORTFOLIO" for portfolio alerts
+    float price;
+    float changePercent;
+    bool isLong;
+    bool isSevere;
+    unsigned long alertTime;            // millis() when raised
+};
+
 class AlertManager {
 private:
     // References to other managers
     BuzzerManager* buzzerMgr;
-    CryptoData* cryptoData;
     DisplayManager* displayMgr;
     const SystemSettings* settings;
     
@@ -22,6 +39,7 @@ private:
     struct AlertState {
         bool active;
         byte mode;
+        uint8_t portfolio;
         String symbol;
         String title;
         String message;
@@ -31,15 +49,13 @@ private:
         unsigned long startTime;
         bool acknowledged;
         
-        AlertState() : active(false), mode(0), price(0.0), 
+        AlertState() : active(false), mode(0), portfolio(0), price(0.0), 
                       isLong(false), isSevere(false), 
                       startTime(0), acknowledged(false) {}
     } currentAlert;
     
-    // Alert cooldowns
+    // Alert cooldowns; per position they are kept in the crossing state
     unsigned long lastPortfolioAlertTime;
-    unsigned long lastPositionAlertTime[MAX_POSITIONS_PER_MODE];
-    unsigned long lastExitAlertTime[MAX_POSITIONS_PER_MODE];
     
     // Statistics
     struct AlertStatistics {
@@ -61,17 +77,49 @@ private:
     bool visualEnabled;
     int cooldownPeriod;
     
+    // Threshold-crossing state per symbol ID, updated by position events only
+    struct CrossingState {
+        int8_t level;                   // 0 inside, 1 past alert, 2 past severe threshold
+        float referencePrice;           // Exit mode: price at the last exit alert
+        unsigned long lastAlertTime;
+    };
+    CrossingState* crossing[PORTFOLIO_MAX];     // [portfolio][symbol ID], in PSRAM on first event
+    int8_t portfolioLevel[PORTFOLIO_MAX];
+    bool subscribed;
+    
+    // Raised in the parsing task, shown by the display task
+    struct PendingAlert {
+        byte type;                      // AlertType
+        byte mode;
+        uint8_t portfolio;
+        char symbol[SYMBOL_NAME_LENGTH];
+        float price;
+        float changePercent;
+        bool isLong;
+        bool isSevere;
+    } pendingAlert;
+    volatile bool alertPending;
+    
+    // Written by the parsing task, read by the web task
+    AlertRecord history[ALERT_HISTORY_SIZE];
+    uint32_t historySequence;           // Sequence of the newest alert; 0 = none yet
+    mutable portMUX_TYPE alertLock;     // Pending alert and history
+    
 public:
     AlertManager();
     
     // ===== INITIALIZATION =====
     void init(const SystemSettings& settings, BuzzerManager& buzzer, 
-              CryptoData& data, DisplayManager& display);
+              DisplayManager& display);
     void enable(bool enable = true);
     void enableSound(bool enable = true);
     void enableVisual(bool enable = true);
     void setCooldown(int milliseconds);
     
+    // ===== EVENT-DRIVEN EVALUATION =====
+    // Subscribed to PositionEvents in init(); O(1) per changed position
+    void onPositionEvent(const PositionEvent& event);
+    
     // ===== ALERT CHECKING =====
     void checkAlerts(byte mode);
     void checkPortfolioAlerts(byte mode);
@@ -88,6 +136,13 @@ public:
                           const String& message, float price, 
                           bool isSevere, byte mode);
     
+    // ===== ALERT HISTORY =====
+    // Alerts raised after "sequence", oldest first; returns how many were
+    // copied. Older alerts than the ring holds are gone.
+    int getAlertsSince(uint32_t sequence, AlertRecord* alerts, int maxAlerts) const;
+    uint32_t getAlertSequence() const;
+    static const char* getAlertTitle(byte type);
+    
     // ===== ALERT MANAGEMENT =====
     bool isAlertActive() const;
     const AlertState& getCurrentAlert() const;
@@ -139,6 +194,14 @@ public:
     bool shouldAutoReset(float currentValue, float alertValue) const;
     
 private:
+    // Event evaluation
+    static void positionEventHandler(const PositionEvent& event, void* context);
+    void evaluatePosition(const PositionEvent& event, CrossingState& state);
+    void evaluateExitPosition(const PositionEvent& event, CrossingState& state);
+    void evaluatePortfolio(const PositionEvent& event);
+    int8_t getPositionLevel(float changePercent, int8_t current) const;
+    void raiseAlert(byte type, const PositionEvent& event, float changePercent, bool isSevere);
+    
     // Internal helper functions
     void initializeCooldowns();
     void playPortfolioAlertSound(bool isSevere);
@@ -149,9 +212,7 @@ private:
     bool checkPositionThreshold(const CryptoPosition& position) const;
     bool checkExitThreshold(const CryptoPosition& position) const;
     
-    void addToHistory(byte mode, const String& symbol, float pnlPercent, 
-                     float price, bool isLong, bool isSevere, 
-                     bool isProfit, byte alertType);
+    void addToHistory(byte type, const PositionEvent& event, float changePercent, bool isSevere);
     
     void updateAlertHistoryCounters();
     void cleanupOldAlerts();
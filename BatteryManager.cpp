@@ -1,13 +1,14 @@
 #include "BatteryManager.h"
 #include "ConfigManager.h"
+#include "AdcSampler.h"
 #include <Preferences.h>
+#include <StreamString.h>
 
 // ===== CONSTANTS =====
 #define BATTERY_PIN 34
 #define VOLTAGE_DIVIDER_RATIO 2.0
-#define REFERENCE_VOLTAGE 3.3
-#define ADC_MAX 4095
-#define SAMPLE_COUNT 10
+#define SAMPLE_INTERVAL 500             // ms between background ADC samples
+#define HISTORY_SIZE 100                // Per-minute readings kept in NVS
 #define LOW_BATTERY_THRESHOLD 20
 #define CRITICAL_BATTERY_THRESHOLD 10
 #define FULL_CHARGE_VOLTAGE 4.2
@@ -18,6 +19,42 @@
 BatteryManager* BatteryManager::_instance = nullptr;
 Preferences BatteryManager::_prefs;
 
+// Sampled in the background; reading the voltage never touches the ADC
+static AdcSampler _sampler;
+
+// ===== VOLTAGE HISTORY =====
+// Rolling per-minute readings in millivolts, stored as one NVS blob
+struct VoltageHistory {
+    uint16_t values[HISTORY_SIZE];
+    uint8_t head;
+    uint8_t count;
+};
+
+static VoltageHistory _history;
+static uint32_t _historySum = 0;
+
+static void historyReset() {
+    memset(&_history, 0, sizeof(_history));
+    _historySum = 0;
+}
+
+static void historyAdd(float voltage) {
+    uint16_t millivolts = (uint16_t)constrain(voltage * 1000.0, 0.0, 65535.0);
+    
+    if (_history.count == HISTORY_SIZE) {
+        _historySum -= _history.values[_history.head];
+    } else {
+        _history.count++;
+    }
+    _history.values[_history.head] = millivolts;
+    _history.head = (_history.head + 1) % HISTORY_SIZE;
+    _historySum += millivolts;
+}
+
+static float historyAverage() {
+    return _history.count > 0 ? _historySum / (float)_history.count / 1000.0 : 0.0;
+}
+
 // ===== CONSTRUCTOR/DESTRUCTOR =====
 BatteryManager::BatteryManager()
     : _initialized(false),
@@ -45,9 +82,27 @@ bool BatteryManager::begin() {
     // Configure battery pin
     pinMode(BATTERY_PIN, INPUT);
     
+    // Seeds synchronously, so the first update() below has a value
+    _sampler.begin(BATTERY_PIN, SAMPLE_INTERVAL);
+    
     // Load calibration data
     loadCalibration();
     
+    // Load voltage history; drops the old comma-separated string
+    historyReset();
+    _prefs.begin("battery_stats", false);
+    if (_prefs.getBytes("voltage_ring", &_history, sizeof(_history)) != sizeof(_history) ||
+        _history.head >= HISTORY_SIZE || _history.count > HISTORY_SIZE) {
+        historyReset();
+    }
+    if (_prefs.isKey("voltage_history")) {
+        _prefs.remove("voltage_history");
+    }
+    _prefs.end();
+    for (int i = 0; i < _history.count; i++) {
+        _historySum += _history.values[i];
+    }
+    
     // Initial reading
     update();
     
@@ -66,11 +121,8 @@ void BatteryManager::update() {
     
     _lastUpdateTime = currentTime;
     
-    // Read voltage
-    float newVoltage = readVoltage();
-    
-    // Apply low-pass filter
-    _voltage = (_voltage * 0.7) + (newVoltage * 0.3);
+    // Already median and EMA filtered by the sampler
+    _voltage = readVoltage();
     
     // Calculate percentage
     _percentage = calculatePercentage(_voltage);
@@ -94,17 +146,8 @@ void BatteryManager::update() {
 
 // ===== VOLTAGE READING =====
 float BatteryManager::readVoltage() {
-    // Take multiple samples for accuracy
-    uint32_t sum = 0;
-    for (int i = 0; i < SAMPLE_COUNT; i++) {
-        sum += analogRead(BATTERY_PIN);
-        delay(2);
-    }
-    
-    float average = sum / (float)SAMPLE_COUNT;
-    
-    // Convert to voltage
-    float voltage = (average / ADC_MAX) * REFERENCE_VOLTAGE * VOLTAGE_DIVIDER_RATIO;
+    // Latest filtered sample; eFuse-calibrated millivolts at the pin
+    float voltage = _sampler.getMillivolts() / 1000.0 * VOLTAGE_DIVIDER_RATIO;
     
     // Apply calibration offset
     voltage += _calibrationOffset;
@@ -236,8 +279,8 @@ void BatteryManager::saveCriticalData() {
     _prefs.putULong("last_update", millis());
     _prefs.end();
     
-    // Save other critical data
-    ConfigManager::getInstance().save();
+    // Save other critical data; pending settings cannot wait for the debounce
+    ConfigManager::getInstance().flush();
     
     Serial.println("Critical data saved");
 }
@@ -299,20 +342,8 @@ void BatteryManager::saveStatistics() {
     }
     
     // Save voltage history (rolling window)
-    String voltageHistory = _prefs.getString("voltage_history", "");
-    voltageHistory += String(_voltage, 2) + ",";
-    
-    // Keep only last 100 readings
-    int commaCount = 0;
-    for (int i = 0; i < voltageHistory.length(); i++) {
-        if (voltageHistory[i] == ',') commaCount++;
-        if (commaCount > 100) {
-            voltageHistory = voltageHistory.substring(i + 1);
-            break;
-        }
-    }
-    
-    _prefs.putString("voltage_history", voltageHistory);
+    historyAdd(_voltage);
+    _prefs.putBytes("voltage_ring", &_history, sizeof(_history));
     
     // Save min/max voltages
     float minVoltage = _prefs.getFloat("min_voltage", 100.0);
@@ -334,22 +365,8 @@ BatteryStats BatteryManager::getStatistics() {
     stats.maxVoltage = _prefs.getFloat("max_voltage", 0.0);
     stats.firstUse = _prefs.getULong("first_use", 0);
     
-    // Calculate average voltage from history
-    String voltageHistory = _prefs.getString("voltage_history", "");
-    float sum = 0;
-    int count = 0;
-    
-    int startPos = 0;
-    int commaPos = voltageHistory.indexOf(',');
-    while (commaPos != -1) {
-        String voltageStr = voltageHistory.substring(startPos, commaPos);
-        sum += voltageStr.toFloat();
-        count++;
-        startPos = commaPos + 1;
-        commaPos = voltageHistory.indexOf(',', startPos);
-    }
-    
-    stats.averageVoltage = (count > 0) ? (sum / count) : 0.0;
+    // Running sum over the history ring
+    stats.averageVoltage = historyAverage();
     
     _prefs.end();
     
@@ -358,7 +375,13 @@ BatteryStats BatteryManager::getStatistics() {
 
 // ===== WEB INTERFACE HANDLERS =====
 String BatteryManager::getStatusJSON() {
-    DynamicJsonDocument doc(512);
+    StreamString json;
+    printStatusJSON(json);
+    return json;
+}
+
+void BatteryManager::printStatusJSON(Print& out) {
+    StaticJsonDocument<512> doc;
     
     doc["voltage"] = _voltage;
     doc["percentage"] = _percentage;
@@ -376,9 +399,7 @@ String BatteryManager::getStatusJSON() {
     statsObj["max_voltage"] = stats.maxVoltage;
     statsObj["average_voltage"] = stats.averageVoltage;
     
-    String json;
-    serializeJson(doc, json);
-    return json;
+    serializeJson(doc, out);
 }
 
 void BatteryManager::handleWebRequest(const String& action, const String& params) {
@@ -116,6 +116,10 @@ public:
     void resetStatistics();
     float getBatteryHealth() const; // 0-100%
     
+    // ===== WEB INTERFACE =====
+    String getStatusJSON();
+    void printStatusJSON(Print& out);      // Streams without building a String
+    
     // ===== DEBUG FUNCTIONS =====
     void printStatus() const;
     void printStatistics() const;
@@ -1,6 +1,49 @@
 #include "BuzzerManager.h"
 #include "ConfigManager.h"
 #include <Arduino.h>
+#include <StreamString.h>
+
+// ===== CONSTANTS =====
+#define BUZZER_LEDC_CHANNEL 0
+#define BUZZER_LEDC_RESOLUTION 8
+#define BUZZER_MAX_DUTY 128       // 50% duty at 8-bit resolution = full volume
+
+// Pattern IDs; repeated requests for the same ID are merged while pending
+enum BuzzerPatternId : uint8_t {
+    PATTERN_CUSTOM = 0,
+    PATTERN_LONG_NORMAL,
+    PATTERN_LONG_SEVERE,
+    PATTERN_SHORT_NORMAL,
+    PATTERN_SHORT_SEVERE,
+    PATTERN_EXIT_PROFIT,
+    PATTERN_EXIT_LOSS,
+    PATTERN_PORTFOLIO,
+    PATTERN_CONNECTED,
+    PATTERN_DISCONNECTED,
+    PATTERN_ERROR,
+    PATTERN_SUCCESS,
+    PATTERN_STARTUP,
+    PATTERN_SHUTDOWN,
+    PATTERN_VOLUME
+};
+
+// ===== PATTERN TABLES =====
+// {frequency, duration, pause}
+static const PatternStep LONG_SEVERE_STEPS[] = {{440, 200, 50}, {349, 250, 50}, {294, 300, 0}};
+static const PatternStep LONG_NORMAL_STEPS[] = {{523, 300, 0}};
+static const PatternStep SHORT_SEVERE_STEPS[] = {{784, 100, 20}};          // x3
+static const PatternStep SHORT_NORMAL_STEPS[] = {{659, 250, 0}};
+static const PatternStep EXIT_PROFIT_STEPS[] = {{523, 150, 50}, {659, 150, 50}, {784, 200, 0}};
+static const PatternStep EXIT_LOSS_STEPS[] = {{784, 150, 50}, {659, 150, 50}, {523, 200, 0}};
+static const PatternStep PORTFOLIO_STEPS[] = {{587, 200, 50}, {494, 150, 50}};  // x3
+static const PatternStep CONNECTED_STEPS[] = {{659, 150, 50}, {784, 150, 50}, {880, 200, 0}};
+static const PatternStep DISCONNECTED_STEPS[] = {{880, 150, 50}, {784, 150, 50}, {659, 200, 0}};
+static const PatternStep ERROR_STEPS[] = {{349, 200, 50}, {415, 200, 50}, {349, 300, 0}};
+static const PatternStep SUCCESS_STEPS[] = {{523, 150, 50}, {659, 150, 50}, {784, 200, 50}, {1047, 300, 0}};
+static const PatternStep STARTUP_STEPS[] = {{523, 100, 20}, {659, 100, 20}, {784, 100, 20}, {1047, 200, 0}};
+static const PatternStep SHUTDOWN_STEPS[] = {{1047, 100, 20}, {784, 100, 20}, {659, 100, 20}, {523, 200, 0}};
+
+#define STEP_COUNT(steps) (sizeof(steps) / sizeof(steps[0]))
 
 // ===== CONSTRUCTOR/DESTRUCTOR =====
 BuzzerManager::BuzzerManager(uint8_t pin) 
@@ -14,9 +57,7 @@ BuzzerManager::BuzzerManager(uint8_t pin)
 }
 
 BuzzerManager::~BuzzerManager() {
-    if (_isPlaying) {
-        noTone(_pin);
-    }
+    _sequencer.stop();
 }
 
 // ===== INITIALIZATION =====
@@ -24,8 +65,11 @@ void BuzzerManager::begin() {
     Serial.print("Initializing Buzzer on pin ");
     Serial.println(_pin);
     
-    pinMode(_pin, OUTPUT);
-    digitalWrite(_pin, LOW);
+    // Tones are generated on an LEDC channel driven by the sequencer
+    ledcSetup(BUZZER_LEDC_CHANNEL, 2000, BUZZER_LEDC_RESOLUTION);
+    ledcAttachPin(_pin, BUZZER_LEDC_CHANNEL);
+    ledcWrite(BUZZER_LEDC_CHANNEL, 0);
+    _sequencer.begin("buzzer", &BuzzerManager::sequencerOutput, this);
     
     // Load settings
     _enabled = ConfigManager::getInstance().getBuzzerEnabled();
@@ -44,9 +88,8 @@ void BuzzerManager::begin() {
 }
 
 void BuzzerManager::update() {
-    if (_isPlaying && millis() >= _toneEndTime) {
-        stopTone();
-    }
+    // Playback runs from the sequencer timer; only track completion here
+    _isPlaying = _sequencer.isBusy();
 }
 
 // ===== VOLUME CONTROL =====
@@ -89,9 +132,7 @@ void BuzzerManager::toggleEnabled() {
 
 void BuzzerManager::mute() {
     _muted = true;
-    if (_isPlaying) {
-        stopTone();
-    }
+    stopTone();
     Serial.println("Buzzer muted");
 }
 
@@ -101,29 +142,30 @@ void BuzzerManager::unmute() {
 }
 
 // ===== TONE PLAYBACK =====
-void BuzzerManager::playTone(uint16_t frequency, uint32_t duration) {
-    if (!_enabled || _muted || _volume == 0 || _isPlaying) {
-        return;
+bool BuzzerManager::playPattern(uint8_t patternId, const PatternStep* steps,
+                                uint8_t stepCount, uint8_t repeats) {
+    if (!_enabled || _muted || _volume == 0) {
+        return false;
     }
     
-    // Calculate actual duration based on volume
-    uint32_t actualDuration = map(_volume, 0, 100, 0, duration);
-    if (actualDuration == 0) return;
-    
-    // For low volumes, use pulsing
-    if (_volume < 30) {
-        playPulsedTone(frequency, actualDuration);
-    } else {
-        tone(_pin, frequency, actualDuration);
-        _currentFrequency = frequency;
+    bool queued = _sequencer.enqueue(patternId, steps, stepCount, repeats);
+    if (queued) {
         _isPlaying = true;
-        _toneEndTime = millis() + actualDuration + 10; // Add small buffer
+    } else {
+        Serial.println("Buzzer queue full, pattern dropped");
     }
+    return queued;
+}
+
+void BuzzerManager::playTone(uint16_t frequency, uint32_t duration) {
+    PatternStep step = {frequency, (uint16_t)min<uint32_t>(duration, 0xFFFF), 0};
+    
+    if (!playPattern(PATTERN_CUSTOM, &step, 1)) return;
     
     Serial.print("Playing tone: ");
     Serial.print(frequency);
     Serial.print("Hz, ");
-    Serial.print(actualDuration);
+    Serial.print(duration);
     Serial.print("ms (Vol: ");
     Serial.print(_volume);
     Serial.println("%)");
@@ -133,28 +175,33 @@ void BuzzerManager::playMelody(const uint16_t* frequencies, const uint16_t* dura
     if (!_enabled || _muted || _volume == 0) return;
     
     Serial.println("Playing melody...");
+    
+    // Long melodies are split into several queued patterns
+    PatternStep steps[PATTERN_MAX_STEPS];
+    uint8_t stepCount = 0;
     for (uint8_t i = 0; i < count; i++) {
-        if (_muted) break; // Allow interruption
-        
-        playTone(frequencies[i], durations[i]);
+        steps[stepCount].value = frequencies[i];
+        steps[stepCount].durationMs = durations[i];
+        steps[stepCount].pauseMs = (i < count - 1) ? 30 : 0;  // Small pause between notes
+        stepCount++;
         
-        // Wait for tone to complete (with small buffer)
-        unsigned long noteEnd = millis() + durations[i] + 20;
-        while (millis() < noteEnd && !_muted) {
-            delay(10);
+        if (stepCount == PATTERN_MAX_STEPS || i == count - 1) {
+            if (!playPattern(PATTERN_CUSTOM, steps, stepCount)) break;
+            stepCount = 0;
         }
-        
-        // Small pause between notes
-        if (i < count - 1) delay(30);
     }
 }
 
 void BuzzerManager::stopTone() {
-    noTone(_pin);
+    _sequencer.stop();
     _isPlaying = false;
     _currentFrequency = 0;
 }
 
+bool BuzzerManager::isBusy() const {
+    return _sequencer.isBusy();
+}
+
 // ===== ALERT TONES =====
 void BuzzerManager::playAlert(bool isLong, bool isSevere) {
     if (!_enabled || _muted) return;
@@ -167,25 +214,18 @@ void BuzzerManager::playAlert(bool isLong, bool isSevere) {
     if (isLong) {
         if (isSevere) {
             // Severe long alert: low descending tones
-            playTone(440, 200);  // A4
-            delay(250);
-            playTone(349, 250);  // F4
-            delay(300);
-            playTone(294, 300);  // D4
+            playPattern(PATTERN_LONG_SEVERE, LONG_SEVERE_STEPS, STEP_COUNT(LONG_SEVERE_STEPS));
         } else {
             // Normal long alert: single tone
-            playTone(523, 300);  // C5
+            playPattern(PATTERN_LONG_NORMAL, LONG_NORMAL_STEPS, STEP_COUNT(LONG_NORMAL_STEPS));
         }
     } else {
         if (isSevere) {
             // Severe short alert: rapid beeps
-            for (int i = 0; i < 3; i++) {
-                playTone(784, 100);  // G5
-                delay(120);
-            }
+            playPattern(PATTERN_SHORT_SEVERE, SHORT_SEVERE_STEPS, STEP_COUNT(SHORT_SEVERE_STEPS), 3);
         } else {
             // Normal short alert: single tone
-            playTone(659, 250);  // E5
+            playPattern(PATTERN_SHORT_NORMAL, SHORT_NORMAL_STEPS, STEP_COUNT(SHORT_NORMAL_STEPS));
         }
     }
 }
@@ -198,18 +238,10 @@ void BuzzerManager::playExitAlert(bool isProfit) {
     
     if (isProfit) {
         // Profit: ascending tones
-        playTone(523, 150);   // C5
-        delay(200);
-        playTone(659, 150);   // E5
-        delay(200);
-        playTone(784, 200);   // G5
+        playPattern(PATTERN_EXIT_PROFIT, EXIT_PROFIT_STEPS, STEP_COUNT(EXIT_PROFIT_STEPS));
     } else {
         // Loss: descending tones
-        playTone(784, 150);   // G5
-        delay(200);
-        playTone(659, 150);   // E5
-        delay(200);
-        playTone(523, 200);   // C5
+        playPattern(PATTERN_EXIT_LOSS, EXIT_LOSS_STEPS, STEP_COUNT(EXIT_LOSS_STEPS));
     }
 }
 
@@ -219,12 +251,7 @@ void BuzzerManager::playPortfolioAlert() {
     Serial.println("Playing PORTFOLIO alert");
     
     // Portfolio alert: repeating pattern
-    for (int i = 0; i < 3; i++) {
-        playTone(587, 200);  // D5
-        delay(250);
-        playTone(494, 150);  // B4
-        delay(200);
-    }
+    playPattern(PATTERN_PORTFOLIO, PORTFOLIO_STEPS, STEP_COUNT(PORTFOLIO_STEPS), 3);
 }
 
 void BuzzerManager::playConnectionAlert(bool connected) {
@@ -235,18 +262,10 @@ void BuzzerManager::playConnectionAlert(bool connected) {
     
     if (connected) {
         // Connection established: happy tones
-        playTone(659, 150);   // E5
-        delay(200);
-        playTone(784, 150);   // G5
-        delay(200);
-        playTone(880, 200);   // A5
+        playPattern(PATTERN_CONNECTED, CONNECTED_STEPS, STEP_COUNT(CONNECTED_STEPS));
     } else {
         // Connection lost: sad tones
-        playTone(880, 150);   // A5
-        delay(200);
-        playTone(784, 150);   // G5
-        delay(200);
-        playTone(659, 200);   // E5
+        playPattern(PATTERN_DISCONNECTED, DISCONNECTED_STEPS, STEP_COUNT(DISCONNECTED_STEPS));
     }
 }
 
@@ -256,11 +275,7 @@ void BuzzerManager::playErrorAlert() {
     Serial.println("Playing ERROR alert");
     
     // Error: dissonant tones
-    playTone(349, 200);   // F4
-    delay(250);
-    playTone(415, 200);   // G#4 (dissonant with F4)
-    delay(250);
-    playTone(349, 300);   // F4
+    playPattern(PATTERN_ERROR, ERROR_STEPS, STEP_COUNT(ERROR_STEPS));
 }
 
 void BuzzerManager::playSuccessAlert() {
@@ -269,13 +284,7 @@ void BuzzerManager::playSuccessAlert() {
     Serial.println("Playing SUCCESS alert");
     
     // Success: cheerful tones
-    playTone(523, 150);   // C5
-    delay(200);
-    playTone(659, 150);   // E5
-    delay(200);
-    playTone(784, 200);   // G5
-    delay(250);
-    playTone(1047, 300);  // C6
+    playPattern(PATTERN_SUCCESS, SUCCESS_STEPS, STEP_COUNT(SUCCESS_STEPS));
 }
 
 void BuzzerManager::playStartupTone() {
@@ -284,13 +293,7 @@ void BuzzerManager::playStartupTone() {
     Serial.println("Playing STARTUP tone");
     
     // Startup: ascending arpeggio
-    uint16_t startupFreqs[] = {523, 659, 784, 1047};  // C5, E5, G5, C6
-    uint16_t startupDurs[] = {100, 100, 100, 200};
-    
-    for (int i = 0; i < 4; i++) {
-        playTone(startupFreqs[i], startupDurs[i]);
-        delay(120);
-    }
+    playPattern(PATTERN_STARTUP, STARTUP_STEPS, STEP_COUNT(STARTUP_STEPS));
 }
 
 void BuzzerManager::playShutdownTone() {
@@ -299,13 +302,7 @@ void BuzzerManager::playShutdownTone() {
     Serial.println("Playing SHUTDOWN tone");
     
     // Shutdown: descending arpeggio
-    uint16_t shutdownFreqs[] = {1047, 784, 659, 523};  // C6, G5, E5, C5
-    uint16_t shutdownDurs[] = {100, 100, 100, 200};
-    
-    for (int i = 0; i < 4; i++) {
-        playTone(shutdownFreqs[i], shutdownDurs[i]);
-        delay(120);
-    }
+    playPattern(PATTERN_SHUTDOWN, SHUTDOWN_STEPS, STEP_COUNT(SHUTDOWN_STEPS));
 }
 
 // ===== TEST FUNCTIONS =====
@@ -323,12 +320,10 @@ void BuzzerManager::testVolumeRange() {
         Serial.print(vol);
         Serial.println("%: Testing...");
         
-        playTone(440, 200);  // A4
-        delay(300);
-        playTone(523, 200);  // C5
-        delay(300);
-        playTone(659, 200);  // E5
-        delay(500);
+        // Volume is applied at play time, so wait before changing it
+        static const PatternStep steps[] = {{440, 200, 100}, {523, 200, 100}, {659, 200, 300}};
+        playPattern(PATTERN_CUSTOM, steps, STEP_COUNT(steps));
+        waitForIdle();
     }
     
     // Restore original volume
@@ -344,47 +339,47 @@ void BuzzerManager::testAllAlerts() {
     // Long normal alert
     Serial.println("1. Long normal alert");
     playAlert(true, false);
-    delay(800);
+    waitForIdle(800);
     
     // Long severe alert
     Serial.println("2. Long severe alert");
     playAlert(true, true);
-    delay(800);
+    waitForIdle(800);
     
     // Short normal alert
     Serial.println("3. Short normal alert");
     playAlert(false, false);
-    delay(800);
+    waitForIdle(800);
     
     // Short severe alert
     Serial.println("4. Short severe alert");
     playAlert(false, true);
-    delay(800);
+    waitForIdle(800);
     
     // Exit profit alert
     Serial.println("5. Exit profit alert");
     playExitAlert(true);
-    delay(800);
+    waitForIdle(800);
     
     // Exit loss alert
     Serial.println("6. Exit loss alert");
     playExitAlert(false);
-    delay(800);
+    waitForIdle(800);
     
     // Portfolio alert
     Serial.println("7. Portfolio alert");
     playPortfolioAlert();
-    delay(800);
+    waitForIdle(800);
     
     // Success alert
     Serial.println("8. Success alert");
     playSuccessAlert();
-    delay(800);
+    waitForIdle(800);
     
     // Error alert
     Serial.println("9. Error alert");
     playErrorAlert();
-    delay(800);
+    waitForIdle(800);
     
     Serial.println("Alert test complete");
 }
@@ -399,18 +394,34 @@ void BuzzerManager::playVolumeFeedback() {
     // Duration based on volume
     uint16_t duration = map(_volume, 0, 100, 50, 200);
     
-    playTone(freq, duration);
+    // Merged, so dragging a volume slider does not flood the queue
+    PatternStep step = {freq, duration, 0};
+    playPattern(PATTERN_VOLUME, &step, 1);
 }
 
-void BuzzerManager::playPulsedTone(uint16_t frequency, uint32_t totalDuration) {
-    uint16_t pulseCount = totalDuration / 30;
-    uint16_t pulseDuration = 20;
-    uint16_t pauseDuration = 30 - pulseDuration;
+void BuzzerManager::waitForIdle(uint32_t extraDelayMs) {
+    // Diagnostics only; alert paths never wait on the sequencer
+    while (_sequencer.isBusy()) {
+        delay(10);
+    }
+    if (extraDelayMs > 0) delay(extraDelayMs);
+}
+
+void BuzzerManager::sequencerOutput(uint16_t frequency, void* context) {
+    BuzzerManager* self = static_cast<BuzzerManager*>(context);
     
-    for (uint16_t i = 0; i < pulseCount; i++) {
-        tone(_pin, frequency, pulseDuration);
-        delay(pauseDuration);
+    if (frequency == 0 || self->_muted || !self->_enabled) {
+        ledcWrite(BUZZER_LEDC_CHANNEL, 0);
+        self->_currentFrequency = 0;
+        return;
     }
+    
+    // Volume sets the duty cycle; the pitch comes from the LEDC frequency.
+    // ledcWriteTone() would switch the channel to 10 bits, where
+    // BUZZER_MAX_DUTY is only 12.5%, so the resolution is kept here.
+    ledcChangeFrequency(BUZZER_LEDC_CHANNEL, frequency, BUZZER_LEDC_RESOLUTION);
+    ledcWrite(BUZZER_LEDC_CHANNEL, map(self->_volume, 0, 100, 0, BUZZER_MAX_DUTY));
+    self->_currentFrequency = frequency;
 }
 
 // ===== WEB INTERFACE HANDLERS =====
@@ -424,18 +435,35 @@ void BuzzerManager::handleWebToggle() {
 }
 
 String BuzzerManager::getStatusJSON() {
-    String json = "{";
-    json += "\"enabled\":" + String(_enabled ? "true" : "false") + ",";
-    json += "\"volume\":" + String(_volume) + ",";
-    json += "\"muted\":" + String(_muted ? "true" : "false") + ",";
-    json += "\"playing\":" + String(_isPlaying ? "true" : "false");
-    if (_isPlaying) {
-        json += ",\"frequency\":" + String(_currentFrequency);
-    }
-    json += "}";
+    StreamString json;
+    printStatusJSON(json);
     return json;
 }
 
+void BuzzerManager::printStatusJSON(Print& out) {
+    out.print("{\"enabled\":");
+    out.print(_enabled ? "true" : "false");
+    out.print(",\"volume\":");
+    out.print(_volume);
+    out.print(",\"muted\":");
+    out.print(_muted ? "true" : "false");
+    out.print(",\"playing\":");
+    out.print(_sequencer.isBusy() ? "true" : "false");
+    out.print(",\"queued\":");
+    out.print(_sequencer.getQueueDepth());
+    out.print(",\"played\":");
+    out.print(_sequencer.getPlayedCount());
+    out.print(",\"merged\":");
+    out.print(_sequencer.getMergedCount());
+    out.print(",\"dropped\":");
+    out.print(_sequencer.getDroppedCount());
+    if (_currentFrequency > 0) {
+        out.print(",\"frequency\":");
+        out.print(_currentFrequency);
+    }
+    out.print('}');
+}
+
 // ===== CONFIGURATION =====
 void BuzzerManager::saveConfig() {
     // Configuration is saved automatically in setter methods
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "SystemConfig.h"
+#include "PatternSequencer.h"
 
 class BuzzerManager {
 private:
@@ -60,6 +61,7 @@ public:
     bool isPlayingTone() const;
     
     // ===== ALERT TONES =====
+    void playAlert(bool isLong, bool isSevere);
     void playLongAlert(bool isSevere = false);
     void playShortAlert(bool isSevere = false);
     void playPortfolioAlert();
@@ -81,6 +83,10 @@ public:
     void playMelody(const int* notes, const int* durations, int length);
     
     // ===== CUSTOM SEQUENCES =====
+    // Non-blocking: queues the pattern and returns immediately
+    bool playPattern(uint8_t patternId, const PatternStep* steps,
+                     uint8_t stepCount, uint8_t repeats = 1);
+    bool isBusy() const;
     void playSequence(const ToneSequence* sequence, int length);
     void stopSequence();
     void updateSequence(); // Call in loop to play sequences
@@ -109,6 +115,10 @@ public:
     int getTotalTonesPlayed() const;
     void resetStatistics();
     
+    // ===== WEB INTERFACE =====
+    String getStatusJSON();
+    void printStatusJSON(Print& out);      // Streams without building a String
+    
     // ===== DEBUG FUNCTIONS =====
     void testAllTones();
     void testFrequencyRange(int start = 100, int end = 5000, int step = 100);
@@ -164,6 +174,11 @@ private:
     
     // Debug
     void logTonePlay(int freq, int duration, int volume);
+    void waitForIdle(uint32_t extraDelayMs = 0);
+    
+    // Timer-driven playback
+    PatternSequencer _sequencer;
+    static void sequencerOutput(uint16_t frequency, void* context);
 };
 
 // Inline functions
@@ -205,14 +220,14 @@ inline int BuzzerManager::getTotalTonesPlayed() const {
 }
 
 // Tone sequences (examples)
-const BuzzerManager::ToneSequence BuzzerManager::testSequence[] = {
+inline const BuzzerManager::ToneSequence BuzzerManager::testSequence[] = {
     {523, 200, 100},  // C5
     {659, 200, 100},  // E5
     {784, 200, 100},  // G5
     {1047, 400, 200}  // C6
 };
 
-const BuzzerManager::ToneSequence BuzzerManager::startupSequence[] = {
+inline const BuzzerManager::ToneSequence BuzzerManager::startupSequence[] = {
     {600, 100, 50},
     {800, 150, 50},
     {1000, 200, 100},
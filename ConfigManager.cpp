@@ -0,0 +1,598 @@
+#include "ConfigManager.h"
+#include <ArduinoJson.h>
+
+// ===== CONSTANTS =====
+#define CONFIG_NAMESPACE "config"
+#define CONFIG_TASK_STACK_SIZE 4096
+#define CONFIG_TASK_PRIORITY 1
+
+// ===== STATIC VARIABLES =====
+ConfigManager* ConfigManager::_instance = nullptr;
+
+// ===== CONSTRUCTOR =====
+ConfigManager::ConfigManager()
+    : _entryCount(0),
+      _nvs(0),
+      _commitTask(nullptr),
+      _firstDirtyTime(0),
+      _lastChangeTime(0),
+      _initialized(false) {
+    memset(&_stats, 0, sizeof(_stats));
+    _cacheLock = xSemaphoreCreateMutex();
+    _storageLock = xSemaphoreCreateMutex();
+}
+
+// ===== INITIALIZATION =====
+bool ConfigManager::begin() {
+    if (_initialized) return true;
+
+    if (nvs_open(CONFIG_NAMESPACE, NVS_READWRITE, &_nvs) != ESP_OK) {
+        Serial.println("Failed to open settings storage");
+        return false;
+    }
+    _initialized = true;
+
+    // Commits run at low priority so flash writes never stall the UI tasks
+    if (xTaskCreate(commitTaskEntry, "configCommit", CONFIG_TASK_STACK_SIZE, this,
+                    CONFIG_TASK_PRIORITY, &_commitTask) != pdPASS) {
+        Serial.println("Settings commit task unavailable, writing through");
+        _commitTask = nullptr;
+    }
+
+    return true;
+}
+
+// ===== CACHE =====
+ConfigManager::Entry* ConfigManager::findEntry(const char* key) {
+    for (int i = 0; i < _entryCount; i++) {
+        if (strncmp(_entries[i].key, key, CONFIG_KEY_LENGTH - 1) == 0) {
+            return &_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+// Cached entry for a key, read from NVS on first use. Absent keys are
+// cached too (TYPE_NONE) so defaults do not cost a flash read each time.
+// Caller holds _cacheLock.
+ConfigManager::Entry* ConfigManager::loadEntry(const char* key, ValueType type) {
+    Entry* entry = findEntry(key);
+    if (entry) return entry;
+
+    if (_entryCount < CONFIG_MAX_ENTRIES) {
+        entry = &_entries[_entryCount++];
+    } else {
+        // Recycle a clean entry; dirty ones still have to be written
+        for (int i = CONFIG_MAX_ENTRIES - 1; i >= 0 && !entry; i--) {
+            if (!_entries[i].dirty) entry = &_entries[i];
+        }
+        if (!entry) return nullptr;
+    }
+
+    *entry = Entry(key, type);
+    xSemaphoreTake(_storageLock, portMAX_DELAY);
+    readStored(*entry);
+    xSemaphoreGive(_storageLock);
+    return entry;
+}
+
+bool ConfigManager::fetch(const char* key, ValueType type, Entry& result) {
+    if (!_initialized && !begin()) return false;
+
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    Entry* entry = loadEntry(key, type);
+    if (entry) {
+        result = *entry;
+    } else {
+        result = Entry(key, type);
+        xSemaphoreTake(_storageLock, portMAX_DELAY);
+        readStored(result);
+        xSemaphoreGive(_storageLock);
+    }
+    xSemaphoreGive(_cacheLock);
+
+    return result.type == type;
+}
+
+void ConfigManager::store(const Entry& update) {
+    if (!_initialized && !begin()) return;
+
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    Entry* entry = loadEntry(update.key, update.type);
+
+    if (!entry || !_commitTask) {
+        // No room to defer it; write through
+        if (entry) {
+            entry->type = update.type;
+            entry->value = update.value;
+            entry->text = update.text;
+        }
+        xSemaphoreTake(_storageLock, portMAX_DELAY);
+        if (writeStored(update) && nvs_commit(_nvs) == ESP_OK) {
+            _stats.keysWritten++;
+            _stats.commits++;
+        }
+        xSemaphoreGive(_storageLock);
+    } else if (sameValue(*entry, update)) {
+        _stats.unchanged++;
+    } else {
+        entry->type = update.type;
+        entry->value = update.value;
+        entry->text = update.text;
+        markDirty(*entry);
+    }
+
+    xSemaphoreGive(_cacheLock);
+}
+
+void ConfigManager::markDirty(Entry& entry) {
+    unsigned long now = millis();
+
+    if (_stats.pendingKeys > 0) {
+        _stats.coalesced++;
+    } else {
+        _firstDirtyTime = now;
+    }
+    if (!entry.dirty) {
+        entry.dirty = true;
+        _stats.pendingKeys++;
+    }
+    _lastChangeTime = now;
+
+    // Restarts the quiet period
+    xTaskNotifyGive(_commitTask);
+}
+
+bool ConfigManager::sameValue(const Entry& a, const Entry& b) {
+    if (a.type != b.type) return false;
+
+    switch (a.type) {
+        case TYPE_STRING: return a.text == b.text;
+        case TYPE_INT: return a.value.i == b.value.i;
+        case TYPE_UINT:
+        case TYPE_UCHAR: return a.value.u == b.value.u;
+        case TYPE_FLOAT: return a.value.f == b.value.f;
+        case TYPE_BOOL: return a.value.b == b.value.b;
+        default: return true;
+    }
+}
+
+// ===== STORAGE =====
+// Same encoding as Preferences, so keys written by either are interchangeable
+void ConfigManager::readStored(Entry& entry) {
+    esp_err_t err = ESP_FAIL;
+
+    switch (entry.type) {
+        case TYPE_STRING: {
+            size_t length = 0;
+            err = nvs_get_str(_nvs, entry.key, nullptr, &length);
+            if (err != ESP_OK) break;
+            char* buffer = (char*)malloc(length);
+            if (!buffer) {
+                err = ESP_ERR_NO_MEM;
+                break;
+            }
+            err = nvs_get_str(_nvs, entry.key, buffer, &length);
+            if (err == ESP_OK) entry.text = buffer;
+            free(buffer);
+            break;
+        }
+        case TYPE_INT:
+            err = nvs_get_i32(_nvs, entry.key, &entry.value.i);
+            break;
+        case TYPE_UINT:
+            err = nvs_get_u32(_nvs, entry.key, &entry.value.u);
+            break;
+        case TYPE_UCHAR:
+        case TYPE_BOOL: {
+            uint8_t value = 0;
+            err = nvs_get_u8(_nvs, entry.key, &value);
+            if (entry.type == TYPE_BOOL) {
+                entry.value.b = value != 0;
+            } else {
+                entry.value.u = value;
+            }
+            break;
+        }
+        case TYPE_FLOAT: {
+            size_t length = sizeof(entry.value.f);
+            err = nvs_get_blob(_nvs, entry.key, &entry.value.f, &length);
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (err != ESP_OK) {
+        entry.type = TYPE_NONE;
+        entry.value.u = 0;
+        entry.text = "";
+    }
+}
+
+bool ConfigManager::writeStored(const Entry& entry) {
+    esp_err_t err = ESP_FAIL;
+
+    switch (entry.type) {
+        case TYPE_STRING: err = nvs_set_str(_nvs, entry.key, entry.text.c_str()); break;
+        case TYPE_INT: err = nvs_set_i32(_nvs, entry.key, entry.value.i); break;
+        case TYPE_UINT: err = nvs_set_u32(_nvs, entry.key, entry.value.u); break;
+        case TYPE_UCHAR: err = nvs_set_u8(_nvs, entry.key, (uint8_t)entry.value.u); break;
+        case TYPE_BOOL: err = nvs_set_u8(_nvs, entry.key, entry.value.b ? 1 : 0); break;
+        case TYPE_FLOAT:
+            err = nvs_set_blob(_nvs, entry.key, &entry.value.f, sizeof(entry.value.f));
+            break;
+        default:
+            break;
+    }
+
+    if (err != ESP_OK) {
+        Serial.print("Failed to store setting: ");
+        Serial.println(entry.key);
+        return false;
+    }
+    return true;
+}
+
+// ===== BACKGROUND COMMIT =====
+// Milliseconds until the pending keys are due; UINT32_MAX when nothing is pending
+uint32_t ConfigManager::commitDelay() {
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+
+    uint32_t wait = UINT32_MAX;
+    if (_stats.pendingKeys > 0) {
+        unsigned long now = millis();
+        unsigned long quiet = now - _lastChangeTime;
+        unsigned long pending = now - _firstDirtyTime;
+
+        if (quiet >= CONFIG_COMMIT_DELAY || pending >= CONFIG_COMMIT_MAX_DELAY) {
+            wait = 0;
+        } else {
+            wait = min(CONFIG_COMMIT_DELAY - quiet, CONFIG_COMMIT_MAX_DELAY - pending);
+        }
+    }
+
+    xSemaphoreGive(_cacheLock);
+    return wait;
+}
+
+void ConfigManager::commitTaskEntry(void* param) {
+    ConfigManager* config = static_cast<ConfigManager*>(param);
+
+    while (true) {
+        uint32_t wait = config->commitDelay();
+        if (wait > 0) {
+            // Woken early by every change, which restarts the quiet period
+            ulTaskNotifyTake(pdTRUE, wait == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(wait));
+            continue;
+        }
+        config->flush();
+    }
+}
+
+// ===== PERSISTENCE =====
+void ConfigManager::save() {
+    // Setters schedule the commit themselves; only write-through mode is left
+    if (_initialized && !_commitTask) flush();
+}
+
+void ConfigManager::flush() {
+    if (!_initialized) return;
+
+    unsigned long start = micros();
+    int written = 0;
+    Entry pending;
+
+    // Entries are taken one at a time so setters are never blocked on flash
+    for (int i = 0; i < CONFIG_MAX_ENTRIES; i++) {
+        xSemaphoreTake(_cacheLock, portMAX_DELAY);
+        bool dirty = i < _entryCount && _entries[i].dirty;
+        if (dirty) {
+            pending = _entries[i];
+            _entries[i].dirty = false;
+            _stats.pendingKeys--;
+        }
+        xSemaphoreGive(_cacheLock);
+
+        if (!dirty) continue;
+
+        xSemaphoreTake(_storageLock, portMAX_DELAY);
+        if (writeStored(pending)) written++;
+        xSemaphoreGive(_storageLock);
+    }
+
+    if (written == 0) return;
+
+    // One flash commit for every key of the batch
+    xSemaphoreTake(_storageLock, portMAX_DELAY);
+    esp_err_t err = nvs_commit(_nvs);
+    xSemaphoreGive(_storageLock);
+
+    uint32_t elapsed = micros() - start;
+
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    _stats.commits++;
+    _stats.keysWritten += written;
+    _stats.lastCommitMicros = elapsed;
+    if (elapsed > _stats.maxCommitMicros) _stats.maxCommitMicros = elapsed;
+    xSemaphoreGive(_cacheLock);
+
+    if (err != ESP_OK) {
+        Serial.println("Settings commit failed");
+    }
+}
+
+bool ConfigManager::hasPendingChanges() {
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    bool pending = _stats.pendingKeys > 0;
+    xSemaphoreGive(_cacheLock);
+    return pending;
+}
+
+ConfigStorageStats ConfigManager::getStats() {
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    ConfigStorageStats stats = _stats;
+    xSemaphoreGive(_cacheLock);
+    return stats;
+}
+
+void ConfigManager::printStatusJSON(Print& out) {
+    ConfigStorageStats stats = getStats();
+    StaticJsonDocument<256> doc;
+
+    doc["commits"] = stats.commits;
+    doc["keys_written"] = stats.keysWritten;
+    doc["coalesced"] = stats.coalesced;
+    doc["unchanged"] = stats.unchanged;
+    doc["pending"] = stats.pendingKeys;
+    doc["last_commit_us"] = stats.lastCommitMicros;
+    doc["max_commit_us"] = stats.maxCommitMicros;
+    doc["cached"] = _entryCount;
+
+    serializeJson(doc, out);
+}
+
+// ===== WIFI SETTINGS =====
+String ConfigManager::getWiFiSSID() { return getString("wifi_ssid", ""); }
+void ConfigManager::setWiFiSSID(const String& ssid) { putString("wifi_ssid", ssid); }
+String ConfigManager::getWiFiPassword() { return getString("wifi_pass", ""); }
+void ConfigManager::setWiFiPassword(const String& password) { putString("wifi_pass", password); }
+bool ConfigManager::getWiFiAutoConnect() { return getBool("wifi_auto", true); }
+void ConfigManager::setWiFiAutoConnect(bool autoConnect) { putBool("wifi_auto", autoConnect); }
+bool ConfigManager::getAPEnabled() { return getBool("ap_enabled", true); }
+void ConfigManager::setAPEnabled(bool enabled) { putBool("ap_enabled", enabled); }
+
+// ===== API SETTINGS =====
+String ConfigManager::getAPIServer() { return getString("api_server", ""); }
+void ConfigManager::setAPIServer(const String& server) { putString("api_server", server); }
+String ConfigManager::getAPIUsername() { return getString("api_user", ""); }
+void ConfigManager::setAPIUsername(const String& username) { putString("api_user", username); }
+String ConfigManager::getAPIPassword() { return getString("api_pass", ""); }
+void ConfigManager::setAPIPassword(const String& password) { putString("api_pass", password); }
+size_t ConfigManager::getAPIServer(char* buffer, size_t size) { return getString("api_server", buffer, size); }
+size_t ConfigManager::getAPIUsername(char* buffer, size_t size) { return getString("api_user", buffer, size); }
+size_t ConfigManager::getAPIPassword(char* buffer, size_t size) { return getString("api_pass", buffer, size); }
+String ConfigManager::getEntryPortfolio() { return getString("port_entry", "Arduino"); }
+void ConfigManager::setEntryPortfolio(const String& portfolio) { putString("port_entry", portfolio); }
+String ConfigManager::getExitPortfolio() { return getString("port_exit", "MyExit"); }
+void ConfigManager::setExitPortfolio(const String& portfolio) { putString("port_exit", portfolio); }
+
+// ===== PORTFOLIO TABLE =====
+// Rows past entry and exit keep their name and alert style in port<N>_name
+// and port<N>_exit; every row has port<N>_int and port<N>_prio
+static void portfolioKey(char* key, uint8_t index, const char* field) {
+    snprintf(key, CONFIG_KEY_LENGTH, "port%u_%s", index, field);
+}
+
+bool ConfigManager::getPortfolioConfig(uint8_t index, PortfolioConfig& config) {
+    memset(&config, 0, sizeof(config));
+    if (index >= PORTFOLIO_MAX) return false;
+
+    char key[CONFIG_KEY_LENGTH];
+    if (index == PORTFOLIO_ENTRY) {
+        getString("port_entry", config.name, sizeof(config.name), "Arduino");
+    } else if (index == PORTFOLIO_EXIT) {
+        getString("port_exit", config.name, sizeof(config.name), "MyExit");
+        config.exitAlerts = true;
+    } else {
+        portfolioKey(key, index, "name");
+        getString(key, config.name, sizeof(config.name));
+        portfolioKey(key, index, "exit");
+        config.exitAlerts = getBool(key, false);
+    }
+
+    portfolioKey(key, index, "int");
+    config.refreshInterval = getUInt(key, 0);
+    portfolioKey(key, index, "prio");
+    config.priority = getUChar(key, 0);
+    return config.name[0] != '\0';
+}
+
+void ConfigManager::setPortfolioConfig(uint8_t index, const PortfolioConfig& config) {
+    if (index >= PORTFOLIO_MAX) return;
+
+    char key[CONFIG_KEY_LENGTH];
+    if (index == PORTFOLIO_ENTRY) {
+        putString("port_entry", config.name);
+    } else if (index == PORTFOLIO_EXIT) {
+        putString("port_exit", config.name);
+    } else {
+        portfolioKey(key, index, "name");
+        putString(key, config.name);
+        portfolioKey(key, index, "exit");
+        putBool(key, config.exitAlerts);
+    }
+
+    portfolioKey(key, index, "int");
+    putUInt(key, config.refreshInterval);
+    portfolioKey(key, index, "prio");
+    putUChar(key, config.priority);
+}
+
+// ===== ALERT SETTINGS =====
+float ConfigManager::getAlertThreshold() { return getFloat("alert_thresh", -5.0); }
+void ConfigManager::setAlertThreshold(float threshold) { putFloat("alert_thresh", threshold); }
+float ConfigManager::getSevereThreshold() { return getFloat("sev_thresh", -10.0); }
+void ConfigManager::setSevereThreshold(float threshold) { putFloat("sev_thresh", threshold); }
+float ConfigManager::getPortfolioThreshold() { return getFloat("port_thresh", -7.0); }
+void ConfigManager::setPortfolioThreshold(float threshold) { putFloat("port_thresh", threshold); }
+uint8_t ConfigManager::getBuzzerVolume() { return getUChar("buzzer_vol", 50); }
+void ConfigManager::setBuzzerVolume(uint8_t volume) { putUChar("buzzer_vol", volume); }
+bool ConfigManager::getBuzzerEnabled() { return getBool("buzzer_en", true); }
+void ConfigManager::setBuzzerEnabled(bool enabled) { putBool("buzzer_en", enabled); }
+
+// ===== LED SETTINGS =====
+bool ConfigManager::getLEDEnabled() { return getBool("led_en", true); }
+void ConfigManager::setLEDEnabled(bool enabled) { putBool("led_en", enabled); }
+uint8_t ConfigManager::getLEDBrightness() { return getUChar("led_bright", 100); }
+void ConfigManager::setLEDBrightness(uint8_t brightness) { putUChar("led_bright", brightness); }
+
+// ===== GENERAL GETTERS/SETTERS =====
+String ConfigManager::getString(const char* key, const String& defaultValue) {
+    Entry entry;
+    return fetch(key, TYPE_STRING, entry) ? entry.text : defaultValue;
+}
+
+// Copies out of the cached entry, so a read costs no String allocation
+size_t ConfigManager::getString(const char* key, char* buffer, size_t size, const char* defaultValue) {
+    if (!_initialized && !begin()) return strlcpy(buffer, defaultValue, size);
+
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    Entry* entry = loadEntry(key, TYPE_STRING);
+    size_t length;
+    if (entry && entry->type == TYPE_STRING) {
+        length = strlcpy(buffer, entry->text.c_str(), size);
+    } else if (entry) {
+        length = strlcpy(buffer, defaultValue, size);
+    } else {
+        xSemaphoreGive(_cacheLock);
+        String value = getString(key, String(defaultValue));
+        return strlcpy(buffer, value.c_str(), size);
+    }
+    xSemaphoreGive(_cacheLock);
+
+    return length;
+}
+
+void ConfigManager::putString(const char* key, const String& value) {
+    Entry update(key, TYPE_STRING);
+    update.text = value;
+    store(update);
+}
+
+int ConfigManager::getInt(const char* key, int defaultValue) {
+    Entry entry;
+    return fetch(key, TYPE_INT, entry) ? entry.value.i : defaultValue;
+}
+
+void ConfigManager::putInt(const char* key, int value) {
+    Entry update(key, TYPE_INT);
+    update.value.i = value;
+    store(update);
+}
+
+float ConfigManager::getFloat(const char* key, float defaultValue) {
+    Entry entry;
+    return fetch(key, TYPE_FLOAT, entry) ? entry.value.f : defaultValue;
+}
+
+void ConfigManager::putFloat(const char* key, float value) {
+    Entry update(key, TYPE_FLOAT);
+    update.value.f = value;
+    store(update);
+}
+
+bool ConfigManager::getBool(const char* key, bool defaultValue) {
+    Entry entry;
+    return fetch(key, TYPE_BOOL, entry) ? entry.value.b : defaultValue;
+}
+
+void ConfigManager::putBool(const char* key, bool value) {
+    Entry update(key, TYPE_BOOL);
+    update.value.b = value;
+    store(update);
+}
+
+uint8_t ConfigManager::getUChar(const char* key, uint8_t defaultValue) {
+    Entry entry;
+    return fetch(key, TYPE_UCHAR, entry) ? (uint8_t)entry.value.u : defaultValue;
+}
+
+void ConfigManager::putUChar(const char* key, uint8_t value) {
+    Entry update(key, TYPE_UCHAR);
+    update.value.u = value;
+    store(update);
+}
+
+uint32_t ConfigManager::getUInt(const char* key, uint32_t defaultValue) {
+    Entry entry;
+    return fetch(key, TYPE_UINT, entry) ? entry.value.u : defaultValue;
+}
+
+void ConfigManager::putUInt(const char* key, uint32_t value) {
+    Entry update(key, TYPE_UINT);
+    update.value.u = value;
+    store(update);
+}
+
+// ===== UTILITY =====
+void ConfigManager::clear() {
+    if (!_initialized && !begin()) return;
+
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    for (int i = 0; i < _entryCount; i++) {
+        _entries[i] = Entry();
+    }
+    _entryCount = 0;
+    _stats.pendingKeys = 0;
+
+    xSemaphoreTake(_storageLock, portMAX_DELAY);
+    nvs_erase_all(_nvs);
+    nvs_commit(_nvs);
+    xSemaphoreGive(_storageLock);
+    xSemaphoreGive(_cacheLock);
+}
+
+void ConfigManager::factoryReset() {
+    clear();
+    Serial.println("Settings storage erased");
+}
+
+String ConfigManager::getAllSettingsJSON() {
+    DynamicJsonDocument doc(2048);
+
+    xSemaphoreTake(_cacheLock, portMAX_DELAY);
+    for (int i = 0; i < _entryCount; i++) {
+        const Entry& entry = _entries[i];
+
+        // Credentials never leave the device
+        if (strstr(entry.key, "pass")) {
+            if (entry.type != TYPE_NONE) doc[entry.key] = "********";
+            continue;
+        }
+
+        switch (entry.type) {
+            case TYPE_STRING: doc[entry.key] = entry.text; break;
+            case TYPE_INT: doc[entry.key] = entry.value.i; break;
+            case TYPE_UINT:
+            case TYPE_UCHAR: doc[entry.key] = entry.value.u; break;
+            case TYPE_FLOAT: doc[entry.key] = entry.value.f; break;
+            case TYPE_BOOL: doc[entry.key] = entry.value.b; break;
+            default: break;
+        }
+    }
+
+    // Keys are referenced, not copied, so serialize before releasing them
+    String json;
+    serializeJson(doc, json);
+    xSemaphoreGive(_cacheLock);
+    return json;
+}
+
+// ===== STATIC ACCESS =====
+ConfigManager& ConfigManager::getInstance() {
+    if (!_instance) {
+        _instance = new ConfigManager();
+    }
+    return *_instance;
+}
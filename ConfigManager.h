@@ -2,20 +2,107 @@
 #define CONFIGMANAGER_H
 
 #include <Arduino.h>
-#include <Preferences.h>
+#include <nvs.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "PortfolioTable.h"
 
+#define CONFIG_MAX_ENTRIES 96           // Room for the portfolio table keys
+#define CONFIG_KEY_LENGTH 16            // NVS keys are at most 15 characters
+#define CONFIG_COMMIT_DELAY 1500        // Quiet time before dirty keys are written
+#define CONFIG_COMMIT_MAX_DELAY 10000   // Upper bound while changes keep arriving
+
+// Persistence counters; latencies in microseconds
+struct ConfigStorageStats {
+    uint32_t commits;
+    uint32_t keysWritten;
+    uint32_t coalesced;         // Changes absorbed into an already pending commit
+    uint32_t unchanged;         // Writes skipped because the value was already stored
+    uint32_t lastCommitMicros;
+    uint32_t maxCommitMicros;
+    uint8_t pendingKeys;
+};
+
+// Every setting goes through this cache. Writes only mark the key dirty;
+// a background task commits all dirty keys to NVS once the changes have
+// settled, so a burst of edits costs a single flash commit.
 class ConfigManager {
 private:
-    Preferences _prefs;
+    enum ValueType : uint8_t {
+        TYPE_NONE,
+        TYPE_STRING,
+        TYPE_INT,
+        TYPE_UINT,
+        TYPE_UCHAR,
+        TYPE_FLOAT,
+        TYPE_BOOL
+    };
+
+    struct Entry {
+        char key[CONFIG_KEY_LENGTH];
+        ValueType type;             // TYPE_NONE = not stored
+        bool dirty;
+        union {
+            int32_t i;
+            uint32_t u;
+            float f;
+            bool b;
+        } value;
+        String text;
+
+        Entry() : type(TYPE_NONE), dirty(false) {
+            key[0] = '\0';
+            value.u = 0;
+        }
+        Entry(const char* name, ValueType valueType) : type(valueType), dirty(false) {
+            strlcpy(key, name, sizeof(key));
+            value.u = 0;
+        }
+    };
+
     static ConfigManager* _instance;
-    
-    ConfigManager() {}
-    
+
+    Entry _entries[CONFIG_MAX_ENTRIES];
+    int _entryCount;
+    nvs_handle_t _nvs;
+    SemaphoreHandle_t _cacheLock;       // Entries, schedule and statistics
+    SemaphoreHandle_t _storageLock;     // NVS handle
+    TaskHandle_t _commitTask;
+    unsigned long _firstDirtyTime;
+    unsigned long _lastChangeTime;
+    bool _initialized;
+    ConfigStorageStats _stats;
+
+    ConfigManager();
+
+    // Cache
+    Entry* findEntry(const char* key);
+    Entry* loadEntry(const char* key, ValueType type);
+    bool fetch(const char* key, ValueType type, Entry& result);
+    void store(const Entry& update);
+    void markDirty(Entry& entry);
+    static bool sameValue(const Entry& a, const Entry& b);
+
+    // Storage; callers hold _storageLock
+    void readStored(Entry& entry);
+    bool writeStored(const Entry& entry);
+
+    // Background commit
+    uint32_t commitDelay();
+    static void commitTaskEntry(void* param);
+
 public:
     static ConfigManager& getInstance();
-    
-    void begin();
-    
+
+    bool begin();
+
+    // Persistence
+    void save();                // Makes sure a commit is scheduled
+    void flush();               // Commits now; before restart or reset
+    bool hasPendingChanges();
+    ConfigStorageStats getStats();
+    void printStatusJSON(Print& out);
+
     // WiFi settings
     String getWiFiSSID();
     void setWiFiSSID(const String& ssid);
@@ -25,7 +112,7 @@ public:
     void setWiFiAutoConnect(bool autoConnect);
     bool getAPEnabled();
     void setAPEnabled(bool enabled);
-    
+
     // API settings
     String getAPIServer();
     void setAPIServer(const String& server);
@@ -33,11 +120,19 @@ public:
     void setAPIUsername(const String& username);
     String getAPIPassword();
     void setAPIPassword(const String& password);
+    size_t getAPIServer(char* buffer, size_t size);
+    size_t getAPIUsername(char* buffer, size_t size);
+    size_t getAPIPassword(char* buffer, size_t size);
     String getEntryPortfolio();
     void setEntryPortfolio(const String& portfolio);
     String getExitPortfolio();
     void setExitPortfolio(const String& portfolio);
-    
+
+    // Portfolio table; rows PORTFOLIO_ENTRY and PORTFOLIO_EXIT are the two
+    // portfolios above. False when the row has no name.
+    bool getPortfolioConfig(uint8_t index, PortfolioConfig& config);
+    void setPortfolioConfig(uint8_t index, const PortfolioConfig& config);
+
     // Alert settings
     float getAlertThreshold();
     void setAlertThreshold(float threshold);
@@ -49,9 +144,16 @@ public:
     void setBuzzerVolume(uint8_t volume);
     bool getBuzzerEnabled();
     void setBuzzerEnabled(bool enabled);
-    
+
+    // LED settings
+    bool getLEDEnabled();
+    void setLEDEnabled(bool enabled);
+    uint8_t getLEDBrightness();
+    void setLEDBrightness(uint8_t brightness);
+
     // General getters/setters
     String getString(const char* key, const String& defaultValue = "");
+    size_t getString(const char* key, char* buffer, size_t size, const char* defaultValue = "");
     void putString(const char* key, const String& value);
     int getInt(const char* key, int defaultValue = 0);
     void putInt(const char* key, int value);
@@ -63,11 +165,15 @@ public:
     void putUChar(const char* key, uint8_t value);
     uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
     void putUInt(const char* key, uint32_t value);
-    
+
+    void setFloat(const char* key, float value) { putFloat(key, value); }
+    void setBool(const char* key, bool value) { putBool(key, value); }
+    void setUInt(const char* key, uint32_t value) { putUInt(key, value); }
+
     // Utility
     void clear();
     void factoryReset();
     String getAllSettingsJSON();
 };
 
-#endif
\ No newline at end of file
+#endif
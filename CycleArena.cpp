@@ -0,0 +1,97 @@
+#include "CycleArena.h"
+#include <esp_heap_caps.h>
+
+// ===== STATIC VARIABLES =====
+CycleArena CycleArena::_arenas[ARENA_COUNT];
+
+static uint32_t heapCaps() {
+    return psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+}
+
+// ===== CONSTRUCTOR =====
+CycleArena::CycleArena()
+    : _base(nullptr),
+      _capacity(0),
+      _used(0),
+      _lastOffset(0) {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+// ===== INITIALIZATION =====
+bool CycleArena::begin(size_t capacity) {
+    if (_base) return true;
+
+    _base = (uint8_t*)heap_caps_malloc(capacity, heapCaps());
+    if (!_base) {
+        Serial.println("Failed to allocate cycle arena, using the heap");
+        return false;
+    }
+
+    _capacity = capacity;
+    _stats.capacity = capacity;
+    reset();
+    return true;
+}
+
+void CycleArena::reset() {
+    _used = 0;
+    _lastOffset = 0;
+    _stats.used = 0;
+    _stats.resets++;
+}
+
+// ===== ALLOCATION =====
+void* CycleArena::allocate(size_t size) {
+    size_t offset = (_used + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    if (!_base || offset + size > _capacity) {
+        _stats.overflows++;
+        return heap_caps_malloc(size, heapCaps());
+    }
+
+    _lastOffset = offset;
+    _used = offset + size;
+    _stats.used = _used;
+    if (_used > _stats.peak) _stats.peak = _used;
+    return _base + offset;
+}
+
+void* CycleArena::reallocate(void* ptr, size_t size) {
+    if (!ptr) return allocate(size);
+    if (!owns(ptr)) return heap_caps_realloc(ptr, size, heapCaps());
+
+    // The newest block grows or shrinks in place, which covers shrinkToFit()
+    size_t offset = (uint8_t*)ptr - _base;
+    if (offset == _lastOffset && offset + size <= _capacity) {
+        _used = offset + size;
+        _stats.used = _used;
+        if (_used > _stats.peak) _stats.peak = _used;
+        return ptr;
+    }
+
+    size_t available = _used - offset;
+    void* moved = allocate(size);
+    if (moved) {
+        memcpy(moved, ptr, min(size, available));
+    }
+    return moved;
+}
+
+void CycleArena::release(void* ptr) {
+    // Arena blocks are returned by reset()
+    if (ptr && !owns(ptr)) {
+        heap_caps_free(ptr);
+    }
+}
+
+bool CycleArena::owns(const void* ptr) const {
+    return _base && ptr >= _base && ptr < _base + _capacity;
+}
+
+// ===== GETTERS =====
+CycleArenaStats CycleArena::getStats() const { return _stats; }
+
+// ===== STATIC ACCESS =====
+CycleArena& CycleArena::get(CycleArenaId id) {
+    return _arenas[id < ARENA_COUNT ? id : ARENA_FETCH];
+}
@@ -0,0 +1,72 @@
+#ifndef CYCLE_ARENA_H
+#define CYCLE_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#define ARENA_FETCH_SIZE 32768          // Fetch cycle: documents of the non-streamed parse
+#define ARENA_WEB_SIZE 16384            // One web request: body documents and JSON export
+#define ARENA_ALIGNMENT 8
+
+enum CycleArenaId : uint8_t {
+    ARENA_FETCH,                        // Owned by the fetch task, reset when a cycle ends
+    ARENA_WEB,                          // Owned by the web task, reset after each request
+    ARENA_COUNT
+};
+
+struct CycleArenaStats {
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t peak;                      // Highest use within one cycle since boot
+    uint32_t resets;
+    uint32_t overflows;                 // Allocations that fell back to the heap
+};
+
+// Bump allocator for buffers that only live for one cycle. Allocation moves
+// a pointer forward and freeing is a no-op; reset() hands the whole block
+// back at once, so per-cycle temporaries never fragment the heap. The block
+// is taken once at boot, from PSRAM when present.
+//
+// Each arena belongs to one task and is not locked. Nothing allocated from
+// it may outlive the reset at the end of that task's cycle. When the arena
+// is full, allocations are served from the heap and freed normally.
+class CycleArena {
+public:
+    static CycleArena& get(CycleArenaId id);
+
+    bool begin(size_t capacity);
+    void reset();
+
+    void* allocate(size_t size);
+    void* reallocate(void* ptr, size_t size);
+    void release(void* ptr);
+    bool owns(const void* ptr) const;
+
+    CycleArenaStats getStats() const;
+
+private:
+    CycleArena();
+
+    static CycleArena _arenas[ARENA_COUNT];
+
+    uint8_t* _base;
+    size_t _capacity;
+    size_t _used;
+    size_t _lastOffset;                 // Start of the newest block, grown in place
+    CycleArenaStats _stats;
+};
+
+// ArduinoJson allocator over a cycle arena
+struct ArenaAllocator {
+    CycleArena* arena;
+
+    explicit ArenaAllocator(CycleArenaId id) : arena(&CycleArena::get(id)) {}
+
+    void* allocate(size_t size) { return arena->allocate(size); }
+    void deallocate(void* ptr) { arena->release(ptr); }
+    void* reallocate(void* ptr, size_t size) { return arena->reallocate(ptr, size); }
+};
+
+typedef BasicJsonDocument<ArenaAllocator> ArenaJsonDocument;
+
+#endif
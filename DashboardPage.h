@@ -0,0 +1,146 @@
+#ifndef DASHBOARD_PAGE_H
+#define DASHBOARD_PAGE_H
+
+#include <Arduino.h>
+
+// Built-in dashboard; WebInterface sends it straight from flash (send_P)
+// when the filesystem has no dashboard.html
+static const char DASHBOARD_HTML[] PROGMEM = R"rawliteral(
+<!DOCTYPE html>
+<html lang="en">
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0">
+    <title>Portfolio Monitor Dashboard</title>
+    <link rel="stylesheet" href="/styles.css">
+    <script src="/script.js"></script>
+</head>
+<body>
+    <div class="container">
+        <header>
+            <h1>Portfolio Monitor Dashboard</h1>
+            <div class="status-bar">
+                <span id="wifi-status">Connecting...</span>
+                <span id="battery-status">100%</span>
+                <span id="time">00:00:00</span>
+            </div>
+        </header>
+        
+        <main>
+            <div class="dashboard-grid">
+                <div class="card">
+                    <h2>Entry Mode</h2>
+                    <div class="stats" id="entry-stats">
+                        Loading...
+                    </div>
+                </div>
+                
+                <div class="card">
+                    <h2>Exit Mode</h2>
+                    <div class="stats" id="exit-stats">
+                        Loading...
+                    </div>
+                </div>
+                
+                <div class="card">
+                    <h2>Alerts</h2>
+                    <div class="alerts" id="alerts-list">
+                        No active alerts
+                    </div>
+                </div>
+                
+                <div class="card">
+                    <h2>Quick Actions</h2>
+                    <div class="actions">
+                        <button onclick="refreshData()">Refresh Data</button>
+                        <button onclick="testAlerts()">Test Alerts</button>
+                        <button onclick="openSettings()">Settings</button>
+                    </div>
+                </div>
+            </div>
+        </main>
+        
+        <footer>
+            <p>Portfolio Monitor v4.5.3 | ESP32-WROVER-E</p>
+        </footer>
+    </div>
+    
+    <script>
+        // Live updates arrive over the push channel; polling is only the fallback
+        function renderStats(id, summary) {
+            document.getElementById(id).innerHTML = 
+                `Positions: ${summary.totalPositions}<br>
+                 P/L: ${summary.totalPnlPercent.toFixed(2)}%<br>
+                 Value: $${summary.totalCurrentValue.toFixed(2)}`;
+        }
+        
+        function renderAlerts(alerts) {
+            if (alerts.length == 0) return;
+            let list = document.getElementById('alerts-list');
+            if (!list.querySelector('ul')) list.innerHTML = '<ul></ul>';
+            alerts.forEach(alert => {
+                let item = document.createElement('li');
+                item.textContent = `${alert.symbol}: ${alert.message}`;
+                list.querySelector('ul').prepend(item);
+            });
+        }
+        
+        function updateDashboard() {
+            fetch('/api/data/summary')
+                .then(response => response.json())
+                .then(data => {
+                    renderStats('entry-stats', data.entry);
+                    renderStats('exit-stats', data.exit);
+                });
+            
+            fetch('/api/alerts/status')
+                .then(response => response.json())
+                .then(data => {
+                    let list = document.getElementById('alerts-list');
+                    list.innerHTML = 'No active alerts';
+                    renderAlerts(data.entry.active.concat(data.exit.active));
+                });
+        }
+        
+        let pollTimer = null;
+        
+        function startPolling() {
+            if (pollTimer) return;
+            updateDashboard();
+            pollTimer = setInterval(updateDashboard, 10000);
+        }
+        
+        function connectPush() {
+            let socket = new WebSocket(`ws://${location.hostname}:81/`);
+            
+            socket.onopen = () => {
+                clearInterval(pollTimer);
+                pollTimer = null;
+                document.getElementById('wifi-status').textContent = 'Live';
+            };
+            
+            socket.onmessage = event => {
+                let msg = JSON.parse(event.data);
+                if (msg.type == 'alerts') {
+                    renderAlerts(msg.alerts);
+                } else if (msg.mode == 'entry' || msg.mode == 'exit') {
+                    // Rows past entry and exit have no card on this page
+                    renderStats(msg.mode + '-stats', msg.summary);
+                }
+            };
+            
+            socket.onclose = () => {
+                document.getElementById('wifi-status').textContent = 'Reconnecting...';
+                startPolling();
+                setTimeout(connectPush, 5000);
+            };
+        }
+        
+        updateDashboard(); // Initial update
+        connectPush();
+    </script>
+</body>
+</html>
+)rawliteral";
+
+#endif
@@ -1,23 +1,208 @@
 #include "DataManager.h"
 #include "ConfigManager.h"
 #include "APIManager.h"
+#include "MetricsRegistry.h"
+#include "CycleArena.h"
 #include <Preferences.h>
+#include <esp_heap_caps.h>
+#include <new>
+#include <climits>
 
 // ===== STATIC VARIABLES =====
 DataManager* DataManager::_instance = nullptr;
 
 // ===== CONSTANTS =====
-#define MAX_POSITIONS_PER_MODE 100
-#define POSITION_HISTORY_SIZE 50
 #define DATA_UPDATE_INTERVAL 15000
+#define DATA_FETCH_BUDGET 8000          // ms after which no further request starts in a cycle
+#define STREAM_POSITION_DOC_SIZE 512    // One filtered position object
+#define STREAM_SUMMARY_DOC_SIZE 128     // The three filtered summary totals
+#define STREAM_READ_TIMEOUT 5000
+#define STREAM_KEY_LENGTH 24
+#define STREAM_NAME_LENGTH PORTFOLIO_NAME_LENGTH    // Portfolio names used as keys
+#define SLOT_NONE 0xFF                  // Empty entry in the symbol ID indexes
+#define SNAPSHOT_WAIT_TIMEOUT 50        // ms to wait for a reader to release a buffer
+#define SNAPSHOT_SAVE_INTERVAL 600000   // ms between NVS writes of a portfolio's totals
+
+static uint8_t portfolioIndex(uint8_t portfolio) {
+    return portfolio < PORTFOLIO_MAX ? portfolio : PORTFOLIO_ENTRY;
+}
+
+static uint32_t heapCaps() {
+    return psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+}
+
+// Capacity for count positions. Ranges grow a granule at a time and only
+// shrink once more than a granule is spare, so a count moving around a
+// boundary does not resize on every parse.
+static int fitCapacity(int count, int current) {
+    int needed = (count + POSITION_POOL_GRANULE - 1) / POSITION_POOL_GRANULE * POSITION_POOL_GRANULE;
+    if (needed <= current && current - needed <= POSITION_POOL_GRANULE) return current;
+    return needed;
+}
+
+// ===== METRICS =====
+static Metric* _parseLatency[PORTFOLIO_MAX];
+static Metric* _mergeLatency[PORTFOLIO_MAX];
+static Metric* _eventLatency[PORTFOLIO_MAX];
+
+static Metric* portfolioLatency(Metric** cache, uint8_t portfolio, const char* tag,
+                                const char* name, const char* help) {
+    Metric*& metric = cache[portfolioIndex(portfolio)];
+    if (!metric) {
+        char labels[METRICS_LABEL_LENGTH];
+        snprintf(labels, sizeof(labels), "mode=\"%s\"", tag);
+        metric = MetricsRegistry::getInstance().histogram(name, help, labels);
+    }
+    return metric;
+}
+
+// ===== POSITION POOL =====
+const size_t PositionPool::PLANE_ELEMENT_SIZE[PositionPool::PLANE_COUNT] = {
+    sizeof(uint16_t),           // symbolId
+    sizeof(float),              // changePercent
+    sizeof(float),              // pnlValue
+    sizeof(float),              // currentPrice
+    sizeof(PositionDetail)
+};
+
+PositionPool::PositionPool()
+    : _size(0),
+      _inPSRAM(false) {
+    memset(_planes, 0, sizeof(_planes));
+    memset(_offset, 0, sizeof(_offset));
+    memset(_capacity, 0, sizeof(_capacity));
+}
+
+bool PositionPool::begin(int size) {
+    if (_planes[0]) return true;
+
+    uint32_t caps = heapCaps();
+    for (int i = 0; i < PLANE_COUNT; i++) {
+        _planes[i] = (uint8_t*)heap_caps_calloc(size, PLANE_ELEMENT_SIZE[i], caps);
+        if (!_planes[i]) {
+            Serial.println("Failed to allocate position pool");
+            for (int j = 0; j < i; j++) {
+                heap_caps_free(_planes[j]);
+                _planes[j] = nullptr;
+            }
+            return false;
+        }
+    }
+
+    _size = size;
+    _inPSRAM = caps == MALLOC_CAP_SPIRAM;
+    return true;
+}
+
+bool PositionPool::reserve(uint8_t owner, int count) {
+    if (owner >= PORTFOLIO_MAX) return false;
+    return resize(owner, fitCapacity(count, _capacity[owner]));
+}
+
+void PositionPool::release(uint8_t owner) {
+    if (owner < PORTFOLIO_MAX) {
+        resize(owner, 0);
+    }
+}
+
+bool PositionPool::resize(uint8_t owner, int capacity) {
+    int delta = capacity - _capacity[owner];
+    if (delta == 0) return true;
+
+    int used = getUsed();
+    if (!_planes[0] || used + delta > _size) return false;
+
+    // In every plane the ranges after this one are a single packed block
+    int tail = _offset[owner] + _capacity[owner];
+    for (int i = 0; i < PLANE_COUNT; i++) {
+        size_t element = PLANE_ELEMENT_SIZE[i];
+        memmove(_planes[i] + (tail + delta) * element, _planes[i] + tail * element,
+                (used - tail) * element);
+        if (delta > 0) {
+            memset(_planes[i] + tail * element, 0, delta * element);
+        }
+    }
+
+    for (int i = owner + 1; i < PORTFOLIO_MAX; i++) {
+        _offset[i] += delta;
+    }
+    _capacity[owner] = capacity;
+    return true;
+}
+
+void* PositionPool::plane(int index, uint8_t owner) const {
+    if (!_planes[index] || owner >= PORTFOLIO_MAX) return nullptr;
+    return _planes[index] + _offset[owner] * PLANE_ELEMENT_SIZE[index];
+}
+
+PositionColumns PositionPool::getColumns(uint8_t owner) const {
+    PositionColumns columns;
+    columns.symbolId = (uint16_t*)plane(PLANE_SYMBOL_ID, owner);
+    columns.changePercent = (float*)plane(PLANE_CHANGE_PERCENT, owner);
+    columns.pnlValue = (float*)plane(PLANE_PNL_VALUE, owner);
+    columns.currentPrice = (float*)plane(PLANE_CURRENT_PRICE, owner);
+    return columns;
+}
+
+PositionDetail* PositionPool::getDetails(uint8_t owner) const {
+    return (PositionDetail*)plane(PLANE_DETAIL, owner);
+}
+
+int PositionPool::getCapacity(uint8_t owner) const {
+    return owner < PORTFOLIO_MAX ? _capacity[owner] : 0;
+}
+
+int PositionPool::getUsed() const {
+    return _offset[PORTFOLIO_MAX - 1] + _capacity[PORTFOLIO_MAX - 1];
+}
+
+int PositionPool::getSize() const { return _size; }
+bool PositionPool::isInPSRAM() const { return _inPSRAM; }
 
 // ===== CONSTRUCTOR/DESTRUCTOR =====
 DataManager::DataManager()
-    : _initialized(false),
-      _entryPositionCount(0),
-      _exitPositionCount(0),
+    : _portfolios(nullptr),
+      _snapshotsSkipped(0),
+      _mergeAlertThreshold(0),
+      _mergeSevereThreshold(0),
+      _parseRemovedCount(0),
+      _initialized(false),
       _lastUpdateTime(0),
-      _updateInterval(DATA_UPDATE_INTERVAL) {
+      _updateInterval(DATA_UPDATE_INTERVAL),
+      _batchSupported(true) {
+    _reloadPending.store(false);
+    memset(_parseChanged, 0, sizeof(_parseChanged));
+    memset(_slotLive, 0, sizeof(_slotLive));
+
+    // A row is a few KB of indexes; the table is kept out of internal RAM
+    void* rows = heap_caps_calloc(PORTFOLIO_MAX, sizeof(Portfolio), heapCaps());
+    if (!rows) {
+        rows = heap_caps_calloc(PORTFOLIO_MAX, sizeof(Portfolio), MALLOC_CAP_8BIT);
+    }
+    if (!rows) {
+        Serial.println("Failed to allocate portfolio table");
+        return;
+    }
+
+    _portfolios = (Portfolio*)rows;
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        Portfolio& state = *new (&_portfolios[i]) Portfolio();
+        if (i == PORTFOLIO_ENTRY) {
+            strlcpy(state.tag, "entry", sizeof(state.tag));
+        } else if (i == PORTFOLIO_EXIT) {
+            strlcpy(state.tag, "exit", sizeof(state.tag));
+        } else {
+            snprintf(state.tag, sizeof(state.tag), "port%u", i);
+        }
+
+        state.snapshots = nullptr;
+        state.publishedIndex.store(0);
+        state.publishedGeneration.store(0);
+        for (int j = 0; j < SNAPSHOT_BUFFER_COUNT; j++) {
+            state.snapshotReaders[j].store(0);
+        }
+        memset(state.slotById, SLOT_NONE, sizeof(state.slotById));
+    }
 }
 
 DataManager::~DataManager() {
@@ -30,6 +215,14 @@ DataManager::~DataManager() {
 bool DataManager::begin() {
     Serial.println("Initializing Data Manager...");
     
+    // Positions of every portfolio share one block
+    if (!_pool.begin(POSITION_POOL_SIZE)) {
+        Serial.println("Position pool unavailable");
+    }
+    
+    // Rows get their history and snapshot buffers once they are configured
+    applyPortfolioConfig();
+    
     // Clear all data
     clearAllData();
     
@@ -49,9 +242,108 @@ void DataManager::update() {
     // Currently data is updated via fetchData() calls
 }
 
+// ===== PORTFOLIO TABLE =====
+DataManager::Portfolio& DataManager::row(uint8_t portfolio) {
+    return _portfolios[portfolioIndex(portfolio)];
+}
+
+const DataManager::Portfolio& DataManager::row(uint8_t portfolio) const {
+    return _portfolios[portfolioIndex(portfolio)];
+}
+
+// The parser only ever writes unpublished buffers, so its own task reads
+// the published one without pinning it
+const PortfolioSnapshot* DataManager::published(uint8_t portfolio) const {
+    const Portfolio& state = row(portfolio);
+    return state.snapshots ? &state.snapshots[state.publishedIndex.load()] : nullptr;
+}
+
+void DataManager::requestPortfolioReload() {
+    _reloadPending.store(true);
+}
+
+// Rows whose name changed or that were removed start over empty, and an
+// unused row holds no part of the pool
+void DataManager::applyPortfolioConfig() {
+    _reloadPending.store(false);
+
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        Portfolio& state = _portfolios[i];
+        PortfolioConfig config;
+        bool configured = ConfigManager::getInstance().getPortfolioConfig(i, config);
+        bool renamed = strcmp(config.name, state.config.name) != 0;
+
+        state.config = config;
+        if (configured && !state.active) {
+            activatePortfolio(i);
+        }
+        state.active = configured;
+
+        if (renamed || !configured) {
+            if (_initialized) clearData(i);
+            state.lastFetch = 0;
+        }
+    }
+}
+
+void DataManager::activatePortfolio(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+
+    // History storage is allocated once and reused for the lifetime of the device
+    char directory[PORTFOLIO_TAG_LENGTH + 1];
+    snprintf(directory, sizeof(directory), "/%s", state.tag);
+    if (!state.history.begin()) {
+        Serial.println("Price history unavailable");
+    }
+    if (!state.log.begin(directory)) {
+        Serial.println("History log unavailable");
+    }
+
+    // Position arrays of the buffers follow the portfolio's size on publish
+    if (!state.snapshots) {
+        void* buffers = heap_caps_calloc(SNAPSHOT_BUFFER_COUNT, sizeof(PortfolioSnapshot), heapCaps());
+        if (buffers) {
+            state.snapshots = (PortfolioSnapshot*)buffers;
+            for (int i = 0; i < SNAPSHOT_BUFFER_COUNT; i++) {
+                new (&state.snapshots[i]) PortfolioSnapshot();
+            }
+        } else {
+            Serial.println("Snapshot buffers unavailable");
+        }
+    }
+
+    Serial.print("Portfolio ");
+    Serial.print(state.tag);
+    Serial.print(": ");
+    Serial.println(state.config.name);
+}
+
+bool DataManager::isPortfolioActive(uint8_t portfolio) const {
+    return portfolio < PORTFOLIO_MAX && _portfolios[portfolio].active;
+}
+
+const PortfolioConfig& DataManager::getPortfolioConfig(uint8_t portfolio) const {
+    return row(portfolio).config;
+}
+
+const char* DataManager::getPortfolioTag(uint8_t portfolio) const {
+    return row(portfolio).tag;
+}
+
+uint8_t DataManager::findPortfolio(const String& tag) const {
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        if (tag == _portfolios[i].tag) return i;
+    }
+    return PORTFOLIO_ENTRY;
+}
+
 // ===== DATA PARSING =====
-bool DataManager::parsePortfolioData(const String& jsonData, bool isExitMode) {
-    DynamicJsonDocument doc(8192);  // JSON_BUFFER_SIZE
+bool DataManager::parsePortfolioData(const String& jsonData, uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    MetricTimer timer(portfolioLatency(_parseLatency, portfolio, state.tag, "portfolio_parse_seconds",
+                                       "Portfolio parse and apply, including a streamed body"));
+    
+    ArenaJsonDocument doc(8192, ArenaAllocator(ARENA_FETCH));  // JSON_BUFFER_SIZE
     DeserializationError error = deserializeJson(doc, jsonData);
     
     if (error) {
@@ -65,147 +357,570 @@ bool DataManager::parsePortfolioData(const String& jsonData, bool isExitMode) {
         return false;
     }
     
-    JsonArray portfolio = doc["portfolio"];
-    int itemCount = portfolio.size();
+    JsonArray positions = doc["portfolio"];
     
-    // Clear existing data for this mode
-    if (isExitMode) {
-        _exitPositionCount = 0;
-        memset(_exitPositions, 0, sizeof(_exitPositions));
-    } else {
-        _entryPositionCount = 0;
-        memset(_entryPositions, 0, sizeof(_entryPositions));
-    }
+    // Rows are merged into the existing slots; positions not listed are closed
+    beginMerge(portfolio, false);
     
-    // Parse positions
     int parsedCount = 0;
-    for (JsonObject item : portfolio) {
-        if (parsedCount >= MAX_POSITIONS_PER_MODE) {
-            Serial.println("Warning: Maximum positions reached");
-            break;
-        }
-        
-        CryptoPosition* position;
-        if (isExitMode) {
-            position = &_exitPositions[_exitPositionCount];
-        } else {
-            position = &_entryPositions[_entryPositionCount];
-        }
-        
-        if (parsePosition(item, *position)) {
+    PositionRecord update;
+    for (JsonObject item : positions) {
+        if (parsePosition(item, update) && applyPosition(update, portfolio)) {
             parsedCount++;
-            
-            // Set alert thresholds from config
-            position->alertThreshold = ConfigManager::getInstance().getAlertThreshold();
-            position->severeThreshold = ConfigManager::getInstance().getSevereThreshold();
-            
-            // Initialize alert flags
-            position->alerted = false;
-            position->severeAlerted = false;
-            position->hasAlerted = false;
-            position->lastAlertTime = 0;
-            position->lastAlertPrice = 0.0;
-            position->lastAlertPercent = 0.0;
-            
-            // For exit mode
-            position->exitAlerted = false;
-            position->exitAlertLastPrice = position->currentPrice;
-            position->exitAlertTime = 0;
-            
-            if (isExitMode) {
-                _exitPositionCount++;
-            } else {
-                _entryPositionCount++;
-            }
         }
     }
     
-    // Parse summary
+    endMerge(portfolio, true);
+    
+    // Totals from the payload take precedence over the running sums
+    state.serverTotals = false;
     if (doc.containsKey("summary")) {
         JsonObject summary = doc["summary"];
-        parseSummary(summary, isExitMode);
-    } else {
-        // Calculate summary from positions
-        PortfolioSummary* summary;
-        CryptoPosition* positions;
-        int count;
-        
-        if (isExitMode) {
-            summary = &_exitSummary;
-            positions = _exitPositions;
-            count = _exitPositionCount;
-        } else {
-            summary = &_entrySummary;
-            positions = _entryPositions;
-            count = _entryPositionCount;
+        parseSummary(summary, portfolio);
+    }
+    
+    finishParse(portfolio);
+    
+    Serial.print("Parsed ");
+    Serial.print(parsedCount);
+    Serial.print(" positions for ");
+    Serial.println(state.config.name);
+    
+    return parsedCount > 0;
+}
+
+// ===== STREAMING PARSER =====
+// Reads the body token by token so only one position object is ever held
+// in memory; peak RAM does not depend on the payload size.
+
+// Wait for the next non-whitespace character without consuming it
+static int streamPeekToken(Stream& stream) {
+    unsigned long start = millis();
+    while (millis() - start < STREAM_READ_TIMEOUT) {
+        int c = stream.peek();
+        if (c < 0) {
+            delay(1);
+            continue;
         }
-        
-        // Calculate basic summary
-        float totalInvestment = 0;
-        float totalCurrentValue = 0;
-        float totalPnl = 0;
-        int longCount = 0;
-        int shortCount = 0;
-        int winningCount = 0;
-        int losingCount = 0;
-        float maxLoss = 0;
-        
-        for (int i = 0; i < count; i++) {
-            totalCurrentValue += positions[i].currentPrice * positions[i].quantity;
-            totalPnl += positions[i].pnlValue;
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            stream.read();
+            continue;
+        }
+        return c;
+    }
+    return -1;
+}
+
+static int streamReadToken(Stream& stream) {
+    int c = streamPeekToken(stream);
+    if (c >= 0) stream.read();
+    return c;
+}
+
+// Read an object key (opening quote already consumed) and its ':' separator
+static bool streamReadKey(Stream& stream, char* key, size_t keySize) {
+    size_t len = 0;
+    unsigned long start = millis();
+    bool escaped = false;
+    
+    while (millis() - start < STREAM_READ_TIMEOUT) {
+        int c = stream.read();
+        if (c < 0) {
+            delay(1);
+            continue;
+        }
+        if (!escaped && c == '"') {
+            key[len] = '\0';
+            return streamReadToken(stream) == ':';
+        }
+        escaped = !escaped && c == '\\';
+        if (len < keySize - 1) key[len++] = (char)c;
+    }
+    return false;
+}
+
+// Consume and discard one JSON value
+static bool streamSkipValue(Stream& stream) {
+    StaticJsonDocument<16> filter;
+    filter.set(false);
+    StaticJsonDocument<16> doc;
+    return !deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+}
+
+bool DataManager::parsePortfolioStream(Stream& stream, uint8_t portfolio, bool isDelta) {
+    Portfolio& state = row(portfolio);
+    MetricTimer timer(portfolioLatency(_parseLatency, portfolio, state.tag, "portfolio_parse_seconds",
+                                       "Portfolio parse and apply, including a streamed body"));
+    
+    if (streamReadToken(stream) != '{') {
+        Serial.println("Stream Parse Error: expected object");
+        return false;
+    }
+    
+    // A delta only carries changes; a full payload also closes unlisted positions
+    beginMerge(portfolio, isDelta);
+    
+    StaticJsonDocument<STREAM_SUMMARY_DOC_SIZE> summaryDoc;
+    bool hasPortfolio = false;
+    bool hasSummary = false;
+    bool ok = true;
+    int parsedCount = 0;
+    char key[STREAM_KEY_LENGTH];
+    
+    if (streamPeekToken(stream) == '}') {
+        stream.read();
+    } else {
+        while (ok) {
+            if (streamReadToken(stream) != '"' || !streamReadKey(stream, key, sizeof(key))) {
+                ok = false;
+                break;
+            }
             
-            if (positions[i].isLong) longCount++;
-            else shortCount++;
+            if (strcmp(key, "portfolio") == 0) {
+                hasPortfolio = true;
+                ok = parsePositionArray(stream, portfolio, parsedCount);
+            } else if (isDelta && strcmp(key, "removed") == 0) {
+                ok = parseRemovedSymbols(stream, portfolio);
+            } else if (strcmp(key, "summary") == 0) {
+                // Only the totals parseSummary() reads are kept
+                StaticJsonDocument<96> filter;
+                filter["total_investment"] = true;
+                filter["total_current_value"] = true;
+                filter["total_pnl"] = true;
+                DeserializationError error = deserializeJson(summaryDoc, stream,
+                                                             DeserializationOption::Filter(filter));
+                hasSummary = !error && summaryDoc.is<JsonObject>();
+                ok = !error;
+            } else {
+                ok = streamSkipValue(stream);
+            }
             
-            if (positions[i].changePercent >= 0) winningCount++;
-            else losingCount++;
+            if (!ok) break;
             
-            if (positions[i].changePercent < maxLoss) {
-                maxLoss = positions[i].changePercent;
+            int next = streamReadToken(stream);
+            if (next == '}') break;
+            if (next != ',') ok = false;
+        }
+    }
+    
+    // A truncated payload cannot tell which positions were closed
+    endMerge(portfolio, ok && hasPortfolio);
+    
+    if (!ok) {
+        Serial.print("Stream Parse Error after ");
+        Serial.print(parsedCount);
+        Serial.println(" positions");
+    } else if (!hasPortfolio) {
+        Serial.println("No 'portfolio' field in JSON");
+        return false;
+    }
+    
+    // Summary can arrive before the positions, so it is applied last
+    state.serverTotals = false;
+    if (ok && hasSummary) {
+        JsonObject summary = summaryDoc.as<JsonObject>();
+        parseSummary(summary, portfolio);
+    }
+    
+    finishParse(portfolio);
+    
+    Serial.print(isDelta ? "Applied " : "Streamed ");
+    Serial.print(parsedCount);
+    Serial.print(isDelta ? " changed positions for " : " positions for ");
+    Serial.println(state.config.name);
+    
+    // An empty array is valid: no changes in a delta, no open positions in a full payload
+    return ok && hasPortfolio;
+}
+
+bool DataManager::applyPositions(uint8_t portfolio, const PositionRecord* positions, int count,
+                                 const char* const* removed, int removedCount, bool isDelta) {
+    Portfolio& state = row(portfolio);
+    if (!state.active) return false;
+    
+    MetricTimer timer(portfolioLatency(_parseLatency, portfolio, state.tag, "portfolio_parse_seconds",
+                                       "Portfolio parse and apply, including a streamed body"));
+    
+    beginMerge(portfolio, isDelta);
+    
+    // IDs are local to this device, so they are interned here
+    PositionRecord update;
+    for (int i = 0; i < count; i++) {
+        update = positions[i];
+        update.symbol[sizeof(update.symbol) - 1] = '\0';
+        update.symbolId = SymbolTable::getInstance().intern(update.symbol);
+        applyPosition(update, portfolio);
+    }
+    for (int i = 0; i < removedCount; i++) {
+        removePosition(removed[i], portfolio);
+    }
+    
+    endMerge(portfolio, true);
+    
+    // No payload summary; totals come from the running metrics
+    state.serverTotals = false;
+    finishParse(portfolio);
+    
+    // Counts as this row's fetch, and is logged like one
+    state.lastFetch = millis();
+    saveDataSnapshot(portfolio);
+    return true;
+}
+
+// Everything a parse publishes once its positions are merged
+void DataManager::finishParse(uint8_t portfolio) {
+    row(portfolio).metrics.recordSample();
+    rebuildSymbolIndex(portfolio);
+    updateRanking(portfolio);
+    updatePositionHistory(portfolio);
+    publishSnapshot(portfolio);
+    publishPositionEvents(portfolio);
+    
+    _lastUpdateTime = millis();
+}
+
+bool DataManager::parsePositionArray(Stream& stream, uint8_t portfolio, int& parsedCount) {
+    // Only the fields parsePosition() reads are kept
+    StaticJsonDocument<256> filter;
+    filter["symbol"] = true;
+    filter["pnl_percent"] = true;
+    filter["current_price"] = true;
+    filter["entry_price"] = true;
+    filter["quantity"] = true;
+    filter["pnl"] = true;
+    filter["position"] = true;
+    filter["position_side"] = true;
+    filter["side"] = true;
+    filter["leverage"] = true;
+    filter["liquidation_price"] = true;
+    filter["margin_type"] = true;
+    
+    if (streamReadToken(stream) != '[') return false;
+    if (streamPeekToken(stream) == ']') {
+        stream.read();
+        return true;
+    }
+    
+    StaticJsonDocument<STREAM_POSITION_DOC_SIZE> doc;
+    PositionRecord update;
+    bool fullReported = false;
+    
+    while (true) {
+        DeserializationError error = deserializeJson(doc, stream,
+                                                     DeserializationOption::Filter(filter));
+        if (error) {
+            Serial.print("JSON Parse Error: ");
+            Serial.println(error.c_str());
+            return false;
+        }
+        
+        JsonObject item = doc.as<JsonObject>();
+        if (!item.isNull() && parsePosition(item, update)) {
+            if (applyPosition(update, portfolio)) {
+                parsedCount++;
+            } else if (!fullReported) {
+                Serial.println("Warning: Maximum positions reached");
+                fullReported = true;
             }
         }
         
-        summary->totalCurrentValue = totalCurrentValue;
-        summary->totalPnl = totalPnl;
-        summary->totalInvestment = totalCurrentValue - totalPnl;
-        summary->totalPositions = count;
-        summary->longPositions = longCount;
-        summary->shortPositions = shortCount;
-        summary->winningPositions = winningCount;
-        summary->losingPositions = losingCount;
-        summary->maxDrawdown = maxLoss;
+        int next = streamReadToken(stream);
+        if (next == ']') return true;
+        if (next != ',') return false;
+    }
+}
+
+bool DataManager::parseRemovedSymbols(Stream& stream, uint8_t portfolio) {
+    if (streamReadToken(stream) != '[') return false;
+    if (streamPeekToken(stream) == ']') {
+        stream.read();
+        return true;
+    }
+    
+    StaticJsonDocument<64> doc;
+    
+    while (true) {
+        if (deserializeJson(doc, stream)) return false;
         
-        if (summary->totalInvestment > 0) {
-            summary->totalPnlPercent = (totalPnl / summary->totalInvestment) * 100;
-        } else {
-            summary->totalPnlPercent = 0.0;
+        const char* symbol = doc.as<const char*>();
+        if (symbol) {
+            removePosition(symbol, portfolio);
         }
+        
+        int next = streamReadToken(stream);
+        if (next == ']') return true;
+        if (next != ',') return false;
     }
+}
+
+// ===== MERGING =====
+// Incoming rows are matched to existing slots by symbol ID, so untouched
+// positions keep their slot, ranking and alert state. Closed positions are
+// tombstoned and compacted once at the end of the parse.
+static void storePosition(const PositionColumns& columns, PositionDetail* details, int slot,
+                          const PositionRecord& position) {
+    columns.symbolId[slot] = position.symbolId;
+    columns.changePercent[slot] = position.changePercent;
+    columns.pnlValue[slot] = position.pnlValue;
+    columns.currentPrice[slot] = position.currentPrice;
+    details[slot] = static_cast<const PositionDetail&>(position);
+}
+
+static void movePosition(const PositionColumns& columns, PositionDetail* details, int from, int to) {
+    columns.symbolId[to] = columns.symbolId[from];
+    columns.changePercent[to] = columns.changePercent[from];
+    columns.pnlValue[to] = columns.pnlValue[from];
+    columns.currentPrice[to] = columns.currentPrice[from];
+    details[to] = details[from];
+}
+
+static void loadPosition(const PositionColumns& columns, const PositionDetail* details, int slot,
+                         PositionRecord& position) {
+    static_cast<PositionDetail&>(position) = details[slot];
+    position.symbolId = columns.symbolId[slot];
+    position.changePercent = columns.changePercent[slot];
+    position.pnlValue = columns.pnlValue[slot];
+    position.currentPrice = columns.currentPrice[slot];
+}
+
+int DataManager::findSlot(uint16_t symbolId, const char* symbol, uint8_t portfolio) const {
+    const Portfolio& state = row(portfolio);
     
-    // Calculate derived metrics
-    calculateDerivedMetrics(isExitMode);
+    if (symbolId < SYMBOL_TABLE_CAPACITY) {
+        uint8_t slot = state.slotById[symbolId];
+        if (slot == SLOT_NONE || slot >= state.count) return -1;
+        return getColumns(portfolio).symbolId[slot] == symbolId ? slot : -1;
+    }
     
-    // Update history
-    updatePositionHistory(isExitMode);
+    // Only symbols that did not fit in the symbol table get here
+    const PositionDetail* details = getDetails(portfolio);
+    for (int i = 0; symbol && i < state.count; i++) {
+        if (strcmp(details[i].symbol, symbol) == 0) return i;
+    }
+    return -1;
+}
+
+void DataManager::beginMerge(uint8_t portfolio, bool isDelta) {
+    int count = row(portfolio).count;
     
-    _lastUpdateTime = millis();
+    // A full payload lists every open position; whatever it leaves out was closed
+    for (int i = 0; i < count; i++) {
+        _slotLive[i] = isDelta;
+    }
+    memset(_parseChanged, 0, sizeof(_parseChanged));
+    _parseRemovedCount = 0;
     
-    Serial.print("Parsed ");
-    Serial.print(parsedCount);
-    Serial.print(" positions for ");
-    Serial.println(isExitMode ? "Exit Mode" : "Entry Mode");
+    // Read once per parse rather than once per new position
+    _mergeAlertThreshold = ConfigManager::getInstance().getAlertThreshold();
+    _mergeSevereThreshold = ConfigManager::getInstance().getSevereThreshold();
+}
+
+bool DataManager::applyPosition(const PositionRecord& update, uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    
+    int slot = findSlot(update.symbolId, update.symbol, portfolio);
+    if (slot >= 0) {
+        _slotLive[slot] = true;
+        if (mergePosition(portfolio, slot, update)) {
+            trackPosition(portfolio, slot);
+            markChanged(update.symbolId);
+        }
+        return true;
+    }
     
-    return parsedCount > 0;
+    // A new position may grow the range; only the ranges after it move
+    int count = state.count;
+    if (count >= MAX_POSITIONS_PER_PORTFOLIO || !_pool.reserve(portfolioIndex(portfolio), count + 1)) {
+        return false;
+    }
+    
+    PositionRecord added = update;
+    resetAlertState(added);
+    storePosition(getColumns(portfolio), _pool.getDetails(portfolioIndex(portfolio)), count, added);
+    _slotLive[count] = true;
+    
+    // Later rows of the same payload may refer to it
+    if (update.symbolId != SYMBOL_ID_NONE) {
+        state.slotById[update.symbolId] = count;
+    }
+    state.count++;
+    trackPosition(portfolio, count);
+    markChanged(update.symbolId);
+    return true;
+}
+
+bool DataManager::mergePosition(uint8_t portfolio, int slot, const PositionRecord& update) {
+    PositionColumns columns = getColumns(portfolio);
+    PositionDetail& target = _pool.getDetails(portfolioIndex(portfolio))[slot];
+    
+    // Market fields only; alert state of the existing slot is kept
+    bool changed = columns.changePercent[slot] != update.changePercent ||
+                   columns.pnlValue[slot] != update.pnlValue ||
+                   columns.currentPrice[slot] != update.currentPrice ||
+                   target.quantity != update.quantity ||
+                   target.entryPrice != update.entryPrice ||
+                   target.isLong != update.isLong ||
+                   target.leverage != update.leverage ||
+                   target.liquidationPrice != update.liquidationPrice ||
+                   strcmp(target.positionSide, update.positionSide) != 0 ||
+                   strcmp(target.marginType, update.marginType) != 0;
+    if (!changed) return false;
+    
+    columns.changePercent[slot] = update.changePercent;
+    columns.pnlValue[slot] = update.pnlValue;
+    columns.currentPrice[slot] = update.currentPrice;
+    target.quantity = update.quantity;
+    target.entryPrice = update.entryPrice;
+    target.isLong = update.isLong;
+    target.leverage = update.leverage;
+    target.liquidationPrice = update.liquidationPrice;
+    memcpy(target.positionSide, update.positionSide, sizeof(target.positionSide));
+    memcpy(target.marginType, update.marginType, sizeof(target.marginType));
+    return true;
+}
+
+bool DataManager::removePosition(const char* symbol, uint8_t portfolio) {
+    int slot = findSlot(SymbolTable::getInstance().find(symbol), symbol, portfolio);
+    if (slot < 0) return false;
+    
+    _slotLive[slot] = false;
+    return true;
 }
 
-bool DataManager::parsePosition(JsonObject& item, CryptoPosition& position) {
+void DataManager::endMerge(uint8_t portfolio, bool complete) {
+    Portfolio& state = row(portfolio);
+    MetricTimer timer(portfolioLatency(_mergeLatency, portfolio, state.tag, "portfolio_merge_seconds",
+                                       "Closing unlisted positions and compacting the table"));
+    
+    PositionColumns columns = getColumns(portfolio);
+    PositionDetail* details = _pool.getDetails(portfolioIndex(portfolio));
+    int& count = state.count;
+    
+    // One pass; surviving slots keep their relative order
+    if (complete) {
+        int live = 0;
+        for (int i = 0; i < count; i++) {
+            if (!_slotLive[i]) {
+                state.metrics.removePosition(i);
+                if (columns.symbolId[i] != SYMBOL_ID_NONE) {
+                    _parseRemoved[_parseRemovedCount++] = columns.symbolId[i];
+                }
+                continue;
+            }
+            if (live != i) {
+                movePosition(columns, details, i, live);
+                state.metrics.movePosition(i, live);
+            }
+            live++;
+        }
+        if (live < count) {
+            int closed = count - live;
+            memset(&columns.symbolId[live], 0, closed * sizeof(uint16_t));
+            memset(&columns.changePercent[live], 0, closed * sizeof(float));
+            memset(&columns.pnlValue[live], 0, closed * sizeof(float));
+            memset(&columns.currentPrice[live], 0, closed * sizeof(float));
+            memset(&details[live], 0, closed * sizeof(PositionDetail));
+            count = live;
+        }
+
+        // Hands spare granules back to the pool
+        _pool.reserve(portfolioIndex(portfolio), count);
+    }
+    
+    for (int i = 0; i < CHANGED_SET_WORDS; i++) {
+        state.pendingChanged[i] |= _parseChanged[i];
+    }
+}
+
+void DataManager::markChanged(uint16_t symbolId) {
+    if (symbolId < SYMBOL_TABLE_CAPACITY) {
+        _parseChanged[symbolId / 32] |= 1UL << (symbolId % 32);
+    }
+}
+
+void DataManager::rebuildSymbolIndex(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    const uint16_t* symbolIds = getColumns(portfolio).symbolId;
+    
+    memset(state.slotById, SLOT_NONE, SYMBOL_TABLE_CAPACITY);
+    for (int i = 0; i < state.count; i++) {
+        if (symbolIds[i] != SYMBOL_ID_NONE) {
+            state.slotById[symbolIds[i]] = i;
+        }
+    }
+}
+
+// Reports only the positions in this parse's changed set, so listeners do
+// work in proportion to what changed rather than to the portfolio
+void DataManager::publishPositionEvents(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    MetricTimer timer(portfolioLatency(_eventLatency, portfolio, state.tag, "position_events_seconds",
+                                       "Change event fan-out, including alert evaluation"));
+    
+    PositionColumns columns = getColumns(portfolio);
+    const PositionDetail* details = getDetails(portfolio);
+    float* priceById = state.priceById;
+    PositionEvents& events = PositionEvents::getInstance();
+    
+    PositionEvent event;
+    memset(&event, 0, sizeof(event));
+    event.portfolio = portfolioIndex(portfolio);
+    event.isExitMode = state.config.exitAlerts;
+    
+    event.type = POSITION_EVENT_CHANGED;
+    for (int i = 0; i < state.count; i++) {
+        uint16_t id = columns.symbolId[i];
+        if (id == SYMBOL_ID_NONE) continue;
+        if (!(_parseChanged[id / 32] & (1UL << (id % 32)))) continue;
+        
+        float& reported = priceById[id];
+        
+        event.symbolId = id;
+        event.symbol = details[i].symbol;
+        event.price = columns.currentPrice[i];
+        event.previousPrice = reported;
+        event.changePercent = columns.changePercent[i];
+        event.pnlValue = columns.pnlValue[i];
+        event.isLong = details[i].isLong;
+        reported = columns.currentPrice[i];
+        events.publish(event);
+    }
+    
+    // Only the slots this parse's compaction dropped can have closed
+    event.type = POSITION_EVENT_REMOVED;
+    event.changePercent = 0;
+    event.pnlValue = 0;
+    event.price = 0;
+    event.isLong = false;
+    for (int i = 0; i < _parseRemovedCount; i++) {
+        uint16_t id = _parseRemoved[i];
+        if (priceById[id] == 0 || state.slotById[id] != SLOT_NONE) continue;
+        
+        event.symbolId = id;
+        event.symbol = SymbolTable::getInstance().getName(id);
+        event.previousPrice = priceById[id];
+        priceById[id] = 0;
+        events.publish(event);
+    }
+    _parseRemovedCount = 0;
+    
+    event.type = POSITION_EVENT_PARSED;
+    event.symbolId = SYMBOL_ID_NONE;
+    event.symbol = nullptr;
+    event.previousPrice = 0;
+    event.portfolioPnlPercent = getSummary(portfolio).totalPnlPercent;
+    events.publish(event);
+}
+
+bool DataManager::parsePosition(JsonObject& item, PositionRecord& position) {
     // Clear position
-    memset(&position, 0, sizeof(CryptoPosition));
+    memset(&position, 0, sizeof(PositionRecord));
     
     // Parse required fields
     const char* symbol = item["symbol"] | "UNKNOWN";
     strncpy(position.symbol, symbol, 15);
     position.symbol[15] = '\0';
+    position.symbolId = SymbolTable::getInstance().intern(position.symbol);
     
     position.changePercent = item["pnl_percent"] | 0.0;
     position.currentPrice = item["current_price"] | 0.0;
@@ -251,97 +966,118 @@ bool DataManager::parsePosition(JsonObject& item, CryptoPosition& position) {
     return true;
 }
 
-void DataManager::parseSummary(JsonObject& summary, bool isExitMode) {
-    PortfolioSummary* portfolioSummary;
-    if (isExitMode) {
-        portfolioSummary = &_exitSummary;
-    } else {
-        portfolioSummary = &_entrySummary;
+void DataManager::resetAlertState(PositionRecord& position) {
+    // Thresholds as read by beginMerge()
+    position.alertThreshold = _mergeAlertThreshold;
+    position.severeThreshold = _mergeSevereThreshold;
+    
+    // Initialize alert flags
+    position.alerted = false;
+    position.severeAlerted = false;
+    position.hasAlerted = false;
+    position.lastAlertTime = 0;
+    position.lastAlertPrice = 0.0;
+    position.lastAlertPercent = 0.0;
+    
+    // For exit mode
+    position.exitAlerted = false;
+    position.exitAlertLastPrice = position.currentPrice;
+    position.exitAlertTime = 0;
+}
+
+// ===== METRICS =====
+// Totals and counts are kept by PortfolioMetrics as positions change; the
+// summary is only re-derived when the metrics generation has moved on.
+void DataManager::trackPosition(uint8_t portfolio, int slot) {
+    PositionColumns columns = getColumns(portfolio);
+    const PositionDetail& detail = getDetails(portfolio)[slot];
+    
+    row(portfolio).metrics.setPosition(slot, columns.currentPrice[slot] * detail.quantity,
+                                       columns.pnlValue[slot], columns.changePercent[slot], detail.isLong);
+}
+
+void DataManager::refreshSummary(uint8_t portfolio) const {
+    const Portfolio& state = row(portfolio);
+    const PortfolioMetrics& metrics = state.metrics;
+    if (state.summaryGeneration == metrics.getGeneration()) return;
+    
+    PortfolioTotals& summary = state.summary;
+    
+    if (!state.serverTotals) {
+        summary.totalCurrentValue = metrics.getTotalValue();
+        summary.totalPnl = metrics.getTotalPnl();
+        summary.totalInvestment = summary.totalCurrentValue - summary.totalPnl;
+        summary.totalPnlPercent = summary.totalInvestment > 0
+            ? (summary.totalPnl / summary.totalInvestment) * 100 : 0.0;
     }
     
-    portfolioSummary->totalInvestment = summary["total_investment"] | 0.0;
-    portfolioSummary->totalCurrentValue = summary["total_current_value"] | 0.0;
-    portfolioSummary->totalPnl = summary["total_pnl"] | 0.0;
-    
-    // Calculate percentage
-    if (portfolioSummary->totalInvestment > 0) {
-        portfolioSummary->totalPnlPercent = 
-            ((portfolioSummary->totalCurrentValue - portfolioSummary->totalInvestment) / 
-             portfolioSummary->totalInvestment) * 100;
-    } else {
-        portfolioSummary->totalPnlPercent = 0.0;
-    }
+    summary.totalPositions = metrics.getCount();
+    summary.longPositions = metrics.getLongCount();
+    summary.shortPositions = metrics.getShortCount();
+    summary.winningPositions = metrics.getWinningCount();
+    summary.losingPositions = metrics.getLosingCount();
     
-    // Count positions
-    portfolioSummary->totalPositions = isExitMode ? _exitPositionCount : _entryPositionCount;
+    summary.riskExposure = metrics.getTotalValue();
+    summary.avgPositionSize = summary.totalPositions > 0
+        ? summary.riskExposure / summary.totalPositions : 0.0;
+    summary.maxDrawdown = metrics.getMaxDrawdown();
+    summary.sharpeRatio = metrics.getSharpeRatio();
+    summary.volatility = metrics.getVolatility();
     
-    // Count longs/shorts, winners/losers
-    portfolioSummary->longPositions = 0;
-    portfolioSummary->shortPositions = 0;
-    portfolioSummary->winningPositions = 0;
-    portfolioSummary->losingPositions = 0;
+    state.summaryGeneration = metrics.getGeneration();
+}
+
+void DataManager::parseSummary(JsonObject& summary, uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    PortfolioTotals& portfolioSummary = state.summary;
     
-    CryptoPosition* positions;
-    int count;
+    // Counts and derived metrics always come from the running metrics
+    portfolioSummary.totalInvestment = summary["total_investment"] | 0.0;
+    portfolioSummary.totalCurrentValue = summary["total_current_value"] | 0.0;
+    portfolioSummary.totalPnl = summary["total_pnl"] | 0.0;
     
-    if (isExitMode) {
-        positions = _exitPositions;
-        count = _exitPositionCount;
+    // Calculate percentage
+    if (portfolioSummary.totalInvestment > 0) {
+        portfolioSummary.totalPnlPercent = 
+            ((portfolioSummary.totalCurrentValue - portfolioSummary.totalInvestment) / 
+             portfolioSummary.totalInvestment) * 100;
     } else {
-        positions = _entryPositions;
-        count = _entryPositionCount;
-    }
-    
-    for (int i = 0; i < count; i++) {
-        if (positions[i].isLong) {
-            portfolioSummary->longPositions++;
-        } else {
-            portfolioSummary->shortPositions++;
-        }
-        
-        if (positions[i].changePercent >= 0) {
-            portfolioSummary->winningPositions++;
-        } else {
-            portfolioSummary->losingPositions++;
-        }
+        portfolioSummary.totalPnlPercent = 0.0;
     }
     
-    // Additional metrics if available
-    portfolioSummary->maxDrawdown = summary["max_drawdown"] | 0.0;
-    portfolioSummary->sharpeRatio = summary["sharpe_ratio"] | 0.0;
-    portfolioSummary->avgPositionSize = summary["avg_position_size"] | 0.0;
-    portfolioSummary->riskExposure = summary["risk_exposure"] | 0.0;
+    state.serverTotals = true;
 }
 
 // ===== DATA FETCHING =====
-bool DataManager::fetchData(bool isExitMode) {
-    String portfolioName;
-    if (isExitMode) {
-        portfolioName = ConfigManager::getInstance().getExitPortfolio();
-    } else {
-        portfolioName = ConfigManager::getInstance().getEntryPortfolio();
-    }
-    
-    if (portfolioName.isEmpty()) {
+bool DataManager::fetchData(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    if (!state.active) {
         Serial.println("Portfolio name not configured");
         return false;
     }
-    
-    String response;
-    bool success = APIManager::getInstance().fetchPortfolioData(portfolioName, isExitMode, response);
-    
-    if (success) {
-        // Parse the response
-        bool parseSuccess = parsePortfolioData(response, isExitMode);
-        
-        if (parseSuccess) {
-            // Save successful update
-            saveDataSnapshot(isExitMode);
-            return true;
-        } else {
-            Serial.println("Failed to parse portfolio data");
-            return false;
-        }
+    state.lastFetch = millis();
+    
+    // Parse straight from the socket; no response String is built
+    APIResponseInfo info;
+    bool success = APIManager::getInstance().fetchPortfolioStream(
+        state.config.name, portfolioIndex(portfolio),
+        [this, portfolio, &info](Stream& stream) {
+            return parsePortfolioStream(stream, portfolio, info.isDelta);
+        },
+        &info);
+    
+    if (success && info.notModified) {
+        // 304: positions and alert state stay untouched, but the held
+        // prices are still this interval's sample
+        saveDetailedDataToFile(portfolio);
+        return true;
+    } else if (success) {
+        // Save successful update
+        saveDataSnapshot(portfolio);
+        return true;
+    } else if (info.httpCode == HTTP_CODE_OK) {
+        Serial.println("Failed to parse portfolio data");
+        return false;
     } else {
         Serial.println("Failed to fetch portfolio data");
         return false;
@@ -349,294 +1085,521 @@ bool DataManager::fetchData(bool isExitMode) {
 }
 
 bool DataManager::fetchAllData() {
-    bool entrySuccess = false;
-    bool exitSuccess = false;
+    return fetchPortfolios(true);
+}
     
-    // Fetch entry data
-    String entryPortfolio = ConfigManager::getInstance().getEntryPortfolio();
-    if (!entryPortfolio.isEmpty()) {
-        entrySuccess = fetchData(false);
-    }
+bool DataManager::fetchDueData() {
+    return fetchPortfolios(false);
+}
     
-    // Fetch exit data
-    String exitPortfolio = ConfigManager::getInstance().getExitPortfolio();
-    if (!exitPortfolio.isEmpty()) {
-        exitSuccess = fetchData(true);
+// Due rows in fetch order: higher priority first, then the longest waiting
+int DataManager::collectDue(bool force, uint8_t* order) const {
+    unsigned long now = millis();
+    unsigned long waited[PORTFOLIO_MAX];
+    int count = 0;
+
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        const Portfolio& state = _portfolios[i];
+        if (!state.active) continue;
+
+        waited[i] = state.lastFetch == 0 ? ULONG_MAX : now - state.lastFetch;
+        if (!force && waited[i] < state.config.refreshInterval) continue;
+
+        int slot = count++;
+        while (slot > 0) {
+            const Portfolio& before = _portfolios[order[slot - 1]];
+            if (before.config.priority > state.config.priority) break;
+            if (before.config.priority == state.config.priority &&
+                waited[order[slot - 1]] >= waited[i]) break;
+            order[slot] = order[slot - 1];
+            slot--;
+        }
+        order[slot] = i;
     }
-    
-    return entrySuccess || exitSuccess;
+    return count;
 }
 
-// ===== DATA ANALYSIS =====
-void DataManager::calculateDerivedMetrics(bool isExitMode) {
-    CryptoPosition* positions;
-    int count;
-    PortfolioSummary* summary;
-    
-    if (isExitMode) {
-        positions = _exitPositions;
-        count = _exitPositionCount;
-        summary = &_exitSummary;
-    } else {
-        positions = _entryPositions;
-        count = _entryPositionCount;
-        summary = &_entrySummary;
+bool DataManager::fetchPortfolios(bool force) {
+    if (_reloadPending.load()) {
+        applyPortfolioConfig();
     }
-    
-    if (count == 0) return;
-    
-    // Calculate additional metrics
-    float totalExposure = 0;
-    float maxLoss = summary->maxDrawdown;
-    
-    for (int i = 0; i < count; i++) {
-        totalExposure += positions[i].currentPrice * positions[i].quantity;
+
+    uint8_t order[PORTFOLIO_MAX];
+    int count = collectDue(force, order);
+    if (count == 0) return false;
+
+    bool updated[PORTFOLIO_MAX];
+    memset(updated, 0, sizeof(updated));
+
+    // A batch asks for every active row in table order, whichever are due, so
+    // its validators stay keyed by one ?names= list. The batched response is
+    // keyed by name, so names have to be distinct
+    uint8_t batch[PORTFOLIO_MAX];
+    int batchCount = 0;
+    std::vector<String> names;
+    bool distinct = true;
+    for (uint8_t p = 0; p < PORTFOLIO_MAX; p++) {
+        if (!_portfolios[p].active) continue;
+        const char* name = _portfolios[p].config.name;
+        for (const String& other : names) {
+            distinct = distinct && other != name;
+        }
+        names.push_back(name);
+        batch[batchCount++] = p;
+    }
+
+    // Every active portfolio in one round trip when the server supports it
+    if (_batchSupported && batchCount > 1 && distinct) {
+        APIResponseInfo info;
+        bool success = APIManager::getInstance().fetchPortfolios(
+            names,
+            [&](Stream& stream) {
+                return parseBatchStream(stream, batch, batchCount, info.isDelta, updated);
+            },
+            &info);
+
+        unsigned long now = millis();
+        for (int i = 0; i < batchCount; i++) {
+            _portfolios[batch[i]].lastFetch = now;
+        }
+        
+        if (success && info.notModified) {
+            for (int i = 0; i < batchCount; i++) {
+                saveDetailedDataToFile(batch[i]);
+            }
+            return true;
+        }
         
-        if (positions[i].changePercent < maxLoss) {
-            maxLoss = positions[i].changePercent;
+        if (info.httpCode == HTTP_CODE_NOT_FOUND) {
+            Serial.println("Batched endpoint not available, using per-portfolio requests");
+            _batchSupported = false;
+        } else if (info.httpCode == HTTP_CODE_OK) {
+            bool anyUpdated = false;
+            for (int i = 0; i < batchCount; i++) {
+                if (!updated[batch[i]]) continue;
+                saveDataSnapshot(batch[i]);
+                anyUpdated = true;
+            }
+            return anyUpdated;
+        } else {
+            Serial.println("Failed to fetch portfolio data");
+            return false;
         }
     }
     
-    summary->maxDrawdown = maxLoss;
-    summary->riskExposure = totalExposure;
-    
-    // Calculate average position size
-    if (count > 0) {
-        summary->avgPositionSize = totalExposure / count;
+    // One request each, in fetch order; rows not reached before the budget
+    // is spent stay due and are ahead of their priority peers next cycle
+    unsigned long start = millis();
+    bool anyUpdated = false;
+    for (int i = 0; i < count; i++) {
+        if (i > 0 && millis() - start > DATA_FETCH_BUDGET) {
+            Serial.print("Fetch budget spent, deferred ");
+            Serial.print(count - i);
+            Serial.println(" portfolios");
+            break;
+        }
+        anyUpdated |= fetchData(order[i]);
     }
+    
+    return anyUpdated;
 }
 
-void DataManager::sortPositionsByPNL(bool isExitMode, bool ascending) {
-    CryptoPosition* positions;
-    int count;
-    
-    if (isExitMode) {
-        positions = _exitPositions;
-        count = _exitPositionCount;
-    } else {
-        positions = _entryPositions;
-        count = _entryPositionCount;
+bool DataManager::parseBatchStream(Stream& stream, const uint8_t* order, int count,
+                                   bool isDelta, bool* updated) {
+    char key[STREAM_NAME_LENGTH];
+    bool hasPortfolios = false;
+    bool anyUpdated = false;
+    
+    if (streamReadToken(stream) != '{') return false;
+    if (streamPeekToken(stream) == '}') {
+        stream.read();
+        return false;
     }
     
-    // Simple bubble sort
-    for (int i = 0; i < count - 1; i++) {
-        for (int j = 0; j < count - i - 1; j++) {
-            bool shouldSwap = false;
+    while (true) {
+        if (streamReadToken(stream) != '"' || !streamReadKey(stream, key, sizeof(key))) {
+            return false;
+        }
+        
+        if (strcmp(key, "portfolios") == 0) {
+            hasPortfolios = true;
             
-            if (ascending) {
-                shouldSwap = positions[j].changePercent > positions[j + 1].changePercent;
+            // Each sub-object goes to its portfolio's parser as it arrives
+            if (streamReadToken(stream) != '{') return false;
+            if (streamPeekToken(stream) == '}') {
+                stream.read();
             } else {
-                shouldSwap = positions[j].changePercent < positions[j + 1].changePercent;
-            }
-            
-            if (shouldSwap) {
-                CryptoPosition temp = positions[j];
-                positions[j] = positions[j + 1];
-                positions[j + 1] = temp;
+                while (true) {
+                    if (streamReadToken(stream) != '"' || !streamReadKey(stream, key, sizeof(key))) {
+                        return false;
+                    }
+                    
+                    int match = -1;
+                    for (int i = 0; i < count && match < 0; i++) {
+                        if (strcmp(_portfolios[order[i]].config.name, key) == 0) match = order[i];
+                    }
+
+                    if (match >= 0) {
+                        updated[match] = parsePortfolioStream(stream, match, isDelta);
+                        anyUpdated = anyUpdated || updated[match];
+                    } else if (!streamSkipValue(stream)) {
+                        return false;
+                    }
+                    
+                    int next = streamReadToken(stream);
+                    if (next == '}') break;
+                    if (next != ',') return false;
+                }
             }
+        } else if (!streamSkipValue(stream)) {
+            return false;
         }
+        
+        int next = streamReadToken(stream);
+        if (next == '}') break;
+        if (next != ',') return false;
+    }
+    
+    if (!hasPortfolios) {
+        Serial.println("No 'portfolios' field in JSON");
     }
+    
+    return hasPortfolios && anyUpdated;
 }
 
-// ===== POSITION HISTORY =====
-void DataManager::updatePositionHistory(bool isExitMode) {
-    CryptoPosition* positions;
-    int count;
-    std::vector<PositionHistory>* history;
-    
-    if (isExitMode) {
-        positions = _exitPositions;
-        count = _exitPositionCount;
-        history = &_exitPositionHistory;
-    } else {
-        positions = _entryPositions;
-        count = _entryPositionCount;
-        history = &_entryPositionHistory;
+// ===== DATA ANALYSIS =====
+void DataManager::updateRanking(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    PositionColumns columns = getColumns(portfolio);
+    
+    // Slots keep their rank unless their keys moved past a neighbour
+    state.ranking.resize(state.count);
+    for (int i = 0; i < state.count; i++) {
+        state.ranking.update(i, columns.changePercent[i], columns.pnlValue[i]);
     }
-    
-    unsigned long currentTime = millis();
-    
-    // Update history for each position
+}
+
+const PositionRanking& DataManager::getRanking(uint8_t portfolio) const {
+    return row(portfolio).ranking;
+}
+
+int DataManager::getRankedPositions(uint8_t portfolio, RankKey key, bool worstFirst,
+                                    const PositionRecord** positions, int maxCount) const {
+    const PortfolioSnapshot* snapshot = published(portfolio);
+    if (!snapshot) return 0;
+    uint8_t indices[RANKING_MAX_POSITIONS];
+    
+    // Published ranking, so the slots match the published records
+    int count = snapshot->ranking.top(key, worstFirst, indices,
+                                      min(maxCount, RANKING_MAX_POSITIONS));
     for (int i = 0; i < count; i++) {
-        // Find existing history for this symbol
-        bool found = false;
-        for (auto& hist : *history) {
-            if (strcmp(hist.symbol, positions[i].symbol) == 0) {
-                // Update existing history
-                hist.lastPrice = positions[i].currentPrice;
-                hist.lastUpdate = currentTime;
-                hist.changePercent = positions[i].changePercent;
-                
-                // Add to price history
-                if (hist.priceHistory.size() >= POSITION_HISTORY_SIZE) {
-                    hist.priceHistory.erase(hist.priceHistory.begin());
-                }
-                hist.priceHistory.push_back(positions[i].currentPrice);
-                
-                found = true;
+        positions[i] = &snapshot->positions[indices[i]];
+    }
+    return count;
+}
+
+// ===== SNAPSHOTS =====
+// Sizes a buffer's position array to the portfolio, with the pool's granule
+// and slack. Only called on buffers no reader holds.
+static bool fitSnapshot(PortfolioSnapshot& snapshot, int count) {
+    int capacity = fitCapacity(count, snapshot.capacity);
+    if (capacity == snapshot.capacity) return true;
+
+    if (capacity == 0) {
+        heap_caps_free(snapshot.positions);
+        snapshot.positions = nullptr;
+        snapshot.capacity = 0;
+        return true;
+    }
+
+    void* positions = heap_caps_realloc(snapshot.positions, capacity * sizeof(PositionRecord), heapCaps());
+    if (!positions) return false;
+
+    snapshot.positions = (PositionRecord*)positions;
+    snapshot.capacity = capacity;
+    return true;
+}
+
+// Copies the parser's working state into a buffer no reader holds and makes
+// it the published one with a single index store. Readers pin the published
+// index with a count and re-check it, so a buffer is never written under them.
+void DataManager::publishSnapshot(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    if (!state.snapshots) return;
+    
+    uint32_t published = state.publishedIndex.load();
+    int target = -1;
+    unsigned long start = millis();
+    while (true) {
+        for (int i = 0; i < SNAPSHOT_BUFFER_COUNT; i++) {
+            if (i != (int)published && state.snapshotReaders[i].load() == 0) {
+                target = i;
                 break;
             }
         }
+        if (target >= 0) break;
         
-        // Create new history if not found
-        if (!found) {
-            PositionHistory newHist;
-            strncpy(newHist.symbol, positions[i].symbol, 15);
-            newHist.symbol[15] = '\0';
-            newHist.lastPrice = positions[i].currentPrice;
-            newHist.lastUpdate = currentTime;
-            newHist.changePercent = positions[i].changePercent;
-            newHist.priceHistory.push_back(positions[i].currentPrice);
-            
-            history->push_back(newHist);
-            
-            // Limit history size
-            if (history->size() > 20) {
-                history->erase(history->begin());
-            }
+        // Both spare buffers are pinned; the next parse publishes everything anyway
+        if (millis() - start > SNAPSHOT_WAIT_TIMEOUT) {
+            _snapshotsSkipped++;
+            Serial.println("Snapshot buffers busy, publish skipped");
+            return;
         }
+        delay(1);
+    }
+    
+    PortfolioSnapshot& snapshot = state.snapshots[target];
+    if (!fitSnapshot(snapshot, state.count)) {
+        _snapshotsSkipped++;
+        Serial.println("Snapshot buffer allocation failed, publish skipped");
+        return;
     }
-}
 
-// ===== DATA PERSISTENCE =====
-void DataManager::saveDataSnapshot(bool isExitMode) {
-    // Save to preferences
-    String prefix = isExitMode ? "exit_data" : "entry_data";
+    // Readers get whole records, gathered back from the columns
+    PositionColumns columns = getColumns(portfolio);
+    const PositionDetail* details = getDetails(portfolio);
+    snapshot.count = state.count;
+    for (int i = 0; i < snapshot.count; i++) {
+        loadPosition(columns, details, i, snapshot.positions[i]);
+    }
+    snapshot.summary = getSummary(portfolio);
+    snapshot.ranking = state.ranking;
     
-    _prefs.begin(prefix.c_str(), false);
+    // Changes of skipped publishes stay pending until one succeeds
+    memcpy(snapshot.changed, state.pendingChanged, sizeof(snapshot.changed));
+    memset(state.pendingChanged, 0, sizeof(state.pendingChanged));
+    snapshot.publishTime = millis();
+    snapshot.generation = state.publishedGeneration.load() + 1;
     
-    // Save timestamp
-    _prefs.putULong("last_update", millis());
+    state.publishedIndex.store(target);
+    state.publishedGeneration.store(snapshot.generation);
+}
+
+const PortfolioSnapshot* DataManager::acquireSnapshot(uint8_t portfolio, uint8_t& index) {
+    Portfolio& state = row(portfolio);
+    if (!state.snapshots) return nullptr;
     
-    // Save summary
-    PortfolioSummary* summary;
-    if (isExitMode) {
-        summary = &_exitSummary;
-    } else {
-        summary = &_entrySummary;
+    while (true) {
+        uint32_t published = state.publishedIndex.load();
+        state.snapshotReaders[published].fetch_add(1);
+        
+        // Still published after pinning: the writer will not pick it now
+        if (state.publishedIndex.load() == published) {
+            index = published;
+            return &state.snapshots[published];
+        }
+        state.snapshotReaders[published].fetch_sub(1);
+    }
+}
+
+void DataManager::releaseSnapshot(uint8_t portfolio, uint8_t index) {
+    row(portfolio).snapshotReaders[index].fetch_sub(1);
+}
+
+SnapshotReader::SnapshotReader(uint8_t portfolio)
+    : _snapshot(nullptr),
+      _portfolio(portfolio),
+      _index(0) {
+    _snapshot = DataManager::getInstance().acquireSnapshot(portfolio, _index);
+}
+
+SnapshotReader::~SnapshotReader() {
+    if (_snapshot) {
+        DataManager::getInstance().releaseSnapshot(_portfolio, _index);
     }
+}
+
+// ===== POSITION HISTORY =====
+void DataManager::updatePositionHistory(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    PositionColumns columns = getColumns(portfolio);
     
+    uint32_t currentTime = millis();
+    
+    // Symbols that could not be interned have no ring and are not recorded
+    for (int i = 0; i < state.count; i++) {
+        if (columns.symbolId[i] == SYMBOL_ID_NONE) continue;
+        state.history.append(columns.symbolId[i], columns.currentPrice[i],
+                             columns.changePercent[i], currentTime);
+    }
+}
+
+const PriceHistoryStore& DataManager::getHistory(uint8_t portfolio) const {
+    return row(portfolio).history;
+}
+
+TimeSeriesLog& DataManager::getHistoryLog(uint8_t portfolio) {
+    return row(portfolio).log;
+}
+
+// ===== DATA PERSISTENCE =====
+// One Preferences namespace per row: entry_data, exit_data, port2_data..
+void DataManager::saveDataSnapshot(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    
+    // Save detailed data to the history log
+    saveDetailedDataToFile(portfolio);
+    
+    // The totals only seed the display after a reboot, so each write to
+    // flash has to be a change and at most one per interval
+    const PortfolioTotals* summary = &getSummary(portfolio);
+    const PortfolioTotals& saved = state.savedTotals;
+    bool changed = summary->totalInvestment != saved.totalInvestment ||
+                   summary->totalCurrentValue != saved.totalCurrentValue ||
+                   summary->totalPnl != saved.totalPnl ||
+                   summary->totalPositions != saved.totalPositions;
+    bool due = state.lastSnapshotSave == 0 || millis() - state.lastSnapshotSave >= SNAPSHOT_SAVE_INTERVAL;
+    if (!changed || !due) return;
+    
+    char prefix[PORTFOLIO_TAG_LENGTH + 8];
+    snprintf(prefix, sizeof(prefix), "%s_data", state.tag);
+    
+    _prefs.begin(prefix, false);
     _prefs.putFloat("total_investment", summary->totalInvestment);
     _prefs.putFloat("total_current_value", summary->totalCurrentValue);
     _prefs.putFloat("total_pnl", summary->totalPnl);
     _prefs.putFloat("total_pnl_percent", summary->totalPnlPercent);
     _prefs.putUInt("total_positions", summary->totalPositions);
-    
     _prefs.end();
+    
+    state.savedTotals = *summary;
+    state.lastSnapshotSave = millis();
 }
 
 void DataManager::loadHistoricalData() {
-    // Load entry data
-    _prefs.begin("entry_data", true);
-    _entrySummary.totalInvestment = _prefs.getFloat("total_investment", 0);
-    _entrySummary.totalCurrentValue = _prefs.getFloat("total_current_value", 0);
-    _entrySummary.totalPnl = _prefs.getFloat("total_pnl", 0);
-    _entrySummary.totalPnlPercent = _prefs.getFloat("total_pnl_percent", 0);
-    _prefs.end();
+    char prefix[PORTFOLIO_TAG_LENGTH + 8];
+    
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        Portfolio& state = _portfolios[i];
+        if (!state.active) continue;
+    
+        snprintf(prefix, sizeof(prefix), "%s_data", state.tag);
+        _prefs.begin(prefix, true);
+        state.summary.totalInvestment = _prefs.getFloat("total_investment", 0);
+        state.summary.totalCurrentValue = _prefs.getFloat("total_current_value", 0);
+        state.summary.totalPnl = _prefs.getFloat("total_pnl", 0);
+        state.summary.totalPnlPercent = _prefs.getFloat("total_pnl_percent", 0);
+        
+        // What NVS already holds, so an unchanged first parse writes nothing
+        state.savedTotals = state.summary;
+        state.savedTotals.totalPositions = _prefs.getUInt("total_positions", 0);
+        _prefs.end();
     
-    // Load exit data
-    _prefs.begin("exit_data", true);
-    _exitSummary.totalInvestment = _prefs.getFloat("total_investment", 0);
-    _exitSummary.totalCurrentValue = _prefs.getFloat("total_current_value", 0);
-    _exitSummary.totalPnl = _prefs.getFloat("total_pnl", 0);
-    _exitSummary.totalPnlPercent = _prefs.getFloat("total_pnl_percent", 0);
-    _prefs.end();
+        // Shown until the first parse moves the metrics on
+        state.summaryGeneration = state.metrics.getGeneration();
+
+        // Refill the price rings from the log instead of waiting for new samples
+        restoreHistory(i);
+    }
 }
 
-void DataManager::saveDetailedDataToFile(bool isExitMode) {
-    // This would save detailed data to SPIFFS
-    // Implement based on your storage needs
+static bool restoreHistoryRecord(const HistoryRecord& record, void* context) {
+    // The symbol table is full; the ring has no slot for it
+    if (record.symbolId == SYMBOL_ID_NONE) return true;
+    
+    // Restored samples predate this boot's millis() and carry timestamp 0
+    static_cast<PriceHistoryStore*>(context)->append(record.symbolId, record.price, 0, 0);
+    return true;
 }
 
-// ===== DATA QUERY METHODS =====
-CryptoPosition* DataManager::getPosition(const char* symbol, bool isExitMode) {
-    CryptoPosition* positions;
-    int count;
+void DataManager::restoreHistory(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
     
-    if (isExitMode) {
-        positions = _exitPositions;
-        count = _exitPositionCount;
-    } else {
-        positions = _entryPositions;
-        count = _entryPositionCount;
-    }
+    uint32_t lastTime = state.log.getLastTime();
+    if (!state.log.isReady() || lastTime == 0) return;
     
-    for (int i = 0; i < count; i++) {
-        if (strcmp(positions[i].symbol, symbol) == 0) {
-            return &positions[i];
+    uint32_t span = (uint32_t)POSITION_HISTORY_SIZE * HISTORY_LOG_INTERVAL;
+    uint32_t from = lastTime > span ? lastTime - span : 0;
+    int restored = state.log.query(from, lastTime, restoreHistoryRecord, &state.history, true);
+    
+    Serial.print(state.config.name);
+    Serial.print(" history restored: ");
+    Serial.print(restored);
+    Serial.println(" samples");
+}
+
+void DataManager::saveDetailedDataToFile(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+    TimeSeriesLog& log = state.log;
+    uint32_t now = time(nullptr);
+    
+    // Records are keyed by wall-clock time, so wait for NTP
+    if (!log.isReady() || now < HISTORY_LOG_MIN_TIME) return;
+    
+    if (log.isDue(now)) {
+        PositionColumns columns = getColumns(portfolio);
+        
+        for (int i = 0; i < state.count; i++) {
+            if (columns.symbolId[i] == SYMBOL_ID_NONE) continue;
+            log.record(now, columns.symbolId[i], columns.currentPrice[i], columns.pnlValue[i]);
         }
     }
     
-    return nullptr;
+    // Batched samples reach flash about once per HISTORY_LOG_FLUSH_INTERVAL
+    log.update(now);
 }
 
-CryptoPosition* DataManager::getWorstPosition(bool isExitMode) {
-    CryptoPosition* positions;
-    int count;
-    
-    if (isExitMode) {
-        positions = _exitPositions;
-        count = _exitPositionCount;
-    } else {
-        positions = _entryPositions;
-        count = _entryPositionCount;
+// ===== DATA QUERY METHODS =====
+const PositionRecord* DataManager::getPosition(const char* symbol, uint8_t portfolio) const {
+    uint16_t id = SymbolTable::getInstance().find(symbol);
+    if (id != SYMBOL_ID_NONE) {
+        return getPositionById(id, portfolio);
     }
     
-    if (count == 0) return nullptr;
+    const PortfolioSnapshot* snapshot = published(portfolio);
+    if (!snapshot) return nullptr;
     
-    CryptoPosition* worst = &positions[0];
-    for (int i = 1; i < count; i++) {
-        if (positions[i].changePercent < worst->changePercent) {
-            worst = &positions[i];
+    // Only symbols that did not fit in the symbol table get here
+    for (int i = 0; i < snapshot->count; i++) {
+        if (strcmp(snapshot->positions[i].symbol, symbol) == 0) {
+            return &snapshot->positions[i];
         }
     }
     
-    return worst;
+    return nullptr;
 }
 
-CryptoPosition* DataManager::getBestPosition(bool isExitMode) {
-    CryptoPosition* positions;
-    int count;
+const PositionRecord* DataManager::getPositionById(uint16_t symbolId, uint8_t portfolio) const {
+    if (symbolId >= SYMBOL_TABLE_CAPACITY) return nullptr;
     
-    if (isExitMode) {
-        positions = _exitPositions;
-        count = _exitPositionCount;
-    } else {
-        positions = _entryPositions;
-        count = _entryPositionCount;
-    }
+    const PortfolioSnapshot* snapshot = published(portfolio);
+    if (!snapshot) return nullptr;
     
-    if (count == 0) return nullptr;
-    
-    CryptoPosition* best = &positions[0];
-    for (int i = 1; i < count; i++) {
-        if (positions[i].changePercent > best->changePercent) {
-            best = &positions[i];
-        }
+    // The index follows the working set; the ID check catches a slot that moved since
+    uint8_t slot = row(portfolio).slotById[symbolId];
+    if (slot == SLOT_NONE || slot >= snapshot->count || snapshot->positions[slot].symbolId != symbolId) {
+        return nullptr;
     }
+    return &snapshot->positions[slot];
+}
+
+const PositionRecord* DataManager::getWorstPosition(uint8_t portfolio) const {
+    const PortfolioSnapshot* snapshot = published(portfolio);
+    int index = snapshot ? snapshot->ranking.worst(RANK_BY_CHANGE_PERCENT) : -1;
+    
+    return index >= 0 ? &snapshot->positions[index] : nullptr;
+}
+
+const PositionRecord* DataManager::getBestPosition(uint8_t portfolio) const {
+    const PortfolioSnapshot* snapshot = published(portfolio);
+    int index = snapshot ? snapshot->ranking.best(RANK_BY_CHANGE_PERCENT) : -1;
     
-    return best;
+    return index >= 0 ? &snapshot->positions[index] : nullptr;
 }
 
 // ===== WEB INTERFACE =====
-String DataManager::getDataJSON(bool isExitMode) {
-    DynamicJsonDocument doc(8192);
-    
-    PortfolioSummary* summary;
-    CryptoPosition* positions;
-    int count;
-    
-    if (isExitMode) {
-        summary = &_exitSummary;
-        positions = _exitPositions;
-        count = _exitPositionCount;
-        doc["mode"] = "exit";
-    } else {
-        summary = &_entrySummary;
-        positions = _entryPositions;
-        count = _entryPositionCount;
-        doc["mode"] = "entry";
-    }
+String DataManager::getDataJSON(uint8_t portfolio) {
+    ArenaJsonDocument doc(8192, ArenaAllocator(ARENA_WEB));
+    
+    const Portfolio& state = row(portfolio);
+    SnapshotReader snapshot(portfolio);
+    if (!snapshot.isValid()) return "{}";
+    
+    const PortfolioTotals* summary = &snapshot->summary;
+    const PositionRecord* positions = snapshot->positions;
+    int count = snapshot->count;
+    bool exitAlerts = state.config.exitAlerts;
+    doc["mode"] = state.tag;
     
     // Summary
     JsonObject summaryObj = doc.createNestedObject("summary");
@@ -651,6 +1614,7 @@ String DataManager::getDataJSON(bool isExitMode) {
     summaryObj["losingPositions"] = summary->losingPositions;
     summaryObj["maxDrawdown"] = summary->maxDrawdown;
     summaryObj["sharpeRatio"] = summary->sharpeRatio;
+    summaryObj["volatility"] = summary->volatility;
     
     // Positions
     JsonArray positionsArray = doc.createNestedArray("positions");
@@ -668,7 +1632,7 @@ String DataManager::getDataJSON(bool isExitMode) {
         posObj["severeAlerted"] = positions[i].severeAlerted;
         posObj["lastAlertTime"] = positions[i].lastAlertTime;
         
-        if (isExitMode) {
+        if (exitAlerts) {
             posObj["exitAlerted"] = positions[i].exitAlerted;
             posObj["exitAlertTime"] = positions[i].exitAlertTime;
         }
@@ -678,55 +1642,49 @@ String DataManager::getDataJSON(bool isExitMode) {
     doc["lastUpdate"] = _lastUpdateTime;
     doc["positionCount"] = count;
     
+    // Sized up front so the result is one heap block, not a chain of regrowths
     String json;
+    json.reserve(measureJson(doc) + 1);
     serializeJson(doc, json);
     return json;
 }
 
 // ===== UTILITY FUNCTIONS =====
 void DataManager::clearAllData() {
-    memset(_entryPositions, 0, sizeof(_entryPositions));
-    memset(_exitPositions, 0, sizeof(_exitPositions));
-    
-    _entryPositionCount = 0;
-    _exitPositionCount = 0;
-    
-    memset(&_entrySummary, 0, sizeof(PortfolioSummary));
-    memset(&_exitSummary, 0, sizeof(PortfolioSummary));
-    
-    _entryPositionHistory.clear();
-    _exitPositionHistory.clear();
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        clearData(i);
+    }
     
     Serial.println("All crypto data cleared");
 }
 
-void DataManager::clearData(bool isExitMode) {
-    if (isExitMode) {
-        memset(_exitPositions, 0, sizeof(_exitPositions));
-        _exitPositionCount = 0;
-        memset(&_exitSummary, 0, sizeof(PortfolioSummary));
-        _exitPositionHistory.clear();
-    } else {
-        memset(_entryPositions, 0, sizeof(_entryPositions));
-        _entryPositionCount = 0;
-        memset(&_entrySummary, 0, sizeof(PortfolioSummary));
-        _entryPositionHistory.clear();
-    }
+void DataManager::clearData(uint8_t portfolio) {
+    Portfolio& state = row(portfolio);
+
+    // A delta against the discarded data would be meaningless
+    APIManager::getInstance().clearValidators(portfolioIndex(portfolio));
+    
+    // The range goes back to the pool until positions arrive again
+    _pool.release(portfolioIndex(portfolio));
+    state.count = 0;
+    memset(&state.summary, 0, sizeof(PortfolioTotals));
+    state.metrics.clear();
+    state.history.clear();
+    state.ranking.clear();
+    memset(state.slotById, SLOT_NONE, sizeof(state.slotById));
+    memset(state.priceById, 0, sizeof(state.priceById));
+    state.serverTotals = false;
+    
+    publishSnapshot(portfolio);
 }
 
-void DataManager::printSummary(bool isExitMode) {
-    PortfolioSummary* summary;
-    int count;
+void DataManager::printSummary(uint8_t portfolio) {
+    const PortfolioTotals* summary = &getSummary(portfolio);
+    int count = row(portfolio).count;
     
-    if (isExitMode) {
-        summary = &_exitSummary;
-        count = _exitPositionCount;
-        Serial.println("\n=== Exit Mode Summary ===");
-    } else {
-        summary = &_entrySummary;
-        count = _entryPositionCount;
-        Serial.println("\n=== Entry Mode Summary ===");
-    }
+    Serial.print("\n=== ");
+    Serial.print(row(portfolio).config.name);
+    Serial.println(" Summary ===");
     
     Serial.print("Total Positions: ");
     Serial.println(count);
@@ -750,28 +1708,59 @@ void DataManager::printSummary(bool isExitMode) {
     Serial.print("Max Drawdown: ");
     Serial.print(summary->maxDrawdown, 2);
     Serial.println("%");
+    Serial.print("Volatility: ");
+    Serial.print(summary->volatility, 2);
+    Serial.print("%  Sharpe: ");
+    Serial.println(summary->sharpeRatio, 2);
     Serial.println("=======================\n");
 }
 
 // ===== GETTERS =====
-const CryptoPosition* DataManager::getPositions(bool isExitMode) const {
-    return isExitMode ? _exitPositions : _entryPositions;
+const PositionRecord* DataManager::getPositions(uint8_t portfolio) const {
+    const PortfolioSnapshot* snapshot = published(portfolio);
+    return snapshot ? snapshot->positions : nullptr;
+}
+
+int DataManager::getPositionCount(uint8_t portfolio) const {
+    const PortfolioSnapshot* snapshot = published(portfolio);
+    return snapshot ? snapshot->count : 0;
+}
+
+PositionColumns DataManager::getColumns(uint8_t portfolio) const {
+    return _pool.getColumns(portfolioIndex(portfolio));
+}
+
+const PositionDetail* DataManager::getDetails(uint8_t portfolio) const {
+    return _pool.getDetails(portfolioIndex(portfolio));
 }
 
-int DataManager::getPositionCount(bool isExitMode) const {
-    return isExitMode ? _exitPositionCount : _entryPositionCount;
+int DataManager::getWorkingCount(uint8_t portfolio) const {
+    return row(portfolio).count;
 }
 
-const PortfolioSummary& DataManager::getSummary(bool isExitMode) const {
-    return isExitMode ? _exitSummary : _entrySummary;
+const PortfolioTotals& DataManager::getSummary(uint8_t portfolio) const {
+    refreshSummary(portfolio);
+    return row(portfolio).summary;
+}
+
+uint32_t DataManager::getGeneration(uint8_t portfolio) const {
+    return row(portfolio).publishedGeneration.load();
 }
 
 unsigned long DataManager::getLastUpdateTime() const {
     return _lastUpdateTime;
 }
 
-bool DataManager::hasData(bool isExitMode) const {
-    return isExitMode ? (_exitPositionCount > 0) : (_entryPositionCount > 0);
+uint32_t DataManager::getSnapshotsSkipped() const {
+    return _snapshotsSkipped;
+}
+
+const PositionPool& DataManager::getPool() const {
+    return _pool;
+}
+
+bool DataManager::hasData(uint8_t portfolio) const {
+    return row(portfolio).count > 0;
 }
 
 bool DataManager::isInitialized() const {
@@ -784,4 +1773,4 @@ DataManager& DataManager::getInstance() {
         _instance = new DataManager();
     }
     return *_instance;
-}
\ No newline at end of file
+}
@@ -3,17 +3,30 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <Preferences.h>
 #include <vector>
 #include <string>
+#include <atomic>
+#include "PositionRanking.h"
+#include "SymbolTable.h"
+#include "PriceHistory.h"
+#include "TimeSeriesLog.h"
+#include "PositionEvents.h"
+#include "PortfolioMetrics.h"
+#include "PortfolioTable.h"
 
-// ساختار برای موقعیت‌های کریپتو
-typedef struct {
+#define MAX_POSITIONS_PER_PORTFOLIO 100 // Ranking and metrics index slots with a uint8_t
+#define POSITION_POOL_SIZE 384          // Open positions across all portfolios
+#define POSITION_POOL_GRANULE 8         // Ranges and snapshot buffers grow in steps of this
+#define SNAPSHOT_BUFFER_COUNT 4         // Published + writer + up to two held by readers
+#define CHANGED_SET_WORDS (SYMBOL_TABLE_CAPACITY / 32)
+
+// Cold part of a position: what is shown and the alert state. The parser
+// keeps these records in a side table that scans never touch.
+struct PositionDetail {
     char symbol[16];
-    float changePercent;
-    float pnlValue;
     float quantity;
     float entryPrice;
-    float currentPrice;
     bool isLong;
     bool alerted;
     bool severeAlerted;
@@ -34,10 +47,29 @@ typedef struct {
     char marginType[12];
     float leverage;
     float liquidationPrice;
-} CryptoPosition;
+};
+
+// ساختار برای موقعیت‌های کریپتو
+// A whole position, as parsed and as published in snapshots
+struct PositionRecord : PositionDetail {
+    uint16_t symbolId;          // SymbolTable ID, SYMBOL_ID_NONE if not interned
+    float changePercent;
+    float pnlValue;
+    float currentPrice;
+};
+
+// Hot fields of one portfolio's working set, a contiguous column each and
+// indexed by slot. Ranking, history, the log and change detection read
+// these and nothing else.
+struct PositionColumns {
+    uint16_t* symbolId;
+    float* changePercent;
+    float* pnlValue;
+    float* currentPrice;
+};
 
 // ساختار برای خلاصه پرتفولیو
-typedef struct {
+struct PortfolioTotals {
     float totalInvestment;
     float totalCurrentValue;
     float totalPnl;
@@ -51,16 +83,59 @@ typedef struct {
     float sharpeRatio;
     float avgPositionSize;
     float riskExposure;
-} PortfolioSummary;
+    float volatility;       // Std. deviation of per-parse returns, percent
+};
 
-// ساختار برای تاریخچه موقعیت
-typedef struct {
-    char symbol[16];
-    std::vector<float> priceHistory;
-    unsigned long lastUpdate;
-    float lastPrice;
-    float changePercent;
-} PositionHistory;
+// One published generation of a portfolio. Never written while a reader holds it.
+struct PortfolioSnapshot {
+    uint32_t generation;            // Increments on every publish; 0 = nothing published yet
+    unsigned long publishTime;
+    int count;
+    int capacity;                   // Positions the buffer holds, follows the portfolio's size
+    PortfolioTotals summary;
+    PositionRanking ranking;
+    uint32_t changed[CHANGED_SET_WORDS];    // Symbol IDs changed since the previous generation
+    PositionRecord* positions;      // [capacity], in PSRAM
+};
+
+// Working positions of every portfolio, in PSRAM when present. Each hot
+// field is a plane of its own and the PositionDetail records are one more.
+// A portfolio owns the same range in every plane, sized to its position
+// count and rounded up to POSITION_POOL_GRANULE; ranges are packed in
+// portfolio order, so a resize moves the ranges after it with one memmove
+// per plane. Parsing task only.
+class PositionPool {
+public:
+    PositionPool();
+    
+    bool begin(int size);
+    
+    // Ranges after owner move, so pointers into them are stale afterwards;
+    // owner's own range keeps its start. False when the pool is full.
+    bool reserve(uint8_t owner, int count);
+    void release(uint8_t owner);
+    
+    PositionColumns getColumns(uint8_t owner) const;
+    PositionDetail* getDetails(uint8_t owner) const;
+    int getCapacity(uint8_t owner) const;
+    int getUsed() const;
+    int getSize() const;
+    bool isInPSRAM() const;
+    
+private:
+    enum { PLANE_SYMBOL_ID, PLANE_CHANGE_PERCENT, PLANE_PNL_VALUE, PLANE_CURRENT_PRICE,
+           PLANE_DETAIL, PLANE_COUNT };
+    static const size_t PLANE_ELEMENT_SIZE[PLANE_COUNT];
+    
+    bool resize(uint8_t owner, int capacity);
+    void* plane(int index, uint8_t owner) const;
+    
+    uint8_t* _planes[PLANE_COUNT];
+    int _size;
+    bool _inPSRAM;
+    uint16_t _offset[PORTFOLIO_MAX];
+    uint16_t _capacity[PORTFOLIO_MAX];
+};
 
 class DataManager {
 public:
@@ -70,36 +145,71 @@ public:
     bool begin();
     void update();
     
+    // Portfolio table, read from ConfigManager. A reload is applied by the
+    // parsing task before its next fetch.
+    void requestPortfolioReload();
+    bool isPortfolioActive(uint8_t portfolio) const;
+    const PortfolioConfig& getPortfolioConfig(uint8_t portfolio) const;
+    const char* getPortfolioTag(uint8_t portfolio) const;
+    uint8_t findPortfolio(const String& tag) const;     // PORTFOLIO_ENTRY if unknown
+    
     // Data parsing
-    bool parsePortfolioData(const String& jsonData, bool isExitMode);
-    bool fetchData(bool isExitMode);
+    bool parsePortfolioData(const String& jsonData, uint8_t portfolio);
+    bool parsePortfolioStream(Stream& stream, uint8_t portfolio, bool isDelta = false);
+    
+    // Positions from another device (LanFanout followers), merged and
+    // published like a parse. Without isDelta, unlisted positions are closed.
+    bool applyPositions(uint8_t portfolio, const PositionRecord* positions, int count,
+                        const char* const* removed, int removedCount, bool isDelta);
+    bool fetchData(uint8_t portfolio);
     bool fetchAllData();
+    bool fetchDueData();        // Portfolios whose refresh interval has passed, by priority;
+                                // intervals are rounded up to whole fetch cycles
     
-    // Data access
-    const CryptoPosition* getPositions(bool isExitMode = false) const;
-    int getPositionCount(bool isExitMode = false) const;
-    const PortfolioSummary& getSummary(bool isExitMode = false) const;
-    CryptoPosition* getPosition(const char* symbol, bool isExitMode = false);
+    // Snapshot access for other tasks; see SnapshotReader
+    uint32_t getGeneration(uint8_t portfolio = PORTFOLIO_ENTRY) const;
     
-    // Data analysis
-    void sortPositionsByPNL(bool isExitMode, bool ascending = true);
-    CryptoPosition* getWorstPosition(bool isExitMode = false);
-    CryptoPosition* getBestPosition(bool isExitMode = false);
+    // Data access; parsing task only. Positions are the whole records of
+    // the last published snapshot, valid until the next parse. Summaries are
+    // derived from the running metrics on first read after a change.
+    const PositionRecord* getPositions(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    int getPositionCount(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    const PortfolioTotals& getSummary(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    const PositionRecord* getPosition(const char* symbol, uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    const PositionRecord* getPositionById(uint16_t symbolId, uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    
+    // Working set, split into hot columns and detail records; parsing task
+    // only, valid until the next parse. Slots match getPositions() once published.
+    PositionColumns getColumns(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    const PositionDetail* getDetails(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    int getWorkingCount(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    
+    // Data analysis; positions stay in their slots, order comes from the ranking
+    void updateRanking(uint8_t portfolio);
+    const PositionRanking& getRanking(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    int getRankedPositions(uint8_t portfolio, RankKey key, bool worstFirst,
+                           const PositionRecord** positions, int maxCount) const;
+    const PositionRecord* getWorstPosition(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    const PositionRecord* getBestPosition(uint8_t portfolio = PORTFOLIO_ENTRY) const;
     
     // Data management
     void clearAllData();
-    void clearData(bool isExitMode);
-    bool hasData(bool isExitMode = false) const;
+    void clearData(uint8_t portfolio);
+    bool hasData(uint8_t portfolio = PORTFOLIO_ENTRY) const;
     
     // History management
-    void updatePositionHistory(bool isExitMode);
+    void updatePositionHistory(uint8_t portfolio);
+    const PriceHistoryStore& getHistory(uint8_t portfolio = PORTFOLIO_ENTRY) const;
+    TimeSeriesLog& getHistoryLog(uint8_t portfolio = PORTFOLIO_ENTRY);
     
     // JSON output
-    String getDataJSON(bool isExitMode = false);
+    String getDataJSON(uint8_t portfolio = PORTFOLIO_ENTRY);
     
     // Utility
     unsigned long getLastUpdateTime() const;
-    void printSummary(bool isExitMode = false);
+    uint32_t getSnapshotsSkipped() const;
+    const PositionPool& getPool() const;
+    void printSummary(uint8_t portfolio = PORTFOLIO_ENTRY);
     bool isInitialized() const;
     
 private:
@@ -107,34 +217,119 @@ private:
     ~DataManager();
     
     static DataManager* _instance;
+    friend class SnapshotReader;
+    
+    // One row of the portfolio table; rows are taken in PSRAM at construction
+    // and their buffers are only allocated once the row is configured
+    struct Portfolio {
+        PortfolioConfig config;
+        char tag[PORTFOLIO_TAG_LENGTH];
+        bool active;
+        unsigned long lastFetch;        // 0 = not fetched since boot
+        unsigned long lastSnapshotSave; // 0 = totals not written to NVS since boot
+        PortfolioTotals savedTotals;    // Totals NVS holds
+        
+        // Positions are the row's range of the pool
+        int count;
+        mutable PortfolioTotals summary;
+        mutable uint32_t summaryGeneration;     // Metrics generation the summary reflects
+        bool serverTotals;                      // Totals came from the payload's summary
+        PortfolioMetrics metrics;
+        PositionRanking ranking;
+        uint8_t slotById[SYMBOL_TABLE_CAPACITY];        // Symbol ID -> slot; 0xFF = none
+        float priceById[SYMBOL_TABLE_CAPACITY];         // Last price reported to PositionEvents; 0 = none
+        uint32_t pendingChanged[CHANGED_SET_WORDS];     // Not yet in a published snapshot
+        
+        // History, one fixed ring per symbol ID
+        PriceHistoryStore history;
+        TimeSeriesLog log;              // Long-term history on the LittleFS partition
+        
+        // Published snapshots. The parsing task is the only writer; readers
+        // pin a buffer with a count instead of taking a lock.
+        PortfolioSnapshot* snapshots;
+        std::atomic<uint32_t> publishedIndex;
+        std::atomic<uint32_t> publishedGeneration;
+        std::atomic<uint32_t> snapshotReaders[SNAPSHOT_BUFFER_COUNT];
+    };
     
-    // Data storage
-    CryptoPosition _entryPositions[100];  // MAX_POSITIONS_PER_MODE
-    CryptoPosition _exitPositions[100];   // MAX_POSITIONS_PER_MODE
-    PortfolioSummary _entrySummary;
-    PortfolioSummary _exitSummary;
+    Portfolio* _portfolios;             // [PORTFOLIO_MAX]
+    PositionPool _pool;
+    std::atomic<bool> _reloadPending;
+    uint32_t _snapshotsSkipped;
     
-    // History
-    std::vector<PositionHistory> _entryPositionHistory;
-    std::vector<PositionHistory> _exitPositionHistory;
+    // Merge state of the parse in progress; one portfolio is parsed at a time
+    bool _slotLive[MAX_POSITIONS_PER_PORTFOLIO];    // Slot survives compaction
+    uint32_t _parseChanged[CHANGED_SET_WORDS];
+    uint16_t _parseRemoved[MAX_POSITIONS_PER_PORTFOLIO];    // Symbol IDs compaction dropped
+    int _parseRemovedCount;
+    float _mergeAlertThreshold;
+    float _mergeSevereThreshold;
     
     // State
     bool _initialized;
-    int _entryPositionCount;
-    int _exitPositionCount;
     unsigned long _lastUpdateTime;
     unsigned long _updateInterval;
+    bool _batchSupported;       // Cleared when the server has no batched endpoint
     
     // Preferences
     Preferences _prefs;
     
     // Helper methods
-    bool parsePosition(JsonObject& item, CryptoPosition& position);
-    void parseSummary(JsonObject& summary, bool isExitMode);
-    void calculateDerivedMetrics(bool isExitMode);
-    void saveDataSnapshot(bool isExitMode);
+    Portfolio& row(uint8_t portfolio);
+    const Portfolio& row(uint8_t portfolio) const;
+    void applyPortfolioConfig();
+    void activatePortfolio(uint8_t portfolio);
+    const PortfolioSnapshot* published(uint8_t portfolio) const;
+    int findSlot(uint16_t symbolId, const char* symbol, uint8_t portfolio) const;
+    int collectDue(bool force, uint8_t* order) const;
+    bool fetchPortfolios(bool force);
+    bool parsePosition(JsonObject& item, PositionRecord& position);
+    void parseSummary(JsonObject& summary, uint8_t portfolio);
+    void resetAlertState(PositionRecord& position);
+    bool parsePositionArray(Stream& stream, uint8_t portfolio, int& parsedCount);
+    bool parseRemovedSymbols(Stream& stream, uint8_t portfolio);
+    bool parseBatchStream(Stream& stream, const uint8_t* order, int count, bool isDelta,
+                          bool* updated);
+    void beginMerge(uint8_t portfolio, bool isDelta);
+    bool applyPosition(const PositionRecord& update, uint8_t portfolio);
+    bool mergePosition(uint8_t portfolio, int slot, const PositionRecord& update);
+    bool removePosition(const char* symbol, uint8_t portfolio);
+    void endMerge(uint8_t portfolio, bool complete);
+    void finishParse(uint8_t portfolio);
+    void markChanged(uint16_t symbolId);
+    void trackPosition(uint8_t portfolio, int slot);
+    void refreshSummary(uint8_t portfolio) const;
+    void rebuildSymbolIndex(uint8_t portfolio);
+    void publishPositionEvents(uint8_t portfolio);
+    void publishSnapshot(uint8_t portfolio);
+    const PortfolioSnapshot* acquireSnapshot(uint8_t portfolio, uint8_t& index);
+    void releaseSnapshot(uint8_t portfolio, uint8_t index);
+    void saveDataSnapshot(uint8_t portfolio);
     void loadHistoricalData();
-    void saveDetailedDataToFile(bool isExitMode);
+    void restoreHistory(uint8_t portfolio);
+    void saveDetailedDataToFile(uint8_t portfolio);
+};
+
+// Pins the latest snapshot of a portfolio for the reader's scope:
+//   SnapshotReader entry(PORTFOLIO_ENTRY);
+//   if (entry.isValid()) draw(entry->positions, entry->count);
+// Consistent for as long as the reader lives, and never blocks the parser.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(uint8_t portfolio);
+    ~SnapshotReader();
+    
+    bool isValid() const { return _snapshot != nullptr; }
+    const PortfolioSnapshot& operator*() const { return *_snapshot; }
+    const PortfolioSnapshot* operator->() const { return _snapshot; }
+    
+private:
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+    
+    const PortfolioSnapshot* _snapshot;
+    uint8_t _portfolio;
+    uint8_t _index;
 };
 
 #endif
\ No newline at end of file
@@ -1,9 +1,43 @@
 #include "DisplayManager.h"
 #include "SystemConfig.h"
-#include "CryptoData.h"
+#include "DataManager.h"
+#include "NumberFormat.h"
 #include <SPI.h>
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+
+// ===== RETAINED FIELD LAYOUT =====
+#define FIELD_TEXT_HEIGHT   8       // Built-in font at text size 1
+#define FIELD_POWER_WIDTH   60      // Battery icon plus percentage
+#define FIELD_POWER_HEIGHT  15
+#define FIELD_RSSI_WIDTH    20
+#define FIELD_RSSI_HEIGHT   12
+
+// ===== TICKER LAYOUT =====
+#define TICKER_TOP              22      // Title and column captions above
+#define TICKER_ROW_HEIGHT       12
+#define TICKER_TEXT_OFFSET      2       // Glyph row inside a ticker row
+#define TICKER_DEFAULT_SPEED    1       // Pixels per frame
+#define TICKER_MAX_SPEED        12
+
+// Field origins on the main screen, indexed by MainField
+static const int16_t FIELD_ORIGINS[][2] = {
+    {35, 35},                                   // WiFi SSID / state
+    {35, 55},                                   // Clock
+    {210, 32},                                  // Signal bars
+    {60, 90}, {120, 90}, {5, 105},              // Entry count, percent, value
+    {60, 140}, {120, 140}, {5, 155},            // Exit count, percent, value
+    {60, 180}, {150, 180},                      // Total value, percent
+    {5, 210}, {60, 210}, {120, 210}, {180, 210} // Status, power, volume, connection
+};
 
 DisplayManager::DisplayManager() : 
+    frameBuffer(&tft),
+    canvas(&tft),
+    frameBufferEnabled(false),
+    dmaAvailable(false),
+    pushPending(false),
+    dirtyCount(0),
     initialized(false), 
     backlightOn(true), 
     lastInteraction(millis()),
@@ -21,12 +55,25 @@ DisplayManager::DisplayManager() :
     pageChanged(false),
     fontSmall(nullptr),
     fontMedium(nullptr),
-    fontLarge(nullptr) {
+    fontLarge(nullptr),
+    layoutValid(false),
+    framePixels(0),
+    tickerCount(0),
+    tickerMode(0),
+    tickerValid(false),
+    tickerFingerprint(0),
+    tickerOffset(0),
+    tickerSpeed(TICKER_DEFAULT_SPEED) {
+    
+    dmaBuffers[0] = nullptr;
+    dmaBuffers[1] = nullptr;
     
     initColors();
+    resetFields();
 }
 
 DisplayManager::~DisplayManager() {
+    setFrameBufferEnabled(false);
     freeFontMemory();
 }
 
@@ -80,14 +127,85 @@ void DisplayManager::setBrightness(int level) {
 void DisplayManager::setRotation(uint8_t rot) {
     rotation = rot % 4;
     if (initialized) {
+        waitForPush();
         tft.setRotation(rotation);
+        layoutValid = false;
+        markDirty(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    }
+}
+
+bool DisplayManager::setFrameBufferEnabled(bool enable) {
+    if (enable == frameBufferEnabled) return true;
+    
+    waitForPush();
+    
+    if (!enable) {
+        frameBuffer.deleteSprite();
+        heap_caps_free(dmaBuffers[0]);
+        heap_caps_free(dmaBuffers[1]);
+        dmaBuffers[0] = nullptr;
+        dmaBuffers[1] = nullptr;
+        
+        canvas = &tft;
+        frameBufferEnabled = false;
+        layoutValid = false;
+        Serial.println("Display frame buffer disabled");
+        return true;
+    }
+    
+    if (!psramFound()) {
+        Serial.println("Display frame buffer needs PSRAM");
+        return false;
+    }
+    
+    // The sprite lives in PSRAM; DMA reads from two small internal bounce buffers
+    frameBuffer.setColorDepth(16);
+    frameBuffer.setAttribute(PSRAM_ENABLE, true);
+    if (!frameBuffer.createSprite(DISPLAY_WIDTH, DISPLAY_HEIGHT)) {
+        Serial.println("Failed to allocate display frame buffer");
+        return false;
+    }
+    
+    for (int i = 0; i < 2; i++) {
+        dmaBuffers[i] = (uint16_t*)heap_caps_malloc(DISPLAY_DMA_CHUNK_PIXELS * sizeof(uint16_t),
+                                                    MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
     }
+    if (!dmaBuffers[0] || !dmaBuffers[1]) {
+        Serial.println("Failed to allocate display DMA buffers");
+        heap_caps_free(dmaBuffers[0]);
+        heap_caps_free(dmaBuffers[1]);
+        dmaBuffers[0] = nullptr;
+        dmaBuffers[1] = nullptr;
+        frameBuffer.deleteSprite();
+        return false;
+    }
+    
+    if (!dmaAvailable) {
+        dmaAvailable = tft.initDMA();
+    }
+    
+    canvas = &frameBuffer;
+    frameBufferEnabled = true;
+    layoutValid = false;
+    
+    Serial.print("Display frame buffer enabled (");
+    Serial.print(DISPLAY_WIDTH * DISPLAY_HEIGHT * 2 / 1024);
+    Serial.println(dmaAvailable ? " KB PSRAM, DMA push)" : " KB PSRAM, blocking push)");
+    return true;
+}
+
+bool DisplayManager::isFrameBufferEnabled() const {
+    return frameBufferEnabled;
 }
 
 void DisplayManager::clear() {
     if (!initialized) return;
     
-    tft.fillScreen(colors.background);
+    canvas->fillScreen(colors.background);
+    markDirty(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    
+    // Whatever was retained is gone from the panel now
+    layoutValid = false;
 }
 
 void DisplayManager::setBacklight(bool on) {
@@ -105,9 +223,10 @@ void DisplayManager::setDefaultColorScheme() {
     colors.info = DisplayColors::LIGHT_BLUE;
     colors.header = DisplayColors::DARK_BLUE;
     colors.border = DisplayColors::MEDIUM_GREY;
+    layoutValid = false;
     
     if (initialized) {
-        tft.setTextColor(colors.text, colors.background);
+        canvas->setTextColor(colors.text, colors.background);
     }
 }
 
@@ -115,9 +234,9 @@ void DisplayManager::printText(int x, int y, const String& text,
                               uint16_t color, uint16_t bgColor) {
     if (!initialized || text.length() == 0) return;
     
-    tft.setTextColor(color, bgColor);
-    tft.setCursor(x, y);
-    tft.print(text);
+    canvas->setTextColor(color, bgColor);
+    canvas->setCursor(x, y);
+    canvas->print(text);
 }
 
 void DisplayManager::printCentered(int y, const String& text, 
@@ -137,8 +256,8 @@ void DisplayManager::drawProgressBar(int x, int y, int width, int height,
     percentage = constrain(percentage, 0.0, 100.0);
     
     // Draw background
-    tft.fillRect(x, y, width, height, bgColor);
-    tft.drawRect(x, y, width, height, colors.border);
+    canvas->fillRect(x, y, width, height, bgColor);
+    canvas->drawRect(x, y, width, height, colors.border);
     
     // Calculate fill width
     int fillWidth = (width - 2) * (percentage / 100.0);
@@ -146,7 +265,7 @@ void DisplayManager::drawProgressBar(int x, int y, int width, int height,
     
     // Draw fill
     if (fillWidth > 0) {
-        tft.fillRect(x + 1, y + 1, fillWidth, height - 2, color);
+        canvas->fillRect(x + 1, y + 1, fillWidth, height - 2, color);
     }
 }
 
@@ -156,8 +275,8 @@ void DisplayManager::drawBatteryIcon(int x, int y, int percent, bool charging) {
     percent = constrain(percent, 0, 100);
     
     // Battery body
-    tft.drawRect(x, y, 30, 15, colors.text);
-    tft.drawRect(x + 30, y + 4, 3, 7, colors.text);
+    canvas->drawRect(x, y, 30, 15, colors.text);
+    canvas->drawRect(x + 30, y + 4, 3, 7, colors.text);
     
     // Calculate fill
     int fillWidth = (28 * percent) / 100;
@@ -168,7 +287,7 @@ void DisplayManager::drawBatteryIcon(int x, int y, int percent, bool charging) {
     if (charging) {
         fillColor = DisplayColors::BATTERY_CHARGING;
     } else if (percent > 50) {
-        fillColor = DisplayColors::BATTERY_FULL;
+        fillColor = DisplayColors::BATTERY_HIGH;
     } else if (percent > 20) {
         fillColor = DisplayColors::BATTERY_MEDIUM;
     } else {
@@ -177,14 +296,14 @@ void DisplayManager::drawBatteryIcon(int x, int y, int percent, bool charging) {
     
     // Draw fill
     if (fillWidth > 0) {
-        tft.fillRect(x + 1, y + 1, fillWidth, 13, fillColor);
+        canvas->fillRect(x + 1, y + 1, fillWidth, 13, fillColor);
     }
     
     // Draw percentage text
     if (showDetails) {
-        tft.setTextColor(colors.text, colors.background);
-        tft.setCursor(x + 35, y + 4);
-        tft.print(String(percent) + "%");
+        canvas->setTextColor(colors.text, colors.background);
+        canvas->setCursor(x + 35, y + 4);
+        canvas->print(String(percent) + "%");
     }
 }
 
@@ -194,28 +313,31 @@ void DisplayManager::showSplashScreen() {
     clear();
     
     // Draw border
-    tft.drawRect(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1, colors.accent);
-    tft.drawRect(1, 1, DISPLAY_WIDTH - 3, DISPLAY_HEIGHT - 3, colors.info);
+    canvas->drawRect(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1, colors.accent);
+    canvas->drawRect(1, 1, DISPLAY_WIDTH - 3, DISPLAY_HEIGHT - 3, colors.info);
     
     // Title
-    tft.setTextColor(colors.accent, colors.background);
-    tft.setTextSize(3);
+    canvas->setTextColor(colors.accent, colors.background);
+    canvas->setTextSize(3);
     printCentered(40, "PORTFOLIO");
     printCentered(80, "MONITOR");
     
     // Version
-    tft.setTextColor(colors.info, colors.background);
-    tft.setTextSize(2);
+    canvas->setTextColor(colors.info, colors.background);
+    canvas->setTextSize(2);
     printCentered(120, "v4.5.3");
     
     // Hardware info
-    tft.setTextSize(1);
+    canvas->setTextSize(1);
     printCentered(150, "ESP32-WROVER-E");
     printCentered(170, "240x240 IPS + RGB LEDs");
     
     // Loading animation
+    presentFrame();
     for (int i = 0; i < DISPLAY_WIDTH; i += 10) {
-        tft.drawFastHLine(20, 200, i, colors.accent);
+        canvas->drawFastHLine(20, 200, i, colors.accent);
+        markDirty(20, 200, i, 1);
+        presentFrame();
         delay(10);
     }
     
@@ -223,63 +345,56 @@ void DisplayManager::showSplashScreen() {
     setMode(DISPLAY_MODE_MAIN);
 }
 
-void DisplayManager::showMainScreen(const SystemState& state, const CryptoData& data) {
+void DisplayManager::showMainScreen(const SystemState& state) {
     if (!initialized || currentMode != DISPLAY_MODE_MAIN) return;
     
-    clear();
+    framePixels = 0;
+    
+    // Static labels and separators are only drawn when the screen was cleared
+    if (!layoutValid || pageChanged) {
+        drawMainLayout();
+    }
     
     // Draw header
     drawMainHeader(state);
     
-    // Draw separator
-    drawSeparator(75);
-    
-    // Get portfolio summaries
-    const PortfolioSummary* entrySummary = data.getSummary(0);
-    const PortfolioSummary* exitSummary = data.getSummary(1);
+    // Get portfolio summaries; zeros until the first parse is published
+    static const PortfolioTotals noData = {};
+    SnapshotReader entry(PORTFOLIO_ENTRY);
+    SnapshotReader exit(PORTFOLIO_EXIT);
+    const PortfolioTotals& entrySummary = entry.isValid() ? entry->summary : noData;
+    const PortfolioTotals& exitSummary = exit.isValid() ? exit->summary : noData;
     
     // Draw entry section
-    drawEntrySection(90, *entrySummary, state);
-    
-    // Draw separator
-    drawSeparator(130);
+    drawEntrySection(90, entrySummary, state);
     
     // Draw exit section
-    drawExitSection(140, *exitSummary, state);
+    drawExitSection(140, exitSummary, state);
     
     // Draw total section
-    float totalValue = entrySummary->totalCurrentValue + exitSummary->totalCurrentValue;
-    float totalInvestment = entrySummary->totalInvestment + exitSummary->totalInvestment;
-    float totalPnLPercent = 0;
-    
-    if (totalInvestment > 0) {
-        totalPnLPercent = ((totalValue - totalInvestment) / totalInvestment) * 100;
-    }
-    
-    tft.setTextColor(colors.accent, colors.background);
-    tft.setTextSize(1);
-    tft.setCursor(5, 180);
-    tft.print("TOTAL:");
-    
-    tft.setTextColor(colors.text, colors.background);
-    tft.setCursor(60, 180);
-    tft.print("$" + formatNumber(totalValue));
-    
-    tft.setTextColor(totalPnLPercent >= 0 ? colors.positive : colors.negative, 
-                     colors.background);
-    tft.setCursor(150, 180);
-    tft.print(formatPercent(totalPnLPercent));
+    drawTotalSection(180, entrySummary, exitSummary, state);
     
     // Draw status bar
     drawStatusBar(state);
     
+    // Update render statistics
+    if (framePixels > 0) {
+        renderStats.framesRendered++;
+    } else {
+        renderStats.framesSkipped++;
+    }
+    renderStats.pixelsPushed += framePixels;
+    renderStats.lastFramePixels = framePixels;
+    
+    presentFrame();
+    
     // Record interaction for auto-dim
     recordInteraction();
 }
 
 void DisplayManager::showAlertScreen(const String& title, const String& symbol, 
                                     const String& message, float price, 
-                                    bool isSevere, byte mode) {
+                                    bool isSevere, byte mode, uint8_t portfolio) {
     if (!initialized) return;
     
     setMode(DISPLAY_MODE_ALERT);
@@ -287,38 +402,44 @@ void DisplayManager::showAlertScreen(const String& title, const String& symbol,
     
     // Set background color based on severity
     uint16_t bgColor = isSevere ? DisplayColors::ALERT_RED : DisplayColors::ALERT_ORANGE;
-    tft.fillRect(0, 0, DISPLAY_WIDTH, 50, bgColor);
+    canvas->fillRect(0, 0, DISPLAY_WIDTH, 50, bgColor);
     
     // Draw title
-    tft.setTextColor(DisplayColors::WHITE, bgColor);
-    tft.setTextSize(3);
+    canvas->setTextColor(DisplayColors::WHITE, bgColor);
+    canvas->setTextSize(3);
     printCentered(10, title);
     
     // Draw symbol
-    tft.setTextColor(DisplayColors::YELLOW, colors.background);
-    tft.setTextSize(4);
+    canvas->setTextColor(DisplayColors::YELLOW, colors.background);
+    canvas->setTextSize(4);
     printCentered(70, symbol);
     
     // Draw price
-    tft.setTextSize(3);
-    tft.setCursor(30, 120);
-    tft.print("$" + formatPrice(price));
+    char priceText[NUMBER_TEXT_LENGTH];
+    priceText[0] = '$';
+    NumberFormat::price(priceText + 1, sizeof(priceText) - 1, price);
+    canvas->setTextSize(3);
+    canvas->setCursor(30, 120);
+    canvas->print(priceText);
     
     // Draw message
-    tft.setTextColor(colors.text, colors.background);
-    tft.setTextSize(2);
+    canvas->setTextColor(colors.text, colors.background);
+    canvas->setTextSize(2);
     printCentered(160, message);
     
-    // Draw mode indicator
-    tft.setTextColor(mode == 0 ? colors.positive : colors.warning, colors.background);
-    tft.setTextSize(1);
-    tft.setCursor(5, 220);
-    tft.print(mode == 0 ? "ENTRY MODE" : "EXIT MODE");
+    // Draw the portfolio the alert came from, colored by its alert style
+    canvas->setTextColor(mode == 0 ? colors.positive : colors.warning, colors.background);
+    canvas->setTextSize(1);
+    canvas->setCursor(5, 220);
+    canvas->print(DataManager::getInstance().getPortfolioConfig(portfolio).name);
     
     // Draw auto-return countdown
-    tft.setTextColor(colors.info, colors.background);
-    tft.setCursor(150, 220);
-    tft.print("Auto-close: 8s");
+    canvas->setTextColor(colors.info, colors.background);
+    canvas->setCursor(150, 220);
+    canvas->print("Auto-close: 8s");
+    
+    // The whole alert is composed off-screen and appears in one push
+    presentFrame();
     
     modeStartTime = millis();
 }
@@ -326,7 +447,7 @@ void DisplayManager::showAlertScreen(const String& title, const String& symbol,
 void DisplayManager::update() {
     if (!initialized) return;
     
-    updateBlink();
+    updateBlinkState();
     handleAutoDim();
     
     // Check if alert screen should auto-return
@@ -335,201 +456,656 @@ void DisplayManager::update() {
     }
 }
 
-void DisplayManager::updateMainScreen(const SystemState& state, const CryptoData& data) {
+void DisplayManager::updateMainScreen(const SystemState& state) {
     if (currentMode == DISPLAY_MODE_MAIN) {
-        showMainScreen(state, data);
+        showMainScreen(state);
     }
 }
 
-void DisplayManager::drawMainHeader(const SystemState& state) {
+void DisplayManager::invalidateMainScreen() {
+    layoutValid = false;
+}
+
+void DisplayManager::drawMainLayout() {
+    clear();
+    resetFields();
+    
     // Title
-    tft.setTextColor(colors.accent, colors.background);
-    tft.setTextSize(2);
-    tft.setCursor(5, 5);
-    tft.print("PORTFOLIO");
+    canvas->setTextColor(colors.accent, colors.background);
+    canvas->setTextSize(2);
+    canvas->setCursor(5, 5);
+    canvas->print("PORTFOLIO");
     
-    // WiFi status
-    tft.setTextSize(1);
-    tft.setCursor(5, 35);
-    tft.print("WiFi:");
+    // Header labels
+    canvas->setTextSize(1);
+    canvas->setCursor(5, 35);
+    canvas->print("WiFi:");
+    
+    canvas->setTextColor(colors.info, colors.background);
+    canvas->setCursor(5, 55);
+    canvas->print("Time:");
     
+    drawSeparator(75);
+    
+    // Section labels
+    canvas->setTextColor(colors.positive, colors.background);
+    canvas->setCursor(5, 90);
+    canvas->print("ENTRY:");
+    
+    drawSeparator(130);
+    
+    canvas->setTextColor(colors.warning, colors.background);
+    canvas->setCursor(5, 140);
+    canvas->print("EXIT:");
+    
+    canvas->setTextColor(colors.accent, colors.background);
+    canvas->setCursor(5, 180);
+    canvas->print("TOTAL:");
+    
+    // Status bar line
+    canvas->drawFastHLine(0, 200, DISPLAY_WIDTH, colors.border);
+    
+    layoutValid = true;
+    pageChanged = false;
+    
+    renderStats.fullRedraws++;
+    framePixels += DISPLAY_WIDTH * DISPLAY_HEIGHT;
+}
+
+void DisplayManager::drawMainHeader(const SystemState& state) {
+    // WiFi status
     if (state.isConnectedToWiFi) {
-        tft.setTextColor(colors.positive, colors.background);
         String ssid = state.currentSSID.length() > 0 ? state.currentSSID : "Connected";
         if (ssid.length() > 12) {
             ssid = ssid.substring(0, 12) + "...";
         }
-        tft.setCursor(35, 35);
-        tft.print(ssid);
+        drawField(FIELD_WIFI, ssid, colors.positive);
     } else if (state.apModeActive) {
-        tft.setTextColor(colors.warning, colors.background);
-        tft.setCursor(35, 35);
-        tft.print("AP Mode");
+        drawField(FIELD_WIFI, "AP Mode", colors.warning);
     } else {
-        tft.setTextColor(colors.negative, colors.background);
-        tft.setCursor(35, 35);
-        tft.print("No WiFi");
+        drawField(FIELD_WIFI, "No WiFi", colors.negative);
     }
     
-    // Time
-    tft.setTextColor(colors.info, colors.background);
-    tft.setCursor(5, 55);
-    tft.print("Time:");
+    // Signal strength
+    int bars = 0;
+    if (state.isConnectedToWiFi) {
+        int rssi = WiFi.RSSI();
+        if (rssi >= -55) bars = 4;
+        else if (rssi >= -65) bars = 3;
+        else if (rssi >= -75) bars = 2;
+        else if (rssi >= -85) bars = 1;
+    }
+    
+    char rssiKey[2] = {(char)('0' + bars), '\0'};
+    if (fieldChanged(FIELD_RSSI, rssiKey, colors.positive)) {
+        RetainedField& field = fields[FIELD_RSSI];
+        canvas->fillRect(field.x, field.y, FIELD_RSSI_WIDTH, FIELD_RSSI_HEIGHT, colors.background);
+        drawSignalBars(field.x, field.y, bars, colors.positive);
+        commitField(FIELD_RSSI, rssiKey, colors.positive, FIELD_RSSI_WIDTH);
+    }
     
+    // Time
     if (state.currentDateTime.length() > 10) {
-        tft.setCursor(35, 55);
-        tft.print(state.currentDateTime.substring(11, 19));
+        drawField(FIELD_CLOCK, state.currentDateTime.substring(11, 19), colors.info);
     } else {
-        tft.setCursor(35, 55);
-        tft.print("--:--:--");
+        drawField(FIELD_CLOCK, "--:--:--", colors.info);
     }
 }
 
-void DisplayManager::drawEntrySection(int y, const PortfolioSummary& summary, 
+// "Val: $12.5K", or empty so the line is erased when details are turned off
+static void formatValueField(char* text, size_t size, float value, bool show) {
+    text[0] = '\0';
+    if (!show) return;
+    
+    size_t length = strlcpy(text, "Val: $", size);
+    NumberFormat::compact(text + length, size - length, value);
+}
+
+void DisplayManager::drawEntrySection(int y, const PortfolioTotals& summary, 
                                      const SystemState& state) {
-    tft.setTextColor(colors.positive, colors.background);
-    tft.setTextSize(1);
-    tft.setCursor(5, y);
-    tft.print("ENTRY:");
+    char text[DISPLAY_FIELD_LENGTH];
     
-    tft.setTextColor(colors.text, colors.background);
-    tft.setCursor(60, y);
-    tft.print(String(summary.totalPositions) + " pos");
+    snprintf(text, sizeof(text), "%d pos", summary.totalPositions);
+    drawField(FIELD_ENTRY_COUNT, text, colors.text);
     
-    tft.setTextColor(summary.totalPnlPercent >= 0 ? colors.positive : colors.negative, 
-                     colors.background);
-    tft.setCursor(120, y);
-    tft.print(formatPercent(summary.totalPnlPercent));
+    NumberFormat::percent(text, sizeof(text), summary.totalPnlPercent);
+    drawField(FIELD_ENTRY_PERCENT, text,
+              summary.totalPnlPercent >= 0 ? colors.positive : colors.negative);
     
-    if (showDetails) {
-        tft.setTextColor(colors.info, colors.background);
-        tft.setCursor(5, y + 15);
-        tft.print("Val: $" + formatNumber(summary.totalCurrentValue));
-    }
+    formatValueField(text, sizeof(text), summary.totalCurrentValue, showDetails);
+    drawField(FIELD_ENTRY_VALUE, text, colors.info);
 }
 
-void DisplayManager::drawExitSection(int y, const PortfolioSummary& summary, 
+void DisplayManager::drawExitSection(int y, const PortfolioTotals& summary, 
                                     const SystemState& state) {
-    tft.setTextColor(colors.warning, colors.background);
-    tft.setTextSize(1);
-    tft.setCursor(5, y);
-    tft.print("EXIT:");
+    char text[DISPLAY_FIELD_LENGTH];
     
-    tft.setTextColor(colors.text, colors.background);
-    tft.setCursor(60, y);
-    tft.print(String(summary.totalPositions) + " pos");
+    snprintf(text, sizeof(text), "%d pos", summary.totalPositions);
+    drawField(FIELD_EXIT_COUNT, text, colors.text);
     
-    tft.setTextColor(summary.totalPnlPercent >= 0 ? colors.positive : colors.negative, 
-                     colors.background);
-    tft.setCursor(120, y);
-    tft.print(formatPercent(summary.totalPnlPercent));
+    NumberFormat::percent(text, sizeof(text), summary.totalPnlPercent);
+    drawField(FIELD_EXIT_PERCENT, text,
+              summary.totalPnlPercent >= 0 ? colors.positive : colors.negative);
     
-    if (showDetails) {
-        tft.setTextColor(colors.info, colors.background);
-        tft.setCursor(5, y + 15);
-        tft.print("Val: $" + formatNumber(summary.totalCurrentValue));
+    formatValueField(text, sizeof(text), summary.totalCurrentValue, showDetails);
+    drawField(FIELD_EXIT_VALUE, text, colors.info);
+}
+
+void DisplayManager::drawTotalSection(int y, const PortfolioTotals& entry, 
+                                     const PortfolioTotals& exit, const SystemState& state) {
+    float totalValue = entry.totalCurrentValue + exit.totalCurrentValue;
+    float totalInvestment = entry.totalInvestment + exit.totalInvestment;
+    float totalPnLPercent = 0;
+    
+    if (totalInvestment > 0) {
+        totalPnLPercent = ((totalValue - totalInvestment) / totalInvestment) * 100;
     }
+    
+    char text[DISPLAY_FIELD_LENGTH];
+    text[0] = '$';
+    NumberFormat::compact(text + 1, sizeof(text) - 1, totalValue);
+    drawField(FIELD_TOTAL_VALUE, text, colors.text);
+    
+    NumberFormat::percent(text, sizeof(text), totalPnLPercent);
+    drawField(FIELD_TOTAL_PERCENT, text,
+              totalPnLPercent >= 0 ? colors.positive : colors.negative);
 }
 
 void DisplayManager::drawStatusBar(const SystemState& state) {
-    tft.drawFastHLine(0, 200, DISPLAY_WIDTH, colors.border);
-    
     // Alert status
     if (state.mode1GreenActive || state.mode1RedActive || 
         state.mode2GreenActive || state.mode2RedActive) {
-        tft.setTextColor(colors.warning, colors.background);
-        tft.setCursor(5, 210);
-        tft.print("ALERT!");
+        drawField(FIELD_STATUS, "ALERT!", colors.warning);
     } else if (state.connectionLost) {
-        tft.setTextColor(colors.negative, colors.background);
-        tft.setCursor(5, 210);
-        tft.print("NO CONN");
+        drawField(FIELD_STATUS, "NO CONN", colors.negative);
     } else {
-        tft.setTextColor(colors.positive, colors.background);
-        tft.setCursor(5, 210);
-        tft.print("READY");
+        drawField(FIELD_STATUS, "READY", colors.positive);
     }
     
-    // Power source
+    // Power source; the battery icon is repainted as one block
+    String powerKey;
     if (state.powerSource == POWER_SOURCE_USB) {
-        tft.setTextColor(colors.info, colors.background);
-        tft.setCursor(60, 210);
-        tft.print("USB");
+        powerKey = "USB";
     } else if (state.showBattery) {
-        drawBatteryIcon(60, 210, state.batteryPercent, false);
+        powerKey = "B" + String(state.batteryPercent);
+    }
+    
+    if (fieldChanged(FIELD_POWER, powerKey.c_str(), colors.info)) {
+        RetainedField& field = fields[FIELD_POWER];
+        canvas->fillRect(field.x, field.y, FIELD_POWER_WIDTH, FIELD_POWER_HEIGHT, colors.background);
+        
+        if (state.powerSource == POWER_SOURCE_USB) {
+            canvas->setTextColor(colors.info, colors.background);
+            canvas->setCursor(field.x, field.y);
+            canvas->print("USB");
+        } else if (state.showBattery) {
+            drawBatteryIcon(field.x, field.y, state.batteryPercent, false);
+        }
+        commitField(FIELD_POWER, powerKey.c_str(), colors.info, FIELD_POWER_WIDTH);
     }
     
     // Volume
-    tft.setTextColor(DisplayColors::MAGENTA, colors.background);
-    tft.setCursor(120, 210);
-    tft.print("Vol:" + String(state.buzzerVolume) + "%");
+    drawField(FIELD_VOLUME, "Vol:" + String(state.buzzerVolume) + "%", DisplayColors::MAGENTA);
     
     // Connection type
     if (state.apModeActive) {
-        tft.setTextColor(colors.warning, colors.background);
-        tft.setCursor(180, 210);
-        tft.print("AP");
+        drawField(FIELD_CONNECTION, "AP", colors.warning);
     } else if (state.isConnectedToWiFi) {
-        tft.setTextColor(colors.positive, colors.background);
-        tft.setCursor(180, 210);
-        tft.print("WiFi");
+        drawField(FIELD_CONNECTION, "WiFi", colors.positive);
     } else {
-        tft.setTextColor(colors.negative, colors.background);
-        tft.setCursor(180, 210);
-        tft.print("OFF");
+        drawField(FIELD_CONNECTION, "OFF", colors.negative);
+    }
+}
+
+// ===== TICKER VIEW =====
+static uint32_t hashBytes(uint32_t hash, const void* data, size_t length) {
+    // FNV-1a
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
     }
+    return hash;
+}
+
+static uint32_t hashTickerPosition(const PositionRecord& position) {
+    uint32_t hash = hashBytes(2166136261u, position.symbol, strnlen(position.symbol, sizeof(position.symbol)));
+    hash = hashBytes(hash, &position.changePercent, sizeof(position.changePercent));
+    hash = hashBytes(hash, &position.currentPrice, sizeof(position.currentPrice));
+    hash = hashBytes(hash, &position.pnlValue, sizeof(position.pnlValue));
+    return hash;
 }
 
-void DisplayManager::drawSeparator(int y) {
-    tft.drawFastHLine(0, y, DISPLAY_WIDTH, colors.border);
+static int tickerPriceDecimals(float price) {
+    // Price precision steps, capped to the width of the column
+    uint8_t decimals = NumberFormat::priceDecimals(price);
+    return decimals > 8 ? 8 : decimals;
 }
 
-String DisplayManager::formatNumber(float number, int decimals) {
-    if (number == 0) return "0";
+// Writes one right-aligned number column and the separator after it
+static size_t putTickerColumn(char* out, size_t size, float value, NumberSpec spec,
+                              uint8_t width, char separator) {
+    size_t length = NumberFormat::format(out, size, value, spec);
+    length = NumberFormat::alignRight(out, length, width, size);
+    if (separator && length + 1 < size) {
+        out[length++] = separator;
+        out[length] = '\0';
+    }
+    return length;
+}
+
+void DisplayManager::showTickerScreen(byte mode) {
+    if (!initialized) return;
     
-    float absNumber = fabs(number);
+    // Rendering happens in updateTickerScreen() from the mode's snapshot
+    tickerMode = mode;
+    tickerOffset = 0;
+    tickerValid = false;
+    layoutValid = false;
+    setMode(DISPLAY_MODE_TICKER);
+}
+
+void DisplayManager::updateTickerScreen() {
+    if (!initialized || currentMode != DISPLAY_MODE_TICKER) return;
+    
+    framePixels = 0;
+    
+    if (!layoutValid || pageChanged) {
+        clear();
+        tickerValid = false;
+        layoutValid = true;
+        pageChanged = false;
+        renderStats.fullRedraws++;
+        framePixels += DISPLAY_WIDTH * DISPLAY_HEIGHT;
+    }
+    
+    // Rows keep their own text, so the snapshot is only pinned while they are refreshed
+    bool changed;
+    {
+        SnapshotReader snapshot(tickerMode == 0 ? PORTFOLIO_ENTRY : PORTFOLIO_EXIT);
+        changed = snapshot.isValid() ? refreshTickerCache(snapshot->positions, snapshot->count)
+                                     : refreshTickerCache(nullptr, 0);
+    }
+    if (changed) {
+        drawTickerHeader();
+    }
+    
+    // Scroll only when the list does not fit; one blank row separates the wrap
+    int viewHeight = DISPLAY_HEIGHT - TICKER_TOP;
+    int cycleHeight = (tickerCount + 1) * TICKER_ROW_HEIGHT;
+    bool scrolling = tickerCount * TICKER_ROW_HEIGHT > viewHeight;
+    
+    if (scrolling) {
+        tickerOffset = (tickerOffset + tickerSpeed) % cycleHeight;
+    } else {
+        tickerOffset = 0;
+    }
     
-    if (absNumber >= 1000000) {
-        return String(number / 1000000, decimals) + "M";
-    } else if (absNumber >= 10000) {
-        return String(number / 1000, 1) + "K";
-    } else if (absNumber >= 1000) {
-        return String(number / 1000, 2) + "K";
-    } else if (absNumber >= 1) {
-        return String(number, decimals);
-    } else if (absNumber >= 0.01) {
-        return String(number, 4);
-    } else if (absNumber >= 0.0001) {
-        return String(number, 6);
+    if (scrolling || changed) {
+        drawTickerRows();
+        renderStats.framesRendered++;
     } else {
-        return String(number, 8);
+        renderStats.framesSkipped++;
     }
+    
+    renderStats.pixelsPushed += framePixels;
+    renderStats.lastFramePixels = framePixels;
+    
+    presentFrame();
 }
 
-String DisplayManager::formatPercent(float percent) {
-    if (percent > 0) {
-        return "+" + String(percent, 2) + "%";
-    } else if (percent < 0) {
-        return String(percent, 2) + "%";
-    } else {
-        return "0.00%";
+void DisplayManager::scrollTicker(int pixels) {
+    int cycleHeight = (tickerCount + 1) * TICKER_ROW_HEIGHT;
+    if (cycleHeight <= 0) return;
+    
+    tickerOffset = ((tickerOffset + pixels) % cycleHeight + cycleHeight) % cycleHeight;
+}
+
+void DisplayManager::setTickerSpeed(int pixelsPerFrame) {
+    tickerSpeed = constrain(pixelsPerFrame, 0, TICKER_MAX_SPEED);
+}
+
+byte DisplayManager::getTickerMode() const {
+    return tickerMode;
+}
+
+bool DisplayManager::refreshTickerCache(const PositionRecord* positions, int count) {
+    count = min(count, MAX_POSITIONS_PER_MODE);
+    
+    // Cheap change check; nothing is formatted unless a shown field moved
+    uint32_t fingerprint = hashBytes(2166136261u, &count, sizeof(count));
+    for (int i = 0; i < count; i++) {
+        uint32_t positionHash = hashTickerPosition(positions[i]);
+        fingerprint = hashBytes(fingerprint, &positionHash, sizeof(positionHash));
+    }
+    
+    if (tickerValid && fingerprint == tickerFingerprint) return false;
+    
+    // Worst first; the ranking only shifts the slots whose percent moved
+    if (!tickerValid) {
+        tickerRanking.clear();
+    }
+    tickerRanking.resize(count);
+    for (int i = 0; i < count; i++) {
+        tickerRanking.update(i, positions[i].changePercent, positions[i].pnlValue);
+    }
+    
+    // Rows whose content did not change keep their formatted text
+    for (int i = 0; i < count; i++) {
+        const PositionRecord& position = positions[tickerRanking.at(RANK_BY_CHANGE_PERCENT, i)];
+        uint32_t rowHash = hashTickerPosition(position);
+        TickerRow& row = tickerRows[i];
+        
+        if (tickerValid && i < tickerCount && row.fingerprint == rowHash) continue;
+        
+        formatTickerRow(row, position);
+        row.fingerprint = rowHash;
+        renderStats.tickerRowsFormatted++;
     }
+    
+    tickerCount = count;
+    tickerFingerprint = fingerprint;
+    tickerValid = true;
+    renderStats.tickerRefreshes++;
+    
+    return true;
+}
+
+void DisplayManager::formatTickerRow(TickerRow& row, const PositionRecord& position) const {
+    // "SYMBOL    +12.34%   123.4567    +56.78", columns as in drawTickerHeader()
+    size_t length = strnlen(position.symbol, 8);
+    memcpy(row.text, position.symbol, length);
+    memset(row.text + length, ' ', 9 - length);
+    length = 9;
+    
+    char* out = row.text;
+    length += putTickerColumn(out + length, sizeof(row.text) - length,
+                              position.changePercent, NumberSpecs::CHANGE, 7, '%');
+    if (length + 1 < sizeof(row.text)) out[length++] = ' ';
+    length += putTickerColumn(out + length, sizeof(row.text) - length, position.currentPrice,
+                              NumberSpec(tickerPriceDecimals(position.currentPrice)), 10, ' ');
+    length += putTickerColumn(out + length, sizeof(row.text) - length,
+                              position.pnlValue, NumberSpecs::CHANGE, 9, 0);
+    
+    // Pad to the full width so the opaque glyphs overwrite the previous row
+    for (int i = length; i < TICKER_ROW_LENGTH - 1; i++) {
+        row.text[i] = ' ';
+    }
+    row.text[TICKER_ROW_LENGTH - 1] = '\0';
+    
+    row.color = position.changePercent >= 0 ? colors.positive : colors.negative;
+}
+
+void DisplayManager::drawTickerHeader() {
+    char line[TICKER_ROW_LENGTH];
+    
+    canvas->fillRect(0, 0, DISPLAY_WIDTH, TICKER_TOP, colors.background);
+    canvas->setTextSize(1);
+    
+    // Title and position count
+    canvas->setTextColor(tickerMode == 0 ? colors.positive : colors.warning, colors.background);
+    canvas->setCursor(0, 1);
+    canvas->print(tickerMode == 0 ? "ENTRY POSITIONS" : "EXIT POSITIONS");
+    
+    snprintf(line, sizeof(line), "%d pos", tickerCount);
+    canvas->setTextColor(colors.text, colors.background);
+    canvas->setCursor(DISPLAY_WIDTH - strlen(line) * 6, 1);
+    canvas->print(line);
+    
+    // Column captions, aligned with formatTickerRow()
+    snprintf(line, sizeof(line), "%-8s %8s %10s %9s", "SYMBOL", "PNL%", "PRICE", "PNL$");
+    canvas->setTextColor(colors.info, colors.background);
+    canvas->setCursor(0, 11);
+    canvas->print(line);
+    
+    canvas->drawFastHLine(0, TICKER_TOP - 2, DISPLAY_WIDTH, colors.border);
+    
+    markDirty(0, 0, DISPLAY_WIDTH, TICKER_TOP);
+    framePixels += DISPLAY_WIDTH * TICKER_TOP;
+}
+
+void DisplayManager::drawTickerRows() {
+    int viewHeight = DISPLAY_HEIGHT - TICKER_TOP;
+    bool scrolling = tickerCount * TICKER_ROW_HEIGHT > viewHeight;
+    int cycleRows = tickerCount + 1;
+    
+    // Rows are clipped to the list area
+    canvas->setViewport(0, TICKER_TOP, DISPLAY_WIDTH, viewHeight);
+    canvas->setTextSize(1);
+    canvas->setTextWrap(false);
+    
+    int slot = tickerOffset / TICKER_ROW_HEIGHT;
+    for (int y = -(tickerOffset % TICKER_ROW_HEIGHT); y < viewHeight; y += TICKER_ROW_HEIGHT, slot++) {
+        int index = scrolling ? slot % cycleRows : slot;
+        
+        if (index >= tickerCount) {
+            // Wrap gap, or the empty space below a short list
+            canvas->fillRect(0, y, DISPLAY_WIDTH, scrolling ? TICKER_ROW_HEIGHT : viewHeight - y,
+                             colors.background);
+            if (!scrolling) break;
+            continue;
+        }
+        
+        const TickerRow& row = tickerRows[index];
+        int textBottom = TICKER_TEXT_OFFSET + FIELD_TEXT_HEIGHT;
+        
+        // Glyphs are opaque; only the spacing above and below needs a fill
+        canvas->fillRect(0, y, DISPLAY_WIDTH, TICKER_TEXT_OFFSET, colors.background);
+        canvas->fillRect(0, y + textBottom, DISPLAY_WIDTH, TICKER_ROW_HEIGHT - textBottom, colors.background);
+        canvas->setTextColor(row.color, colors.background);
+        canvas->setCursor(0, y + TICKER_TEXT_OFFSET);
+        canvas->print(row.text);
+    }
+    
+    canvas->setTextWrap(true);
+    canvas->resetViewport();
+    
+    markDirty(0, TICKER_TOP, DISPLAY_WIDTH, viewHeight);
+    framePixels += DISPLAY_WIDTH * viewHeight;
 }
 
-String DisplayManager::formatPrice(float price) {
-    if (price <= 0) return "0.00";
+// ===== FRAME BUFFER =====
+void DisplayManager::markDirty(int x, int y, int width, int height) {
+    if (!frameBufferEnabled) return;
+    
+    // Clip to the panel
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (x + width > DISPLAY_WIDTH) width = DISPLAY_WIDTH - x;
+    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
+    if (width <= 0 || height <= 0) return;
+    
+    if (dirtyCount < DISPLAY_MAX_DIRTY_RECTS) {
+        DirtyRect& rect = dirtyRects[dirtyCount++];
+        rect.x = x;
+        rect.y = y;
+        rect.width = width;
+        rect.height = height;
+        return;
+    }
     
-    if (price >= 1000) {
-        return String(price, 2);
-    } else if (price >= 1) {
-        return String(price, 4);
-    } else if (price >= 0.01) {
-        return String(price, 6);
-    } else if (price >= 0.0001) {
-        return String(price, 8);
+    // Out of slots: collapse everything into one bounding box
+    int x0 = x, y0 = y, x1 = x + width, y1 = y + height;
+    for (int i = 0; i < dirtyCount; i++) {
+        const DirtyRect& rect = dirtyRects[i];
+        x0 = min(x0, (int)rect.x);
+        y0 = min(y0, (int)rect.y);
+        x1 = max(x1, rect.x + rect.width);
+        y1 = max(y1, rect.y + rect.height);
+    }
+    dirtyRects[0].x = x0;
+    dirtyRects[0].y = y0;
+    dirtyRects[0].width = x1 - x0;
+    dirtyRects[0].height = y1 - y0;
+    dirtyCount = 1;
+}
+
+void DisplayManager::presentFrame() {
+    if (!frameBufferEnabled || dirtyCount == 0) return;
+    
+    // The previous transfer still owns a bounce buffer and the SPI bus
+    waitForPush();
+    
+    unsigned long start = micros();
+    const uint16_t* pixels = (const uint16_t*)frameBuffer.getPointer();
+    int current = 0;
+    
+    // Sprite memory is already in panel byte order
+    tft.setSwapBytes(false);
+    tft.startWrite();
+    
+    for (int i = 0; i < dirtyCount; i++) {
+        const DirtyRect& rect = dirtyRects[i];
+        int rowsPerChunk = max(1, DISPLAY_DMA_CHUNK_PIXELS / rect.width);
+        
+        for (int row = 0; row < rect.height; row += rowsPerChunk) {
+            int rows = min(rowsPerChunk, rect.height - row);
+            uint16_t* chunk = dmaBuffers[current];
+            
+            // Copy while the other buffer is still being sent
+            for (int r = 0; r < rows; r++) {
+                memcpy(chunk + r * rect.width,
+                       pixels + (rect.y + row + r) * DISPLAY_WIDTH + rect.x,
+                       rect.width * sizeof(uint16_t));
+            }
+            
+            if (dmaAvailable) {
+                tft.pushImageDMA(rect.x, rect.y + row, rect.width, rows, chunk);
+            } else {
+                tft.pushImage(rect.x, rect.y + row, rect.width, rows, chunk);
+            }
+            current ^= 1;
+        }
+    }
+    
+    if (dmaAvailable) {
+        // The last chunk finishes in the background; waitForPush() closes it
+        pushPending = true;
     } else {
-        return String(price, 10);
+        tft.endWrite();
+    }
+    
+    dirtyCount = 0;
+    
+    uint32_t pushTime = micros() - start;
+    renderStats.bufferPushes++;
+    renderStats.lastPushTimeUs = pushTime;
+    if (pushTime > renderStats.maxPushTimeUs) renderStats.maxPushTimeUs = pushTime;
+}
+
+void DisplayManager::waitForPush() {
+    if (!pushPending) return;
+    
+    tft.dmaWait();
+    tft.endWrite();
+    pushPending = false;
+}
+
+// ===== RETAINED FIELDS =====
+void DisplayManager::resetFields() {
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        RetainedField& field = fields[i];
+        field.x = FIELD_ORIGINS[i][0];
+        field.y = FIELD_ORIGINS[i][1];
+        field.width = 0;
+        field.height = FIELD_TEXT_HEIGHT;
+        field.color = 0;
+        field.valid = false;
+        field.text[0] = '\0';
     }
+    
+    fields[FIELD_POWER].height = FIELD_POWER_HEIGHT;
+    fields[FIELD_RSSI].height = FIELD_RSSI_HEIGHT;
+}
+
+bool DisplayManager::fieldChanged(MainField id, const char* key, uint16_t color) const {
+    const RetainedField& field = fields[id];
+    return !field.valid || field.color != color ||
+           strncmp(field.text, key, DISPLAY_FIELD_LENGTH) != 0;
+}
+
+void DisplayManager::commitField(MainField id, const char* key, uint16_t color, uint16_t width) {
+    RetainedField& field = fields[id];
+    
+    strncpy(field.text, key, DISPLAY_FIELD_LENGTH - 1);
+    field.text[DISPLAY_FIELD_LENGTH - 1] = '\0';
+    field.color = color;
+    field.width = width;
+    field.valid = true;
+    
+    markDirty(field.x, field.y, width, field.height);
+    framePixels += (uint32_t)width * field.height;
+    renderStats.fieldsRepainted++;
+}
+
+bool DisplayManager::drawField(MainField id, const String& text, uint16_t color) {
+    return drawField(id, text.c_str(), color);
+}
+
+bool DisplayManager::drawField(MainField id, const char* text, uint16_t color) {
+    if (!fieldChanged(id, text, color)) return false;
+    
+    RetainedField& field = fields[id];
+    uint16_t width = strlen(text) * 6;  // Same estimate as getTextWidth()
+    
+    // Glyphs are drawn with an opaque background, so only a longer old value
+    // leaves pixels behind
+    canvas->setTextColor(color, colors.background);
+    canvas->setTextSize(1);
+    canvas->setCursor(field.x, field.y);
+    canvas->print(text);
+    
+    uint16_t painted = width;
+    if (field.width > width) {
+        canvas->fillRect(field.x + width, field.y, field.width - width, field.height, colors.background);
+        markDirty(field.x + width, field.y, field.width - width, field.height);
+        painted = field.width;
+    }
+    
+    commitField(id, text, color, width);
+    
+    // Account for the erased tail as well
+    framePixels += (uint32_t)(painted - width) * field.height;
+    return true;
+}
+
+void DisplayManager::drawSeparator(int y, int margin) {
+    canvas->drawFastHLine(margin, y, DISPLAY_WIDTH - 2 * margin, colors.border);
+}
+
+void DisplayManager::drawSignalBars(int x, int y, int bars, uint16_t color) {
+    if (!initialized) return;
+    
+    // Four bars of rising height, unlit bars drawn as outlines
+    for (int i = 0; i < 4; i++) {
+        int barHeight = 3 * (i + 1);
+        int barX = x + i * 5;
+        int barY = y + FIELD_RSSI_HEIGHT - barHeight;
+        
+        if (i < bars) {
+            canvas->fillRect(barX, barY, 3, barHeight, color);
+        } else {
+            canvas->drawRect(barX, barY, 3, barHeight, colors.border);
+        }
+    }
+}
+
+// String forms of NumberFormat; the render paths write into buffers directly
+String DisplayManager::formatNumber(float number, int decimals) const {
+    char text[NUMBER_TEXT_LENGTH];
+    NumberFormat::compact(text, sizeof(text), number, decimals);
+    return String(text);
+}
+
+String DisplayManager::formatPercent(float percent) const {
+    char text[NUMBER_TEXT_LENGTH];
+    NumberFormat::percent(text, sizeof(text), percent);
+    return String(text);
+}
+
+String DisplayManager::formatPrice(float price) const {
+    char text[NUMBER_TEXT_LENGTH];
+    NumberFormat::price(text, sizeof(text), price);
+    return String(text);
 }
 
 void DisplayManager::recordInteraction() {
@@ -583,8 +1159,8 @@ void DisplayManager::showMessage(const String& line1, const String& line2,
     
     clear();
     
-    tft.setTextColor(colors.text, colors.background);
-    tft.setTextSize(2);
+    canvas->setTextColor(colors.text, colors.background);
+    canvas->setTextSize(2);
     
     if (line1.length() > 0) {
         printCentered(40, line1);
@@ -594,7 +1170,7 @@ void DisplayManager::showMessage(const String& line1, const String& line2,
         printCentered(80, line2);
     }
     
-    tft.setTextSize(1);
+    canvas->setTextSize(1);
     
     if (line3.length() > 0) {
         printCentered(130, line3);
@@ -604,6 +1180,7 @@ void DisplayManager::showMessage(const String& line1, const String& line2,
         printCentered(150, line4);
     }
     
+    presentFrame();
     recordInteraction();
 }
 
@@ -613,22 +1190,24 @@ void DisplayManager::showWarning(const String& title, const String& message) {
     clear();
     
     // Warning background
-    tft.fillRect(0, 0, DISPLAY_WIDTH, 50, DisplayColors::ALERT_ORANGE);
+    canvas->fillRect(0, 0, DISPLAY_WIDTH, 50, DisplayColors::ALERT_ORANGE);
     
     // Title
-    tft.setTextColor(DisplayColors::WHITE, DisplayColors::ALERT_ORANGE);
-    tft.setTextSize(3);
+    canvas->setTextColor(DisplayColors::WHITE, DisplayColors::ALERT_ORANGE);
+    canvas->setTextSize(3);
     printCentered(10, title);
     
     // Message
-    tft.setTextColor(colors.text, colors.background);
-    tft.setTextSize(2);
+    canvas->setTextColor(colors.text, colors.background);
+    canvas->setTextSize(2);
     printCentered(100, message);
     
     // Icon
-    tft.setTextSize(4);
+    canvas->setTextSize(4);
     printCentered(160, "⚠️");
     
+    presentFrame();
+    
     modeStartTime = millis();
     setMode(DISPLAY_MODE_ALERT);
 }
@@ -646,7 +1225,7 @@ void DisplayManager::freeFontMemory() {
     // Free any allocated font memory
 }
 
-void DisplayManager::updateBlink() {
+void DisplayManager::updateBlinkState() {
     unsigned long now = millis();
     if (now - lastBlinkTime > 500) {
         lastBlinkTime = now;
@@ -654,7 +1233,36 @@ void DisplayManager::updateBlink() {
     }
 }
 
-int DisplayManager::getTextWidth(const String& text) const {
+int DisplayManager::getTextWidth(const String& text, uint8_t font) const {
     // Simple estimation - in real implementation, use font metrics
     return text.length() * 6 * 1; // 6 pixels per char * text size
-}
\ No newline at end of file
+}
+
+// ===== RENDER STATISTICS =====
+const DisplayRenderStats& DisplayManager::getRenderStats() const {
+    return renderStats;
+}
+
+void DisplayManager::resetRenderStats() {
+    renderStats = DisplayRenderStats();
+}
+
+String DisplayManager::getRenderStatsJSON() const {
+    uint32_t frames = renderStats.framesRendered + renderStats.framesSkipped;
+    
+    String json = "{";
+    json += "\"frames_rendered\":" + String(renderStats.framesRendered) + ",";
+    json += "\"frames_skipped\":" + String(renderStats.framesSkipped) + ",";
+    json += "\"full_redraws\":" + String(renderStats.fullRedraws) + ",";
+    json += "\"fields_repainted\":" + String(renderStats.fieldsRepainted) + ",";
+    json += "\"pixels_pushed\":" + String(renderStats.pixelsPushed) + ",";
+    json += "\"last_frame_pixels\":" + String(renderStats.lastFramePixels) + ",";
+    json += "\"avg_frame_pixels\":" + String(frames > 0 ? renderStats.pixelsPushed / frames : 0) + ",";
+    json += "\"frame_buffer\":" + String(frameBufferEnabled ? "true" : "false") + ",";
+    json += "\"dma\":" + String(frameBufferEnabled && dmaAvailable ? "true" : "false") + ",";
+    json += "\"buffer_pushes\":" + String(renderStats.bufferPushes) + ",";
+    json += "\"last_push_us\":" + String(renderStats.lastPushTimeUs) + ",";
+    json += "\"max_push_us\":" + String(renderStats.maxPushTimeUs);
+    json += "}";
+    return json;
+}
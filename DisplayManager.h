@@ -5,14 +5,57 @@
 #include <SPI.h>
 #include <Arduino.h>
 #include "SystemConfig.h"
+#include "PositionRanking.h"
 
 // Forward declarations
-class CryptoData;
 struct SystemState;
+struct PortfolioTotals;
+struct PositionRecord;
+
+#define DISPLAY_FIELD_LENGTH 24
+#define DISPLAY_MAX_DIRTY_RECTS 16
+#define TICKER_ROW_LENGTH 41         // 40 columns at text size 1
+
+// Main screen rendering statistics
+struct DisplayRenderStats {
+    uint32_t framesRendered;     // Frames that repainted at least one field
+    uint32_t framesSkipped;      // Frames where nothing changed
+    uint32_t fullRedraws;        // Frames that cleared and rebuilt the layout
+    uint32_t fieldsRepainted;
+    uint32_t pixelsPushed;       // Pixels written to the panel by the main screen
+    uint32_t lastFramePixels;
+    uint32_t bufferPushes;       // Frame buffer transfers to the panel
+    uint32_t lastPushTimeUs;     // CPU time spent queueing the last transfer
+    uint32_t maxPushTimeUs;
+    uint32_t tickerRefreshes;    // Ticker cache rebuilds after a data change
+    uint32_t tickerRowsFormatted;
+    
+    DisplayRenderStats() : framesRendered(0), framesSkipped(0), fullRedraws(0),
+                           fieldsRepainted(0), pixelsPushed(0), lastFramePixels(0),
+                           bufferPushes(0), lastPushTimeUs(0), maxPushTimeUs(0),
+                           tickerRefreshes(0), tickerRowsFormatted(0) {}
+};
 
 class DisplayManager {
 private:
     TFT_eSPI tft;
+    
+    // Optional PSRAM frame buffer; canvas is the sprite when enabled, tft otherwise
+    TFT_eSprite frameBuffer;
+    TFT_eSPI* canvas;
+    bool frameBufferEnabled;
+    bool dmaAvailable;
+    bool pushPending;
+    uint16_t* dmaBuffers[2];
+    
+    struct DirtyRect {
+        int16_t x;
+        int16_t y;
+        int16_t width;
+        int16_t height;
+    };
+    DirtyRect dirtyRects[DISPLAY_MAX_DIRTY_RECTS];
+    uint8_t dirtyCount;
     bool initialized;
     bool backlightOn;
     unsigned long lastInteraction;
@@ -55,6 +98,57 @@ private:
         uint16_t border;
     } colors;
     
+    // Retained main screen fields; each one remembers what is on the panel
+    enum MainField : uint8_t {
+        FIELD_WIFI,
+        FIELD_CLOCK,
+        FIELD_RSSI,
+        FIELD_ENTRY_COUNT,
+        FIELD_ENTRY_PERCENT,
+        FIELD_ENTRY_VALUE,
+        FIELD_EXIT_COUNT,
+        FIELD_EXIT_PERCENT,
+        FIELD_EXIT_VALUE,
+        FIELD_TOTAL_VALUE,
+        FIELD_TOTAL_PERCENT,
+        FIELD_STATUS,
+        FIELD_POWER,
+        FIELD_VOLUME,
+        FIELD_CONNECTION,
+        FIELD_COUNT
+    };
+    
+    struct RetainedField {
+        int16_t x;
+        int16_t y;
+        uint16_t width;          // Width of the painted area
+        uint16_t height;
+        uint16_t color;
+        bool valid;
+        char text[DISPLAY_FIELD_LENGTH];
+    };
+    
+    RetainedField fields[FIELD_COUNT];
+    bool layoutValid;
+    uint32_t framePixels;
+    DisplayRenderStats renderStats;
+    
+    // Position ticker: rows are formatted once per data change, worst first
+    struct TickerRow {
+        char text[TICKER_ROW_LENGTH];
+        uint16_t color;
+        uint32_t fingerprint;    // Hash of the position fields in the text
+    };
+    
+    TickerRow tickerRows[MAX_POSITIONS_PER_MODE];
+    PositionRanking tickerRanking;
+    int tickerCount;
+    byte tickerMode;
+    bool tickerValid;
+    uint32_t tickerFingerprint;
+    int32_t tickerOffset;        // Scroll position in pixels
+    int tickerSpeed;             // Pixels per frame
+    
 public:
     DisplayManager();
     ~DisplayManager();
@@ -67,6 +161,8 @@ public:
     void setInvertColors(bool invert);
     void setShowDetails(bool show);
     void setTimeout(int milliseconds);
+    bool setFrameBufferEnabled(bool enable);
+    bool isFrameBufferEnabled() const;
     
     // ===== BASIC OPERATIONS =====
     void clear();
@@ -113,10 +209,10 @@ public:
     
     // ===== SCREEN MANAGEMENT =====
     void showSplashScreen();
-    void showMainScreen(const SystemState& state, const CryptoData& data);
+    void showMainScreen(const SystemState& state);
     void showAlertScreen(const String& title, const String& symbol, 
                         const String& message, float price, 
-                        bool isSevere, byte mode);
+                        bool isSevere, byte mode, uint8_t portfolio);
     void showConnectionScreen(const String& ssid, const String& status, 
                              int progress = -1);
     void showErrorScreen(const String& title, const String& message);
@@ -125,12 +221,25 @@ public:
                     const String& line3 = "", const String& line4 = "");
     void showWarning(const String& title, const String& message);
     void showSuccess(const String& title, const String& message);
+    void showTickerScreen(byte mode);
     
     // ===== UPDATE FUNCTIONS =====
     void update();
-    void updateMainScreen(const SystemState& state, const CryptoData& data);
+    void updateMainScreen(const SystemState& state);
     void updateAlertScreen(unsigned long displayStartTime);
     void updateConnectionScreen(const String& status, int progress);
+    void invalidateMainScreen();
+    void updateTickerScreen();     // Reads DataManager's published snapshots
+    
+    // ===== TICKER VIEW =====
+    void scrollTicker(int pixels);
+    void setTickerSpeed(int pixelsPerFrame);
+    byte getTickerMode() const;
+    
+    // ===== RENDER STATISTICS =====
+    const DisplayRenderStats& getRenderStats() const;
+    void resetRenderStats();
+    String getRenderStatsJSON() const;
     
     // ===== DATA DISPLAY FUNCTIONS =====
     void displayPortfolioSummary(const PortfolioSummary& summary, 
@@ -191,17 +300,35 @@ private:
     
     // Main screen components
     void drawMainHeader(const SystemState& state);
-    void drawMainContent(const SystemState& state, const CryptoData& data);
     void drawMainFooter(const SystemState& state);
     
-    void drawEntrySection(int y, const PortfolioSummary& summary, 
+    void drawEntrySection(int y, const PortfolioTotals& summary, 
                          const SystemState& state);
-    void drawExitSection(int y, const PortfolioSummary& summary, 
+    void drawExitSection(int y, const PortfolioTotals& summary, 
                         const SystemState& state);
-    void drawTotalSection(int y, const PortfolioSummary& entry, 
-                         const PortfolioSummary& exit, const SystemState& state);
+    void drawTotalSection(int y, const PortfolioTotals& entry, 
+                         const PortfolioTotals& exit, const SystemState& state);
     void drawStatusBar(const SystemState& state);
     
+    // Frame buffer helpers
+    void markDirty(int x, int y, int width, int height);
+    void presentFrame();
+    void waitForPush();
+    
+    // Retained-mode helpers
+    void drawMainLayout();
+    void resetFields();
+    bool drawField(MainField id, const char* text, uint16_t color);
+    bool drawField(MainField id, const String& text, uint16_t color);
+    bool fieldChanged(MainField id, const char* key, uint16_t color) const;
+    void commitField(MainField id, const char* key, uint16_t color, uint16_t width);
+    
+    // Ticker view components
+    void drawTickerHeader();
+    void drawTickerRows();
+    bool refreshTickerCache(const PositionRecord* positions, int count);
+    void formatTickerRow(TickerRow& row, const PositionRecord& position) const;
+    
     // Alert screen components
     void drawAlertHeader(const String& title, bool isSevere);
     void drawAlertContent(const String& symbol, const String& message, 
@@ -242,6 +369,11 @@ private:
 
 // Color definitions for easy access
 namespace DisplayColors {
+    // TFT_eSPI::color565 packing; there is no panel object at namespace scope
+    constexpr uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+    
     const uint16_t BLACK        = TFT_BLACK;
     const uint16_t WHITE        = TFT_WHITE;
     const uint16_t RED          = TFT_RED;
@@ -258,42 +390,42 @@ namespace DisplayColors {
     const uint16_t SILVER       = TFT_SILVER;
     
     // Custom colors
-    const uint16_t DARK_GREY    = tft.color565(64, 64, 64);
-    const uint16_t MEDIUM_GREY  = tft.color565(128, 128, 128);
-    const uint16_t LIGHT_GREY   = tft.color565(192, 192, 192);
-    const uint16_t DARK_BLUE    = tft.color565(0, 0, 128);
-    const uint16_t DARK_GREEN   = tft.color565(0, 128, 0);
-    const uint16_t DARK_RED     = tft.color565(128, 0, 0);
-    const uint16_t LIGHT_BLUE   = tft.color565(173, 216, 230);
-    const uint16_t LIGHT_GREEN  = tft.color565(144, 238, 144);
-    const uint16_t LIGHT_RED    = tft.color565(255, 182, 193);
-    const uint16_t TEAL         = tft.color565(0, 128, 128);
-    const uint16_t NAVY         = tft.color565(0, 0, 128);
-    const uint16_t MAROON       = tft.color565(128, 0, 0);
-    const uint16_t OLIVE        = tft.color565(128, 128, 0);
-    const uint16_t LIME         = tft.color565(0, 255, 0);
-    const uint16_t AQUA         = tft.color565(0, 255, 255);
-    const uint16_t FUCHSIA      = tft.color565(255, 0, 255);
+    const uint16_t DARK_GREY    = color565(64, 64, 64);
+    const uint16_t MEDIUM_GREY  = color565(128, 128, 128);
+    const uint16_t LIGHT_GREY   = color565(192, 192, 192);
+    const uint16_t DARK_BLUE    = color565(0, 0, 128);
+    const uint16_t DARK_GREEN   = color565(0, 128, 0);
+    const uint16_t DARK_RED     = color565(128, 0, 0);
+    const uint16_t LIGHT_BLUE   = color565(173, 216, 230);
+    const uint16_t LIGHT_GREEN  = color565(144, 238, 144);
+    const uint16_t LIGHT_RED    = color565(255, 182, 193);
+    const uint16_t TEAL         = color565(0, 128, 128);
+    const uint16_t NAVY         = color565(0, 0, 128);
+    const uint16_t MAROON       = color565(128, 0, 0);
+    const uint16_t OLIVE        = color565(128, 128, 0);
+    const uint16_t LIME         = color565(0, 255, 0);
+    const uint16_t AQUA         = color565(0, 255, 255);
+    const uint16_t FUCHSIA      = color565(255, 0, 255);
     
     // Alert colors
-    const uint16_t ALERT_RED    = tft.color565(255, 50, 50);
-    const uint16_t ALERT_GREEN  = tft.color565(50, 255, 50);
-    const uint16_t ALERT_YELLOW = tft.color565(255, 255, 50);
-    const uint16_t ALERT_ORANGE = tft.color565(255, 165, 0);
+    const uint16_t ALERT_RED    = color565(255, 50, 50);
+    const uint16_t ALERT_GREEN  = color565(50, 255, 50);
+    const uint16_t ALERT_YELLOW = color565(255, 255, 50);
+    const uint16_t ALERT_ORANGE = color565(255, 165, 0);
     
     // Portfolio colors
-    const uint16_t PROFIT_GREEN = tft.color565(0, 200, 0);
-    const uint16_t LOSS_RED     = tft.color565(200, 0, 0);
-    const uint16_t NEUTRAL_BLUE = tft.color565(0, 120, 255);
+    const uint16_t PROFIT_GREEN = color565(0, 200, 0);
+    const uint16_t LOSS_RED     = color565(200, 0, 0);
+    const uint16_t NEUTRAL_BLUE = color565(0, 120, 255);
     
     // Status colors
-    const uint16_t CONNECTED    = tft.color565(0, 200, 0);
-    const uint16_t DISCONNECTED = tft.color565(200, 0, 0);
-    const uint16_t CONNECTING   = tft.color565(255, 165, 0);
-    const uint16_t AP_MODE      = tft.color565(255, 255, 0);
+    const uint16_t CONNECTED    = color565(0, 200, 0);
+    const uint16_t DISCONNECTED = color565(200, 0, 0);
+    const uint16_t CONNECTING   = color565(255, 165, 0);
+    const uint16_t AP_MODE      = color565(255, 255, 0);
     
     // Battery colors
-    const uint16_t BATTERY_FULL    = GREEN;
+    const uint16_t BATTERY_HIGH    = GREEN;
     const uint16_t BATTERY_MEDIUM  = YELLOW;
     const uint16_t BATTERY_LOW     = ORANGE;
     const uint16_t BATTERY_CRITICAL = RED;
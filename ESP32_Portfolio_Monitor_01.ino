@@ -6,10 +6,10 @@
 
 #include <Arduino.h>
 #include "SystemConfig.h"
-#include "CryptoData.h"
+#include "DataManager.h"
+#include "ConfigManager.h"
 #include "DisplayManager.h"
 #include "AlertManager.h"
-#include "DataProcessor.h"
 #include "BuzzerManager.h"
 #include "LEDManager.h"
 #include "SettingsManager.h"
@@ -18,11 +18,18 @@
 #include "BatteryManager.h"
 #include "TimeManager.h"
 #include "APIManager.h"
+#include "TaskScheduler.h"
+#include "PowerManager.h"
+#include "MetricsRegistry.h"
+#include "CycleArena.h"
+#include "LanFanout.h"
+#ifdef PIPELINE_BENCHMARK
+#include "PipelineBenchmark.h"
+#endif
 
 // ===== GLOBAL OBJECTS =====
 DisplayManager displayMgr;
 AlertManager alertMgr;
-DataProcessor dataProcessor;
 BuzzerManager buzzerMgr;
 LEDManager ledMgr;
 SettingsManager settingsMgr;
@@ -30,14 +37,14 @@ WiFiManager wifiMgr;
 WebInterface webInterface;
 BatteryManager batteryMgr;
 TimeManager timeMgr;
-APIManager apiMgr;
 
 // ===== GLOBAL VARIABLES =====
 SystemSettings settings;
-CryptoData cryptoData;
 SystemState systemState;
 unsigned long systemStartTime = 0;
 bool apEnabled = true;
+int fetchTaskId = -1;
+int webTaskId = -1;
 
 // ===== FUNCTION PROTOTYPES =====
 void initializeSystem();
@@ -45,6 +52,11 @@ void updateSystem();
 void handleSystemEvents();
 void checkResetButton();
 void manageWiFiMode();
+void startScheduler();
+void cycleDisplayView();
+#ifdef PIPELINE_BENCHMARK
+void benchmarkRender(void* context);
+#endif
 
 // ===== SETUP =====
 void setup() {
@@ -67,6 +79,16 @@ void setup() {
     // Play startup tone
     buzzerMgr.playStartupTone();
     
+#ifdef PIPELINE_BENCHMARK
+    // Bench builds replay generated payloads before the tasks start
+    PipelineBenchmark benchmark;
+    benchmark.setRenderStage(benchmarkRender, nullptr);
+    benchmark.run();
+#endif
+    
+    // Hand the periodic work over to the scheduler
+    startScheduler();
+    
     Serial.println("\n✅ System initialized successfully!");
     Serial.println("Free Heap: " + String(ESP.getFreeHeap()) + " bytes");
     Serial.println("========================================");
@@ -74,76 +96,134 @@ void setup() {
 
 // ===== LOOP =====
 void loop() {
-    unsigned long currentTime = millis();
+    // All periodic work runs in scheduler tasks; loop only reports health
+    TaskScheduler::getInstance().update();
+    delay(100);
+}
+
+// ===== SCHEDULED TASKS =====
+// Network fetch/parse runs on core 0 so a slow API call never stalls
+// the web server, display or alerts on core 1.
+
+void fetchTask() {
+    if (!wifiMgr.isConnected()) return;
+    
+    // A live LAN leader fetches for this device
+    LanFanout& lan = LanFanout::getInstance();
+    if (!lan.shouldFetch()) return;
+    
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    PowerManager& power = PowerManager::getInstance();
+    power.beginFetch();
+    int64_t fetchStart = esp_timer_get_time();
+    
+    // Every due row of the portfolio table, batched into one conditional
+    // request and parsed off the socket. The parse publishes the snapshots
+    // the display and web server read, and the events alerts run on.
+    // Writers of the table hold the data lock; readers never take it.
+    bool updated = false;
+    if (scheduler.lockData()) {
+        updated = DataManager::getInstance().fetchDueData();
+        scheduler.unlockData();
+    }
+    if (updated) {
+        lan.publish();
+    }
     
-    // 1. Handle web server
-    webInterface.handleClient();
+    systemState.lastDataUpdate = millis();
+    power.endFetch();
     
-    // 2. Update WiFi
-    wifiMgr.update();
+    // Every document of this cycle is gone; hand the arena back in one step
+    CycleArena::get(ARENA_FETCH).reset();
     
-    // 3. Manage WiFi mode
+    // Requests can outlast the cycle counter; timed with esp_timer
+    static Metric* fetchTime = MetricsRegistry::getInstance().histogram(
+        "portfolio_fetch_seconds", "Fetch cycle of the due portfolios, including parse");
+    MetricsRegistry::observe(fetchTime, (uint32_t)(esp_timer_get_time() - fetchStart));
+}
+
+void wifiTask() {
+    wifiMgr.update();
     manageWiFiMode();
+    LanFanout::getInstance().update();
     
-    // 4. Check battery
-    if (currentTime - systemState.lastBatteryCheck > BATTERY_CHECK_INTERVAL) {
-        batteryMgr.checkBattery();
-        systemState.lastBatteryCheck = currentTime;
-    }
-    
-    // 5. Update time if connected
     if (wifiMgr.isConnected()) {
         timeMgr.update();
     }
     
-    // 6. Update data from API
-    if (wifiMgr.isConnected() && 
-        (currentTime - systemState.lastDataUpdate > DATA_UPDATE_INTERVAL)) {
-        
-        // Entry Mode data
-        if (strlen(settings.entryPortfolio) > 0) {
-            String data = apiMgr.fetchPortfolioData(0);
-            if (data != "{}") {
-                dataProcessor.parseData(data, 0);
-                cryptoData.calculatePortfolioSummary(0);
-            }
-        }
-        
-        // Exit Mode data
-        if (strlen(settings.exitPortfolio) > 0) {
-            String data = apiMgr.fetchPortfolioData(1);
-            if (data != "{}") {
-                dataProcessor.parseData(data, 1);
-                cryptoData.calculatePortfolioSummary(1);
-            }
-        }
-        
-        systemState.lastDataUpdate = currentTime;
-    }
+    // Radio sleep and task cadence follow the power state
+    PowerManager& power = PowerManager::getInstance();
+    power.update();
     
-    // 7. Check alerts
-    if (currentTime - systemState.lastAlertCheck > 5000) {
-        if (cryptoData.getCount(0) > 0) alertMgr.checkAlerts(0);
-        if (cryptoData.getCount(1) > 0) alertMgr.checkAlerts(1);
-        systemState.lastAlertCheck = currentTime;
-    }
-    
-    // 8. Update display
-    if (currentTime - systemState.lastDisplayUpdate > DISPLAY_UPDATE_INTERVAL) {
-        displayMgr.updateMainScreen(systemState, cryptoData);
-        systemState.lastDisplayUpdate = currentTime;
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    scheduler.setTaskPeriod(fetchTaskId, power.getFetchInterval());
+    scheduler.setTaskPeriod(webTaskId, power.getWebPollInterval());
+}
+
+void webTask() {
+    webInterface.handleClient();
+    CycleArena::get(ARENA_WEB).reset();
+}
+
+void displayTask() {
+    // Alerts are evaluated on the parser's change events; only the screen is shown here
+    alertMgr.updateAlertDisplay();
+    
+    // Runs at the ticker frame rate; the summary screen keeps its own interval
+    bool ticker = displayMgr.getMode() == DISPLAY_MODE_TICKER;
+    if (!ticker && millis() - systemState.lastDisplayUpdate < DISPLAY_UPDATE_INTERVAL) return;
+    
+    static Metric* tickerTime = MetricsRegistry::getInstance().histogram(
+        "display_render_seconds", "Screen update", "screen=\"ticker\"");
+    static Metric* mainTime = MetricsRegistry::getInstance().histogram(
+        "display_render_seconds", "Screen update", "screen=\"main\"");
+    
+    // Drawn from the published snapshots, so a fetch in progress never holds a frame back
+    {
+        MetricTimer timer(ticker ? tickerTime : mainTime);
+        if (ticker) {
+            displayMgr.updateTickerScreen();
+        } else {
+            displayMgr.updateMainScreen(systemState);
+        }
     }
     
-    // 9. Update LEDs
+    systemState.lastDisplayUpdate = millis();
+}
+
+void batteryTask() {
+    batteryMgr.checkBattery();
+    PowerManager::getInstance().setBatteryState(batteryMgr.getPercent(), batteryMgr.isCharging());
+    systemState.lastBatteryCheck = millis();
+}
+
+void uiTask() {
+    // The buzzer's LEDC output stops in light sleep
+    PowerManager::getInstance().setHoldAwake(buzzerMgr.isBusy());
     ledMgr.update(systemState);
-    
-    // 10. Check reset button
     checkResetButton();
-    
-    // 11. Handle system events
     handleSystemEvents();
+}
+
+void startScheduler() {
+    using namespace SchedulerConfig;
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    
+    scheduler.begin();
+    
+    //                name       period                   deadline priority core          stack
+    scheduler.addTask({"fetch",   DATA_UPDATE_INTERVAL,    12000,   1,       NETWORK_CORE, NETWORK_STACK_SIZE, fetchTask});
+    scheduler.addTask({"wifi",    100,                     50,      2,       NETWORK_CORE, 8192,               wifiTask});
+    scheduler.addTask({"web",     POWER_WEB_POLL_ACTIVE,   20,      3,       UI_CORE,      8192,               webTask});
+    scheduler.addTask({"display", TICKER_FRAME_INTERVAL,   30,      2,       UI_CORE,      DEFAULT_STACK_SIZE, displayTask});
+    scheduler.addTask({"ui",      20,                      10,      2,       UI_CORE,      DEFAULT_STACK_SIZE, uiTask});
+    scheduler.addTask({"battery", BATTERY_CHECK_INTERVAL,  100,     1,       UI_CORE,      DEFAULT_STACK_SIZE, batteryTask});
+    
+    fetchTaskId = scheduler.findTask("fetch");
+    webTaskId = scheduler.findTask("web");
     
-    delay(2);
+    scheduler.start();
+    Serial.println("⏱️ Scheduler running");
 }
 
 // ===== SYSTEM INITIALIZATION =====
@@ -158,6 +238,7 @@ void initializeSystem() {
     // 2. Initialize display
     Serial.print("  Initializing display... ");
     displayMgr.init(settings.displayBrightness, settings.displayRotation);
+    displayMgr.setFrameBufferEnabled(settings.displayFrameBuffer);
     Serial.println("✅");
     
     // 3. Initialize buzzer
@@ -179,8 +260,7 @@ void initializeSystem() {
     
     // 6. Initialize web interface
     Serial.print("  Initializing web interface... ");
-    webInterface.init(settings, wifiMgr, displayMgr, buzzerMgr, 
-                      cryptoData, systemState);
+    webInterface.init(settings, wifiMgr, displayMgr, buzzerMgr, systemState);
     Serial.println("✅");
     
     // 7. Initialize battery manager
@@ -195,12 +275,36 @@ void initializeSystem() {
     
     // 9. Initialize API manager
     Serial.print("  Initializing API manager... ");
-    apiMgr.init(settings);
+    APIManager::getInstance().begin();
     Serial.println("✅");
     
-    // 10. Initialize alert manager
+    // 10. Load the portfolio table; the fetch task parses into it
+    Serial.print("  Initializing data manager... ");
+    ConfigManager::getInstance().begin();
+    DataManager::getInstance().begin();
+    Serial.println("✅");
+    
+    // 11. Initialize alert manager
     Serial.print("  Initializing alert manager... ");
-    alertMgr.init(settings, buzzerMgr, cryptoData, displayMgr);
+    alertMgr.init(settings, buzzerMgr, displayMgr);
+    webInterface.attachAlerts(alertMgr);
+    Serial.println("✅");
+    
+    // 12. Initialize power scheduler
+    Serial.print("  Initializing power scheduler... ");
+    PowerManager::getInstance().begin(RESET_BUTTON_PIN);
+    PowerManager::getInstance().setBatteryState(batteryMgr.getPercent(), batteryMgr.isCharging());
+    Serial.println("✅");
+    
+    // 13. Reserve per-cycle arenas before any task allocates from them
+    Serial.print("  Reserving cycle arenas... ");
+    CycleArena::get(ARENA_FETCH).begin(ARENA_FETCH_SIZE);
+    CycleArena::get(ARENA_WEB).begin(ARENA_WEB_SIZE);
+    Serial.println("✅");
+    
+    // 14. Join the LAN fan-out group; role "off" keeps fetching directly
+    Serial.print("  Initializing LAN fan-out... ");
+    LanFanout::getInstance().begin(settings);
     Serial.println("✅");
     
     // Initialize system state
@@ -212,6 +316,8 @@ void initializeSystem() {
     systemState.isConnectedToWiFi = false;
     systemState.apModeActive = false;
     systemState.powerSource = POWER_SOURCE_USB;
+    systemState.showBattery = settings.showBattery;
+    systemState.buzzerVolume = settings.buzzerVolume;
     
     Serial.println("🎯 System initialization complete!");
 }
@@ -243,6 +349,7 @@ void handleSystemEvents() {
     // Update WiFi state in system state
     systemState.isConnectedToWiFi = currentConnectedState;
     systemState.apModeActive = wifiMgr.isAPActive();
+    systemState.currentSSID = wifiMgr.getCurrentSSID();
     
     // Check battery warning
     if (batteryMgr.isLow() && !systemState.batteryLow) {
@@ -288,7 +395,9 @@ void checkResetButton() {
             buttonPressed = false;
             unsigned long holdTime = millis() - pressStart;
             
-            if (holdTime > 500 && holdTime < 3000) {
+            if (holdTime > DEBOUNCE_DELAY && holdTime <= 500) {
+                cycleDisplayView();
+            } else if (holdTime > 500 && holdTime < 3000) {
                 Serial.println("\n🔄 Short press - Resetting alerts");
                 alertMgr.resetAll();
                 displayMgr.showMessage("ALERTS RESET", "All alerts cleared");
@@ -298,6 +407,26 @@ void checkResetButton() {
     }
 }
 
+// ===== DISPLAY VIEWS =====
+void cycleDisplayView() {
+    // Summary -> entry positions -> exit positions -> summary
+    if (displayMgr.getMode() != DISPLAY_MODE_TICKER) {
+        displayMgr.showTickerScreen(0);
+    } else if (displayMgr.getTickerMode() == 0) {
+        displayMgr.showTickerScreen(1);
+    } else {
+        displayMgr.setMode(DISPLAY_MODE_MAIN);
+        systemState.lastDisplayUpdate = 0;
+    }
+}
+
+#ifdef PIPELINE_BENCHMARK
+void benchmarkRender(void* context) {
+    // Replayed parses are published like fetched ones, so the ticker draws them
+    displayMgr.updateTickerScreen();
+}
+#endif
+
 // ===== WIFI MODE MANAGEMENT =====
 void manageWiFiMode() {
     static unsigned long lastCheck = 0;
@@ -347,8 +476,8 @@ void printSystemStatus() {
     Serial.println("  Free Heap: " + String(ESP.getFreeHeap()) + " bytes");
     Serial.println("  WiFi: " + String(systemState.isConnectedToWiFi ? "Connected" : "Disconnected"));
     Serial.println("  AP Mode: " + String(systemState.apModeActive ? "Active" : "Inactive"));
-    Serial.println("  Entry Positions: " + String(cryptoData.getCount(0)));
-    Serial.println("  Exit Positions: " + String(cryptoData.getCount(1)));
+    Serial.println("  Entry Positions: " + String(DataManager::getInstance().getPositionCount(PORTFOLIO_ENTRY)));
+    Serial.println("  Exit Positions: " + String(DataManager::getInstance().getPositionCount(PORTFOLIO_EXIT)));
     Serial.println("  Battery: " + String(batteryMgr.getPercent()) + "%");
     Serial.println("  Volume: " + String(settings.buzzerVolume) + "%");
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "HTTPBodyStream.h"
+
+// ===== CONSTANTS =====
+#define CHUNK_HEADER_MAX_LENGTH 32
+
+// ===== CONSTRUCTOR =====
+HTTPBodyStream::HTTPBodyStream(Stream& source, bool chunked, long contentLength)
+    : _source(source),
+      _chunked(chunked),
+      _remaining(chunked ? 0 : contentLength),
+      _chunkCRLFPending(false),
+      _eof(!chunked && contentLength == 0),
+      _complete(!chunked && contentLength == 0),
+      _bytesRead(0) {
+}
+
+// ===== STREAM INTERFACE =====
+int HTTPBodyStream::available() {
+    if (_eof) return 0;
+
+    int avail = _source.available();
+    if (_remaining > 0 && avail > _remaining) {
+        avail = _remaining;
+    }
+    return avail;
+}
+
+int HTTPBodyStream::read() {
+    if (!fill()) return -1;
+
+    int c = sourceRead();
+    if (c < 0) return -1;
+
+    _bytesRead++;
+    if (_remaining > 0) {
+        _remaining--;
+        if (_remaining == 0) {
+            if (_chunked) {
+                _chunkCRLFPending = true;
+            } else {
+                _eof = true;
+                _complete = true;
+            }
+        }
+    }
+    return c;
+}
+
+int HTTPBodyStream::peek() {
+    if (!fill()) return -1;
+    return sourcePeek();
+}
+
+bool HTTPBodyStream::drain() {
+    if (!isBounded()) return false;
+
+    while (!_eof && read() >= 0) {
+    }
+    return _complete;
+}
+
+// ===== CHUNK DECODING =====
+bool HTTPBodyStream::fill() {
+    if (_eof) return false;
+    if (_chunked && _remaining == 0) return readChunkHeader();
+    return true;
+}
+
+bool HTTPBodyStream::readChunkHeader() {
+    // Data of the previous chunk is followed by CRLF
+    if (_chunkCRLFPending) {
+        if (sourceRead() != '\r' || sourceRead() != '\n') {
+            _eof = true;
+            return false;
+        }
+        _chunkCRLFPending = false;
+    }
+
+    // "<hex size>[;extensions]\r\n"
+    char line[CHUNK_HEADER_MAX_LENGTH];
+    size_t len = 0;
+    while (true) {
+        int c = sourceRead();
+        if (c < 0) {
+            _eof = true;
+            return false;
+        }
+        if (c == '\n') break;
+        if (c != '\r' && len < sizeof(line) - 1) line[len++] = (char)c;
+    }
+    line[len] = '\0';
+
+    long size = strtol(line, nullptr, 16);
+    if (size > 0) {
+        _remaining = size;
+        return true;
+    }
+
+    // Last chunk: skip optional trailers up to the empty line
+    while (true) {
+        len = 0;
+        int c;
+        while ((c = sourceRead()) >= 0 && c != '\n') {
+            if (c != '\r') len++;
+        }
+        if (c < 0 || len == 0) break;
+    }
+
+    _eof = true;
+    _complete = true;
+    return false;
+}
+
+// ===== SOURCE ACCESS =====
+int HTTPBodyStream::sourceRead() {
+    unsigned long start = millis();
+    do {
+        int c = _source.read();
+        if (c >= 0) return c;
+        delay(1);
+    } while (millis() - start < _source.getTimeout());
+    return -1;
+}
+
+int HTTPBodyStream::sourcePeek() {
+    unsigned long start = millis();
+    do {
+        int c = _source.peek();
+        if (c >= 0) return c;
+        delay(1);
+    } while (millis() - start < _source.getTimeout());
+    return -1;
+}
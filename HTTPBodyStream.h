@@ -0,0 +1,44 @@
+#ifndef HTTP_BODY_STREAM_H
+#define HTTP_BODY_STREAM_H
+
+#include <Arduino.h>
+
+// Read-only view of one HTTP response body on a kept-alive connection.
+// Decodes chunked transfer encoding and stops at the end of the body, so the
+// socket is left positioned at the next response.
+class HTTPBodyStream : public Stream {
+public:
+    HTTPBodyStream(Stream& source, bool chunked, long contentLength);
+
+    // Stream interface
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t) override { return 0; }
+    void flush() override {}
+
+    // Discard the rest of the body; true if the end was reached cleanly
+    bool drain();
+
+    // True once the whole body has been consumed
+    bool isComplete() const { return _complete; }
+    // False for close-delimited bodies, which can never be drained
+    bool isBounded() const { return _chunked || _remaining >= 0; }
+    size_t getBytesRead() const { return _bytesRead; }
+
+private:
+    bool fill();
+    bool readChunkHeader();
+    int sourceRead();
+    int sourcePeek();
+
+    Stream& _source;
+    bool _chunked;
+    long _remaining;       // Bytes left in the body or current chunk; -1 = unknown
+    bool _chunkCRLFPending;
+    bool _eof;
+    bool _complete;
+    size_t _bytesRead;
+};
+
+#endif
@@ -1,6 +1,12 @@
 #include "LEDManager.h"
 #include "ConfigManager.h"
 #include <Arduino.h>
+#include <StreamString.h>
+
+// ===== CONSTANTS =====
+#define LED_PATTERN_ON_TIME 150     // Standard blink duration
+#define LED_PATTERN_GAP_TIME 100
+#define LED_PATTERN_REPEAT_GAP 300
 
 // ===== CONSTRUCTOR/DESTRUCTOR =====
 LEDManager::LEDManager() 
@@ -8,7 +14,8 @@ LEDManager::LEDManager()
       _mode2GreenState(false), _mode2RedState(false),
       _blinkState(false), _blinking(false),
       _lastBlinkTime(0), _blinkInterval(500),
-      _ledEnabled(true), _brightness(100) {
+      _ledEnabled(true), _brightness(100),
+      _alertTimeout(0), _patternActive(false) {
 }
 
 LEDManager::~LEDManager() {
@@ -32,6 +39,8 @@ void LEDManager::begin() {
     // Turn off all LEDs initially
     turnOffAll();
     
+    _sequencer.begin("leds", &LEDManager::sequencerOutput, this);
+    
     Serial.print("LEDs initialized: ");
     Serial.print(_ledEnabled ? "ENABLED" : "DISABLED");
     Serial.print(", Brightness: ");
@@ -44,6 +53,16 @@ void LEDManager::update() {
     
     unsigned long currentTime = millis();
     
+    // Patterns own the outputs while playing; restore state once done
+    if (_sequencer.isBusy()) {
+        _patternActive = true;
+        return;
+    }
+    if (_patternActive) {
+        _patternActive = false;
+        updateLEDOutputs();
+    }
+    
     // Handle blinking
     if (_blinking && (currentTime - _lastBlinkTime >= _blinkInterval)) {
         _blinkState = !_blinkState;
@@ -92,28 +111,19 @@ void LEDManager::setAlertLEDs(bool mode1Green, bool mode1Red,
 }
 
 void LEDManager::blinkLEDs(uint8_t pattern[], uint8_t patternLength, uint8_t repeats) {
-    if (!_ledEnabled) return;
+    if (!_ledEnabled || patternLength == 0) return;
     
-    for (uint8_t r = 0; r < repeats; r++) {
-        for (uint8_t i = 0; i < patternLength; i++) {
-            uint8_t ledMask = pattern[i];
-            
-            // Set LEDs based on pattern
-            digitalWrite(LED_MODE1_GREEN, (ledMask & 0x01) ? HIGH : LOW);
-            digitalWrite(LED_MODE1_RED, (ledMask & 0x02) ? HIGH : LOW);
-            digitalWrite(LED_MODE2_GREEN, (ledMask & 0x04) ? HIGH : LOW);
-            digitalWrite(LED_MODE2_RED, (ledMask & 0x08) ? HIGH : LOW);
-            
-            delay(150); // Standard blink duration
-            
-            // Turn off
-            turnOffAll();
-            
-            if (i < patternLength - 1) delay(100);
-        }
-        
-        if (r < repeats - 1) delay(300);
+    PatternStep steps[PATTERN_MAX_STEPS];
+    uint8_t stepCount = min<uint8_t>(patternLength, PATTERN_MAX_STEPS);
+    
+    for (uint8_t i = 0; i < stepCount; i++) {
+        steps[i].value = pattern[i];
+        steps[i].durationMs = LED_PATTERN_ON_TIME;
+        steps[i].pauseMs = (i < stepCount - 1) ? LED_PATTERN_GAP_TIME : LED_PATTERN_REPEAT_GAP;
     }
+    
+    // Played from the sequencer timer; returns immediately
+    _sequencer.enqueue(0, steps, stepCount, repeats);
 }
 
 void LEDManager::testSequence() {
@@ -121,33 +131,17 @@ void LEDManager::testSequence() {
     
     Serial.println("Testing LED sequence...");
     
-    // Turn on each LED individually
-    digitalWrite(LED_MODE1_GREEN, HIGH);
-    delay(300);
-    digitalWrite(LED_MODE1_GREEN, LOW);
-    
-    digitalWrite(LED_MODE1_RED, HIGH);
-    delay(300);
-    digitalWrite(LED_MODE1_RED, LOW);
-    
-    digitalWrite(LED_MODE2_GREEN, HIGH);
-    delay(300);
-    digitalWrite(LED_MODE2_GREEN, LOW);
-    
-    digitalWrite(LED_MODE2_RED, HIGH);
-    delay(300);
-    digitalWrite(LED_MODE2_RED, LOW);
-    
-    // All on
-    turnOnAll();
-    delay(500);
-    turnOffAll();
+    // Each LED individually, then all on
+    static const PatternStep testSteps[] = {
+        {0x01, 300, 0}, {0x02, 300, 0}, {0x04, 300, 0}, {0x08, 300, 0}, {0x0F, 500, 0}
+    };
+    _sequencer.enqueue(0, testSteps, sizeof(testSteps) / sizeof(testSteps[0]));
     
     // Pattern
     uint8_t testPattern[] = {0x01, 0x02, 0x04, 0x08, 0x0F};
     blinkLEDs(testPattern, 5, 2);
     
-    Serial.println("LED test complete");
+    Serial.println("LED test queued");
 }
 
 void LEDManager::turnOffAll() {
@@ -228,6 +222,16 @@ void LEDManager::updateLEDOutputs() {
     }
 }
 
+void LEDManager::sequencerOutput(uint16_t mask, void* context) {
+    LEDManager* self = static_cast<LEDManager*>(context);
+    uint8_t value = self->_ledEnabled ? map(self->_brightness, 0, 100, 0, 255) : 0;
+    
+    analogWrite(LED_MODE1_GREEN, (mask & 0x01) ? value : 0);
+    analogWrite(LED_MODE1_RED, (mask & 0x02) ? value : 0);
+    analogWrite(LED_MODE2_GREEN, (mask & 0x04) ? value : 0);
+    analogWrite(LED_MODE2_RED, (mask & 0x08) ? value : 0);
+}
+
 // ===== WEB INTERFACE HANDLERS =====
 void LEDManager::handleWebControl(const String& command, const String& params) {
     if (command == "test") {
@@ -252,19 +256,35 @@ void LEDManager::handleWebControl(const String& command, const String& params) {
 }
 
 String LEDManager::getStatusJSON() {
-    String json = "{";
-    json += "\"enabled\":" + String(_ledEnabled ? "true" : "false") + ",";
-    json += "\"brightness\":" + String(_brightness) + ",";
-    json += "\"blinking\":" + String(_blinking ? "true" : "false") + ",";
-    json += "\"mode1_green\":" + String(_mode1GreenState ? "true" : "false") + ",";
-    json += "\"mode1_red\":" + String(_mode1RedState ? "true" : "false") + ",";
-    json += "\"mode2_green\":" + String(_mode2GreenState ? "true" : "false") + ",";
-    json += "\"mode2_red\":" + String(_mode2RedState ? "true" : "false") + ",";
-    json += "\"alert_timeout\":" + String(_alertTimeout);
-    json += "}";
+    StreamString json;
+    printStatusJSON(json);
     return json;
 }
 
+void LEDManager::printStatusJSON(Print& out) {
+    out.print("{\"enabled\":");
+    out.print(_ledEnabled ? "true" : "false");
+    out.print(",\"brightness\":");
+    out.print(_brightness);
+    out.print(",\"blinking\":");
+    out.print(_blinking ? "true" : "false");
+    out.print(",\"mode1_green\":");
+    out.print(_mode1GreenState ? "true" : "false");
+    out.print(",\"mode1_red\":");
+    out.print(_mode1RedState ? "true" : "false");
+    out.print(",\"mode2_green\":");
+    out.print(_mode2GreenState ? "true" : "false");
+    out.print(",\"mode2_red\":");
+    out.print(_mode2RedState ? "true" : "false");
+    out.print(",\"alert_timeout\":");
+    out.print(_alertTimeout);
+    out.print(",\"pattern_active\":");
+    out.print(_sequencer.isBusy() ? "true" : "false");
+    out.print(",\"patterns_queued\":");
+    out.print(_sequencer.getQueueDepth());
+    out.print('}');
+}
+
 void LEDManager::parseParams(const String& paramsStr, int* params, uint8_t count) {
     int startIdx = 0;
     int endIdx = 0;
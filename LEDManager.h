@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "SystemConfig.h"
+#include "PatternSequencer.h"
 
 class LEDManager {
 private:
@@ -181,6 +182,8 @@ public:
     void updateBrightness();
     
     // ===== PRESET FUNCTIONS =====
+    // Non-blocking: pattern bits are M1 green, M1 red, M2 green, M2 red
+    void blinkLEDs(uint8_t pattern[], uint8_t patternLength, uint8_t repeats);
     void allOn();
     void allOff();
     void testSequence();
@@ -206,6 +209,10 @@ public:
     unsigned long getUptime() const;
     void resetStatistics();
     
+    // ===== WEB INTERFACE =====
+    String getStatusJSON();
+    void printStatusJSON(Print& out);      // Streams without building a String
+    
     // ===== DEBUG FUNCTIONS =====
     void printState() const;
     void testAllLEDs();
@@ -258,6 +265,11 @@ private:
     
     // Debug
     void logLEDState(const char* operation) const;
+    
+    // Timer-driven patterns
+    PatternSequencer _sequencer;
+    bool _patternActive;
+    static void sequencerOutput(uint16_t mask, void* context);
 };
 
 // Inline functions
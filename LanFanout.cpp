@@ -0,0 +1,668 @@
+#include "LanFanout.h"
+#include "SystemConfig.h"
+#include "ConfigManager.h"
+#include "DataManager.h"
+#include "PowerManager.h"
+#include "TaskScheduler.h"
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+#include <mbedtls/md.h>
+
+// ===== STATIC VARIABLES =====
+LanFanout* LanFanout::_instance = nullptr;
+
+static const IPAddress LAN_GROUP(239, 80, 77, 70);
+
+static const char* const ROLE_NAMES[LAN_ROLE_COUNT] = {"off", "auto", "leader", "follower"};
+static const char* const STATE_NAMES[LAN_STATE_COUNT] = {"standalone", "leading", "following"};
+
+static uint32_t heapCaps() {
+    return psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+}
+
+static uint32_t fnv1a(uint32_t hash, const char* text) {
+    while (*text) {
+        hash = (hash ^ (uint8_t)*text++) * 16777619u;
+    }
+    // Separator, so "ab"+"c" and "a"+"bc" differ
+    return (hash ^ 0xFF) * 16777619u;
+}
+
+static const LanEntry* findEntry(const LanEntry* entries, int count, const char* symbol) {
+    for (int i = 0; i < count; i++) {
+        if (strncmp(entries[i].symbol, symbol, sizeof(entries[i].symbol)) == 0) return &entries[i];
+    }
+    return nullptr;
+}
+
+static void toEntry(const PositionRecord& position, LanEntry& entry) {
+    // Zeroed first so entries compare with memcmp
+    memset(&entry, 0, sizeof(entry));
+    strlcpy(entry.symbol, position.symbol, sizeof(entry.symbol));
+    entry.changePercent = position.changePercent;
+    entry.pnlValue = position.pnlValue;
+    entry.quantity = position.quantity;
+    entry.entryPrice = position.entryPrice;
+    entry.currentPrice = position.currentPrice;
+    entry.flags = position.isLong ? LAN_ENTRY_LONG : 0;
+}
+
+static void toRecord(const LanEntry& entry, PositionRecord& position) {
+    memset(&position, 0, sizeof(position));
+    strlcpy(position.symbol, entry.symbol, sizeof(position.symbol));
+    position.symbolId = SYMBOL_ID_NONE;
+    position.changePercent = entry.changePercent;
+    position.pnlValue = entry.pnlValue;
+    position.quantity = entry.quantity;
+    position.entryPrice = entry.entryPrice;
+    position.currentPrice = entry.currentPrice;
+    position.isLong = entry.flags & LAN_ENTRY_LONG;
+}
+
+// ===== CONSTRUCTOR =====
+LanFanout::LanFanout()
+    : _initialized(false),
+      _role(LAN_ROLE_OFF),
+      _state(LAN_STATE_STANDALONE),
+      _lock(nullptr),
+      _socketOpen(false),
+      _deviceId(0),
+      _epoch(0),
+      _group(0),
+      _keyLength(0),
+      _claimDelay(0),
+      _leaderId(0),
+      _leaderEpoch(0),
+      _leaderInterval(0),
+      _lastLeaderFrame(0),
+      _lastHeartbeat(0),
+      _lastData(0),
+      _current(nullptr),
+      _delta(nullptr),
+      _records(nullptr),
+      _removed(nullptr) {
+    memset(_key, 0, sizeof(_key));
+    memset(_portfolios, 0, sizeof(_portfolios));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+// ===== INITIALIZATION =====
+bool LanFanout::begin(const SystemSettings& settings) {
+    if (_initialized) return true;
+
+    _lock = xSemaphoreCreateMutex();
+    if (!_lock) {
+        Serial.println("Failed to create LAN fan-out lock");
+        return false;
+    }
+
+    // Entry buffers for both roles, so a role change needs no allocation
+    uint32_t caps = heapCaps();
+    size_t size = LAN_MAX_POSITIONS * sizeof(LanEntry);
+    _current = (LanEntry*)heap_caps_calloc(1, size, caps);
+    _delta = (LanEntry*)heap_caps_calloc(1, size, caps);
+    _records = (PositionRecord*)heap_caps_calloc(LAN_MAX_POSITIONS, sizeof(PositionRecord), caps);
+    _removed = (const char**)heap_caps_calloc(LAN_MAX_POSITIONS, sizeof(const char*), caps);
+    bool allocated = _current && _delta && _records && _removed;
+    for (int i = 0; i < PORTFOLIO_MAX; i++) {
+        _portfolios[i].sent = (LanEntry*)heap_caps_calloc(1, size, caps);
+        _portfolios[i].staging = (LanEntry*)heap_caps_calloc(1, size, caps);
+        allocated = allocated && _portfolios[i].sent && _portfolios[i].staging;
+    }
+    if (!allocated) {
+        Serial.println("Failed to allocate LAN fan-out buffers");
+        heap_caps_free(_current);
+        heap_caps_free(_delta);
+        heap_caps_free(_records);
+        heap_caps_free(_removed);
+        for (int i = 0; i < PORTFOLIO_MAX; i++) {
+            heap_caps_free(_portfolios[i].sent);
+            heap_caps_free(_portfolios[i].staging);
+        }
+        memset(_portfolios, 0, sizeof(_portfolios));
+        _current = _delta = nullptr;
+        _records = nullptr;
+        _removed = nullptr;
+        return false;
+    }
+
+    _deviceId = (uint32_t)ESP.getEfuseMac();
+    _epoch = esp_random() | 1;
+
+    uint32_t group = 2166136261u;
+    group = fnv1a(group, settings.server);
+    group = fnv1a(group, settings.username);
+    DataManager& data = DataManager::getInstance();
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        group = fnv1a(group, data.isPortfolioActive(i) ? data.getPortfolioConfig(i).name : "");
+    }
+    _group = group;
+    _keyLength = strlcpy(_key, settings.userpass, sizeof(_key));
+    if (_keyLength >= sizeof(_key)) _keyLength = sizeof(_key) - 1;
+
+    uint8_t role = ConfigManager::getInstance().getUChar("lan_role", LAN_ROLE_OFF);
+    _role = role < LAN_ROLE_COUNT ? (LanRole)role : LAN_ROLE_OFF;
+
+    // Preferred leaders claim first; the device ID spreads the rest
+    _claimDelay = _deviceId % LAN_CLAIM_JITTER;
+    if (_role != LAN_ROLE_LEADER) _claimDelay += LAN_CLAIM_JITTER;
+
+    _initialized = true;
+
+    Serial.print("LAN fan-out initialized, role ");
+    Serial.println(getRoleName(_role));
+    return true;
+}
+
+void LanFanout::update() {
+    if (!_initialized) return;
+
+    xSemaphoreTake(_lock, portMAX_DELAY);
+
+    if (_role == LAN_ROLE_OFF || WiFi.status() != WL_CONNECTED) {
+        closeSocket();
+        setState(LAN_STATE_STANDALONE);
+        xSemaphoreGive(_lock);
+        return;
+    }
+
+    if (!_socketOpen) {
+        openSocket();
+    }
+    if (_socketOpen) {
+        receive();
+    }
+
+    unsigned long now = millis();
+    switch (_state) {
+        case LAN_STATE_FOLLOWING:
+            if (now - _lastLeaderFrame > LAN_LEADER_TIMEOUT) {
+                Serial.println("LAN leader silent, fetching directly");
+                _stats.fallbacks++;
+                setState(LAN_STATE_STANDALONE);
+            }
+            break;
+
+        case LAN_STATE_STANDALONE:
+            if (getRank() > 0 && _socketOpen && now - _lastLeaderFrame > LAN_LEADER_TIMEOUT + _claimDelay) {
+                becomeLeader();
+            }
+            break;
+
+        case LAN_STATE_LEADING:
+            if (getRank() == 0) {
+                // Role changed to follower
+                setState(LAN_STATE_STANDALONE);
+            } else if (now - _lastHeartbeat >= LAN_HEARTBEAT_INTERVAL) {
+                sendHeartbeat();
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    xSemaphoreGive(_lock);
+}
+
+// ===== FETCH TASK =====
+bool LanFanout::shouldFetch() const {
+    if (!_initialized || _state != LAN_STATE_FOLLOWING) return true;
+
+    // A leader that heartbeats but cannot reach the server is no source either
+    unsigned long lastData = _lastData;
+    uint32_t interval = max(_leaderInterval, (uint32_t)DATA_UPDATE_INTERVAL);
+    return lastData == 0 || millis() - lastData > LAN_DATA_TIMEOUT_CYCLES * interval;
+}
+
+void LanFanout::publish() {
+    if (!_initialized || _state != LAN_STATE_LEADING) return;
+
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        publishPortfolio(i);
+    }
+    xSemaphoreGive(_lock);
+}
+
+// Rows the fetch left alone go out as an empty delta, which still tells
+// followers the leader reaches the server
+void LanFanout::publishPortfolio(uint8_t portfolio) {
+    if (!DataManager::getInstance().isPortfolioActive(portfolio)) return;
+
+    // Copied from the published snapshot; the parser is never held up
+    int count;
+    {
+        SnapshotReader snapshot(portfolio);
+        if (!snapshot.isValid()) return;
+
+        count = min(snapshot->count, LAN_MAX_POSITIONS);
+        for (int i = 0; i < count; i++) {
+            toEntry(snapshot->positions[i], _current[i]);
+        }
+    }
+
+    PortfolioState& state = _portfolios[portfolio];
+    int changes = collectDelta(state, _current, count, _delta);
+
+    // A delta only pays while it is smaller than the portfolio
+    bool snapshot = state.snapshotDue || changes < 0 || changes >= count ||
+                    ++state.publishes >= LAN_SNAPSHOT_EVERY;
+    state.sequence++;
+    if (snapshot) {
+        sendFrames(LAN_FRAME_SNAPSHOT, portfolio, _current, count, state.sequence, 0);
+        state.publishes = 0;
+        state.snapshotDue = false;
+    } else {
+        sendFrames(LAN_FRAME_DELTA, portfolio, _delta, changes, state.sequence, state.sequence - 1);
+    }
+
+    memcpy(state.sent, _current, count * sizeof(LanEntry));
+    state.sentCount = count;
+}
+
+// Changed and new positions, then the removed ones flagged; -1 when the
+// delta would not fit in a snapshot's worth of entries
+int LanFanout::collectDelta(const PortfolioState& state, const LanEntry* current, int count,
+                            LanEntry* delta) const {
+    int changes = 0;
+
+    for (int i = 0; i < count; i++) {
+        const LanEntry* previous = findEntry(state.sent, state.sentCount, current[i].symbol);
+        if (previous && memcmp(previous, &current[i], sizeof(LanEntry)) == 0) continue;
+        if (changes >= LAN_MAX_POSITIONS) return -1;
+        delta[changes++] = current[i];
+    }
+
+    for (int i = 0; i < state.sentCount; i++) {
+        if (findEntry(current, count, state.sent[i].symbol)) continue;
+        if (changes >= LAN_MAX_POSITIONS) return -1;
+        delta[changes] = state.sent[i];
+        delta[changes++].flags |= LAN_ENTRY_REMOVED;
+    }
+
+    return changes;
+}
+
+// ===== ELECTION =====
+uint8_t LanFanout::getRank() const {
+    switch (_role) {
+        case LAN_ROLE_LEADER: return 2;
+        case LAN_ROLE_AUTO: return 1;
+        default: return 0;
+    }
+}
+
+bool LanFanout::outranks(uint8_t rank, uint32_t deviceId) const {
+    uint8_t own = getRank();
+    return rank > own || (rank == own && deviceId > _deviceId);
+}
+
+// True when the sender is, or has just become, the leader we follow
+bool LanFanout::acceptLeader(const LanFrameHeader& header) {
+    if (!outranks(header.rank, header.deviceId)) {
+        // A weaker device leads; take over, it yields on our first heartbeat
+        if (_state != LAN_STATE_LEADING && getRank() > 0) becomeLeader();
+        return false;
+    }
+
+    if (header.deviceId != _leaderId || header.epoch != _leaderEpoch) {
+        if (header.deviceId != _leaderId) {
+            _stats.leaderChanges++;
+            Serial.printf("LAN leader %08lx\n", (unsigned long)header.deviceId);
+        }
+        _leaderId = header.deviceId;
+        _leaderEpoch = header.epoch;
+        _lastData = 0;
+        for (int i = 0; i < PORTFOLIO_MAX; i++) {
+            _portfolios[i].applied = 0;
+            _portfolios[i].stagingSequence = 0;
+        }
+    }
+
+    _lastLeaderFrame = millis();
+    if (header.fetchInterval > 0) _leaderInterval = header.fetchInterval;
+    setState(LAN_STATE_FOLLOWING);
+    return true;
+}
+
+void LanFanout::becomeLeader() {
+    Serial.println("LAN fan-out leading");
+    _leaderId = _deviceId;
+    _leaderEpoch = _epoch;
+
+    // Followers may hold anything; the first publish of each portfolio is whole
+    for (int i = 0; i < PORTFOLIO_MAX; i++) {
+        _portfolios[i].snapshotDue = true;
+    }
+    setState(LAN_STATE_LEADING);
+    sendHeartbeat();
+}
+
+void LanFanout::setState(LanState state) {
+    if (_state == state) return;
+
+    if (state == LAN_STATE_STANDALONE) {
+        _leaderId = 0;
+        _lastData = 0;
+    }
+    _state = state;
+}
+
+// ===== SOCKET =====
+void LanFanout::openSocket() {
+    _socketOpen = _udp.beginMulticast(LAN_GROUP, LAN_PORT);
+    if (!_socketOpen) return;
+
+    // Listen for a full leader timeout before claiming
+    _lastLeaderFrame = millis();
+}
+
+void LanFanout::closeSocket() {
+    if (!_socketOpen) return;
+
+    _udp.stop();
+    _socketOpen = false;
+}
+
+void LanFanout::receive() {
+    for (int i = 0; i < LAN_MAX_PACKETS_PER_UPDATE; i++) {
+        int size = _udp.parsePacket();
+        if (size <= 0) return;
+
+        if (size > (int)sizeof(_packet)) {
+            _udp.flush();
+            _stats.framesRejected++;
+            continue;
+        }
+        int length = _udp.read(_packet, sizeof(_packet));
+        if (length > 0) handlePacket(length);
+    }
+}
+
+void LanFanout::handlePacket(size_t length) {
+    if (length < sizeof(LanFrameHeader) + LAN_TAG_LENGTH) {
+        _stats.framesRejected++;
+        return;
+    }
+
+    LanFrameHeader header;
+    memcpy(&header, _packet, sizeof(header));
+
+    // Multicast loops our own datagrams back
+    if (header.magic == LAN_MAGIC && header.deviceId == _deviceId) return;
+
+    size_t payload = sizeof(LanFrameHeader) + header.count * sizeof(LanEntry);
+    if (header.magic != LAN_MAGIC || header.version != LAN_VERSION || header.group != _group ||
+        header.portfolio >= PORTFOLIO_MAX || header.count > LAN_ENTRIES_PER_FRAME ||
+        length != payload + LAN_TAG_LENGTH) {
+        _stats.framesRejected++;
+        return;
+    }
+
+    // Constant-time compare; the tag is what keeps other networks' devices out
+    uint8_t tag[LAN_TAG_LENGTH];
+    computeTag(_packet, payload, tag);
+    uint8_t difference = 0;
+    for (int i = 0; i < LAN_TAG_LENGTH; i++) {
+        difference |= tag[i] ^ _packet[payload + i];
+    }
+    if (difference != 0) {
+        _stats.framesRejected++;
+        return;
+    }
+    _stats.framesReceived++;
+
+    switch (header.type) {
+        case LAN_FRAME_HEARTBEAT:
+            acceptLeader(header);
+            break;
+
+        case LAN_FRAME_SNAPSHOT:
+        case LAN_FRAME_DELTA:
+            if (acceptLeader(header)) {
+                stageFragment(header, (const LanEntry*)(_packet + sizeof(LanFrameHeader)));
+            }
+            break;
+
+        case LAN_FRAME_RESYNC: {
+            if (_state != LAN_STATE_LEADING) break;
+
+            // One snapshot per heartbeat answers every follower that missed the delta
+            PortfolioState& state = _portfolios[header.portfolio];
+            if (state.sequence > 0 && millis() - state.lastResync >= LAN_HEARTBEAT_INTERVAL) {
+                state.lastResync = millis();
+                sendFrames(LAN_FRAME_SNAPSHOT, header.portfolio, state.sent, state.sentCount,
+                           state.sequence, 0);
+            }
+            break;
+        }
+
+        default:
+            _stats.framesRejected++;
+            break;
+    }
+}
+
+// ===== FRAMES =====
+void LanFanout::fillHeader(LanFrameHeader& header, LanFrameType type, uint8_t portfolio) {
+    memset(&header, 0, sizeof(header));
+    header.magic = LAN_MAGIC;
+    header.version = LAN_VERSION;
+    header.type = type;
+    header.rank = getRank();
+    header.portfolio = portfolio;
+    header.deviceId = _deviceId;
+    header.epoch = _epoch;
+    header.group = _group;
+    header.fetchInterval = PowerManager::getInstance().getFetchInterval();
+}
+
+void LanFanout::computeTag(const uint8_t* data, size_t length, uint8_t* tag) const {
+    uint8_t digest[32];
+    mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), (const uint8_t*)_key, _keyLength,
+                    data, length, digest);
+    memcpy(tag, digest, LAN_TAG_LENGTH);
+}
+
+// _packet holds the header and entries; the tag is appended here
+bool LanFanout::sendPacket(size_t length) {
+    if (!_socketOpen) return false;
+
+    computeTag(_packet, length, _packet + length);
+    length += LAN_TAG_LENGTH;
+
+    if (!_udp.beginPacket(LAN_GROUP, LAN_PORT)) return false;
+    _udp.write(_packet, length);
+    if (!_udp.endPacket()) return false;
+
+    _stats.framesSent++;
+    _stats.bytesSent += length;
+    return true;
+}
+
+void LanFanout::sendHeartbeat() {
+    LanFrameHeader header;
+    fillHeader(header, LAN_FRAME_HEARTBEAT, 0);
+    header.fragments = 1;
+    memcpy(_packet, &header, sizeof(header));
+
+    sendPacket(sizeof(header));
+    _lastHeartbeat = millis();
+}
+
+void LanFanout::sendFrames(LanFrameType type, uint8_t portfolio, const LanEntry* entries, int total,
+                           uint32_t sequence, uint32_t base) {
+    // An empty frame still goes out: it empties a snapshot or confirms a sequence
+    int fragments = max(1, (int)((total + LAN_ENTRIES_PER_FRAME - 1) / LAN_ENTRIES_PER_FRAME));
+
+    for (int f = 0; f < fragments; f++) {
+        int first = f * LAN_ENTRIES_PER_FRAME;
+        int count = min((int)LAN_ENTRIES_PER_FRAME, total - first);
+
+        LanFrameHeader header;
+        fillHeader(header, type, portfolio);
+        header.sequence = sequence;
+        header.base = base;
+        header.total = total;
+        header.fragment = f;
+        header.fragments = fragments;
+        header.count = count;
+
+        memcpy(_packet, &header, sizeof(header));
+        memcpy(_packet + sizeof(header), &entries[first], count * sizeof(LanEntry));
+        sendPacket(sizeof(header) + count * sizeof(LanEntry));
+    }
+
+    // Data frames double as heartbeats
+    _lastHeartbeat = millis();
+}
+
+void LanFanout::requestResync(uint8_t portfolio) {
+    PortfolioState& state = _portfolios[portfolio];
+    if (state.lastResyncRequest && millis() - state.lastResyncRequest < LAN_HEARTBEAT_INTERVAL) return;
+    state.lastResyncRequest = millis();
+    _stats.resyncRequests++;
+
+    LanFrameHeader header;
+    fillHeader(header, LAN_FRAME_RESYNC, portfolio);
+    header.fragments = 1;
+    memcpy(_packet, &header, sizeof(header));
+    sendPacket(sizeof(header));
+}
+
+// ===== FOLLOWER =====
+void LanFanout::stageFragment(const LanFrameHeader& header, const LanEntry* entries) {
+    PortfolioState& state = _portfolios[header.portfolio];
+
+    // Snapshots older than what is held are replays or late duplicates
+    if (header.type == LAN_FRAME_SNAPSHOT && state.applied && header.sequence < state.applied) return;
+
+    if (header.total > LAN_MAX_POSITIONS || header.fragments == 0 ||
+        header.fragments > LAN_MAX_FRAGMENTS || header.fragment >= header.fragments ||
+        header.fragment * LAN_ENTRIES_PER_FRAME + header.count > header.total) {
+        _stats.framesRejected++;
+        return;
+    }
+
+    // A new frame abandons a partial one; a missed delta shows up as a base mismatch
+    if (header.sequence != state.stagingSequence || header.type != state.stagingType ||
+        header.total != state.stagingTotal || header.fragments != state.stagingFragments) {
+        state.stagingSequence = header.sequence;
+        state.stagingType = header.type;
+        state.stagingBase = header.base;
+        state.stagingTotal = header.total;
+        state.stagingFragments = header.fragments;
+        state.stagingReceived = 0;
+    }
+
+    memcpy(&state.staging[header.fragment * LAN_ENTRIES_PER_FRAME], entries, header.count * sizeof(LanEntry));
+    state.stagingReceived |= 1UL << header.fragment;
+
+    uint32_t complete = (1UL << state.stagingFragments) - 1;
+    if (state.stagingReceived != complete) return;
+
+    // A frame that could not be applied leaves "applied" behind, so the
+    // next delta asks for a snapshot
+    if (state.stagingType == LAN_FRAME_DELTA && state.applied != state.stagingBase) {
+        requestResync(header.portfolio);
+    } else {
+        applyFrame(header.portfolio);
+    }
+    state.stagingSequence = 0;
+}
+
+bool LanFanout::applyFrame(uint8_t portfolio) {
+    PortfolioState& state = _portfolios[portfolio];
+    LanEntry* entries = state.staging;
+    int count = state.stagingTotal;
+    bool isDelta = state.stagingType == LAN_FRAME_DELTA;
+
+    // A snapshot is the whole portfolio, so it carries no removals
+    int positions = 0;
+    int removed = 0;
+    for (int i = 0; i < count; i++) {
+        entries[i].symbol[sizeof(entries[i].symbol) - 1] = '\0';
+        if (entries[i].flags & LAN_ENTRY_REMOVED) {
+            if (isDelta) _removed[removed++] = entries[i].symbol;
+        } else {
+            toRecord(entries[i], _records[positions++]);
+        }
+    }
+
+    // Merged like a parse: alert state survives, events and history follow
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    if (!scheduler.lockData(LAN_APPLY_LOCK_TIMEOUT)) return false;
+    bool applied = DataManager::getInstance().applyPositions(portfolio, _records, positions,
+                                                             _removed, removed, isDelta);
+    scheduler.unlockData();
+    if (!applied) return false;
+
+    if (isDelta) {
+        _stats.deltasApplied++;
+    } else {
+        _stats.snapshotsApplied++;
+    }
+    state.applied = state.stagingSequence;
+    _lastData = millis();
+    return true;
+}
+
+// ===== SETTINGS =====
+LanRole LanFanout::getRole() const {
+    return _role;
+}
+
+void LanFanout::setRole(LanRole role) {
+    if (role >= LAN_ROLE_COUNT) return;
+
+    _role = role;
+    _claimDelay = _deviceId % LAN_CLAIM_JITTER;
+    if (role != LAN_ROLE_LEADER) _claimDelay += LAN_CLAIM_JITTER;
+    ConfigManager::getInstance().putUChar("lan_role", role);
+}
+
+const char* LanFanout::getRoleName(LanRole role) {
+    return role < LAN_ROLE_COUNT ? ROLE_NAMES[role] : "unknown";
+}
+
+LanRole LanFanout::findRole(const String& name) {
+    for (int i = 0; i < LAN_ROLE_COUNT; i++) {
+        if (name == ROLE_NAMES[i]) return (LanRole)i;
+    }
+    return LAN_ROLE_COUNT;
+}
+
+// ===== STATUS =====
+LanState LanFanout::getState() const {
+    return _state;
+}
+
+const char* LanFanout::getStateName(LanState state) {
+    return state < LAN_STATE_COUNT ? STATE_NAMES[state] : "unknown";
+}
+
+uint32_t LanFanout::getDeviceId() const {
+    return _deviceId;
+}
+
+uint32_t LanFanout::getLeaderId() const {
+    return _leaderId;
+}
+
+unsigned long LanFanout::getDataAge() const {
+    unsigned long lastData = _lastData;
+    return lastData ? millis() - lastData : 0;
+}
+
+LanStats LanFanout::getStats() const {
+    return _stats;
+}
+
+// ===== STATIC ACCESS =====
+LanFanout& LanFanout::getInstance() {
+    if (!_instance) {
+        _instance = new LanFanout();
+    }
+    return *_instance;
+}
@@ -0,0 +1,227 @@
+#ifndef LAN_FANOUT_H
+#define LAN_FANOUT_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "PortfolioTable.h"
+
+struct PositionRecord;
+struct SystemSettings;
+
+// Transport
+#define LAN_PORT 47800
+#define LAN_MAGIC 0x464C4D50                    // "PMLF"
+#define LAN_VERSION 2                           // 2: frames carry a portfolio table row
+#define LAN_PACKET_SIZE 1400                    // Stays below the WiFi MTU, no IP fragmentation
+#define LAN_TAG_LENGTH 8                        // Truncated HMAC-SHA256
+#define LAN_MAX_PACKETS_PER_UPDATE 8
+
+// Election and fallback
+#define LAN_HEARTBEAT_INTERVAL 2000
+#define LAN_LEADER_TIMEOUT 7000                 // Three missed heartbeats
+#define LAN_CLAIM_JITTER 1500                   // Spreads claims after a leader dies
+#define LAN_DATA_TIMEOUT_CYCLES 3               // Leader fetch periods without data before fetching directly
+#define LAN_APPLY_LOCK_TIMEOUT 20               // ms; a frame that cannot get the data lock is resynced
+
+// Payload
+#define LAN_MAX_POSITIONS 100                   // MAX_POSITIONS_PER_PORTFOLIO
+#define LAN_SNAPSHOT_EVERY 8                    // Publishes per full snapshot; deltas in between
+
+enum LanRole : uint8_t {
+    LAN_ROLE_OFF,               // Fetch directly, ignore the LAN
+    LAN_ROLE_AUTO,              // Lead or follow, whatever the election gives
+    LAN_ROLE_LEADER,            // Preferred leader; wins elections against auto
+    LAN_ROLE_FOLLOWER,          // Never leads; fetches directly while nobody does
+    LAN_ROLE_COUNT
+};
+
+enum LanState : uint8_t {
+    LAN_STATE_STANDALONE,       // No leader heard; fetching directly
+    LAN_STATE_LEADING,          // Fetching and rebroadcasting
+    LAN_STATE_FOLLOWING,        // Fed by the leader
+    LAN_STATE_COUNT
+};
+
+enum LanFrameType : uint8_t {
+    LAN_FRAME_HEARTBEAT,
+    LAN_FRAME_SNAPSHOT,         // Whole portfolio, replaces what the follower holds
+    LAN_FRAME_DELTA,            // Changed and removed positions since sequence "base"
+    LAN_FRAME_RESYNC            // Follower missed a delta and asks for a snapshot
+};
+
+// One datagram: header, "count" entries, then the tag over both
+struct __attribute__((packed)) LanFrameHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t type;               // LanFrameType
+    uint8_t rank;               // Election rank of the sender; device ID breaks ties
+    uint8_t portfolio;          // Row in the portfolio table
+    uint32_t deviceId;
+    uint32_t epoch;             // Random per boot, so a restarted leader's sequences are not stale
+    uint32_t group;             // Server, account and portfolios; other groups are ignored
+    uint32_t sequence;          // Per-portfolio publish count of the leader
+    uint32_t base;              // Delta: sequence the follower must hold to apply it
+    uint32_t fetchInterval;     // Leader's current fetch period, ms
+    uint16_t total;             // Entries in the whole snapshot or delta
+    uint8_t fragment;
+    uint8_t fragments;
+    uint8_t count;
+};
+
+#define LAN_ENTRY_LONG 0x01
+#define LAN_ENTRY_REMOVED 0x02
+
+struct __attribute__((packed)) LanEntry {
+    char symbol[16];
+    float changePercent;
+    float pnlValue;
+    float quantity;
+    float entryPrice;
+    float currentPrice;
+    uint8_t flags;
+};
+
+#define LAN_ENTRIES_PER_FRAME ((LAN_PACKET_SIZE - sizeof(LanFrameHeader) - LAN_TAG_LENGTH) / sizeof(LanEntry))
+#define LAN_MAX_FRAGMENTS ((LAN_MAX_POSITIONS + LAN_ENTRIES_PER_FRAME - 1) / LAN_ENTRIES_PER_FRAME)
+
+struct LanStats {
+    uint32_t framesSent;
+    uint32_t bytesSent;
+    uint32_t framesReceived;
+    uint32_t framesRejected;        // Wrong version, group or tag, or malformed
+    uint32_t snapshotsApplied;
+    uint32_t deltasApplied;
+    uint32_t resyncRequests;        // Deltas that did not match the held sequence
+    uint32_t leaderChanges;
+    uint32_t fallbacks;             // Leader went silent, direct fetch resumed
+};
+
+// Fan-out of the portfolio fetch over the LAN. One device (the leader)
+// fetches from the API server and rebroadcasts what it parsed as compact
+// binary snapshots and deltas on a UDP multicast group; the others merge
+// them into DataManager as if they had parsed them, and skip their own
+// fetch. The leader is the highest (rank, device ID) that heartbeats; when it goes silent, or stops sending
+// data, followers go back to fetching directly and eligible ones claim
+// leadership after a rank-dependent delay. A leader steps down as soon as
+// it hears a higher one.
+//
+// Only devices configured with the same server, account and portfolio
+// table form a group, and every datagram carries an HMAC keyed by the API
+// password, so a device that does not know it cannot feed prices in.
+class LanFanout {
+public:
+    static LanFanout& getInstance();
+
+    bool begin(const SystemSettings& settings);     // After DataManager::begin()
+    void update();                      // From the WiFi task: socket, election, receive
+
+    // Fetch task
+    bool shouldFetch() const;           // False while a live leader keeps the data fresh
+    void publish();                     // After a successful fetch cycle; leader only
+
+    // Settings
+    LanRole getRole() const;
+    void setRole(LanRole role);
+    static const char* getRoleName(LanRole role);
+    static LanRole findRole(const String& name);    // LAN_ROLE_COUNT if unknown
+
+    // Status
+    LanState getState() const;
+    static const char* getStateName(LanState state);
+    uint32_t getDeviceId() const;
+    uint32_t getLeaderId() const;       // 0 = none
+    unsigned long getDataAge() const;   // ms since data last came from the leader
+    LanStats getStats() const;
+
+private:
+    LanFanout();
+    LanFanout(const LanFanout&) = delete;
+    LanFanout& operator=(const LanFanout&) = delete;
+
+    static LanFanout* _instance;
+
+    // Per portfolio table row; "sent" on the leader, "staging" on followers
+    struct PortfolioState {
+        LanEntry* sent;                 // What followers hold after the last publish
+        int sentCount;
+        uint32_t sequence;
+        uint8_t publishes;              // Since the last snapshot
+        bool snapshotDue;
+        unsigned long lastResync;
+
+        LanEntry* staging;              // Fragments of the frame being assembled
+        uint8_t stagingType;
+        uint32_t stagingSequence;
+        uint32_t stagingBase;
+        uint16_t stagingTotal;
+        uint8_t stagingFragments;
+        uint32_t stagingReceived;       // Bit per fragment
+        uint32_t applied;               // Sequence DataManager reflects; 0 = none
+        unsigned long lastResyncRequest;
+    };
+
+    // Election
+    uint8_t getRank() const;
+    bool outranks(uint8_t rank, uint32_t deviceId) const;
+    bool acceptLeader(const LanFrameHeader& header);
+    void becomeLeader();
+    void setState(LanState state);
+
+    // Socket
+    void openSocket();
+    void closeSocket();
+    void receive();
+    void handlePacket(size_t length);
+
+    // Frames; callers hold _lock
+    void fillHeader(LanFrameHeader& header, LanFrameType type, uint8_t portfolio);
+    bool sendPacket(size_t length);
+    void sendHeartbeat();
+    void sendFrames(LanFrameType type, uint8_t portfolio, const LanEntry* entries, int total,
+                    uint32_t sequence, uint32_t base);
+    void requestResync(uint8_t portfolio);
+    void computeTag(const uint8_t* data, size_t length, uint8_t* tag) const;
+
+    // Leader
+    void publishPortfolio(uint8_t portfolio);
+    int collectDelta(const PortfolioState& state, const LanEntry* current, int count, LanEntry* delta) const;
+
+    // Follower; merged through DataManager under the scheduler's data lock
+    void stageFragment(const LanFrameHeader& header, const LanEntry* entries);
+    bool applyFrame(uint8_t portfolio);
+
+    bool _initialized;
+    LanRole _role;
+    LanState _state;
+    SemaphoreHandle_t _lock;            // Socket, packet buffer and portfolio state
+
+    WiFiUDP _udp;
+    bool _socketOpen;
+    uint8_t _packet[LAN_PACKET_SIZE];
+
+    uint32_t _deviceId;
+    uint32_t _epoch;
+    uint32_t _group;
+    char _key[64];                      // API password
+    size_t _keyLength;
+    unsigned long _claimDelay;
+
+    uint32_t _leaderId;
+    uint32_t _leaderEpoch;
+    uint32_t _leaderInterval;
+    unsigned long _lastLeaderFrame;
+    unsigned long _lastHeartbeat;
+    volatile unsigned long _lastData;   // 0 = no data from the current leader yet
+
+    PortfolioState _portfolios[PORTFOLIO_MAX];
+    LanEntry* _current;                 // Leader scratch: portfolio as entries
+    LanEntry* _delta;                   // Leader scratch: changes since the last publish
+    PositionRecord* _records;           // Follower scratch: frame as DataManager positions
+    const char** _removed;              // Follower scratch: symbols a delta closes
+
+    LanStats _stats;
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "MetricsRegistry.h"
+
+// ===== CONSTANTS =====
+// Upper bounds of the finite histogram buckets, in microseconds
+static const uint32_t BUCKET_BOUNDS[METRICS_BUCKET_COUNT] = {
+    100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000
+};
+static const char* const BUCKET_LABELS[METRICS_BUCKET_COUNT] = {
+    "0.0001", "0.0005", "0.001", "0.005", "0.01", "0.05", "0.1", "0.5", "1", "5"
+};
+
+// ===== STATIC VARIABLES =====
+MetricsRegistry* MetricsRegistry::_instance = nullptr;
+
+// ===== CONSTRUCTOR =====
+MetricsRegistry::MetricsRegistry()
+    : _count(0) {
+    memset(_metrics, 0, sizeof(_metrics));
+    memset(&_scratch, 0, sizeof(_scratch));
+    portMUX_INITIALIZE(&_registerLock);
+}
+
+// ===== REGISTRATION =====
+Metric* MetricsRegistry::counter(const char* name, const char* help, const char* labels) {
+    return registerMetric(name, help, labels, METRIC_COUNTER);
+}
+
+Metric* MetricsRegistry::gauge(const char* name, const char* help, const char* labels) {
+    return registerMetric(name, help, labels, METRIC_GAUGE);
+}
+
+Metric* MetricsRegistry::histogram(const char* name, const char* help, const char* labels) {
+    return registerMetric(name, help, labels, METRIC_HISTOGRAM);
+}
+
+Metric* MetricsRegistry::registerMetric(const char* name, const char* help, const char* labels,
+                                        MetricType type) {
+    if (!labels) labels = "";
+
+    Metric* metric = nullptr;
+    portENTER_CRITICAL(&_registerLock);
+    for (int i = 0; i < _count; i++) {
+        if (strcmp(_metrics[i].name, name) == 0 && strcmp(_metrics[i].labels, labels) == 0) {
+            metric = &_metrics[i];
+            break;
+        }
+    }
+    if (!metric && _count < METRICS_MAX_METRICS) {
+        metric = &_metrics[_count];
+        metric->name = name;
+        metric->help = help;
+        metric->type = type;
+        strlcpy(metric->labels, labels, sizeof(metric->labels));
+        _count++;
+    }
+    portEXIT_CRITICAL(&_registerLock);
+
+    if (!metric) {
+        Serial.print("Metrics table full, not exported: ");
+        Serial.println(name);
+        return &_scratch;
+    }
+    return metric;
+}
+
+// ===== UPDATES =====
+void MetricsRegistry::increment(Metric* metric, uint32_t amount) {
+    __atomic_fetch_add(&metric->value, amount, __ATOMIC_RELAXED);
+}
+
+void MetricsRegistry::set(Metric* metric, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    __atomic_store_n(&metric->value, bits, __ATOMIC_RELAXED);
+}
+
+void MetricsRegistry::observe(Metric* metric, uint32_t micros) {
+    int bucket = 0;
+    while (bucket < METRICS_BUCKET_COUNT && micros > BUCKET_BOUNDS[bucket]) {
+        bucket++;
+    }
+    __atomic_fetch_add(&metric->buckets[bucket], 1, __ATOMIC_RELAXED);
+
+    // Float sum through compare-and-swap; 32-bit CAS is native on the ESP32
+    uint32_t expected = __atomic_load_n(&metric->sumBits, __ATOMIC_RELAXED);
+    uint32_t desired;
+    do {
+        float sum;
+        memcpy(&sum, &expected, sizeof(sum));
+        sum += micros / 1000000.0f;
+        memcpy(&desired, &sum, sizeof(desired));
+    } while (!__atomic_compare_exchange_n(&metric->sumBits, &expected, desired, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+void MetricsRegistry::observeCycles(Metric* metric, uint32_t cycles) {
+    observe(metric, cycles / getCpuFrequencyMhz());
+}
+
+// ===== EXPORT =====
+// The exposition format ends lines with '\n'; println() would send "\r\n"
+void MetricsRegistry::printHeader(Print& out, const char* name, const char* help, const char* type) {
+    out.print("# HELP ");
+    out.print(name);
+    out.print(' ');
+    out.print(help);
+    out.print('\n');
+    out.print("# TYPE ");
+    out.print(name);
+    out.print(' ');
+    out.print(type);
+    out.print('\n');
+}
+
+void MetricsRegistry::printSample(Print& out, const char* name, const char* labels, double value) {
+    out.print(name);
+    if (labels && labels[0]) {
+        out.print('{');
+        out.print(labels);
+        out.print('}');
+    }
+    out.print(' ');
+    if (value == (double)(int64_t)value) {
+        out.print((long long)value);
+    } else {
+        out.print(value, 6);
+    }
+    out.print('\n');
+}
+
+void MetricsRegistry::printMetric(Print& out, const Metric& metric) {
+    if (metric.type == METRIC_COUNTER) {
+        printSample(out, metric.name, metric.labels, metric.value);
+        return;
+    }
+
+    if (metric.type == METRIC_GAUGE) {
+        uint32_t bits = metric.value;
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        printSample(out, metric.name, metric.labels, value);
+        return;
+    }
+
+    // Cumulative buckets; the count is their total so both always agree
+    uint32_t cumulative = 0;
+    for (int i = 0; i <= METRICS_BUCKET_COUNT; i++) {
+        cumulative += metric.buckets[i];
+
+        out.print(metric.name);
+        out.print("_bucket{");
+        if (metric.labels[0]) {
+            out.print(metric.labels);
+            out.print(',');
+        }
+        out.print("le=\"");
+        out.print(i < METRICS_BUCKET_COUNT ? BUCKET_LABELS[i] : "+Inf");
+        out.print("\"} ");
+        out.print(cumulative);
+        out.print('\n');
+    }
+
+    uint32_t bits = metric.sumBits;
+    float sum;
+    memcpy(&sum, &bits, sizeof(sum));
+
+    out.print(metric.name);
+    out.print("_sum");
+    if (metric.labels[0]) {
+        out.print('{');
+        out.print(metric.labels);
+        out.print('}');
+    }
+    out.print(' ');
+    out.print(sum, 6);
+    out.print('\n');
+
+    out.print(metric.name);
+    out.print("_count");
+    if (metric.labels[0]) {
+        out.print('{');
+        out.print(metric.labels);
+        out.print('}');
+    }
+    out.print(' ');
+    out.print(cumulative);
+    out.print('\n');
+}
+
+void MetricsRegistry::printPrometheus(Print& out) {
+    static const char* const TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+    int count = _count;
+
+    // One HELP/TYPE block per name, followed by all of its label sets
+    for (int i = 0; i < count; i++) {
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++) {
+            seen = strcmp(_metrics[j].name, _metrics[i].name) == 0;
+        }
+        if (seen) continue;
+
+        printHeader(out, _metrics[i].name, _metrics[i].help, TYPE_NAMES[_metrics[i].type]);
+        for (int k = i; k < count; k++) {
+            if (strcmp(_metrics[k].name, _metrics[i].name) == 0) {
+                printMetric(out, _metrics[k]);
+            }
+        }
+    }
+}
+
+int MetricsRegistry::getCount() const { return _count; }
+
+// ===== STATIC ACCESS =====
+MetricsRegistry& MetricsRegistry::getInstance() {
+    if (!_instance) {
+        _instance = new MetricsRegistry();
+    }
+    return *_instance;
+}
@@ -0,0 +1,80 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <Arduino.h>
+
+#define METRICS_MAX_METRICS 48
+#define METRICS_LABEL_LENGTH 40
+#define METRICS_BUCKET_COUNT 10         // Finite latency buckets, plus +Inf
+
+enum MetricType : uint8_t {
+    METRIC_COUNTER,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+};
+
+struct Metric {
+    const char* name;                   // String literal, Prometheus metric name
+    const char* help;
+    char labels[METRICS_LABEL_LENGTH];  // key="value" pairs without braces, may be empty
+    MetricType type;
+    volatile uint32_t value;            // Counter total, or gauge as float bits
+    volatile uint32_t buckets[METRICS_BUCKET_COUNT + 1];  // Per bucket, not cumulative
+    volatile uint32_t sumBits;          // Histogram sum in seconds, float bits
+};
+
+// Fixed table of counters, gauges and latency histograms. A metric is
+// registered once and the pointer kept, typically in a function-local
+// static; every update afterwards is a single atomic operation, so hot
+// paths on either core never block. Exported in Prometheus text format.
+class MetricsRegistry {
+public:
+    static MetricsRegistry& getInstance();
+
+    // Registration; the same name and labels return the same metric. When
+    // the table is full a scratch metric that is never exported is returned.
+    Metric* counter(const char* name, const char* help, const char* labels = "");
+    Metric* gauge(const char* name, const char* help, const char* labels = "");
+    Metric* histogram(const char* name, const char* help, const char* labels = "");
+
+    // Updates
+    static void increment(Metric* metric, uint32_t amount = 1);
+    static void set(Metric* metric, float value);
+    static void observe(Metric* metric, uint32_t micros);
+    static void observeCycles(Metric* metric, uint32_t cycles);
+
+    // Export
+    void printPrometheus(Print& out);
+    static void printHeader(Print& out, const char* name, const char* help, const char* type);
+    static void printSample(Print& out, const char* name, const char* labels, double value);
+
+    int getCount() const;
+
+private:
+    MetricsRegistry();
+
+    static MetricsRegistry* _instance;
+
+    Metric* registerMetric(const char* name, const char* help, const char* labels, MetricType type);
+    void printMetric(Print& out, const Metric& metric);
+
+    Metric _metrics[METRICS_MAX_METRICS];
+    Metric _scratch;
+    volatile int _count;
+    portMUX_TYPE _registerLock;         // Registration only
+};
+
+// Times the enclosing scope with the CPU cycle counter. The counter is per
+// core, so this suits pinned tasks, and it wraps after about 17 s at
+// 240 MHz; longer spans use esp_timer and observe() instead.
+class MetricTimer {
+public:
+    explicit MetricTimer(Metric* metric) : _metric(metric), _start(ESP.getCycleCount()) {}
+    ~MetricTimer() { MetricsRegistry::observeCycles(_metric, ESP.getCycleCount() - _start); }
+
+private:
+    Metric* _metric;
+    uint32_t _start;
+};
+
+#endif
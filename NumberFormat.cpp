@@ -0,0 +1,132 @@
+#include "NumberFormat.h"
+
+// ===== CONSTANTS =====
+static const double POWERS_OF_TEN[NUMBER_MAX_DECIMALS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10
+};
+
+// Smallest price that gets each precision, largest first
+struct PriceStep {
+    float minimum;
+    uint8_t decimals;
+};
+static constexpr PriceStep PRICE_STEPS[] = {
+    {1000.0f, 2},
+    {1.0f, 4},
+    {0.01f, 6},
+    {0.0001f, 8}
+};
+#define PRICE_MIN_DECIMALS 10           // Below the last step
+
+#define SCALED_LIMIT 1.8e19             // Largest scaled value a uint64_t holds
+
+static size_t copyText(char* out, size_t size, const char* text) {
+    size_t length = strlcpy(out, text, size);
+    return length < size ? length : size - 1;
+}
+
+static size_t appendChar(char* out, size_t size, size_t length, char c) {
+    if (length + 1 < size) {
+        out[length++] = c;
+        out[length] = '\0';
+    }
+    return length;
+}
+
+// ===== KERNEL =====
+size_t NumberFormat::format(char* out, size_t size, float value, NumberSpec spec) {
+    if (!out || size == 0) return 0;
+
+    if (isnan(value)) return copyText(out, size, "nan");
+    if (isinf(value)) return copyText(out, size, value < 0 ? "-inf" : "inf");
+
+    // The product is taken in double so every digit the float carries survives
+    bool negative = value < 0;
+    double scaledValue = fabs((double)value) * POWERS_OF_TEN[spec.decimals] + 0.5;
+    if (scaledValue >= SCALED_LIMIT) return copyText(out, size, negative ? "-ovf" : "ovf");
+    uint64_t scaled = (uint64_t)scaledValue;
+
+    // Digits in reverse; 64-bit division only while the value needs it
+    char digits[24];
+    int count = 0;
+    bool zero = scaled == 0;
+    while (scaled > UINT32_MAX) {
+        digits[count++] = '0' + (char)(scaled % 10);
+        scaled /= 10;
+    }
+    uint32_t low = (uint32_t)scaled;
+    do {
+        digits[count++] = '0' + (char)(low % 10);
+        low /= 10;
+    } while (low);
+    while (count < spec.decimals + 1) {
+        digits[count++] = '0';
+    }
+
+    size_t length = 0;
+    size_t limit = size - 1;
+    if (!zero && negative) {
+        out[length++] = '-';
+    } else if (!zero && (spec.flags & NUMBER_SIGN)) {
+        out[length++] = '+';
+    }
+
+    for (int i = count - 1; i >= 0 && length < limit; i--) {
+        out[length++] = digits[i];
+        if (i == spec.decimals && spec.decimals > 0 && length < limit) {
+            out[length++] = '.';
+        }
+    }
+    out[length] = '\0';
+
+    if (spec.flags & NUMBER_PERCENT) {
+        length = appendChar(out, size, length, '%');
+    }
+    return length;
+}
+
+// ===== MAGNITUDE-DEPENDENT =====
+uint8_t NumberFormat::priceDecimals(float price) {
+    for (const PriceStep& step : PRICE_STEPS) {
+        if (price >= step.minimum) return step.decimals;
+    }
+    return PRICE_MIN_DECIMALS;
+}
+
+size_t NumberFormat::price(char* out, size_t size, float price) {
+    if (price <= 0) return copyText(out, size, "0.00");
+    return format(out, size, price, NumberSpec(priceDecimals(price)));
+}
+
+size_t NumberFormat::percent(char* out, size_t size, float percent) {
+    return format(out, size, percent, NumberSpecs::PERCENT);
+}
+
+size_t NumberFormat::compact(char* out, size_t size, float value, uint8_t decimals) {
+    if (value == 0) return copyText(out, size, "0");
+
+    float magnitude = fabs(value);
+    if (magnitude >= 1000000) {
+        size_t length = format(out, size, value / 1000000, NumberSpec(decimals));
+        return appendChar(out, size, length, 'M');
+    }
+    if (magnitude >= 1000) {
+        size_t length = format(out, size, value / 1000, NumberSpec(magnitude >= 10000 ? 1 : 2));
+        return appendChar(out, size, length, 'K');
+    }
+
+    uint8_t digits = magnitude >= 1 ? decimals : magnitude >= 0.01 ? 4 : magnitude >= 0.0001 ? 6 : 8;
+    return format(out, size, value, NumberSpec(digits));
+}
+
+// ===== LAYOUT =====
+size_t NumberFormat::alignRight(char* text, size_t length, size_t width, size_t size) {
+    if (size == 0) return 0;
+    if (width > size - 1) width = size - 1;
+    if (length >= width) return length;
+
+    size_t pad = width - length;
+    memmove(text + pad, text, length + 1);
+    memset(text, ' ', pad);
+    return width;
+}
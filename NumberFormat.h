@@ -0,0 +1,51 @@
+#ifndef NUMBER_FORMAT_H
+#define NUMBER_FORMAT_H
+
+#include <Arduino.h>
+
+#define NUMBER_MAX_DECIMALS 10
+#define NUMBER_TEXT_LENGTH 32           // Fits any float at NUMBER_MAX_DECIMALS
+
+enum NumberFlags : uint8_t {
+    NUMBER_PLAIN = 0,
+    NUMBER_SIGN = 1 << 0,               // '+' before positive values
+    NUMBER_PERCENT = 1 << 1             // Trailing '%'
+};
+
+// How one kind of value is written; built at compile time
+struct NumberSpec {
+    uint8_t decimals;
+    uint8_t flags;
+
+    constexpr NumberSpec(uint8_t digits, uint8_t options = NUMBER_PLAIN)
+        : decimals(digits > NUMBER_MAX_DECIMALS ? NUMBER_MAX_DECIMALS : digits),
+          flags(options) {}
+};
+
+namespace NumberSpecs {
+    constexpr NumberSpec MONEY(2);                              // 1234.50
+    constexpr NumberSpec CHANGE(2, NUMBER_SIGN);                // +12.50
+    constexpr NumberSpec PERCENT(2, NUMBER_SIGN | NUMBER_PERCENT);  // +1.25%
+    constexpr NumberSpec RATIO(2, NUMBER_PERCENT);              // -1.25%
+}
+
+// Number to text for the display, web and serial output. Everything is
+// written into caller buffers: the value is scaled to an integer once and
+// the digits are emitted from it, so no String is built and printf's float
+// path is never entered. Output is always terminated and truncated to fit;
+// the return value is the length written.
+class NumberFormat {
+public:
+    static size_t format(char* out, size_t size, float value, NumberSpec spec);
+
+    // Precision picked by magnitude
+    static size_t price(char* out, size_t size, float price);
+    static size_t percent(char* out, size_t size, float percent);
+    static size_t compact(char* out, size_t size, float value, uint8_t decimals = 2);  // 12.5K, 3.20M
+    static uint8_t priceDecimals(float price);
+
+    // Shifts length characters right within width columns, space filled
+    static size_t alignRight(char* text, size_t length, size_t width, size_t size);
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "PatternSequencer.h"
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+PatternSequencer::PatternSequencer()
+    : _queueHead(0),
+      _queueCount(0),
+      _stepIndex(0),
+      _repeatIndex(0),
+      _inPause(false),
+      _active(false),
+      _timer(nullptr),
+      _output(nullptr),
+      _context(nullptr),
+      _playedCount(0),
+      _mergedCount(0),
+      _droppedCount(0) {
+    portMUX_INITIALIZE(&_lock);
+    memset(&_current, 0, sizeof(_current));
+}
+
+PatternSequencer::~PatternSequencer() {
+    if (_timer) {
+        esp_timer_stop(_timer);
+        esp_timer_delete(_timer);
+    }
+}
+
+// ===== INITIALIZATION =====
+bool PatternSequencer::begin(const char* name, PatternOutputFn output, void* context) {
+    _output = output;
+    _context = context;
+
+    if (_timer) return true;
+
+    esp_timer_create_args_t args = {};
+    args.callback = &PatternSequencer::timerCallback;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = name;
+
+    if (esp_timer_create(&args, &_timer) != ESP_OK) {
+        Serial.print("Failed to create sequencer timer: ");
+        Serial.println(name);
+        _timer = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+// ===== PLAYBACK =====
+bool PatternSequencer::enqueue(uint8_t patternId, const PatternStep* steps,
+                               uint8_t stepCount, uint8_t repeats) {
+    if (!_timer || !steps || stepCount == 0 || repeats == 0) return false;
+    if (stepCount > PATTERN_MAX_STEPS) stepCount = PATTERN_MAX_STEPS;
+
+    bool startNow = false;
+
+    portENTER_CRITICAL(&_lock);
+
+    // Merge duplicates: the same alert fired again before it finished playing
+    if (patternId != 0) {
+        bool duplicate = _active && _current.id == patternId;
+        for (uint8_t i = 0; i < _queueCount && !duplicate; i++) {
+            duplicate = _queue[(_queueHead + i) % PATTERN_QUEUE_SIZE].id == patternId;
+        }
+        if (duplicate) {
+            _mergedCount++;
+            portEXIT_CRITICAL(&_lock);
+            return true;
+        }
+    }
+
+    if (_queueCount >= PATTERN_QUEUE_SIZE) {
+        _droppedCount++;
+        portEXIT_CRITICAL(&_lock);
+        return false;
+    }
+
+    QueuedPattern& slot = _queue[(_queueHead + _queueCount) % PATTERN_QUEUE_SIZE];
+    slot.id = patternId;
+    slot.stepCount = stepCount;
+    slot.repeats = repeats;
+    memcpy(slot.steps, steps, stepCount * sizeof(PatternStep));
+    _queueCount++;
+
+    startNow = !_active;
+    portEXIT_CRITICAL(&_lock);
+
+    if (startNow) {
+        esp_timer_stop(_timer);
+        esp_timer_start_once(_timer, 1);
+    }
+
+    return true;
+}
+
+void PatternSequencer::stop() {
+    if (_timer) {
+        esp_timer_stop(_timer);
+    }
+
+    portENTER_CRITICAL(&_lock);
+    _queueCount = 0;
+    _active = false;
+    _inPause = false;
+    portEXIT_CRITICAL(&_lock);
+
+    if (_output) {
+        _output(0, _context);
+    }
+}
+
+// ===== TIMER CALLBACK =====
+void PatternSequencer::timerCallback(void* arg) {
+    static_cast<PatternSequencer*>(arg)->advance();
+}
+
+bool PatternSequencer::popNext() {
+    if (_queueCount == 0) return false;
+
+    _current = _queue[_queueHead];
+    _queueHead = (_queueHead + 1) % PATTERN_QUEUE_SIZE;
+    _queueCount--;
+    _stepIndex = 0;
+    _repeatIndex = 0;
+    _inPause = false;
+    return true;
+}
+
+void PatternSequencer::advance() {
+    uint16_t value = 0;
+    uint32_t waitMs = 0;
+
+    portENTER_CRITICAL(&_lock);
+
+    if (!_active) {
+        // Idle: start the next queued pattern
+        if (!popNext()) {
+            portEXIT_CRITICAL(&_lock);
+            return;
+        }
+        _active = true;
+    } else if (!_inPause && _current.steps[_stepIndex].pauseMs > 0) {
+        // Tone/LED period finished, hold the output off
+        _inPause = true;
+        waitMs = _current.steps[_stepIndex].pauseMs;
+        portEXIT_CRITICAL(&_lock);
+
+        if (_output) _output(0, _context);
+        esp_timer_start_once(_timer, waitMs * 1000ULL);
+        return;
+    } else {
+        // Move to the next step, repeat or pattern
+        _inPause = false;
+        _stepIndex++;
+        if (_stepIndex >= _current.stepCount) {
+            _stepIndex = 0;
+            _repeatIndex++;
+            if (_repeatIndex >= _current.repeats) {
+                _playedCount++;
+                if (!popNext()) {
+                    _active = false;
+                    portEXIT_CRITICAL(&_lock);
+
+                    if (_output) _output(0, _context);
+                    return;
+                }
+            }
+        }
+    }
+
+    value = _current.steps[_stepIndex].value;
+    waitMs = _current.steps[_stepIndex].durationMs;
+    portEXIT_CRITICAL(&_lock);
+
+    if (_output) _output(value, _context);
+    esp_timer_start_once(_timer, (waitMs > 0 ? waitMs : 1) * 1000ULL);
+}
+
+// ===== GETTERS =====
+bool PatternSequencer::isBusy() const {
+    return _active || _queueCount > 0;
+}
+
+uint8_t PatternSequencer::getQueueDepth() const {
+    return _queueCount;
+}
+
+uint8_t PatternSequencer::getCurrentPatternId() const {
+    return _active ? _current.id : 0;
+}
+
+uint32_t PatternSequencer::getPlayedCount() const { return _playedCount; }
+uint32_t PatternSequencer::getMergedCount() const { return _mergedCount; }
+uint32_t PatternSequencer::getDroppedCount() const { return _droppedCount; }
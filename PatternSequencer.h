@@ -0,0 +1,75 @@
+#ifndef PATTERN_SEQUENCER_H
+#define PATTERN_SEQUENCER_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#define PATTERN_MAX_STEPS 20
+#define PATTERN_QUEUE_SIZE 8
+
+// One step of a pattern: value is a frequency (buzzer) or LED mask; 0 = off
+struct PatternStep {
+    uint16_t value;
+    uint16_t durationMs;
+    uint16_t pauseMs;     // Output off after the step
+};
+
+// Called from the esp_timer task whenever the output has to change
+typedef void (*PatternOutputFn)(uint16_t value, void* context);
+
+// Plays queued step patterns from an esp_timer callback so callers never block
+class PatternSequencer {
+public:
+    PatternSequencer();
+    ~PatternSequencer();
+
+    // Initialization
+    bool begin(const char* name, PatternOutputFn output, void* context);
+
+    // Playback; patternId != 0 is merged with an identical pending/playing pattern
+    bool enqueue(uint8_t patternId, const PatternStep* steps, uint8_t stepCount, uint8_t repeats = 1);
+    void stop();
+
+    // State
+    bool isBusy() const;
+    uint8_t getQueueDepth() const;
+    uint8_t getCurrentPatternId() const;
+
+    // Statistics
+    uint32_t getPlayedCount() const;
+    uint32_t getMergedCount() const;
+    uint32_t getDroppedCount() const;
+
+private:
+    struct QueuedPattern {
+        uint8_t id;
+        uint8_t stepCount;
+        uint8_t repeats;
+        PatternStep steps[PATTERN_MAX_STEPS];
+    };
+
+    static void timerCallback(void* arg);
+    void advance();
+    bool popNext();
+
+    QueuedPattern _queue[PATTERN_QUEUE_SIZE];
+    uint8_t _queueHead;
+    uint8_t _queueCount;
+
+    QueuedPattern _current;
+    uint8_t _stepIndex;
+    uint8_t _repeatIndex;
+    bool _inPause;
+    volatile bool _active;
+
+    esp_timer_handle_t _timer;
+    PatternOutputFn _output;
+    void* _context;
+    mutable portMUX_TYPE _lock;
+
+    uint32_t _playedCount;
+    uint32_t _mergedCount;
+    uint32_t _droppedCount;
+};
+
+#endif
@@ -0,0 +1,290 @@
+#include "PipelineBenchmark.h"
+#include "DataManager.h"
+#include "PositionEvents.h"
+#include "CycleArena.h"
+#include "NumberFormat.h"
+#include <esp_heap_caps.h>
+#include <esp_idf_version.h>
+#include <esp_timer.h>
+
+// ===== FRAME STREAM =====
+// Read-only Stream over one generated payload
+class FrameStream : public Stream {
+public:
+    FrameStream(const char* data, size_t length) : _data(data), _length(length), _position(0) {}
+
+    int available() override { return _length - _position; }
+    int read() override { return _position < _length ? (uint8_t)_data[_position++] : -1; }
+    int peek() override { return _position < _length ? (uint8_t)_data[_position] : -1; }
+    size_t write(uint8_t) override { return 0; }
+    void flush() override {}
+
+    size_t readBytes(char* buffer, size_t length) {
+        size_t count = min(length, _length - _position);
+        memcpy(buffer, _data + _position, count);
+        _position += count;
+        return count;
+    }
+
+private:
+    const char* _data;
+    size_t _length;
+    size_t _position;
+};
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+PipelineBenchmark::PipelineBenchmark()
+    : _frameCapacity(0),
+      _frameIndex(0),
+      _render(nullptr),
+      _renderContext(nullptr) {
+    memset(_frames, 0, sizeof(_frames));
+    memset(_frameLength, 0, sizeof(_frameLength));
+}
+
+PipelineBenchmark::~PipelineBenchmark() {
+    freeFrames();
+}
+
+void PipelineBenchmark::setRenderStage(BenchmarkStageFn fn, void* context) {
+    _render = fn;
+    _renderContext = context;
+}
+
+// ===== PAYLOADS =====
+bool PipelineBenchmark::buildFrames(uint16_t positions) {
+    size_t capacity = 64 + (size_t)positions * BENCH_ROW_SIZE;
+    if (capacity > _frameCapacity) {
+        freeFrames();
+        uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+        for (int f = 0; f < BENCH_FRAME_COUNT; f++) {
+            _frames[f] = (char*)heap_caps_malloc(capacity, caps);
+            if (!_frames[f]) {
+                freeFrames();
+                return false;
+            }
+        }
+        _frameCapacity = capacity;
+    }
+
+    for (int f = 0; f < BENCH_FRAME_COUNT; f++) {
+        char* out = _frames[f];
+        size_t length = snprintf(out, _frameCapacity, "{\"portfolio\":[");
+
+        for (uint16_t i = 0; i < positions && length < _frameCapacity; i++) {
+            // Every frame moves each price a little; the last one also drops
+            // every tenth position far enough to cross the alert thresholds
+            float move = ((i + f) % 7 - 3) * 0.004;
+            if (f == BENCH_FRAME_COUNT - 1 && i % 10 == 0) move -= 0.12;
+
+            float entry = 10.0 + (i % 97) * 3.5;
+            float price = entry * (1.0 + move);
+            float quantity = 1.0 + (i % 13);
+
+            length += snprintf(out + length, _frameCapacity - length,
+                               "%s{\"symbol\":\"BN%04u\",\"quantity\":%.4f,\"entry_price\":%.4f,"
+                               "\"current_price\":%.4f,\"pnl\":%.4f,\"pnl_percent\":%.3f,\"side\":\"%s\"}",
+                               i ? "," : "", (unsigned)i, quantity, entry, price,
+                               (price - entry) * quantity, move * 100.0, i % 3 ? "long" : "short");
+        }
+
+        if (length < _frameCapacity) {
+            length += snprintf(out + length, _frameCapacity - length, "]}");
+        }
+        if (length >= _frameCapacity) return false;
+        _frameLength[f] = length;
+    }
+
+    return true;
+}
+
+void PipelineBenchmark::freeFrames() {
+    for (int f = 0; f < BENCH_FRAME_COUNT; f++) {
+        if (_frames[f]) {
+            heap_caps_free(_frames[f]);
+            _frames[f] = nullptr;
+        }
+    }
+    _frameCapacity = 0;
+}
+
+// ===== STAGES =====
+void PipelineBenchmark::parseStage(void* context) {
+    PipelineBenchmark* self = static_cast<PipelineBenchmark*>(context);
+    int f = self->_frameIndex++ % BENCH_FRAME_COUNT;
+
+    FrameStream stream(self->_frames[f], self->_frameLength[f]);
+    DataManager::getInstance().parsePortfolioStream(stream, PORTFOLIO_ENTRY);
+}
+
+void PipelineBenchmark::jsonStage(void* context) {
+    {
+        String json = DataManager::getInstance().getDataJSON(PORTFOLIO_ENTRY);
+    }
+    // Stands in for the web task, which resets after every request
+    CycleArena::get(ARENA_WEB).reset();
+}
+
+// Price, percent and P&L of every entry position, as a ticker row needs them
+void PipelineBenchmark::formatStage(void* context) {
+    DataManager& data = DataManager::getInstance();
+    const PositionRecord* positions = data.getPositions(PORTFOLIO_ENTRY);
+    char text[NUMBER_TEXT_LENGTH];
+    
+    for (int i = 0; i < data.getPositionCount(PORTFOLIO_ENTRY); i++) {
+        NumberFormat::price(text, sizeof(text), positions[i].currentPrice);
+        NumberFormat::percent(text, sizeof(text), positions[i].changePercent);
+        NumberFormat::format(text, sizeof(text), positions[i].pnlValue, NumberSpecs::CHANGE);
+    }
+}
+
+void PipelineBenchmark::printfStage(void* context) {
+    DataManager& data = DataManager::getInstance();
+    const PositionRecord* positions = data.getPositions(PORTFOLIO_ENTRY);
+    char text[NUMBER_TEXT_LENGTH];
+    
+    for (int i = 0; i < data.getPositionCount(PORTFOLIO_ENTRY); i++) {
+        snprintf(text, sizeof(text), "%.*f", NumberFormat::priceDecimals(positions[i].currentPrice),
+                 positions[i].currentPrice);
+        snprintf(text, sizeof(text), "%+.2f%%", positions[i].changePercent);
+        snprintf(text, sizeof(text), "%+.2f", positions[i].pnlValue);
+    }
+}
+
+// Worst move, total P&L and losers of the entry portfolio, as the alert and
+// summary paths scan for them; once over the columns, once over whole records
+static volatile float _scanSink;
+
+void PipelineBenchmark::scanStage(void* context) {
+    DataManager& data = DataManager::getInstance();
+    PositionColumns columns = data.getColumns(PORTFOLIO_ENTRY);
+    int count = data.getWorkingCount(PORTFOLIO_ENTRY);
+    
+    float worst = 0;
+    float pnl = 0;
+    int losers = 0;
+    for (int i = 0; i < count; i++) {
+        worst = min(worst, columns.changePercent[i]);
+        pnl += columns.pnlValue[i];
+        losers += columns.pnlValue[i] < 0;
+    }
+    _scanSink = worst + pnl + losers;
+}
+
+void PipelineBenchmark::scanRecordsStage(void* context) {
+    DataManager& data = DataManager::getInstance();
+    const PositionRecord* positions = data.getPositions(PORTFOLIO_ENTRY);
+    int count = data.getPositionCount(PORTFOLIO_ENTRY);
+    
+    float worst = 0;
+    float pnl = 0;
+    int losers = 0;
+    for (int i = 0; i < count; i++) {
+        worst = min(worst, positions[i].changePercent);
+        pnl += positions[i].pnlValue;
+        losers += positions[i].pnlValue < 0;
+    }
+    _scanSink = worst + pnl + losers;
+}
+
+// ===== MEASUREMENT =====
+BenchmarkResult PipelineBenchmark::measure(const char* stage, uint16_t positions, uint16_t iterations,
+                                           BenchmarkStageFn fn, void* context) {
+    BenchmarkResult result;
+    memset(&result, 0, sizeof(result));
+    result.stage = stage;
+    result.positions = positions;
+    result.iterations = iterations;
+    result.minUs = UINT32_MAX;
+
+    // Untimed warm-up; first-use allocations (interning, buffers) are not per-op cost
+    fn(context);
+
+    multi_heap_info_t before;
+    heap_caps_get_info(&before, MALLOC_CAP_8BIT);
+    size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    uint32_t eventsBefore = PositionEvents::getInstance().getPublishedCount();
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+    heap_caps_monitor_local_minimum_free_size_start();
+#endif
+
+    uint64_t totalUs = 0;
+    for (uint16_t i = 0; i < iterations; i++) {
+        int64_t start = esp_timer_get_time();
+        fn(context);
+        uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+
+        totalUs += elapsed;
+        if (elapsed < result.minUs) result.minUs = elapsed;
+        if (elapsed > result.maxUs) result.maxUs = elapsed;
+    }
+
+    size_t minimum = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+    heap_caps_monitor_local_minimum_free_size_stop();
+#endif
+    multi_heap_info_t after;
+    heap_caps_get_info(&after, MALLOC_CAP_8BIT);
+
+    if (iterations > 0) {
+        result.nsPerOp = (uint32_t)(totalUs * 1000 / iterations);
+        result.eventsPerOp = (PositionEvents::getInstance().getPublishedCount() - eventsBefore) / iterations;
+    } else {
+        result.minUs = 0;
+    }
+    result.heapDelta = (int32_t)(after.total_allocated_bytes - before.total_allocated_bytes);
+    result.retainedBlocks = (int32_t)(after.allocated_blocks - before.allocated_blocks);
+    result.peakBytes = freeBefore > minimum ? freeBefore - minimum : 0;
+
+    return result;
+}
+
+void PipelineBenchmark::report(const BenchmarkResult& result) {
+    Serial.printf("BENCH stage=%s positions=%u iterations=%u ns_op=%lu min_us=%lu max_us=%lu "
+                  "heap_delta=%ld retained_blocks=%ld peak_bytes=%lu events_op=%lu\n",
+                  result.stage, (unsigned)result.positions, (unsigned)result.iterations,
+                  (unsigned long)result.nsPerOp, (unsigned long)result.minUs,
+                  (unsigned long)result.maxUs, (long)result.heapDelta,
+                  (long)result.retainedBlocks, (unsigned long)result.peakBytes,
+                  (unsigned long)result.eventsPerOp);
+}
+
+// ===== RUN =====
+void PipelineBenchmark::run(uint16_t iterations) {
+    static const uint16_t SIZES[] = {10, 100, BENCH_MAX_POSITIONS};
+
+    DataManager& data = DataManager::getInstance();
+    if (!data.isInitialized()) {
+        data.begin();
+    }
+
+    Serial.println("\n=== Pipeline Benchmark ===");
+    Serial.printf("Free heap %lu, PSRAM %lu\n",
+                  (unsigned long)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+                  (unsigned long)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+
+    for (uint16_t positions : SIZES) {
+        if (!buildFrames(positions)) {
+            Serial.printf("Benchmark payload for %u positions unavailable\n", (unsigned)positions);
+            break;
+        }
+
+        // Rows past MAX_POSITIONS_PER_PORTFOLIO are still parsed, then dropped
+        data.clearData(PORTFOLIO_ENTRY);
+        _frameIndex = 0;
+
+        report(measure("parse", positions, iterations, parseStage, this));
+        report(measure("json", positions, iterations, jsonStage, this));
+        report(measure("format", positions, iterations, formatStage, this));
+        report(measure("format_printf", positions, iterations, printfStage, this));
+        report(measure("scan", positions, iterations, scanStage, this));
+        report(measure("scan_records", positions, iterations, scanRecordsStage, this));
+        if (_render) {
+            report(measure("render", positions, iterations, _render, _renderContext));
+        }
+    }
+
+    data.clearData(PORTFOLIO_ENTRY);
+    freeFrames();
+    Serial.println("==========================\n");
+}
@@ -0,0 +1,70 @@
+#ifndef PIPELINE_BENCHMARK_H
+#define PIPELINE_BENCHMARK_H
+
+#include <Arduino.h>
+
+#define BENCH_DEFAULT_ITERATIONS 50
+#define BENCH_FRAME_COUNT 4             // Payload variants replayed in turn so prices move
+#define BENCH_MAX_POSITIONS 1000
+#define BENCH_ROW_SIZE 192              // Upper bound for one generated position row
+
+typedef void (*BenchmarkStageFn)(void* context);
+
+struct BenchmarkResult {
+    const char* stage;
+    uint16_t positions;
+    uint16_t iterations;
+    uint32_t nsPerOp;
+    uint32_t minUs;
+    uint32_t maxUs;
+    int32_t heapDelta;              // Bytes still allocated after the run
+    int32_t retainedBlocks;         // Heap blocks still allocated after the run
+    uint32_t peakBytes;             // Deepest heap use below the starting free size
+    uint32_t eventsPerOp;           // Position events fanned out to listeners (alerts)
+};
+
+// On-device replay of generated portfolio payloads at 10, 100 and 1000
+// positions through DataManager's streaming parser (merge, change events
+// with their alert listeners, metrics, ranking, snapshots), the web JSON
+// path, number formatting (NumberFormat against snprintf "%f" on the same
+// fields), a hot-field scan (the working set's columns against the
+// published whole records) and an optional render stage. Results go to
+// Serial as one "BENCH key=value ..." line per stage so runs can be
+// diffed. Timings include the parser's own Serial logging.
+//
+// Meant for bench builds (-DPIPELINE_BENCHMARK): the replayed symbols stay
+// interned until reboot. Before IDF 5.1 the peak is a lower bound taken
+// from the lifetime heap minimum. The native env runs the same stages on
+// the host, where the heap figures come from its counted heap stub.
+class PipelineBenchmark {
+public:
+    PipelineBenchmark();
+    ~PipelineBenchmark();
+
+    void setRenderStage(BenchmarkStageFn fn, void* context);
+    void run(uint16_t iterations = BENCH_DEFAULT_ITERATIONS);
+
+private:
+    bool buildFrames(uint16_t positions);
+    void freeFrames();
+    BenchmarkResult measure(const char* stage, uint16_t positions, uint16_t iterations,
+                            BenchmarkStageFn fn, void* context);
+    void report(const BenchmarkResult& result);
+
+    static void parseStage(void* context);
+    static void jsonStage(void* context);
+    static void formatStage(void* context);
+    static void printfStage(void* context);
+    static void scanStage(void* context);
+    static void scanRecordsStage(void* context);
+
+    char* _frames[BENCH_FRAME_COUNT];
+    size_t _frameLength[BENCH_FRAME_COUNT];
+    size_t _frameCapacity;
+    uint16_t _frameIndex;
+
+    BenchmarkStageFn _render;
+    void* _renderContext;
+};
+
+#endif
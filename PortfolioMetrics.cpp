@@ -0,0 +1,143 @@
+#include "PortfolioMetrics.h"
+
+// ===== CONSTRUCTOR =====
+PortfolioMetrics::PortfolioMetrics()
+    : _generation(0) {
+    clear();
+}
+
+void PortfolioMetrics::clear() {
+    memset(_slots, 0, sizeof(_slots));
+    _totalValue = 0;
+    _totalPnl = 0;
+    _count = 0;
+    _longCount = 0;
+    _winningCount = 0;
+
+    _samplePnlChange = 0;
+    _sampleInvestment = 0;
+
+    memset(_returns, 0, sizeof(_returns));
+    _returnHead = 0;
+    _returnCount = 0;
+    _returnSum = 0;
+    _returnSquares = 0;
+
+    _equity = 1.0;
+    _equityPeak = 1.0;
+    _maxDrawdown = 0;
+
+    // Bumped rather than reset, so caches keyed on it are invalidated
+    _generation++;
+}
+
+// ===== POSITION CONTRIBUTIONS =====
+void PortfolioMetrics::apply(const Contribution& contribution, int sign) {
+    _totalValue += sign * (double)contribution.value;
+    _totalPnl += sign * (double)contribution.pnl;
+    _count += sign;
+    if (contribution.isLong) _longCount += sign;
+    if (contribution.winning) _winningCount += sign;
+}
+
+void PortfolioMetrics::setPosition(int slot, float value, float pnl, float changePercent, bool isLong) {
+    if (slot < 0 || slot >= METRICS_MAX_SLOTS) return;
+
+    Contribution& current = _slots[slot];
+    if (current.present) {
+        _samplePnlChange += (double)pnl - current.pnl;
+        apply(current, -1);
+    }
+
+    current.value = value;
+    current.pnl = pnl;
+    current.isLong = isLong;
+    current.winning = changePercent >= 0;
+    current.present = true;
+    apply(current, 1);
+
+    _generation++;
+}
+
+void PortfolioMetrics::removePosition(int slot) {
+    if (slot < 0 || slot >= METRICS_MAX_SLOTS || !_slots[slot].present) return;
+
+    apply(_slots[slot], -1);
+    _slots[slot].present = false;
+
+    // Only rounding is left once the table is empty
+    if (_count == 0) {
+        _totalValue = 0;
+        _totalPnl = 0;
+    }
+
+    _generation++;
+}
+
+void PortfolioMetrics::movePosition(int from, int to) {
+    if (from < 0 || from >= METRICS_MAX_SLOTS || to < 0 || to >= METRICS_MAX_SLOTS) return;
+    if (from == to) return;
+
+    _slots[to] = _slots[from];
+    _slots[from].present = false;
+}
+
+// ===== RETURN SERIES =====
+void PortfolioMetrics::recordSample() {
+    double investment = _totalValue - _totalPnl;
+    double base = _sampleInvestment > 0 ? _sampleInvestment : investment;
+    float sampleReturn = base > 0 ? (float)(_samplePnlChange / base * 100.0) : 0.0;
+
+    // Replace the oldest sample once the window is full
+    if (_returnCount == METRICS_RETURN_WINDOW) {
+        float evicted = _returns[_returnHead];
+        _returnSum -= evicted;
+        _returnSquares -= (double)evicted * evicted;
+    } else {
+        _returnCount++;
+    }
+    _returns[_returnHead] = sampleReturn;
+    _returnHead = (_returnHead + 1) % METRICS_RETURN_WINDOW;
+    _returnSum += sampleReturn;
+    _returnSquares += (double)sampleReturn * sampleReturn;
+
+    _equity *= 1.0 + sampleReturn / 100.0;
+    if (_equity > _equityPeak) _equityPeak = _equity;
+    float drawdown = getDrawdown();
+    if (drawdown < _maxDrawdown) _maxDrawdown = drawdown;
+
+    _samplePnlChange = 0;
+    _sampleInvestment = investment;
+    _generation++;
+}
+
+// ===== GETTERS =====
+uint32_t PortfolioMetrics::getGeneration() const { return _generation; }
+int PortfolioMetrics::getCount() const { return _count; }
+int PortfolioMetrics::getLongCount() const { return _longCount; }
+int PortfolioMetrics::getShortCount() const { return _count - _longCount; }
+int PortfolioMetrics::getWinningCount() const { return _winningCount; }
+int PortfolioMetrics::getLosingCount() const { return _count - _winningCount; }
+float PortfolioMetrics::getTotalValue() const { return (float)_totalValue; }
+float PortfolioMetrics::getTotalPnl() const { return (float)_totalPnl; }
+int PortfolioMetrics::getSampleCount() const { return _returnCount; }
+
+float PortfolioMetrics::getVolatility() const {
+    if (_returnCount < 2) return 0.0;
+
+    double mean = _returnSum / _returnCount;
+    double variance = (_returnSquares - mean * _returnSum) / (_returnCount - 1);
+    return variance > 0 ? (float)sqrt(variance) : 0.0;
+}
+
+float PortfolioMetrics::getSharpeRatio() const {
+    float volatility = getVolatility();
+    if (volatility <= 0) return 0.0;
+    return (float)(_returnSum / _returnCount) / volatility;
+}
+
+float PortfolioMetrics::getDrawdown() const {
+    return _equityPeak > 0 ? (float)((_equity / _equityPeak - 1.0) * 100.0) : 0.0;
+}
+
+float PortfolioMetrics::getMaxDrawdown() const { return _maxDrawdown; }
@@ -0,0 +1,85 @@
+#ifndef PORTFOLIO_METRICS_H
+#define PORTFOLIO_METRICS_H
+
+#include <Arduino.h>
+
+#define METRICS_MAX_SLOTS 100           // MAX_POSITIONS_PER_PORTFOLIO
+#define METRICS_RETURN_WINDOW 50        // Return samples, matches POSITION_HISTORY_SIZE
+
+// Running portfolio aggregates. Position changes adjust the totals and
+// counts directly instead of rescanning the table, and each parse appends
+// one portfolio return to a ring with running moments, so every getter is
+// O(1). Each change bumps the generation so callers can memoize what they
+// derive from it.
+class PortfolioMetrics {
+public:
+    PortfolioMetrics();
+
+    void clear();
+
+    // Position contributions, by table slot
+    void setPosition(int slot, float value, float pnl, float changePercent, bool isLong);
+    void removePosition(int slot);
+    void movePosition(int from, int to);       // Compaction; aggregates unchanged
+
+    // One point of the return series; called once per parse
+    void recordSample();
+
+    // Aggregates
+    uint32_t getGeneration() const;
+    int getCount() const;
+    int getLongCount() const;
+    int getShortCount() const;
+    int getWinningCount() const;
+    int getLosingCount() const;
+    float getTotalValue() const;
+    float getTotalPnl() const;
+
+    // Return series, percent per sample
+    int getSampleCount() const;
+    float getVolatility() const;
+    float getSharpeRatio() const;               // Mean / volatility, zero risk-free rate
+    float getDrawdown() const;                  // <= 0, from the running equity peak
+    float getMaxDrawdown() const;
+
+private:
+    struct Contribution {
+        float value;
+        float pnl;
+        bool isLong;
+        bool winning;
+        bool present;
+    };
+
+    void apply(const Contribution& contribution, int sign);
+
+    Contribution _slots[METRICS_MAX_SLOTS];
+
+    // Running sums are double so long add/subtract chains do not drift
+    double _totalValue;
+    double _totalPnl;
+    int _count;
+    int _longCount;
+    int _winningCount;
+
+    // P/L moved by positions held across the sample; opening or closing a
+    // position is not a return
+    double _samplePnlChange;
+    double _sampleInvestment;
+
+    // Return ring with running sum and sum of squares
+    float _returns[METRICS_RETURN_WINDOW];
+    uint8_t _returnHead;
+    uint8_t _returnCount;
+    double _returnSum;
+    double _returnSquares;
+
+    // Equity index compounded from the returns; starts at 1
+    double _equity;
+    double _equityPeak;
+    float _maxDrawdown;
+
+    uint32_t _generation;
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef PORTFOLIO_TABLE_H
+#define PORTFOLIO_TABLE_H
+
+#include <Arduino.h>
+
+#define PORTFOLIO_MAX 6                 // Portfolios per device, entry and exit included
+#define PORTFOLIO_ENTRY 0               // Configured through port_entry
+#define PORTFOLIO_EXIT 1                // Configured through port_exit
+#define PORTFOLIO_NAME_LENGTH 48
+#define PORTFOLIO_TAG_LENGTH 8          // "entry", "exit", "port2".. in URLs, logs and NVS
+
+// One row of the portfolio table as configured. Rows past entry and exit
+// stay unused until a name is set for them.
+struct PortfolioConfig {
+    char name[PORTFOLIO_NAME_LENGTH];   // "" = unused
+    bool exitAlerts;                    // Alert on moves since the last alert, not on thresholds
+    uint32_t refreshInterval;           // ms between fetches, 0 = every fetch cycle
+    uint8_t priority;                   // Higher is fetched first when several are due
+};
+
+#endif
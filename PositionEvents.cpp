@@ -0,0 +1,40 @@
+#include "PositionEvents.h"
+
+// ===== STATIC VARIABLES =====
+PositionEvents* PositionEvents::_instance = nullptr;
+
+// ===== CONSTRUCTOR =====
+PositionEvents::PositionEvents()
+    : _listenerCount(0),
+      _publishedCount(0) {
+    memset(_listeners, 0, sizeof(_listeners));
+}
+
+// ===== SUBSCRIPTION =====
+bool PositionEvents::subscribe(PositionEventFn fn, void* context) {
+    if (!fn || _listenerCount >= POSITION_EVENT_MAX_LISTENERS) return false;
+
+    _listeners[_listenerCount].fn = fn;
+    _listeners[_listenerCount].context = context;
+    _listenerCount++;
+    return true;
+}
+
+void PositionEvents::publish(const PositionEvent& event) {
+    _publishedCount++;
+    for (uint8_t i = 0; i < _listenerCount; i++) {
+        _listeners[i].fn(event, _listeners[i].context);
+    }
+}
+
+// ===== STATISTICS =====
+uint8_t PositionEvents::getListenerCount() const { return _listenerCount; }
+uint32_t PositionEvents::getPublishedCount() const { return _publishedCount; }
+
+// ===== STATIC ACCESS =====
+PositionEvents& PositionEvents::getInstance() {
+    if (!_instance) {
+        _instance = new PositionEvents();
+    }
+    return *_instance;
+}
@@ -0,0 +1,60 @@
+#ifndef POSITION_EVENTS_H
+#define POSITION_EVENTS_H
+
+#include <Arduino.h>
+
+#define POSITION_EVENT_MAX_LISTENERS 4
+
+enum PositionEventType : uint8_t {
+    POSITION_EVENT_CHANGED,     // Price moved since the last parse, or the position is new
+    POSITION_EVENT_REMOVED,
+    POSITION_EVENT_PARSED       // One parse of a portfolio is complete
+};
+
+// Copy of the fields listeners need, so they depend on neither position struct
+struct PositionEvent {
+    PositionEventType type;
+    uint8_t portfolio;          // Row in the portfolio table
+    bool isExitMode;            // Alert style of that portfolio
+    uint16_t symbolId;
+    const char* symbol;
+    float price;
+    float previousPrice;        // 0 for a new position
+    float changePercent;
+    float pnlValue;
+    bool isLong;
+    float portfolioPnlPercent;  // POSITION_EVENT_PARSED only
+};
+
+typedef void (*PositionEventFn)(const PositionEvent& event, void* context);
+
+// Fan-out of the parser's per-position change events. Listeners run in the
+// parsing task right after a parse was applied and must not block.
+class PositionEvents {
+public:
+    static PositionEvents& getInstance();
+
+    // Subscribe during setup, before the scheduler starts
+    bool subscribe(PositionEventFn fn, void* context);
+    void publish(const PositionEvent& event);
+
+    // Statistics
+    uint8_t getListenerCount() const;
+    uint32_t getPublishedCount() const;
+
+private:
+    PositionEvents();
+
+    static PositionEvents* _instance;
+
+    struct Listener {
+        PositionEventFn fn;
+        void* context;
+    };
+
+    Listener _listeners[POSITION_EVENT_MAX_LISTENERS];
+    uint8_t _listenerCount;
+    uint32_t _publishedCount;
+};
+
+#endif
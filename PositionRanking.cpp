@@ -0,0 +1,126 @@
+#include "PositionRanking.h"
+
+// ===== CONSTRUCTOR =====
+PositionRanking::PositionRanking()
+    : _count(0),
+      _moveCount(0) {
+}
+
+// ===== MAINTENANCE =====
+void PositionRanking::clear() {
+    _count = 0;
+}
+
+void PositionRanking::resize(int count) {
+    count = constrain(count, 0, RANKING_MAX_POSITIONS);
+    if (count == _count) return;
+
+    for (int k = 0; k < RANK_KEY_COUNT; k++) {
+        Order& order = _orders[k];
+
+        if (count > _count) {
+            // New slots enter at the best end until their keys arrive
+            for (int i = _count; i < count; i++) {
+                order.order[i] = i;
+                order.rank[i] = i;
+                order.keys[i] = INFINITY;
+            }
+        } else {
+            // Drop slots past the end, keeping the relative order of the rest
+            int rank = 0;
+            for (int r = 0; r < _count; r++) {
+                uint8_t index = order.order[r];
+                if (index < count) {
+                    order.order[rank] = index;
+                    order.rank[index] = rank;
+                    rank++;
+                }
+            }
+        }
+    }
+
+    _count = count;
+}
+
+void PositionRanking::update(int index, float changePercent, float pnlValue) {
+    if (index < 0 || index >= _count) return;
+
+    float keys[RANK_KEY_COUNT] = {changePercent, pnlValue};
+
+    for (int k = 0; k < RANK_KEY_COUNT; k++) {
+        Order& order = _orders[k];
+
+        // NaN would break the ordering; rank it as the worst value
+        float key = isnan(keys[k]) ? -INFINITY : keys[k];
+        if (order.keys[index] == key) continue;
+
+        order.keys[index] = key;
+        reposition(order, index);
+    }
+}
+
+bool PositionRanking::before(const Order& order, uint8_t a, uint8_t b) const {
+    // Ties are broken by slot so the order is deterministic
+    if (order.keys[a] != order.keys[b]) return order.keys[a] < order.keys[b];
+    return a < b;
+}
+
+void PositionRanking::reposition(Order& order, uint8_t index) {
+    int rank = order.rank[index];
+
+    // Towards the worst end
+    while (rank > 0 && before(order, index, order.order[rank - 1])) {
+        order.order[rank] = order.order[rank - 1];
+        order.rank[order.order[rank]] = rank;
+        rank--;
+        _moveCount++;
+    }
+
+    // Towards the best end
+    while (rank < _count - 1 && before(order, order.order[rank + 1], index)) {
+        order.order[rank] = order.order[rank + 1];
+        order.rank[order.order[rank]] = rank;
+        rank++;
+        _moveCount++;
+    }
+
+    order.order[rank] = index;
+    order.rank[index] = rank;
+}
+
+// ===== QUERIES =====
+int PositionRanking::getCount() const {
+    return _count;
+}
+
+int PositionRanking::worst(RankKey key) const {
+    return at(key, 0, true);
+}
+
+int PositionRanking::best(RankKey key) const {
+    return at(key, 0, false);
+}
+
+int PositionRanking::at(RankKey key, int rank, bool worstFirst) const {
+    if (key >= RANK_KEY_COUNT || rank < 0 || rank >= _count) return -1;
+
+    const Order& order = _orders[key];
+    return order.order[worstFirst ? rank : _count - 1 - rank];
+}
+
+int PositionRanking::top(RankKey key, bool worstFirst, uint8_t* indices, int maxCount) const {
+    if (key >= RANK_KEY_COUNT || !indices) return 0;
+
+    int count = min(maxCount, _count);
+    const Order& order = _orders[key];
+
+    for (int i = 0; i < count; i++) {
+        indices[i] = order.order[worstFirst ? i : _count - 1 - i];
+    }
+    return count;
+}
+
+// ===== STATISTICS =====
+uint32_t PositionRanking::getMoveCount() const {
+    return _moveCount;
+}
@@ -0,0 +1,52 @@
+#ifndef POSITION_RANKING_H
+#define POSITION_RANKING_H
+
+#include <Arduino.h>
+
+#define RANKING_MAX_POSITIONS 100   // MAX_POSITIONS_PER_PORTFOLIO
+
+enum RankKey : uint8_t {
+    RANK_BY_CHANGE_PERCENT,
+    RANK_BY_PNL_VALUE,
+    RANK_KEY_COUNT
+};
+
+// Sorted index over position slots, one order per key, ascending (worst first).
+// Only one-byte slot indices move; the position structs stay where they are.
+// Updating a slot shifts it by insertion, so a refresh where few values
+// change rank costs O(n) instead of a full sort.
+class PositionRanking {
+public:
+    PositionRanking();
+
+    // Maintenance
+    void clear();
+    void resize(int count);                                       // Ranks slots [0, count)
+    void update(int index, float changePercent, float pnlValue);  // New keys for one slot
+
+    // Queries; results are slot indices, -1 when the ranking is empty
+    int getCount() const;
+    int worst(RankKey key = RANK_BY_CHANGE_PERCENT) const;
+    int best(RankKey key = RANK_BY_CHANGE_PERCENT) const;
+    int at(RankKey key, int rank, bool worstFirst = true) const;
+    int top(RankKey key, bool worstFirst, uint8_t* indices, int maxCount) const;
+
+    // Statistics
+    uint32_t getMoveCount() const;     // Index entries shifted since creation
+
+private:
+    struct Order {
+        uint8_t order[RANKING_MAX_POSITIONS];   // Rank -> slot
+        uint8_t rank[RANKING_MAX_POSITIONS];    // Slot -> rank
+        float keys[RANKING_MAX_POSITIONS];      // Slot -> key
+    };
+
+    bool before(const Order& order, uint8_t a, uint8_t b) const;
+    void reposition(Order& order, uint8_t index);
+
+    Order _orders[RANK_KEY_COUNT];
+    int _count;
+    uint32_t _moveCount;
+};
+
+#endif
@@ -0,0 +1,271 @@
+#include "PowerManager.h"
+#include "ConfigManager.h"
+#include <WiFi.h>
+#include <esp_sleep.h>
+#include <esp_idf_version.h>
+#include <driver/gpio.h>
+
+// ===== STATIC VARIABLES =====
+PowerManager* PowerManager::_instance = nullptr;
+
+static const char* const STATE_NAMES[POWER_STATE_COUNT] = {"active", "modem_sleep", "light_sleep"};
+static const uint16_t STATE_CURRENT[POWER_STATE_COUNT] = {
+    POWER_ACTIVE_MA, POWER_MODEM_SLEEP_MA, POWER_LIGHT_SLEEP_MA
+};
+
+// ===== CONSTRUCTOR =====
+PowerManager::PowerManager()
+    : _initialized(false),
+      _enabled(true),
+      _lightSleepSupported(false),
+      _fetching(false),
+      _holdAwake(false),
+      _charging(true),
+      _batteryPercentage(100),
+      _wasConnected(false),
+      _applied(false),
+      _lastActivity(0),
+      _state(POWER_STATE_ACTIVE),
+      _noSleepLock(nullptr),
+      _lockHeld(false),
+      _lock(nullptr),
+      _volatility(0),
+      _stateSince(0) {
+    memset(_lastPortfolioPnl, 0, sizeof(_lastPortfolioPnl));
+    memset(_hasPortfolioPnl, 0, sizeof(_hasPortfolioPnl));
+    memset(_stateTime, 0, sizeof(_stateTime));
+}
+
+// ===== INITIALIZATION =====
+bool PowerManager::begin(uint8_t wakeupPin) {
+    if (_initialized) return true;
+
+    _lock = xSemaphoreCreateMutex();
+    if (!_lock) {
+        Serial.println("Failed to create power lock");
+        return false;
+    }
+
+    _enabled = ConfigManager::getInstance().getBool("power_save", true);
+
+    // The lock is held from the start; releasing it is what allows light sleep
+    if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "power", &_noSleepLock) == ESP_OK &&
+        esp_pm_lock_acquire(_noSleepLock) == ESP_OK) {
+        _lockHeld = true;
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+        esp_pm_config_t config;
+#else
+        esp_pm_config_esp32_t config;
+#endif
+        // Light sleep only; a fixed CPU clock keeps SPI and PWM timing as is
+        config.max_freq_mhz = getCpuFrequencyMhz();
+        config.min_freq_mhz = config.max_freq_mhz;
+        config.light_sleep_enable = true;
+        _lightSleepSupported = esp_pm_configure(&config) == ESP_OK;
+    }
+
+    if (_lightSleepSupported) {
+        // Timers and WiFi beacons wake the chip on their own; the button needs a GPIO wakeup
+        gpio_wakeup_enable((gpio_num_t)wakeupPin, GPIO_INTR_LOW_LEVEL);
+        esp_sleep_enable_gpio_wakeup();
+    } else {
+        // Needs CONFIG_PM_ENABLE and tickless idle in the SDK configuration
+        Serial.println("Automatic light sleep unavailable, modem sleep only");
+    }
+
+    // Market volatility from the parser's per-parse portfolio P/L
+    PositionEvents::getInstance().subscribe(positionEventHandler, this);
+
+    _stateSince = millis();
+    _lastActivity = millis();
+    _initialized = true;
+
+    Serial.print("Power Manager initialized, power save ");
+    Serial.println(_enabled ? "on" : "off");
+    return true;
+}
+
+void PowerManager::update() {
+    if (!_initialized) return;
+
+    // WiFiManager turns power save off on every connect
+    bool connected = WiFi.status() == WL_CONNECTED;
+    if (connected != _wasConnected) {
+        _wasConnected = connected;
+        _applied = false;
+    }
+
+    setState(selectState());
+}
+
+// ===== FETCH CYCLE =====
+void PowerManager::beginFetch() {
+    if (!_initialized) return;
+    _fetching = true;
+    setState(POWER_STATE_ACTIVE);
+}
+
+void PowerManager::endFetch() {
+    if (!_initialized) return;
+    _fetching = false;
+    setState(selectState());
+}
+
+// ===== INPUTS =====
+void PowerManager::setBatteryState(uint8_t percentage, bool charging) {
+    _batteryPercentage = percentage;
+    _charging = charging;
+}
+
+void PowerManager::setHoldAwake(bool hold) {
+    _holdAwake = hold;
+}
+
+void PowerManager::noteActivity() {
+    _lastActivity = millis();
+}
+
+void PowerManager::positionEventHandler(const PositionEvent& event, void* context) {
+    if (event.type != POSITION_EVENT_PARSED || event.portfolio >= PORTFOLIO_MAX) return;
+
+    // Each row is compared with its own previous parse, whatever its alert style
+    PowerManager* self = static_cast<PowerManager*>(context);
+    uint8_t portfolio = event.portfolio;
+    if (self->_hasPortfolioPnl[portfolio]) {
+        float move = fabs(event.portfolioPnlPercent - self->_lastPortfolioPnl[portfolio]);
+        self->_volatility += POWER_VOLATILITY_ALPHA * (move - self->_volatility);
+    }
+    self->_lastPortfolioPnl[portfolio] = event.portfolioPnlPercent;
+    self->_hasPortfolioPnl[portfolio] = true;
+}
+
+// ===== STATE SELECTION =====
+PowerState PowerManager::selectState() const {
+    if (!_enabled || !isOnBattery() || _fetching) return POWER_STATE_ACTIVE;
+
+    bool webActive = millis() - _lastActivity < POWER_WEB_IDLE_TIMEOUT;
+    if (webActive || _holdAwake || !_lightSleepSupported) return POWER_STATE_MODEM_SLEEP;
+
+    return POWER_STATE_LIGHT_SLEEP;
+}
+
+void PowerManager::setState(PowerState state) {
+    if (xSemaphoreTake(_lock, portMAX_DELAY) != pdTRUE) return;
+
+    if (state != _state || !_applied) {
+        if (state != _state) {
+            Serial.print("Power state: ");
+            Serial.println(STATE_NAMES[state]);
+        }
+        accountTime();
+        applyState(state);
+        _state = state;
+        _applied = true;
+    }
+
+    xSemaphoreGive(_lock);
+}
+
+void PowerManager::applyState(PowerState state) {
+    // Modem sleep has no effect while the soft AP is up
+    switch (state) {
+        case POWER_STATE_ACTIVE:
+            WiFi.setSleep(WIFI_PS_NONE);
+            break;
+        case POWER_STATE_MODEM_SLEEP:
+            WiFi.setSleep(WIFI_PS_MIN_MODEM);       // Wakes every DTIM; short request latency
+            break;
+        case POWER_STATE_LIGHT_SLEEP:
+            WiFi.setSleep(WIFI_PS_MAX_MODEM);       // Listen interval; fewer wakeups
+            break;
+        default:
+            break;
+    }
+
+    if (!_noSleepLock) return;
+
+    bool hold = state != POWER_STATE_LIGHT_SLEEP;
+    if (hold && !_lockHeld) {
+        esp_pm_lock_acquire(_noSleepLock);
+    } else if (!hold && _lockHeld) {
+        esp_pm_lock_release(_noSleepLock);
+    }
+    _lockHeld = hold;
+}
+
+void PowerManager::accountTime() {
+    unsigned long now = millis();
+    _stateTime[_state] += now - _stateSince;
+    _stateSince = now;
+}
+
+// ===== SETTINGS =====
+bool PowerManager::isEnabled() const { return _enabled; }
+
+void PowerManager::setEnabled(bool enabled) {
+    _enabled = enabled;
+    ConfigManager::getInstance().putBool("power_save", enabled);
+}
+
+// ===== SCHEDULE =====
+uint32_t PowerManager::getFetchInterval() const {
+    if (!_enabled || !isOnBattery()) return POWER_FETCH_INTERVAL_ACTIVE;
+
+    if (_batteryPercentage <= POWER_CRITICAL_BATTERY) return POWER_FETCH_INTERVAL_CRITICAL;
+    if (_batteryPercentage <= POWER_LOW_BATTERY) return POWER_FETCH_INTERVAL_LOW;
+    if (_volatility >= POWER_VOLATILE_MOVE) return POWER_FETCH_INTERVAL_ACTIVE;
+    return POWER_FETCH_INTERVAL_CALM;
+}
+
+uint32_t PowerManager::getWebPollInterval() const {
+    return _state == POWER_STATE_LIGHT_SLEEP ? POWER_WEB_POLL_IDLE : POWER_WEB_POLL_ACTIVE;
+}
+
+// ===== STATUS =====
+PowerState PowerManager::getState() const { return _state; }
+bool PowerManager::isOnBattery() const { return !_charging; }
+bool PowerManager::isLightSleepSupported() const { return _lightSleepSupported; }
+float PowerManager::getVolatility() const { return _volatility; }
+
+const char* PowerManager::getStateName(PowerState state) const {
+    return state < POWER_STATE_COUNT ? STATE_NAMES[state] : "unknown";
+}
+
+uint16_t PowerManager::getStateCurrent(PowerState state) const {
+    return state < POWER_STATE_COUNT ? STATE_CURRENT[state] : 0;
+}
+
+uint64_t PowerManager::getStateTime(PowerState state) const {
+    if (state >= POWER_STATE_COUNT) return 0;
+
+    // Includes the time spent in the current state so far
+    uint64_t time = _stateTime[state];
+    if (state == _state) time += millis() - _stateSince;
+    return time;
+}
+
+float PowerManager::getAverageCurrent() const {
+    uint64_t total = 0;
+    double charge = 0;
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        uint64_t time = getStateTime((PowerState)i);
+        total += time;
+        charge += (double)time * STATE_CURRENT[i];
+    }
+    return total > 0 ? (float)(charge / total) : STATE_CURRENT[_state];
+}
+
+float PowerManager::getEstimatedRuntime() const {
+    float current = getAverageCurrent();
+    if (!isOnBattery() || current <= 0) return 0;
+    return POWER_BATTERY_CAPACITY_MAH * (_batteryPercentage / 100.0) / current;
+}
+
+// ===== STATIC ACCESS =====
+PowerManager& PowerManager::getInstance() {
+    if (!_instance) {
+        _instance = new PowerManager();
+    }
+    return *_instance;
+}
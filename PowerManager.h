@@ -0,0 +1,116 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <esp_pm.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "PositionEvents.h"
+#include "PortfolioTable.h"
+
+// Fetch cadence on battery
+#define POWER_FETCH_INTERVAL_ACTIVE 15000       // DATA_UPDATE_INTERVAL; USB or a moving market
+#define POWER_FETCH_INTERVAL_CALM 30000
+#define POWER_FETCH_INTERVAL_LOW 60000
+#define POWER_FETCH_INTERVAL_CRITICAL 120000
+#define POWER_LOW_BATTERY 20                    // Percent, as BatteryManager
+#define POWER_CRITICAL_BATTERY 10
+#define POWER_VOLATILE_MOVE 0.5                 // Portfolio P/L points per parse
+#define POWER_VOLATILITY_ALPHA 0.3
+
+// Web UI
+#define POWER_WEB_IDLE_TIMEOUT 60000            // No request or push client this long = idle
+#define POWER_WEB_POLL_ACTIVE 5                 // Web task period, ms
+#define POWER_WEB_POLL_IDLE 50
+
+// Estimated draw per state in mA, WROVER module with display backlight on
+#define POWER_ACTIVE_MA 125
+#define POWER_MODEM_SLEEP_MA 50
+#define POWER_LIGHT_SLEEP_MA 22
+#define POWER_BATTERY_CAPACITY_MAH 2000
+
+enum PowerState : uint8_t {
+    POWER_STATE_ACTIVE,         // Radio always on; fetching, USB power or power save off
+    POWER_STATE_MODEM_SLEEP,    // Radio sleeps between DTIM beacons; web UI in use
+    POWER_STATE_LIGHT_SLEEP,    // Modem sleep plus automatic light sleep when idle
+    POWER_STATE_COUNT
+};
+
+// Battery power scheduler. Keeps the radio on only while a fetch runs and
+// lets the chip light-sleep between fetches while nobody uses the web UI.
+// Timers (the next task release), the button GPIO and WiFi beacons wake it.
+// The fetch interval adapts to the battery level and to how much the
+// portfolio moves between parses.
+class PowerManager {
+public:
+    static PowerManager& getInstance();
+
+    bool begin(uint8_t wakeupPin);
+    void update();                      // From the WiFi task
+
+    // Fetch cycle
+    void beginFetch();
+    void endFetch();
+
+    // Inputs
+    void setBatteryState(uint8_t percentage, bool charging);
+    void setHoldAwake(bool hold);       // e.g. buzzer playing; LEDC stops in light sleep
+    void noteActivity();                // Web request served
+
+    // Settings
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+
+    // Schedule
+    uint32_t getFetchInterval() const;
+    uint32_t getWebPollInterval() const;
+
+    // Status
+    PowerState getState() const;
+    const char* getStateName(PowerState state) const;
+    bool isOnBattery() const;
+    bool isLightSleepSupported() const;
+    float getVolatility() const;
+    uint16_t getStateCurrent(PowerState state) const;
+    uint64_t getStateTime(PowerState state) const;         // ms
+    float getAverageCurrent() const;                       // mA, time-weighted
+    float getEstimatedRuntime() const;                     // Hours left on battery
+
+private:
+    PowerManager();
+
+    static PowerManager* _instance;
+    static void positionEventHandler(const PositionEvent& event, void* context);
+
+    PowerState selectState() const;
+    void setState(PowerState state);
+    void applyState(PowerState state);
+    void accountTime();
+
+    bool _initialized;
+    bool _enabled;
+    bool _lightSleepSupported;
+    bool _fetching;
+    bool _holdAwake;
+    bool _charging;
+    uint8_t _batteryPercentage;
+    bool _wasConnected;
+    bool _applied;
+    volatile unsigned long _lastActivity;
+
+    PowerState _state;
+    esp_pm_lock_handle_t _noSleepLock;
+    bool _lockHeld;
+    SemaphoreHandle_t _lock;
+
+    // Mean absolute portfolio P/L move per parse, over every row of the
+    // portfolio table; written by the parsing task
+    float _lastPortfolioPnl[PORTFOLIO_MAX];
+    bool _hasPortfolioPnl[PORTFOLIO_MAX];
+    float _volatility;
+
+    uint64_t _stateTime[POWER_STATE_COUNT];
+    unsigned long _stateSince;
+};
+
+#endif
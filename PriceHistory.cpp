@@ -0,0 +1,193 @@
+#include "PriceHistory.h"
+#include <esp_heap_caps.h>
+
+// ===== CONSTANTS =====
+#define SERIES_NONE 0xFF
+#define HISTORY_PLANE_SAMPLES (HISTORY_MAX_SERIES * POSITION_HISTORY_SIZE)
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+PriceHistoryStore::PriceHistoryStore()
+    : _prices(nullptr),
+      _changePercents(nullptr),
+      _timestamps(nullptr),
+      _seriesCount(0),
+      _sequence(0),
+      _appendCount(0),
+      _evictionCount(0),
+      _inPSRAM(false) {
+    memset(_seriesById, SERIES_NONE, sizeof(_seriesById));
+}
+
+PriceHistoryStore::~PriceHistoryStore() {
+    heap_caps_free(_prices);
+    heap_caps_free(_changePercents);
+    heap_caps_free(_timestamps);
+}
+
+// ===== INITIALIZATION =====
+bool PriceHistoryStore::begin() {
+    if (_prices) return true;
+
+    uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+    _prices = (float*)heap_caps_malloc(HISTORY_PLANE_SAMPLES * sizeof(float), caps);
+    _changePercents = (float*)heap_caps_malloc(HISTORY_PLANE_SAMPLES * sizeof(float), caps);
+    _timestamps = (uint32_t*)heap_caps_malloc(HISTORY_PLANE_SAMPLES * sizeof(uint32_t), caps);
+
+    if (!_prices || !_changePercents || !_timestamps) {
+        Serial.println("Failed to allocate price history");
+        heap_caps_free(_prices);
+        heap_caps_free(_changePercents);
+        heap_caps_free(_timestamps);
+        _prices = nullptr;
+        _changePercents = nullptr;
+        _timestamps = nullptr;
+        return false;
+    }
+
+    _inPSRAM = caps == MALLOC_CAP_SPIRAM;
+    clear();
+    return true;
+}
+
+void PriceHistoryStore::clear() {
+    memset(_seriesById, SERIES_NONE, sizeof(_seriesById));
+    _seriesCount = 0;
+    _sequence = 0;
+}
+
+// ===== RECORDING =====
+bool PriceHistoryStore::append(uint16_t symbolId, float price, float changePercent,
+                               uint32_t timestamp) {
+    if (!_prices || symbolId >= SYMBOL_TABLE_CAPACITY) return false;
+
+    int series = findSeries(symbolId);
+    if (series < 0) {
+        series = acquireSeries(symbolId);
+    }
+
+    int slot = series * POSITION_HISTORY_SIZE + _head[series];
+    _prices[slot] = price;
+    _changePercents[slot] = changePercent;
+    _timestamps[slot] = timestamp;
+
+    _head[series] = (_head[series] + 1) % POSITION_HISTORY_SIZE;
+    if (_size[series] < POSITION_HISTORY_SIZE) {
+        _size[series]++;
+    }
+    _lastUse[series] = ++_sequence;
+    _appendCount++;
+
+    return true;
+}
+
+int PriceHistoryStore::findSeries(uint16_t symbolId) const {
+    uint8_t series = _seriesById[symbolId];
+    return series == SERIES_NONE ? -1 : series;
+}
+
+int PriceHistoryStore::acquireSeries(uint16_t symbolId) {
+    int series;
+
+    if (_seriesCount < HISTORY_MAX_SERIES) {
+        series = _seriesCount++;
+    } else {
+        // Every series is taken: recycle the one that has gone longest without data
+        series = 0;
+        for (int i = 1; i < HISTORY_MAX_SERIES; i++) {
+            if (_lastUse[i] < _lastUse[series]) {
+                series = i;
+            }
+        }
+        _seriesById[_seriesSymbol[series]] = SERIES_NONE;
+        _evictionCount++;
+    }
+
+    _seriesSymbol[series] = symbolId;
+    _head[series] = 0;
+    _size[series] = 0;
+    _seriesById[symbolId] = series;
+
+    return series;
+}
+
+int PriceHistoryStore::sampleIndex(int series, int age) const {
+    int slot = (_head[series] - 1 - age + 2 * POSITION_HISTORY_SIZE) % POSITION_HISTORY_SIZE;
+    return series * POSITION_HISTORY_SIZE + slot;
+}
+
+// ===== QUERIES =====
+int PriceHistoryStore::getSampleCount(uint16_t symbolId) const {
+    if (symbolId >= SYMBOL_TABLE_CAPACITY) return 0;
+
+    int series = findSeries(symbolId);
+    return series < 0 ? 0 : _size[series];
+}
+
+bool PriceHistoryStore::getWindowStats(uint16_t symbolId, int window,
+                                       HistoryWindowStats& stats) const {
+    stats = HistoryWindowStats();
+
+    int count = getSampleCount(symbolId);
+    if (count == 0) return false;
+
+    int series = findSeries(symbolId);
+    if (window > 0 && window < count) {
+        count = window;
+    }
+
+    // Walk oldest to newest so the drawdown follows the price path
+    float sum = 0;
+    float peak = 0;
+    for (int age = count - 1; age >= 0; age--) {
+        float price = _prices[sampleIndex(series, age)];
+
+        if (age == count - 1) {
+            stats.min = price;
+            stats.max = price;
+            stats.first = price;
+            peak = price;
+        } else {
+            if (price < stats.min) stats.min = price;
+            if (price > stats.max) stats.max = price;
+            if (price > peak) peak = price;
+        }
+
+        if (peak > 0) {
+            float drawdown = (peak - price) / peak * 100.0f;
+            if (drawdown > stats.maxDrawdownPercent) stats.maxDrawdownPercent = drawdown;
+        }
+        sum += price;
+    }
+
+    stats.last = _prices[sampleIndex(series, 0)];
+    stats.mean = sum / count;
+    stats.samples = count;
+
+    return true;
+}
+
+int PriceHistoryStore::copySamples(uint16_t symbolId, float* prices, float* changePercents,
+                                   uint32_t* timestamps, int maxCount) const {
+    int count = min(getSampleCount(symbolId), maxCount);
+    if (count <= 0) return 0;
+
+    int series = findSeries(symbolId);
+    for (int i = 0; i < count; i++) {
+        int index = sampleIndex(series, count - 1 - i);
+        if (prices) prices[i] = _prices[index];
+        if (changePercents) changePercents[i] = _changePercents[index];
+        if (timestamps) timestamps[i] = _timestamps[index];
+    }
+
+    return count;
+}
+
+// ===== STATISTICS =====
+int PriceHistoryStore::getSeriesCount() const { return _seriesCount; }
+uint32_t PriceHistoryStore::getAppendCount() const { return _appendCount; }
+uint32_t PriceHistoryStore::getEvictionCount() const { return _evictionCount; }
+bool PriceHistoryStore::isInPSRAM() const { return _inPSRAM; }
+
+size_t PriceHistoryStore::getMemoryUsage() const {
+    return _prices ? HISTORY_PLANE_SAMPLES * (2 * sizeof(float) + sizeof(uint32_t)) : 0;
+}
@@ -0,0 +1,76 @@
+#ifndef PRICE_HISTORY_H
+#define PRICE_HISTORY_H
+
+#include <Arduino.h>
+#include "SymbolTable.h"
+
+#define POSITION_HISTORY_SIZE 50        // Samples kept per symbol
+#define HISTORY_MAX_SERIES 100          // MAX_POSITIONS_PER_PORTFOLIO
+
+// Summary of the most recent samples of one series
+struct HistoryWindowStats {
+    float min;
+    float max;
+    float mean;
+    float first;
+    float last;
+    float maxDrawdownPercent;   // Largest peak-to-trough drop inside the window
+    uint16_t samples;
+
+    HistoryWindowStats() : min(0), max(0), mean(0), first(0), last(0),
+                           maxDrawdownPercent(0), samples(0) {}
+};
+
+// Fixed-capacity price history, one ring buffer per symbol ID.
+// Storage is struct-of-arrays and allocated once in begin() (PSRAM when
+// present); appends never allocate and never shift memory.
+class PriceHistoryStore {
+public:
+    PriceHistoryStore();
+    ~PriceHistoryStore();
+
+    // Initialization
+    bool begin();
+    void clear();
+
+    // Recording; the least recently updated series is recycled when all are taken
+    bool append(uint16_t symbolId, float price, float changePercent, uint32_t timestamp);
+
+    // Queries; window = most recent N samples, 0 = all
+    int getSampleCount(uint16_t symbolId) const;
+    bool getWindowStats(uint16_t symbolId, int window, HistoryWindowStats& stats) const;
+    int copySamples(uint16_t symbolId, float* prices, float* changePercents,
+                    uint32_t* timestamps, int maxCount) const;     // Oldest first
+
+    // Statistics
+    int getSeriesCount() const;
+    uint32_t getAppendCount() const;
+    uint32_t getEvictionCount() const;
+    size_t getMemoryUsage() const;
+    bool isInPSRAM() const;
+
+private:
+    int findSeries(uint16_t symbolId) const;
+    int acquireSeries(uint16_t symbolId);
+    int sampleIndex(int series, int age) const;     // age 0 = newest
+
+    // Sample planes, [series * POSITION_HISTORY_SIZE + slot]
+    float* _prices;
+    float* _changePercents;
+    uint32_t* _timestamps;
+
+    // Per-series ring state
+    uint16_t _seriesSymbol[HISTORY_MAX_SERIES];
+    uint8_t _head[HISTORY_MAX_SERIES];              // Next slot to write
+    uint8_t _size[HISTORY_MAX_SERIES];
+    uint32_t _lastUse[HISTORY_MAX_SERIES];          // Append sequence for recycling
+    uint8_t _seriesById[SYMBOL_TABLE_CAPACITY];
+
+    int _seriesCount;
+    uint32_t _sequence;
+    uint32_t _appendCount;
+    uint32_t _evictionCount;
+    bool _inPSRAM;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "ResponseWriter.h"
+#include "MetricsRegistry.h"
+#include <esp_timer.h>
+
+// ===== STATIC VARIABLES =====
+char ResponseWriter::_buffer[RESPONSE_BUFFER_SIZE];
+EndpointMetrics ResponseWriter::_endpoints[RESPONSE_MAX_ENDPOINTS];
+int ResponseWriter::_endpointCount = 0;
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+ResponseWriter::ResponseWriter(WebServer& server, const char* endpoint)
+    : _server(server),
+      _metrics(findMetrics(endpoint)),
+      _length(0),
+      _bytesSent(0),
+      _startTime(esp_timer_get_time()),
+      _started(false),
+      _finished(false) {
+}
+
+ResponseWriter::~ResponseWriter() {
+    if (_started && !_finished) {
+        end();
+    }
+}
+
+// ===== RESPONSE =====
+void ResponseWriter::begin(int code, const char* contentType) {
+    if (_started) return;
+
+    _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _server.send(code, contentType, "");
+    _started = true;
+}
+
+void ResponseWriter::end() {
+    if (!_started || _finished) return;
+
+    flushBuffer();
+    _server.sendContent("");
+    _finished = true;
+
+    // One histogram for all endpoints; per-endpoint totals are below
+    static Metric* latency = MetricsRegistry::getInstance().histogram(
+        "http_response_seconds", "Web handler time until the response is sent");
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - _startTime);
+    MetricsRegistry::observe(latency, elapsed);
+
+    if (_metrics) {
+        _metrics->requests++;
+        _metrics->bytesSent += _bytesSent;
+        _metrics->lastBytes = _bytesSent;
+        _metrics->totalTimeUs += elapsed;
+        if (elapsed > _metrics->maxTimeUs) _metrics->maxTimeUs = elapsed;
+    }
+}
+
+size_t ResponseWriter::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t ResponseWriter::write(const uint8_t* data, size_t length) {
+    if (!_started) begin();
+
+    size_t remaining = length;
+    while (remaining > 0) {
+        if (_length == RESPONSE_BUFFER_SIZE) {
+            flushBuffer();
+        }
+        size_t count = min(remaining, RESPONSE_BUFFER_SIZE - _length);
+        memcpy(_buffer + _length, data, count);
+        _length += count;
+        data += count;
+        remaining -= count;
+    }
+
+    _bytesSent += length;
+    return length;
+}
+
+void ResponseWriter::flushBuffer() {
+    if (_length == 0) return;
+
+    _server.sendContent(_buffer, _length);
+    _length = 0;
+}
+
+size_t ResponseWriter::getBytesSent() const {
+    return _bytesSent;
+}
+
+// ===== METRICS =====
+EndpointMetrics* ResponseWriter::findMetrics(const char* endpoint) {
+    if (!endpoint) return nullptr;
+
+    // Endpoints are string literals, so pointers usually match first
+    for (int i = 0; i < _endpointCount; i++) {
+        if (_endpoints[i].endpoint == endpoint || strcmp(_endpoints[i].endpoint, endpoint) == 0) {
+            return &_endpoints[i];
+        }
+    }
+
+    if (_endpointCount >= RESPONSE_MAX_ENDPOINTS) return nullptr;
+
+    _endpoints[_endpointCount].endpoint = endpoint;
+    return &_endpoints[_endpointCount++];
+}
+
+int ResponseWriter::getEndpointCount() {
+    return _endpointCount;
+}
+
+const EndpointMetrics* ResponseWriter::getEndpointMetrics(int index) {
+    return index >= 0 && index < _endpointCount ? &_endpoints[index] : nullptr;
+}
+
+void ResponseWriter::printMetricsJSON(Print& out) {
+    out.print('[');
+    for (int i = 0; i < _endpointCount; i++) {
+        const EndpointMetrics& m = _endpoints[i];
+        if (i > 0) out.print(',');
+        out.print("{\"endpoint\":\"");
+        out.print(m.endpoint);
+        out.print("\",\"requests\":");
+        out.print(m.requests);
+        out.print(",\"bytes\":");
+        out.print(m.bytesSent);
+        out.print(",\"lastBytes\":");
+        out.print(m.lastBytes);
+        out.print(",\"avgTimeUs\":");
+        out.print(m.requests > 0 ? m.totalTimeUs / m.requests : 0);
+        out.print(",\"maxTimeUs\":");
+        out.print(m.maxTimeUs);
+        out.print('}');
+    }
+    out.print(']');
+}
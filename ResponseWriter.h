@@ -0,0 +1,62 @@
+#ifndef RESPONSE_WRITER_H
+#define RESPONSE_WRITER_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+#define RESPONSE_BUFFER_SIZE 1024        // Bytes per chunked-encoding write
+#define RESPONSE_MAX_ENDPOINTS 32
+
+struct EndpointMetrics {
+    const char* endpoint;
+    uint32_t requests;
+    uint32_t bytesSent;
+    uint32_t lastBytes;
+    uint32_t totalTimeUs;
+    uint32_t maxTimeUs;
+
+    EndpointMetrics() : endpoint(nullptr), requests(0), bytesSent(0), lastBytes(0),
+                        totalTimeUs(0), maxTimeUs(0) {}
+};
+
+// Chunked HTTP response body. Derives from Print so serializeJson() can write
+// straight into it; output goes from one static buffer to the client, so memory
+// use does not depend on the size of the response.
+// WebServer serves one client at a time, so only one writer may be active.
+class ResponseWriter : public Print {
+public:
+    ResponseWriter(WebServer& server, const char* endpoint);
+    ~ResponseWriter();
+
+    void begin(int code = 200, const char* contentType = "application/json");
+    void end();
+
+    // Print interface
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t length) override;
+
+    size_t getBytesSent() const;
+
+    // Per-endpoint metrics
+    static int getEndpointCount();
+    static const EndpointMetrics* getEndpointMetrics(int index);
+    static void printMetricsJSON(Print& out);
+
+private:
+    void flushBuffer();
+    static EndpointMetrics* findMetrics(const char* endpoint);
+
+    WebServer& _server;
+    EndpointMetrics* _metrics;
+    size_t _length;
+    size_t _bytesSent;
+    int64_t _startTime;
+    bool _started;
+    bool _finished;
+
+    static char _buffer[RESPONSE_BUFFER_SIZE];
+    static EndpointMetrics _endpoints[RESPONSE_MAX_ENDPOINTS];
+    static int _endpointCount;
+};
+
+#endif
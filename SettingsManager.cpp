@@ -106,6 +106,8 @@ bool SettingsManager::load() {
 bool SettingsManager::save() {
     if (!_initialized) return false;
     
+    // Unchanged fields are dropped by ConfigManager; the rest are committed
+    // together by its background task
     Serial.println("Saving settings to storage...");
     
     // Save WiFi settings
@@ -527,6 +529,7 @@ void SettingsManager::factoryReset() {
     ConfigManager::getInstance().clear();
     setDefaults();
     save();
+    ConfigManager::getInstance().flush();   // A restart usually follows
     Serial.println("Factory reset complete");
 }
 
@@ -0,0 +1,109 @@
+#include "SymbolTable.h"
+
+// ===== STATIC VARIABLES =====
+SymbolTable* SymbolTable::_instance = nullptr;
+
+// ===== CONSTRUCTOR =====
+SymbolTable::SymbolTable()
+    : _count(0),
+      _fullReported(false),
+      _lookupCount(0),
+      _probeCount(0) {
+    portMUX_INITIALIZE(&_lock);
+    memset(_names, 0, sizeof(_names));
+    for (int i = 0; i < SYMBOL_HASH_SLOTS; i++) {
+        _slots[i] = SYMBOL_ID_NONE;
+    }
+}
+
+// ===== LOOKUP =====
+uint16_t SymbolTable::intern(const char* symbol) {
+    if (!symbol || !symbol[0]) return SYMBOL_ID_NONE;
+
+    portENTER_CRITICAL(&_lock);
+
+    uint32_t slot;
+    uint16_t id = lookup(symbol, slot);
+
+    if (id == SYMBOL_ID_NONE && _count < SYMBOL_TABLE_CAPACITY) {
+        id = _count++;
+        strncpy(_names[id], symbol, SYMBOL_NAME_LENGTH - 1);
+        _names[id][SYMBOL_NAME_LENGTH - 1] = '\0';
+        _slots[slot] = id;
+    }
+
+    bool full = id == SYMBOL_ID_NONE && !_fullReported;
+    if (full) _fullReported = true;
+
+    portEXIT_CRITICAL(&_lock);
+
+    if (full) {
+        Serial.println("Warning: Symbol table full, falling back to name lookups");
+    }
+
+    return id;
+}
+
+uint16_t SymbolTable::find(const char* symbol) const {
+    if (!symbol || !symbol[0]) return SYMBOL_ID_NONE;
+
+    portENTER_CRITICAL(&_lock);
+    uint32_t slot;
+    uint16_t id = lookup(symbol, slot);
+    portEXIT_CRITICAL(&_lock);
+
+    return id;
+}
+
+const char* SymbolTable::getName(uint16_t id) const {
+    return id < _count ? _names[id] : "";
+}
+
+uint32_t SymbolTable::hash(const char* symbol) {
+    // FNV-1a over at most the stored length
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < SYMBOL_NAME_LENGTH - 1 && symbol[i]; i++) {
+        h = (h ^ (uint8_t)symbol[i]) * 16777619u;
+    }
+    return h;
+}
+
+uint16_t SymbolTable::lookup(const char* symbol, uint32_t& slot) const {
+    // Caller holds _lock; slot is left on the match or the free slot to use
+    slot = hash(symbol) & (SYMBOL_HASH_SLOTS - 1);
+    _lookupCount++;
+
+    while (_slots[slot] != SYMBOL_ID_NONE) {
+        uint16_t id = _slots[slot];
+        if (strncmp(_names[id], symbol, SYMBOL_NAME_LENGTH - 1) == 0) {
+            return id;
+        }
+        slot = (slot + 1) & (SYMBOL_HASH_SLOTS - 1);
+        _probeCount++;
+    }
+
+    return SYMBOL_ID_NONE;
+}
+
+// ===== STATISTICS =====
+uint16_t SymbolTable::getCount() const { return _count; }
+uint32_t SymbolTable::getLookupCount() const { return _lookupCount; }
+uint32_t SymbolTable::getProbeCount() const { return _probeCount; }
+
+String SymbolTable::getStatusJSON() {
+    String json = "{";
+    json += "\"symbols\":" + String(_count) + ",";
+    json += "\"capacity\":" + String(SYMBOL_TABLE_CAPACITY) + ",";
+    json += "\"lookups\":" + String(_lookupCount) + ",";
+    json += "\"probes\":" + String(_probeCount);
+    json += "}";
+    return json;
+}
+
+// ===== STATIC ACCESS =====
+SymbolTable& SymbolTable::getInstance() {
+    if (!_instance) {
+        _instance = new SymbolTable();
+    }
+    return *_instance;
+}
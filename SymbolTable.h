@@ -0,0 +1,46 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <Arduino.h>
+
+#define SYMBOL_ID_NONE 0xFFFF
+#define SYMBOL_TABLE_CAPACITY 512       // Distinct symbols over the device lifetime
+#define SYMBOL_HASH_SLOTS 1024          // Power of two, load factor <= 0.5
+#define SYMBOL_NAME_LENGTH 16
+
+// Interns position symbols to dense 16-bit IDs. Entries are never removed,
+// so an ID stays valid for the whole run and can index plain arrays.
+class SymbolTable {
+public:
+    static SymbolTable& getInstance();
+
+    // Lookup
+    uint16_t intern(const char* symbol);          // Adds unknown symbols; NONE when full
+    uint16_t find(const char* symbol) const;      // NONE if never interned
+    const char* getName(uint16_t id) const;
+
+    // Statistics
+    uint16_t getCount() const;
+    uint32_t getLookupCount() const;
+    uint32_t getProbeCount() const;
+    String getStatusJSON();
+
+private:
+    SymbolTable();
+
+    static SymbolTable* _instance;
+
+    static uint32_t hash(const char* symbol);
+    uint16_t lookup(const char* symbol, uint32_t& slot) const;
+
+    char _names[SYMBOL_TABLE_CAPACITY][SYMBOL_NAME_LENGTH];
+    uint16_t _slots[SYMBOL_HASH_SLOTS];          // Open addressing, linear probing
+    uint16_t _count;
+    bool _fullReported;
+
+    mutable portMUX_TYPE _lock;
+    mutable uint32_t _lookupCount;
+    mutable uint32_t _probeCount;
+};
+
+#endif
@@ -28,6 +28,7 @@
 // ===== TIMING CONSTANTS =====
 #define DATA_UPDATE_INTERVAL      15000      // 15 seconds
 #define DISPLAY_UPDATE_INTERVAL   2000       // 2 seconds
+#define TICKER_FRAME_INTERVAL     33         // ~30 fps position ticker
 #define ALERT_DISPLAY_TIME        10000      // 10 seconds
 #define WIFI_CONNECT_TIMEOUT      20000      // 20 seconds
 #define RECONNECT_INTERVAL        30000      // 30 seconds
@@ -74,6 +75,8 @@
 #define DISPLAY_WIDTH               240
 #define DISPLAY_HEIGHT              240
 #define DISPLAY_CRYPTO_COUNT        8
+#define DISPLAY_FRAMEBUFFER_DEFAULT true  // Compose frames in a 115 KB PSRAM sprite
+#define DISPLAY_DMA_CHUNK_PIXELS    4096  // Pixels per DMA bounce buffer (internal RAM)
 
 // ===== MEMORY SETTINGS =====
 #define MAX_POSITIONS_PER_MODE      100
@@ -83,7 +86,7 @@
 #define JSON_BUFFER_SIZE            8192
 
 // ===== NTP SETTINGS =====
-const char* NTP_SERVER = "pool.ntp.org";
+const char* const NTP_SERVER = "pool.ntp.org";
 const long GMT_OFFSET = 12600;     // 3.5 hours for Iran
 const int DAYLIGHT_OFFSET = 0;
 
@@ -118,13 +121,14 @@ enum DisplayMode {
     DISPLAY_MODE_CONNECTION,
     DISPLAY_MODE_ERROR,
     DISPLAY_MODE_SPLASH,
-    DISPLAY_MODE_SETUP
+    DISPLAY_MODE_SETUP,
+    DISPLAY_MODE_TICKER
 };
 
 enum WiFiConnectionResult {
     WIFI_CONNECT_SUCCESS,
     WIFI_CONNECT_FAILED,
-    WIFI_CONNECT_TIMEOUT,
+    WIFI_CONNECT_TIMED_OUT,
     WIFI_CONNECT_WRONG_PASSWORD,
     WIFI_CONNECT_NETWORK_NOT_FOUND
 };
@@ -301,6 +305,7 @@ struct SystemSettings {
     bool showDetails;
     bool invertDisplay;
     byte displayRotation;
+    bool displayFrameBuffer;
     
     // Exit Alert Settings
     float exitAlertPercent;
@@ -358,6 +363,7 @@ struct SystemSettings {
         showDetails = true;
         invertDisplay = false;
         displayRotation = 0;
+        displayFrameBuffer = DISPLAY_FRAMEBUFFER_DEFAULT;
         
         exitAlertPercent = DEFAULT_EXIT_ALERT_PERCENT;
         exitAlertEnabled = true;
@@ -414,6 +420,7 @@ struct SystemState {
     
     // Current state
     String currentDateTime;
+    String currentSSID;
     String alertTitle;
     String alertMessage;
     String alertSymbol;
@@ -447,6 +454,8 @@ struct SystemState {
     int currentDisplayPage;
     int totalDisplayPages;
     bool displayNeedsUpdate;
+    bool showBattery;               // Mirrors the system setting for the header
+    uint8_t buzzerVolume;           // Mirrors the alert setting for the header
     
     // Battery
     float batteryVoltage;
@@ -513,6 +522,8 @@ struct SystemState {
         currentDisplayPage = 0;
         totalDisplayPages = 1;
         displayNeedsUpdate = true;
+        showBattery = true;
+        buzzerVolume = DEFAULT_VOLUME;
         
         batteryVoltage = 0.0;
         batteryPercent = 100;
@@ -534,7 +545,6 @@ struct SystemState {
 // ===== FORWARD DECLARATIONS =====
 class DisplayManager;
 class AlertManager;
-class DataProcessor;
 class BuzzerManager;
 class LEDManager;
 class SettingsManager;
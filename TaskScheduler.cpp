@@ -0,0 +1,300 @@
+#include "TaskScheduler.h"
+#include <ArduinoJson.h>
+#include <esp_timer.h>
+
+// ===== STATIC VARIABLES =====
+TaskScheduler* TaskScheduler::_instance = nullptr;
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+TaskScheduler::TaskScheduler()
+    : _taskCount(0),
+      _initialized(false),
+      _running(false),
+      _dataMutex(nullptr),
+      _lastReportTime(0) {
+}
+
+TaskScheduler::~TaskScheduler() {
+    stop();
+    if (_dataMutex) {
+        vSemaphoreDelete(_dataMutex);
+    }
+    if (_instance == this) {
+        _instance = nullptr;
+    }
+}
+
+// ===== INITIALIZATION =====
+bool TaskScheduler::begin() {
+    Serial.println("Initializing Task Scheduler...");
+
+    _dataMutex = xSemaphoreCreateMutex();
+    if (!_dataMutex) {
+        Serial.println("Failed to create data mutex");
+        return false;
+    }
+
+    _initialized = true;
+    Serial.println("Task Scheduler initialized");
+
+    return true;
+}
+
+void TaskScheduler::update() {
+    if (!_running) return;
+
+    if (millis() - _lastReportTime > SchedulerConfig::REPORT_INTERVAL) {
+        printStatistics();
+        _lastReportTime = millis();
+    }
+}
+
+// ===== TASK MANAGEMENT =====
+int TaskScheduler::addTask(const SchedulerTaskConfig& config) {
+    if (_running) {
+        Serial.println("Cannot add task while scheduler is running");
+        return -1;
+    }
+
+    if (_taskCount >= MAX_SCHEDULER_TASKS) {
+        Serial.println("Warning: Maximum scheduler tasks reached");
+        return -1;
+    }
+
+    SchedulerTask& task = _tasks[_taskCount];
+    task.config = config;
+    if (task.config.deadlineMs == 0) {
+        task.config.deadlineMs = task.config.periodMs;
+    }
+    if (task.config.stackSize == 0) {
+        task.config.stackSize = SchedulerConfig::DEFAULT_STACK_SIZE;
+    }
+    task.stats = SchedulerTaskStats();
+    task.handle = nullptr;
+
+    return _taskCount++;
+}
+
+bool TaskScheduler::start() {
+    if (!_initialized || _running) return false;
+
+    _running = true;
+    _lastReportTime = millis();
+
+    for (int i = 0; i < _taskCount; i++) {
+        SchedulerTask& task = _tasks[i];
+
+        BaseType_t result = xTaskCreatePinnedToCore(
+            taskEntry, task.config.name, task.config.stackSize, &task,
+            task.config.priority, &task.handle, task.config.core);
+
+        if (result != pdPASS) {
+            Serial.print("Failed to start task: ");
+            Serial.println(task.config.name);
+            task.handle = nullptr;
+        }
+    }
+
+    Serial.print("Scheduler started with ");
+    Serial.print(_taskCount);
+    Serial.println(" tasks");
+
+    return true;
+}
+
+void TaskScheduler::stop() {
+    _running = false;
+
+    for (int i = 0; i < _taskCount; i++) {
+        if (_tasks[i].handle) {
+            vTaskDelete(_tasks[i].handle);
+            _tasks[i].handle = nullptr;
+        }
+    }
+}
+
+bool TaskScheduler::triggerTask(int taskId) {
+    if (taskId < 0 || taskId >= _taskCount || !_tasks[taskId].handle) return false;
+
+    // Wakes the task before its next release
+    xTaskNotifyGive(_tasks[taskId].handle);
+    return true;
+}
+
+bool TaskScheduler::setTaskPeriod(int taskId, uint32_t periodMs) {
+    if (taskId < 0 || taskId >= _taskCount || periodMs == 0) return false;
+
+    uint32_t previous = _tasks[taskId].config.periodMs;
+    if (previous == periodMs) return true;
+    _tasks[taskId].config.periodMs = periodMs;
+
+    // A longer period applies from the next release; a shorter one releases now
+    if (periodMs < previous) {
+        triggerTask(taskId);
+    }
+    return true;
+}
+
+int TaskScheduler::findTask(const char* name) const {
+    for (int i = 0; i < _taskCount; i++) {
+        if (strcmp(_tasks[i].config.name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ===== TASK EXECUTION =====
+void TaskScheduler::taskEntry(void* param) {
+    SchedulerTask* task = static_cast<SchedulerTask*>(param);
+    TaskScheduler::getInstance().runTask(*task);
+    vTaskDelete(nullptr);
+}
+
+void TaskScheduler::runTask(SchedulerTask& task) {
+    const uint32_t deadlineUs = task.config.deadlineMs * 1000;
+    int64_t release = esp_timer_get_time();
+
+    while (_running) {
+        // Re-read every cycle; setTaskPeriod() may change it
+        const int64_t periodUs = (int64_t)task.config.periodMs * 1000;
+
+        // Sleep until the next release unless triggered early
+        int64_t now = esp_timer_get_time();
+        if (release > now) {
+            TickType_t waitTicks = pdMS_TO_TICKS((release - now) / 1000);
+            if (waitTicks == 0) waitTicks = 1;
+            if (ulTaskNotifyTake(pdTRUE, waitTicks) > 0) {
+                release = esp_timer_get_time();
+            }
+        }
+
+        int64_t start = esp_timer_get_time();
+        uint32_t jitter = start > release ? (uint32_t)(start - release) : 0;
+
+        task.config.callback();
+
+        uint32_t runTime = (uint32_t)(esp_timer_get_time() - start);
+
+        // Update statistics
+        SchedulerTaskStats& stats = task.stats;
+        stats.runs++;
+        stats.lastRunTimeUs = runTime;
+        stats.lastJitterUs = jitter;
+        stats.totalJitterUs += jitter;
+        if (runTime > stats.maxRunTimeUs) stats.maxRunTimeUs = runTime;
+        if (jitter > stats.maxJitterUs) stats.maxJitterUs = jitter;
+        if (runTime > deadlineUs) stats.overruns++;
+
+        // Skip releases that passed while the task was running
+        release += periodUs;
+        now = esp_timer_get_time();
+        if (now - release > periodUs) {
+            uint32_t missed = (uint32_t)((now - release) / periodUs);
+            stats.missedReleases += missed;
+            release += (int64_t)missed * periodUs;
+        }
+    }
+}
+
+// ===== DATA GUARD =====
+bool TaskScheduler::lockData(uint32_t timeoutMs) {
+    if (!_dataMutex) return true;
+
+    TickType_t ticks = timeoutMs == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    return xSemaphoreTake(_dataMutex, ticks) == pdTRUE;
+}
+
+void TaskScheduler::unlockData() {
+    if (_dataMutex) {
+        xSemaphoreGive(_dataMutex);
+    }
+}
+
+// ===== STATISTICS =====
+const SchedulerTaskStats* TaskScheduler::getTaskStats(int taskId) const {
+    if (taskId < 0 || taskId >= _taskCount) return nullptr;
+    return &_tasks[taskId].stats;
+}
+
+void TaskScheduler::resetStatistics() {
+    for (int i = 0; i < _taskCount; i++) {
+        _tasks[i].stats = SchedulerTaskStats();
+    }
+    Serial.println("Scheduler statistics reset");
+}
+
+String TaskScheduler::getStatusJSON() {
+    DynamicJsonDocument doc(256 + _taskCount * 256);
+
+    doc["running"] = _running;
+    doc["task_count"] = _taskCount;
+
+    JsonArray tasks = doc.createNestedArray("tasks");
+    for (int i = 0; i < _taskCount; i++) {
+        const SchedulerTask& task = _tasks[i];
+        const SchedulerTaskStats& stats = task.stats;
+
+        JsonObject obj = tasks.createNestedObject();
+        obj["name"] = task.config.name;
+        obj["core"] = task.config.core;
+        obj["priority"] = task.config.priority;
+        obj["period_ms"] = task.config.periodMs;
+        obj["deadline_ms"] = task.config.deadlineMs;
+        obj["runs"] = stats.runs;
+        obj["overruns"] = stats.overruns;
+        obj["missed_releases"] = stats.missedReleases;
+        obj["last_run_us"] = stats.lastRunTimeUs;
+        obj["max_run_us"] = stats.maxRunTimeUs;
+        obj["max_jitter_us"] = stats.maxJitterUs;
+        obj["avg_jitter_us"] = stats.runs > 0 ? (uint32_t)(stats.totalJitterUs / stats.runs) : 0;
+        obj["stack_free"] = task.handle ? uxTaskGetStackHighWaterMark(task.handle) : 0;
+    }
+
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+void TaskScheduler::printStatistics() {
+    Serial.println("\n=== Scheduler Statistics ===");
+    for (int i = 0; i < _taskCount; i++) {
+        SchedulerTask& task = _tasks[i];
+        SchedulerTaskStats& stats = task.stats;
+
+        if (task.handle) {
+            stats.stackHighWater = uxTaskGetStackHighWaterMark(task.handle);
+        }
+
+        Serial.printf("%-8s core %d  runs %lu  overruns %lu  missed %lu  "
+                      "max run %lu us  max jitter %lu us  stack free %lu\n",
+                      task.config.name, task.config.core,
+                      (unsigned long)stats.runs, (unsigned long)stats.overruns,
+                      (unsigned long)stats.missedReleases,
+                      (unsigned long)stats.maxRunTimeUs,
+                      (unsigned long)stats.maxJitterUs,
+                      (unsigned long)stats.stackHighWater);
+    }
+    Serial.println("============================\n");
+}
+
+// ===== GETTERS =====
+int TaskScheduler::getTaskCount() const { return _taskCount; }
+
+const char* TaskScheduler::getTaskName(int taskId) const {
+    return taskId >= 0 && taskId < _taskCount ? _tasks[taskId].config.name : nullptr;
+}
+
+uint32_t TaskScheduler::getStackFree(int taskId) const {
+    if (taskId < 0 || taskId >= _taskCount || !_tasks[taskId].handle) return 0;
+    return uxTaskGetStackHighWaterMark(_tasks[taskId].handle);
+}
+bool TaskScheduler::isRunning() const { return _running; }
+
+// ===== STATIC ACCESS =====
+TaskScheduler& TaskScheduler::getInstance() {
+    if (!_instance) {
+        _instance = new TaskScheduler();
+    }
+    return *_instance;
+}
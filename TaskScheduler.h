@@ -0,0 +1,106 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#define MAX_SCHEDULER_TASKS 12
+
+typedef std::function<void()> SchedulerCallback;
+
+// Static description of a periodic task
+struct SchedulerTaskConfig {
+    const char* name;
+    uint32_t periodMs;       // Release interval
+    uint32_t deadlineMs;     // Max run time before counted as overrun (0 = period)
+    uint8_t priority;        // FreeRTOS priority
+    uint8_t core;            // 0 = network/protocol core, 1 = application core
+    uint32_t stackSize;
+    SchedulerCallback callback;
+};
+
+// Per-task runtime statistics
+struct SchedulerTaskStats {
+    uint32_t runs;
+    uint32_t overruns;        // Run time exceeded deadline
+    uint32_t missedReleases;  // Whole periods skipped because the task was late
+    uint32_t lastRunTimeUs;
+    uint32_t maxRunTimeUs;
+    uint32_t lastJitterUs;
+    uint32_t maxJitterUs;
+    uint64_t totalJitterUs;
+    uint32_t stackHighWater;
+
+    SchedulerTaskStats() : runs(0), overruns(0), missedReleases(0),
+                           lastRunTimeUs(0), maxRunTimeUs(0),
+                           lastJitterUs(0), maxJitterUs(0),
+                           totalJitterUs(0), stackHighWater(0) {}
+};
+
+class TaskScheduler {
+public:
+    static TaskScheduler& getInstance();
+
+    // Initialization
+    bool begin();
+    void update();
+
+    // Task management
+    int addTask(const SchedulerTaskConfig& config);
+    bool start();
+    void stop();
+    bool triggerTask(int taskId);
+    bool setTaskPeriod(int taskId, uint32_t periodMs);
+    int findTask(const char* name) const;
+
+    // Shared data guard between the fetch task and UI tasks
+    bool lockData(uint32_t timeoutMs = portMAX_DELAY);
+    void unlockData();
+
+    // Statistics
+    const SchedulerTaskStats* getTaskStats(int taskId) const;
+    void resetStatistics();
+    String getStatusJSON();
+    void printStatistics();
+
+    // Getters
+    int getTaskCount() const;
+    const char* getTaskName(int taskId) const;
+    uint32_t getStackFree(int taskId) const;
+    bool isRunning() const;
+
+private:
+    TaskScheduler();
+    ~TaskScheduler();
+
+    struct SchedulerTask {
+        SchedulerTaskConfig config;
+        SchedulerTaskStats stats;
+        TaskHandle_t handle;
+    };
+
+    static TaskScheduler* _instance;
+    static void taskEntry(void* param);
+    void runTask(SchedulerTask& task);
+
+    SchedulerTask _tasks[MAX_SCHEDULER_TASKS];
+    int _taskCount;
+    bool _initialized;
+    bool _running;
+    SemaphoreHandle_t _dataMutex;
+    unsigned long _lastReportTime;
+};
+
+// Default task layout
+namespace SchedulerConfig {
+    const uint8_t NETWORK_CORE = 0;
+    const uint8_t UI_CORE = 1;
+    const uint32_t DEFAULT_STACK_SIZE = 4096;
+    const uint32_t NETWORK_STACK_SIZE = 12288;  // TLS handshake needs headroom
+    const unsigned long REPORT_INTERVAL = 60000;  // 1 minute
+}
+
+#endif
@@ -0,0 +1,619 @@
+#include "TimeSeriesLog.h"
+#include <LittleFS.h>
+#include <esp_heap_caps.h>
+#include <math.h>
+
+// ===== CONSTANTS =====
+#define CHUNK_MAGIC 0x4C53              // "SL"
+#define CHUNK_VERSION 1
+#define SECONDS_PER_DAY 86400UL
+#define LOCAL_NONE 0xFFFF
+#define PRICE_LOG_SCALE 100000.0f       // log(price) units, 0.001% resolution
+#define PNL_SCALE 100.0f                // Cents
+#define PRICE_Q_NONE INT32_MIN          // Price <= 0
+#define FLUSH_LOCK_TIMEOUT 100
+#define MAX_SAMPLE_BYTES 21             // Worst case: own snapshot header + three varints
+#define MAX_DICTIONARY_BYTES (SYMBOL_TABLE_CAPACITY * SYMBOL_NAME_LENGTH)
+
+// On-flash chunk header, followed by payloadBytes of payload:
+//   symbolCount x [len][name]
+//   snapshots: zigzag(time delta), count, count x [local index, zigzag(dPrice), zigzag(dPnl)]
+struct __attribute__((packed)) ChunkHeader {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint32_t firstTime;
+    uint32_t lastTime;
+    uint16_t symbolCount;
+    uint16_t sampleCount;
+    uint32_t payloadBytes;
+    uint16_t checksum;                  // Fletcher-16 of the payload
+};
+
+// ===== STATIC VARIABLES =====
+bool TimeSeriesLog::_mounted = false;
+
+// ===== ENCODING HELPERS =====
+static inline uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static uint8_t* putVarint(uint8_t* out, uint32_t value) {
+    while (value >= 0x80) {
+        *out++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+static bool getVarint(const uint8_t*& in, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && in < end; shift += 7) {
+        uint8_t b = *in++;
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint16_t fletcher16(const uint8_t* data, size_t length) {
+    uint16_t a = 0, b = 0;
+    for (size_t i = 0; i < length; i++) {
+        a = (a + data[i]) % 255;
+        b = (b + a) % 255;
+    }
+    return (b << 8) | a;
+}
+
+static int32_t quantizePrice(float price) {
+    if (!(price > 0)) return PRICE_Q_NONE;
+    return (int32_t)lroundf(logf(price) * PRICE_LOG_SCALE);
+}
+
+static float dequantizePrice(int32_t q) {
+    return q == PRICE_Q_NONE ? 0 : expf(q / PRICE_LOG_SCALE);
+}
+
+static int32_t quantizePnl(float pnl) {
+    float scaled = pnl * PNL_SCALE;
+    if (isnan(scaled)) return 0;
+    if (scaled > 2147483000.0f) return INT32_MAX;
+    if (scaled < -2147483000.0f) return INT32_MIN + 1;
+    return (int32_t)lroundf(scaled);
+}
+
+static void* allocBuffer(size_t size) {
+    uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+    return heap_caps_malloc(size, caps);
+}
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+TimeSeriesLog::TimeSeriesLog()
+    : _pending(nullptr),
+      _pendingCount(0),
+      _scratch(nullptr),
+      _scratchSize(0),
+      _localById(nullptr),
+      _idByLocal(nullptr),
+      _nameByLocal(nullptr),
+      _lastPriceQ(nullptr),
+      _lastPnlQ(nullptr),
+      _dayCount(0),
+      _lastRecordTime(0),
+      _lock(nullptr) {
+    _directory[0] = '\0';
+}
+
+TimeSeriesLog::~TimeSeriesLog() {
+    heap_caps_free(_pending);
+    heap_caps_free(_scratch);
+    heap_caps_free(_localById);
+    heap_caps_free(_idByLocal);
+    heap_caps_free(_nameByLocal);
+    heap_caps_free(_lastPriceQ);
+    heap_caps_free(_lastPnlQ);
+    if (_lock) {
+        vSemaphoreDelete(_lock);
+    }
+}
+
+// ===== INITIALIZATION =====
+bool TimeSeriesLog::mountFilesystem() {
+    if (_mounted) return true;
+
+    if (!LittleFS.begin(true, HISTORY_LOG_MOUNT, 4, HISTORY_LOG_PARTITION)) {
+        Serial.println("History partition mount failed");
+        return false;
+    }
+
+    Serial.print("History partition: ");
+    Serial.print(LittleFS.usedBytes() / 1024);
+    Serial.print(" / ");
+    Serial.print(LittleFS.totalBytes() / 1024);
+    Serial.println(" KB used");
+
+    _mounted = true;
+    return true;
+}
+
+bool TimeSeriesLog::begin(const char* directory) {
+    if (_pending) return true;
+    if (!mountFilesystem()) return false;
+
+    strncpy(_directory, directory, sizeof(_directory) - 1);
+    _directory[sizeof(_directory) - 1] = '\0';
+
+    _scratchSize = HISTORY_LOG_BUFFER_SAMPLES * MAX_SAMPLE_BYTES + MAX_DICTIONARY_BYTES;
+    _pending = (PendingSample*)allocBuffer(HISTORY_LOG_BUFFER_SAMPLES * sizeof(PendingSample));
+    _scratch = (uint8_t*)allocBuffer(_scratchSize);
+    _localById = (uint16_t*)allocBuffer(SYMBOL_TABLE_CAPACITY * sizeof(uint16_t));
+    _idByLocal = (uint16_t*)allocBuffer(SYMBOL_TABLE_CAPACITY * sizeof(uint16_t));
+    _nameByLocal = (const char**)allocBuffer(SYMBOL_TABLE_CAPACITY * sizeof(const char*));
+    _lastPriceQ = (int32_t*)allocBuffer(SYMBOL_TABLE_CAPACITY * sizeof(int32_t));
+    _lastPnlQ = (int32_t*)allocBuffer(SYMBOL_TABLE_CAPACITY * sizeof(int32_t));
+    _lock = xSemaphoreCreateMutex();
+
+    if (!_pending || !_scratch || !_localById || !_idByLocal || !_nameByLocal ||
+        !_lastPriceQ || !_lastPnlQ || !_lock) {
+        Serial.println("Failed to allocate history log buffers");
+        heap_caps_free(_pending);
+        _pending = nullptr;
+        return false;
+    }
+
+    for (int i = 0; i < SYMBOL_TABLE_CAPACITY; i++) {
+        _localById[i] = LOCAL_NONE;
+    }
+
+    if (!LittleFS.exists(_directory)) {
+        LittleFS.mkdir(_directory);
+    }
+
+    loadIndex();
+
+    Serial.print("History log ");
+    Serial.print(_directory);
+    Serial.print(": ");
+    Serial.print(_dayCount);
+    Serial.print(" days, ");
+    Serial.print(getBytesUsed());
+    Serial.println(" bytes");
+
+    return true;
+}
+
+bool TimeSeriesLog::isReady() const {
+    return _pending != nullptr;
+}
+
+// ===== DAY INDEX =====
+void TimeSeriesLog::dayPath(uint32_t day, char* path, size_t size) const {
+    snprintf(path, size, "%s/%lu.bin", _directory, (unsigned long)day);
+}
+
+bool TimeSeriesLog::loadIndex() {
+    _dayCount = 0;
+
+    File dir = LittleFS.open(_directory);
+    if (!dir || !dir.isDirectory()) return false;
+
+    File file = dir.openNextFile();
+    while (file) {
+        const char* name = file.name();
+        const char* base = strrchr(name, '/');
+        base = base ? base + 1 : name;
+
+        char* end;
+        uint32_t day = strtoul(base, &end, 10);
+        file.close();
+
+        if (end != base && strcmp(end, ".bin") == 0) {
+            DayEntry* entry = addDay(day);
+            if (entry && !scanDay(*entry)) {
+                _stats.corruptChunks++;
+            }
+        }
+        file = dir.openNextFile();
+    }
+    dir.close();
+
+    if (_dayCount > 0) {
+        _lastRecordTime = _days[_dayCount - 1].lastTime;
+    }
+    return true;
+}
+
+bool TimeSeriesLog::scanDay(DayEntry& entry) {
+    char path[32];
+    dayPath(entry.day, path, sizeof(path));
+
+    File file = LittleFS.open(path, FILE_READ);
+    if (!file) return false;
+
+    // Only headers are read; payloads are skipped with seek
+    size_t size = file.size();
+    size_t offset = 0;
+    bool clean = true;
+    ChunkHeader header;
+
+    while (offset + sizeof(header) <= size) {
+        if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+            header.magic != CHUNK_MAGIC || header.version != CHUNK_VERSION ||
+            offset + sizeof(header) + header.payloadBytes > size) {
+            clean = false;
+            break;
+        }
+
+        if (entry.firstTime == 0 || header.firstTime < entry.firstTime) entry.firstTime = header.firstTime;
+        if (header.lastTime > entry.lastTime) entry.lastTime = header.lastTime;
+
+        offset += sizeof(header) + header.payloadBytes;
+        file.seek(offset);
+    }
+
+    entry.bytes = size;
+    file.close();
+    return clean && offset == size;
+}
+
+TimeSeriesLog::DayEntry* TimeSeriesLog::addDay(uint32_t day) {
+    int pos = _dayCount;
+    while (pos > 0 && _days[pos - 1].day >= day) {
+        if (_days[pos - 1].day == day) return &_days[pos - 1];
+        pos--;
+    }
+
+    if (_dayCount >= HISTORY_LOG_MAX_DAYS) {
+        if (pos == 0) return nullptr;   // Older than everything we keep
+        removeOldestDay();
+        pos--;
+    }
+
+    memmove(&_days[pos + 1], &_days[pos], (_dayCount - pos) * sizeof(DayEntry));
+    _days[pos].day = day;
+    _days[pos].bytes = 0;
+    _days[pos].firstTime = 0;
+    _days[pos].lastTime = 0;
+    _dayCount++;
+
+    return &_days[pos];
+}
+
+void TimeSeriesLog::removeOldestDay() {
+    if (_dayCount == 0) return;
+
+    char path[32];
+    dayPath(_days[0].day, path, sizeof(path));
+    LittleFS.remove(path);
+
+    memmove(&_days[0], &_days[1], (_dayCount - 1) * sizeof(DayEntry));
+    _dayCount--;
+    _stats.daysPruned++;
+}
+
+void TimeSeriesLog::pruneDays() {
+    // Age limit first, then keep headroom for the other log sharing the partition
+    while (_dayCount > 1 &&
+           _days[_dayCount - 1].day - _days[0].day >= HISTORY_LOG_RETENTION_DAYS) {
+        removeOldestDay();
+    }
+    while (_dayCount > 1 &&
+           LittleFS.usedBytes() * 100 > LittleFS.totalBytes() * HISTORY_LOG_MAX_USAGE_PERCENT) {
+        removeOldestDay();
+    }
+}
+
+// ===== RECORDING =====
+bool TimeSeriesLog::isDue(uint32_t now) const {
+    return _lastRecordTime == 0 || now < _lastRecordTime ||
+           now - _lastRecordTime >= HISTORY_LOG_INTERVAL;
+}
+
+bool TimeSeriesLog::record(uint32_t timestamp, uint16_t symbolId, float price, float pnlValue) {
+    if (!_pending || symbolId >= SYMBOL_TABLE_CAPACITY) return false;
+
+    // A chunk never spans two day files
+    if (_pendingCount > 0 &&
+        (timestamp / SECONDS_PER_DAY != _pending[0].timestamp / SECONDS_PER_DAY ||
+         _pendingCount >= HISTORY_LOG_BUFFER_SAMPLES)) {
+        flush();
+    }
+
+    if (_pendingCount >= HISTORY_LOG_BUFFER_SAMPLES) {
+        _stats.samplesDropped++;
+        return false;
+    }
+
+    PendingSample& sample = _pending[_pendingCount];
+    sample.timestamp = timestamp;
+    sample.symbolId = symbolId;
+    sample.priceQ = quantizePrice(price);
+    sample.pnlQ = quantizePnl(pnlValue);
+    _pendingCount = _pendingCount + 1;
+
+    _lastRecordTime = timestamp;
+    _stats.samplesLogged++;
+    return true;
+}
+
+void TimeSeriesLog::update(uint32_t now) {
+    if (_pendingCount == 0) return;
+
+    if (now < _pending[0].timestamp ||
+        now - _pending[0].timestamp >= HISTORY_LOG_FLUSH_INTERVAL ||
+        now / SECONDS_PER_DAY != _pending[0].timestamp / SECONDS_PER_DAY) {
+        flush();
+    }
+}
+
+bool TimeSeriesLog::flush() {
+    if (!_pending || _pendingCount == 0) return true;
+
+    // A running query holds the lock; keep batching unless the buffer is full
+    if (xSemaphoreTake(_lock, pdMS_TO_TICKS(FLUSH_LOCK_TIMEOUT)) != pdTRUE) {
+        return false;
+    }
+
+    ChunkHeader header;
+    header.magic = CHUNK_MAGIC;
+    header.version = CHUNK_VERSION;
+    header.reserved = 0;
+    header.firstTime = _pending[0].timestamp;
+    header.lastTime = _pending[_pendingCount - 1].timestamp;
+    header.sampleCount = _pendingCount;
+
+    uint16_t symbolCount;
+    header.payloadBytes = encodeChunk(symbolCount);
+    header.symbolCount = symbolCount;
+    header.checksum = fletcher16(_scratch, header.payloadBytes);
+
+    uint32_t day = header.firstTime / SECONDS_PER_DAY;
+    char path[32];
+    dayPath(day, path, sizeof(path));
+
+    bool success = false;
+    File file = LittleFS.open(path, FILE_APPEND);
+    if (file) {
+        size_t written = file.write((const uint8_t*)&header, sizeof(header));
+        written += file.write(_scratch, header.payloadBytes);
+        file.close();
+        success = written == sizeof(header) + header.payloadBytes;
+    }
+
+    if (success) {
+        DayEntry* entry = addDay(day);
+        if (entry) {
+            entry->bytes += sizeof(header) + header.payloadBytes;
+            if (entry->firstTime == 0 || header.firstTime < entry->firstTime) entry->firstTime = header.firstTime;
+            if (header.lastTime > entry->lastTime) entry->lastTime = header.lastTime;
+        }
+        _stats.chunksWritten++;
+        _stats.bytesWritten += sizeof(header) + header.payloadBytes;
+        pruneDays();
+    } else {
+        Serial.print("History log write failed: ");
+        Serial.println(path);
+        _stats.samplesDropped += _pendingCount;
+    }
+
+    _pendingCount = 0;
+    xSemaphoreGive(_lock);
+    return success;
+}
+
+size_t TimeSeriesLog::encodeChunk(uint16_t& symbolCount) {
+    uint8_t* out = _scratch;
+    SymbolTable& symbols = SymbolTable::getInstance();
+
+    // Dictionary of the symbols used in this chunk
+    symbolCount = 0;
+    for (int i = 0; i < _pendingCount; i++) {
+        uint16_t id = _pending[i].symbolId;
+        if (_localById[id] != LOCAL_NONE) continue;
+
+        _localById[id] = symbolCount;
+        _idByLocal[symbolCount] = id;
+        _lastPriceQ[symbolCount] = 0;
+        _lastPnlQ[symbolCount] = 0;
+        symbolCount++;
+
+        const char* name = symbols.getName(id);
+        size_t len = strnlen(name, SYMBOL_NAME_LENGTH - 1);
+        *out++ = (uint8_t)len;
+        memcpy(out, name, len);
+        out += len;
+    }
+
+    // Snapshots of samples sharing a timestamp
+    uint32_t prevTime = _pending[0].timestamp;
+    int i = 0;
+    while (i < _pendingCount) {
+        uint32_t t = _pending[i].timestamp;
+        int j = i;
+        while (j < _pendingCount && _pending[j].timestamp == t) j++;
+
+        out = putVarint(out, zigzag((int32_t)(t - prevTime)));
+        out = putVarint(out, j - i);
+        for (; i < j; i++) {
+            uint16_t local = _localById[_pending[i].symbolId];
+            out = putVarint(out, local);
+            out = putVarint(out, zigzag((int32_t)((uint32_t)_pending[i].priceQ - (uint32_t)_lastPriceQ[local])));
+            out = putVarint(out, zigzag((int32_t)((uint32_t)_pending[i].pnlQ - (uint32_t)_lastPnlQ[local])));
+            _lastPriceQ[local] = _pending[i].priceQ;
+            _lastPnlQ[local] = _pending[i].pnlQ;
+        }
+        prevTime = t;
+    }
+
+    for (uint16_t k = 0; k < symbolCount; k++) {
+        _localById[_idByLocal[k]] = LOCAL_NONE;
+    }
+
+    return out - _scratch;
+}
+
+// ===== QUERIES =====
+int TimeSeriesLog::query(uint32_t from, uint32_t to, HistoryRecordFn callback, void* context,
+                         bool internSymbols) {
+    if (!_pending || !callback || from > to) return 0;
+
+    xSemaphoreTake(_lock, portMAX_DELAY);
+
+    int delivered = 0;
+    bool stopped = false;
+    uint32_t fromDay = from / SECONDS_PER_DAY;
+    uint32_t toDay = to / SECONDS_PER_DAY;
+
+    for (int d = 0; d < _dayCount && !stopped; d++) {
+        if (_days[d].day < fromDay || _days[d].day > toDay) continue;
+        if (_days[d].lastTime < from || _days[d].firstTime > to) continue;
+
+        char path[32];
+        dayPath(_days[d].day, path, sizeof(path));
+        File file = LittleFS.open(path, FILE_READ);
+        if (!file) continue;
+
+        size_t size = file.size();
+        size_t offset = 0;
+        ChunkHeader header;
+
+        while (offset + sizeof(header) <= size) {
+            if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+                header.magic != CHUNK_MAGIC || header.version != CHUNK_VERSION ||
+                header.payloadBytes > _scratchSize ||
+                header.symbolCount > SYMBOL_TABLE_CAPACITY ||
+                offset + sizeof(header) + header.payloadBytes > size) {
+                _stats.corruptChunks++;
+                break;
+            }
+            offset += sizeof(header) + header.payloadBytes;
+
+            // Chunks outside the range are skipped without reading the payload
+            if (header.lastTime < from || header.firstTime > to) {
+                file.seek(offset);
+                continue;
+            }
+
+            if (file.read(_scratch, header.payloadBytes) != header.payloadBytes ||
+                fletcher16(_scratch, header.payloadBytes) != header.checksum) {
+                _stats.corruptChunks++;
+                file.seek(offset);
+                continue;
+            }
+
+            if (!decodeChunk(header.firstTime, header.symbolCount, header.payloadBytes,
+                             from, to, callback, context, internSymbols, delivered)) {
+                stopped = true;
+                break;
+            }
+        }
+        file.close();
+    }
+
+    // The pending batch only grows while the lock keeps flush() out
+    int pendingCount = _pendingCount;
+    HistoryRecord record;
+    for (int i = 0; i < pendingCount && !stopped; i++) {
+        const PendingSample& sample = _pending[i];
+        if (sample.timestamp < from || sample.timestamp > to) continue;
+
+        record.timestamp = sample.timestamp;
+        record.symbolId = sample.symbolId;
+        record.symbol = SymbolTable::getInstance().getName(sample.symbolId);
+        record.price = dequantizePrice(sample.priceQ);
+        record.pnlValue = sample.pnlQ / PNL_SCALE;
+        delivered++;
+        stopped = !callback(record, context);
+    }
+
+    xSemaphoreGive(_lock);
+    return delivered;
+}
+
+bool TimeSeriesLog::decodeChunk(uint32_t firstTime, uint16_t symbolCount, size_t payloadBytes,
+                                uint32_t from, uint32_t to, HistoryRecordFn callback,
+                                void* context, bool internSymbols, int& delivered) {
+    const uint8_t* in = _scratch;
+    const uint8_t* end = _scratch + payloadBytes;
+    SymbolTable& symbols = SymbolTable::getInstance();
+
+    // IDs are per run, so the dictionary is resolved against this run's table.
+    // Only a restore takes IDs for symbols this run has not seen; a web
+    // query must not use up the table, so its records carry the name.
+    for (uint16_t k = 0; k < symbolCount; k++) {
+        if (in >= end || *in >= SYMBOL_NAME_LENGTH || in + 1 + *in > end) {
+            _stats.corruptChunks++;
+            return true;
+        }
+        // Terminated in place: the name moves onto its length byte
+        uint8_t len = *in;
+        char* name = (char*)_scratch + (in - _scratch);
+        memmove(name, in + 1, len);
+        name[len] = '\0';
+        in += 1 + len;
+
+        _idByLocal[k] = internSymbols ? symbols.intern(name) : symbols.find(name);
+        _nameByLocal[k] = name;
+        _lastPriceQ[k] = 0;
+        _lastPnlQ[k] = 0;
+    }
+
+    HistoryRecord record;
+    uint32_t t = firstTime;
+    uint32_t value, count;
+
+    while (in < end) {
+        if (!getVarint(in, end, value)) break;
+        t += unzigzag(value);
+        if (!getVarint(in, end, count)) break;
+
+        for (uint32_t n = 0; n < count; n++) {
+            uint32_t local, dPrice, dPnl;
+            if (!getVarint(in, end, local) || local >= symbolCount ||
+                !getVarint(in, end, dPrice) || !getVarint(in, end, dPnl)) {
+                _stats.corruptChunks++;
+                return true;
+            }
+            _lastPriceQ[local] = (int32_t)((uint32_t)_lastPriceQ[local] + (uint32_t)unzigzag(dPrice));
+            _lastPnlQ[local] = (int32_t)((uint32_t)_lastPnlQ[local] + (uint32_t)unzigzag(dPnl));
+
+            if (t < from || t > to) continue;
+
+            record.timestamp = t;
+            record.symbolId = _idByLocal[local];
+            record.symbol = _nameByLocal[local];
+            record.price = dequantizePrice(_lastPriceQ[local]);
+            record.pnlValue = _lastPnlQ[local] / PNL_SCALE;
+            delivered++;
+
+            if (!callback(record, context)) return false;
+        }
+    }
+
+    return true;
+}
+
+// ===== GETTERS =====
+int TimeSeriesLog::getDayCount() const { return _dayCount; }
+const HistoryLogStats& TimeSeriesLog::getStats() const { return _stats; }
+
+uint32_t TimeSeriesLog::getFirstTime() const {
+    return _dayCount > 0 ? _days[0].firstTime : 0;
+}
+
+uint32_t TimeSeriesLog::getLastTime() const {
+    return _dayCount > 0 ? _days[_dayCount - 1].lastTime : 0;
+}
+
+size_t TimeSeriesLog::getBytesUsed() const {
+    size_t bytes = 0;
+    for (int i = 0; i < _dayCount; i++) {
+        bytes += _days[i].bytes;
+    }
+    return bytes;
+}
@@ -0,0 +1,126 @@
+#ifndef TIME_SERIES_LOG_H
+#define TIME_SERIES_LOG_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "SymbolTable.h"
+
+#define HISTORY_LOG_PARTITION "history"     // LittleFS partition in partitions.csv
+#define HISTORY_LOG_MOUNT "/history"
+#define HISTORY_LOG_INTERVAL 600            // Seconds between logged snapshots
+#define HISTORY_LOG_FLUSH_INTERVAL 3600     // Seconds of samples batched per flash write
+#define HISTORY_LOG_BUFFER_SAMPLES 1024
+#define HISTORY_LOG_RETENTION_DAYS 30
+#define HISTORY_LOG_MAX_USAGE_PERCENT 90
+#define HISTORY_LOG_MAX_DAYS (HISTORY_LOG_RETENTION_DAYS + 2)
+#define HISTORY_LOG_MIN_TIME 1600000000UL   // Earlier clocks are not NTP synced yet
+
+// One decoded sample
+struct HistoryRecord {
+    uint32_t timestamp;     // Unix time, seconds
+    uint16_t symbolId;      // SYMBOL_ID_NONE if not interned this run
+    const char* symbol;     // Valid during the callback
+    float price;
+    float pnlValue;
+};
+
+// Query callback; return false to stop the query
+typedef bool (*HistoryRecordFn)(const HistoryRecord& record, void* context);
+
+struct HistoryLogStats {
+    uint32_t samplesLogged;
+    uint32_t samplesDropped;
+    uint32_t chunksWritten;
+    uint32_t bytesWritten;
+    uint32_t daysPruned;
+    uint32_t corruptChunks;
+
+    HistoryLogStats() : samplesLogged(0), samplesDropped(0), chunksWritten(0),
+                        bytesWritten(0), daysPruned(0), corruptChunks(0) {}
+};
+
+// Append-only PnL history on LittleFS, one file per UTC day.
+// Samples are batched in RAM and written as self-contained chunks: a symbol
+// dictionary followed by delta-encoded price/PnL varints, so a flash write
+// happens about once per HISTORY_LOG_FLUSH_INTERVAL. Chunk headers carry the
+// time range, which lets range queries skip whole chunks and days.
+class TimeSeriesLog {
+public:
+    TimeSeriesLog();
+    ~TimeSeriesLog();
+
+    // Initialization; directory is a short path such as "/entry"
+    bool begin(const char* directory);
+    bool isReady() const;
+
+    // Recording; samples sharing a timestamp form one snapshot
+    bool isDue(uint32_t now) const;
+    bool record(uint32_t timestamp, uint16_t symbolId, float price, float pnlValue);
+    void update(uint32_t now);
+    bool flush();
+
+    // Queries, oldest first, including the batch not yet on flash;
+    // returns the number of records delivered. Logged symbols are only looked
+    // up, unless internSymbols is set when restoring history at boot
+    int query(uint32_t from, uint32_t to, HistoryRecordFn callback, void* context,
+              bool internSymbols = false);
+
+    // Index
+    int getDayCount() const;
+    uint32_t getFirstTime() const;
+    uint32_t getLastTime() const;
+    size_t getBytesUsed() const;
+    const HistoryLogStats& getStats() const;
+
+private:
+    struct PendingSample {
+        uint32_t timestamp;
+        uint16_t symbolId;
+        int32_t priceQ;
+        int32_t pnlQ;
+    };
+
+    struct DayEntry {
+        uint32_t day;           // Unix time / 86400
+        uint32_t bytes;
+        uint32_t firstTime;
+        uint32_t lastTime;
+    };
+
+    static bool mountFilesystem();
+    void dayPath(uint32_t day, char* path, size_t size) const;
+    bool loadIndex();
+    bool scanDay(DayEntry& entry);
+    DayEntry* addDay(uint32_t day);
+    void removeOldestDay();
+    void pruneDays();
+    size_t encodeChunk(uint16_t& symbolCount);
+    bool decodeChunk(uint32_t firstTime, uint16_t symbolCount, size_t payloadBytes,
+                     uint32_t from, uint32_t to, HistoryRecordFn callback,
+                     void* context, bool internSymbols, int& delivered);
+
+    char _directory[16];
+
+    // Pending batch and encoder state, allocated once in begin()
+    PendingSample* _pending;
+    volatile int _pendingCount;         // Published after the sample is filled in
+    uint8_t* _scratch;                  // Encoded chunk payload
+    size_t _scratchSize;
+    uint16_t* _localById;               // Symbol ID -> chunk dictionary index
+    uint16_t* _idByLocal;
+    const char** _nameByLocal;          // Dictionary names, terminated in the scratch buffer
+    int32_t* _lastPriceQ;               // Per dictionary entry, for delta coding
+    int32_t* _lastPnlQ;
+
+    DayEntry _days[HISTORY_LOG_MAX_DAYS];
+    int _dayCount;
+    uint32_t _lastRecordTime;
+
+    SemaphoreHandle_t _lock;
+    HistoryLogStats _stats;
+
+    static bool _mounted;
+};
+
+#endif
@@ -1,5 +1,6 @@
 // Utilities.cpp
 #include "Utilities.h"
+#include "NumberFormat.h"
 
 String urlEncode(const String& str) {
     String encoded = "";
@@ -192,8 +193,8 @@ String intToHexString(int value, int digits) {
 }
 
 String floatToString(float value, int precision) {
-    char buffer[20];
-    dtostrf(value, 0, precision, buffer);
+    char buffer[NUMBER_TEXT_LENGTH];
+    NumberFormat::format(buffer, sizeof(buffer), value, NumberSpec(precision < 0 ? 0 : precision));
     return String(buffer);
 }
 
@@ -9,12 +9,37 @@
 #include "BatteryManager.h"
 #include "TimeManager.h"
 #include "APIManager.h"
+#include "PowerManager.h"
+#include "TaskScheduler.h"
+#include "LanFanout.h"
 // در ابتدای فایل WebInterface.cpp
 #include "DataManager.h"
 #include <ArduinoJson.h>
 #include <FS.h>
 #include <SPIFFS.h>
 #include <Update.h>
+#include "ResponseWriter.h"
+#include "MetricsRegistry.h"
+#include "CycleArena.h"
+#include "PositionEvents.h"
+#include "DashboardPage.h"
+#include "NumberFormat.h"
+#include <WebSocketsServer.h>
+#include <esp_heap_caps.h>
+
+// ===== CONSTANTS =====
+#define HISTORY_DEFAULT_POINTS 300
+#define HISTORY_MAX_POINTS 2000
+#define HISTORY_DEFAULT_SPAN 86400      // Seconds when no range is given
+#define PUSH_PORT 81
+#define PUSH_BUFFER_SIZE 28672          // Full snapshot of 100 positions
+#define PUSH_HEARTBEAT_INTERVAL 15000
+#define STATIC_MAX_ASSETS 32
+#define STATIC_PATH_LENGTH 48
+#define STATIC_HASH_LENGTH 8            // Content hash in names from extra_script.py
+#define CACHE_IMMUTABLE "public, max-age=31536000, immutable"
+#define CACHE_REVALIDATE "no-cache"
+#define ETAG_MSGPACK_SALT 0x80000000    // Gives the MessagePack body of a generation its own ETag
 
 // ===== STATIC VARIABLES =====
 WebServer WebInterface::_server(80);
@@ -23,7 +48,82 @@ String WebInterface::_authUsername = "";
 String WebInterface::_authPassword = "";
 bool WebInterface::_authEnabled = false;
 
+// ===== PUSH CHANNEL =====
+// Dashboards connect to ws://<device>:81/ (JSON text frames) or
+// ws://<device>:81/?format=msgpack (MessagePack binary frames) and receive
+//   {"type":"snapshot"|"delta","mode":"entry"|"exit"|"port2"..,"summary":..,"positions":[..],"removed":[..]}
+//   {"type":"alerts","alerts":[{"mode":..,"symbol":..}, ..]}
+// Every client has its own baseline, so a delta holds only the positions
+// that changed since the last frame sent to that client.
+static WebSocketsServer _pushServer(PUSH_PORT);
+
+struct PushClient {
+    bool connected;
+    bool msgpack;
+    bool snapshotPending;
+    uint32_t alertSequence;             // Sequence of the last alert sent
+    uint32_t baseline[PORTFOLIO_MAX];   // Snapshot generation of the last frame, per portfolio
+    uint32_t* sentHash;                 // [portfolio][symbol ID] of the last frame, 0 = not sent
+};
+
+struct PushState {
+    uint32_t lastGeneration[PORTFOLIO_MAX];     // Snapshot generation last pushed, per portfolio
+    PushClient clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+    uint32_t messagesSent;
+    uint32_t bytesSent;
+};
+static PushState _push;
+
+// Print over the preallocated push buffer
+struct PushBuffer : public Print {
+    char* data;
+    size_t length;
+    bool overflow;
+    
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* bytes, size_t count) override {
+        if (!data || length + count > PUSH_BUFFER_SIZE) {
+            overflow = true;
+            return 0;
+        }
+        memcpy(data + length, bytes, count);
+        length += count;
+        return count;
+    }
+    void reset() {
+        length = 0;
+        overflow = false;
+    }
+};
+static PushBuffer _pushBuffer;
+
+static void handlePushEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
+
+// ===== STATIC ASSETS =====
+// extra_script.py stores data/ gzipped and gives scripts and stylesheets
+// content-hashed names (script.3f2a9c1e.js). The files are indexed once at
+// mount, so a request costs one open and a revalidation costs none.
+struct StaticAsset {
+    char path[STATIC_PATH_LENGTH];      // Request path, without ".gz"
+    char alias[STATIC_PATH_LENGTH];     // Path without the content hash, "" if unhashed
+    uint32_t etag;                      // FNV-1a of the stored bytes
+    bool gzip;
+};
+static StaticAsset _assets[STATIC_MAX_ASSETS];
+static uint8_t _assetCount = 0;
+static uint32_t _dashboardETag = 0;
+static uint32_t _bootTag = 0;           // Keeps generation ETags from matching across reboots
+static AlertManager* _alerts = nullptr; // Owned by the sketch
+
+static void indexAssets();
+static const StaticAsset* findAsset(const String& path);
+static bool sendNotModified(WebServer& server, uint32_t etag, bool immutable);
+
 // ===== INITIALIZATION =====
+void WebInterface::attachAlerts(AlertManager& alerts) {
+    _alerts = &alerts;
+}
+
 bool WebInterface::begin(bool enableAuth, const String& username, const String& password) {
     Serial.println("Initializing Web Interface...");
     
@@ -38,12 +138,35 @@ bool WebInterface::begin(bool enableAuth, const String& username, const String&
     _authUsername = username;
     _authPassword = password;
     
+    _bootTag = esp_random();
+    
     // Setup all routes
     setupRoutes();
     
     // Start server
     _server.begin();
     
+    // Accept selects JSON or MessagePack responses, If-None-Match revalidates assets
+    const char* headers[] = {"Accept", "If-None-Match"};
+    _server.collectHeaders(headers, 2);
+    
+    // Push channel for dashboards; the buffers are allocated once
+    uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+    _pushBuffer.data = (char*)heap_caps_malloc(PUSH_BUFFER_SIZE, caps);
+    _pushBuffer.reset();
+    memset(&_push, 0, sizeof(_push));
+    uint32_t* hashes = (uint32_t*)heap_caps_calloc(WEBSOCKETS_SERVER_CLIENT_MAX * PORTFOLIO_MAX * SYMBOL_TABLE_CAPACITY,
+                                                   sizeof(uint32_t), caps);
+    for (int i = 0; hashes && i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        _push.clients[i].sentHash = hashes + i * PORTFOLIO_MAX * SYMBOL_TABLE_CAPACITY;
+    }
+    _pushServer.begin();
+    _pushServer.onEvent(handlePushEvent);
+    _pushServer.enableHeartbeat(PUSH_HEARTBEAT_INTERVAL, 3000, 2);
+    if (enableAuth) {
+        _pushServer.setAuthorization(username.c_str(), password.c_str());
+    }
+    
     Serial.println("Web Interface initialized");
     Serial.print("Server started on port 80");
     if (_authEnabled) {
@@ -67,18 +190,7 @@ bool WebInterface::initSPIFFS() {
         return false;
     }
     
-    // List files for debugging
-    Serial.println("SPIFFS Files:");
-    File root = SPIFFS.open("/");
-    File file = root.openNextFile();
-    while (file) {
-        Serial.print("  ");
-        Serial.print(file.name());
-        Serial.print(" (");
-        Serial.print(file.size());
-        Serial.println(" bytes)");
-        file = root.openNextFile();
-    }
+    indexAssets();
     
     _spiffsInitialized = true;
     return true;
@@ -113,6 +225,8 @@ void WebInterface::setupAPIRoutes() {
     _server.on("/api/system/restart", HTTP_POST, handleSystemRestart);
     _server.on("/api/system/factory-reset", HTTP_POST, handleFactoryReset);
     _server.on("/api/system/update", HTTP_POST, handleSystemUpdate);
+    _server.on("/api/system/endpoints", HTTP_GET, handleEndpointMetrics);
+    _server.on("/api/metrics", HTTP_GET, handleMetrics);
     
     // WiFi API
     _server.on("/api/wifi/scan", HTTP_GET, handleWiFiScan);
@@ -132,6 +246,7 @@ void WebInterface::setupAPIRoutes() {
     _server.on("/api/data/summary", HTTP_GET, handleDataSummary);
     _server.on("/api/data/refresh", HTTP_POST, handleDataRefresh);
     _server.on("/api/data/history", HTTP_GET, handleDataHistory);
+    _server.on("/api/history", HTTP_GET, handleHistory);
     
     // Alert API
     _server.on("/api/alerts/status", HTTP_GET, handleAlertsStatus);
@@ -144,6 +259,7 @@ void WebInterface::setupAPIRoutes() {
     _server.on("/api/device/leds", HTTP_POST, handleLEDControl);
     _server.on("/api/device/display", HTTP_POST, handleDisplayControl);
     _server.on("/api/device/rgb", HTTP_POST, handleRGBControl);
+    _server.on("/api/device/status", HTTP_GET, handleDeviceStatus);
     
     // Battery API
     _server.on("/api/battery/status", HTTP_GET, handleBatteryStatus);
@@ -165,10 +281,11 @@ void WebInterface::setupPageRoutes() {
         }
     });
     
+    // Built-in page from flash unless data/ ships its own
     _server.on("/dashboard", HTTP_GET, []() {
-        if (!handleFileRead("/dashboard.html")) {
-            handleNotFound();
-        }
+        if (handleFileRead("/dashboard.html")) return;
+        if (sendNotModified(_server, _dashboardETag, false)) return;
+        _server.send_P(200, "text/html", DASHBOARD_HTML);
     });
     
     _server.on("/setup", HTTP_GET, []() {
@@ -239,6 +356,7 @@ void WebInterface::setupSystemRoutes() {
     _server.on("/update", HTTP_POST, []() {
         _server.sendHeader("Connection", "close");
         _server.send(200, "text/plain", (Update.hasError()) ? "FAIL" : "OK");
+        ConfigManager::getInstance().flush();
         ESP.restart();
     }, []() {
         HTTPUpload& upload = _server.upload();
@@ -263,6 +381,9 @@ void WebInterface::setupSystemRoutes() {
 
 // ===== AUTHENTICATION =====
 bool WebInterface::checkAuth() {
+    // Every API handler passes here; keeps the device out of light sleep
+    PowerManager::getInstance().noteActivity();
+    
     if (!_authEnabled) return true;
     
     if (!_server.authenticate(_authUsername.c_str(), _authPassword.c_str())) {
@@ -273,36 +394,125 @@ bool WebInterface::checkAuth() {
 }
 
 // ===== FILE HANDLING =====
-bool WebInterface::handleFileRead(String path) {
-    Serial.println("handleFileRead: " + path);
+// Small fixed-size documents go out through the chunked writer as well
+static void sendDocument(WebServer& server, const char* endpoint, const JsonDocument& doc) {
+    ResponseWriter out(server, endpoint);
+    serializeJson(doc, out);
+    out.end();
+}
+
+static uint32_t fnv1a(uint32_t hash, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+static bool isWebAsset(const String& path) {
+    return path.endsWith(".html") || path.endsWith(".css") || path.endsWith(".js") ||
+           path.endsWith(".ico") || path.endsWith(".png") || path.endsWith(".jpg") ||
+           path.endsWith(".svg");
+}
+
+// "/script.3f2a9c1e.js" -> "/script.js"; false if the name carries no hash
+static bool stripContentHash(const String& path, char* alias, size_t size) {
+    int ext = path.lastIndexOf('.');
+    int dot = ext > 0 ? path.lastIndexOf('.', ext - 1) : -1;
+    if (dot < 0 || ext - dot - 1 != STATIC_HASH_LENGTH) return false;
+    
+    for (int i = dot + 1; i < ext; i++) {
+        if (!isxdigit((unsigned char)path[i])) return false;
+    }
     
+    String stripped = path.substring(0, dot) + path.substring(ext);
+    strlcpy(alias, stripped.c_str(), size);
+    return true;
+}
+
+static void indexAssets() {
+    _assetCount = 0;
+    _dashboardETag = fnv1a(2166136261UL, (const uint8_t*)DASHBOARD_HTML, strlen_P(DASHBOARD_HTML));
+    
+    uint8_t buffer[512];
+    File root = SPIFFS.open("/");
+    File file = root.openNextFile();
+    while (file) {
+        String path = file.name();
+        if (!path.startsWith("/")) path = "/" + path;
+        
+        bool gzip = path.endsWith(".gz");
+        if (gzip) path.remove(path.length() - 3);
+        
+        if (isWebAsset(path) && path.length() < STATIC_PATH_LENGTH) {
+            if (_assetCount >= STATIC_MAX_ASSETS) {
+                Serial.println("Static asset index full, skipping: " + path);
+            } else {
+                StaticAsset& asset = _assets[_assetCount++];
+                strlcpy(asset.path, path.c_str(), sizeof(asset.path));
+                if (!stripContentHash(path, asset.alias, sizeof(asset.alias))) {
+                    asset.alias[0] = '\0';
+                }
+                asset.gzip = gzip;
+                asset.etag = 2166136261UL;
+                size_t count;
+                while ((count = file.read(buffer, sizeof(buffer))) > 0) {
+                    asset.etag = fnv1a(asset.etag, buffer, count);
+                }
+            }
+        }
+        file = root.openNextFile();
+    }
+    
+    Serial.printf("Static assets indexed: %u\n", _assetCount);
+}
+
+static const StaticAsset* findAsset(const String& path) {
+    for (uint8_t i = 0; i < _assetCount; i++) {
+        if (path == _assets[i].path) return &_assets[i];
+    }
+    // Unhashed name of a hashed file, e.g. from the built-in dashboard
+    for (uint8_t i = 0; i < _assetCount; i++) {
+        if (_assets[i].alias[0] && path == _assets[i].alias) return &_assets[i];
+    }
+    return nullptr;
+}
+
+// Sends ETag/Cache-Control and answers 304 if the client copy is current
+static bool sendNotModified(WebServer& server, uint32_t etag, bool immutable) {
+    char tag[12];
+    snprintf(tag, sizeof(tag), "\"%08lx\"", (unsigned long)etag);
+    
+    server.sendHeader("ETag", tag);
+    server.sendHeader("Cache-Control", immutable ? CACHE_IMMUTABLE : CACHE_REVALIDATE);
+    
+    if (server.header("If-None-Match") != tag) return false;
+    server.send(304);
+    return true;
+}
+
+bool WebInterface::handleFileRead(String path) {
     if (path.endsWith("/")) {
         path += "index.html";
     }
     
-    String contentType = getContentType(path);
-    String pathWithGz = path + ".gz";
+    const StaticAsset* asset = findAsset(path);
+    if (!asset) return false;
     
-    if (SPIFFS.exists(pathWithGz) || SPIFFS.exists(path)) {
-        if (SPIFFS.exists(pathWithGz)) {
-            path += ".gz";
-        }
-        
-        File file = SPIFFS.open(path, "r");
-        if (!file) {
-            Serial.println("Failed to open file: " + path);
-            return false;
-        }
-        
-        size_t sent = _server.streamFile(file, contentType);
-        file.close();
-        
-        Serial.println(String("Sent file: ") + path + " (" + sent + " bytes)");
-        return true;
+    // Only the hashed name is immutable; the alias moves with every rebuild
+    bool immutable = asset->alias[0] && path == asset->path;
+    if (sendNotModified(_server, asset->etag, immutable)) return true;
+    
+    String stored = String(asset->path) + (asset->gzip ? ".gz" : "");
+    File file = SPIFFS.open(stored, "r");
+    if (!file) {
+        Serial.println("Failed to open file: " + stored);
+        return false;
     }
     
-    Serial.println("File not found: " + path);
-    return false;
+    // streamFile adds Content-Encoding: gzip for .gz files
+    _server.streamFile(file, getContentType(path));
+    file.close();
+    return true;
 }
 
 String WebInterface::getContentType(String filename) {
@@ -323,7 +533,7 @@ String WebInterface::getContentType(String filename) {
 void WebInterface::handleSystemStatus() {
     if (!checkAuth()) return;
     
-    DynamicJsonDocument doc(1024);
+    StaticJsonDocument<384> doc;
     
     doc["status"] = "online";
     doc["uptime"] = millis() / 1000;
@@ -333,67 +543,243 @@ void WebInterface::handleSystemStatus() {
     doc["cpuFreq"] = ESP.getCpuFreqMHz();
     doc["flashSize"] = ESP.getFlashChipSize();
     
-    String response;
-    serializeJson(doc, response);
-    _server.send(200, "application/json", response);
+    sendDocument(_server, "/api/system/status", doc);
 }
 
 // System Info Handler
 void WebInterface::handleSystemInfo() {
     if (!checkAuth()) return;
     
-    DynamicJsonDocument doc(2048);
+    ResponseWriter out(_server, "/api/system/info");
+    StaticJsonDocument<512> doc;
     
     // Hardware info
-    doc["hardware"]["model"] = "ESP32-WROVER-E";
-    doc["hardware"]["chipId"] = String((uint32_t)ESP.getEfuseMac(), HEX);
-    doc["hardware"]["cpuFreq"] = ESP.getCpuFreqMHz();
-    doc["hardware"]["flashSize"] = ESP.getFlashChipSize();
-    doc["hardware"]["freeHeap"] = ESP.getFreeHeap();
-    doc["hardware"]["minHeap"] = ESP.getMinFreeHeap();
-    doc["hardware"]["maxHeap"] = ESP.getMaxAllocHeap();
+    doc["model"] = "ESP32-WROVER-E";
+    doc["chipId"] = String((uint32_t)ESP.getEfuseMac(), HEX);
+    doc["cpuFreq"] = ESP.getCpuFreqMHz();
+    doc["flashSize"] = ESP.getFlashChipSize();
+    doc["freeHeap"] = ESP.getFreeHeap();
+    doc["minHeap"] = ESP.getMinFreeHeap();
+    doc["maxHeap"] = ESP.getMaxAllocHeap();
+    
+    out.print("{\"hardware\":");
+    serializeJson(doc, out);
+    doc.clear();
     
     // Software info
-    doc["software"]["version"] = "4.5.3";
-    doc["software"]["buildDate"] = __DATE__ " " __TIME__;
-    doc["software"]["sdkVersion"] = ESP.getSdkVersion();
+    doc["version"] = "4.5.3";
+    doc["buildDate"] = __DATE__ " " __TIME__;
+    doc["sdkVersion"] = ESP.getSdkVersion();
+    
+    out.print(",\"software\":");
+    serializeJson(doc, out);
+    doc.clear();
     
     // Network info
-    doc["network"]["mac"] = WiFi.macAddress();
-    doc["network"]["hostname"] = WiFi.getHostname();
+    doc["mac"] = WiFi.macAddress();
+    doc["hostname"] = WiFi.getHostname();
     
     if (WiFiManager::getInstance().isConnected()) {
-        doc["network"]["connected"] = true;
-        doc["network"]["ssid"] = WiFiManager::getInstance().getCurrentSSID();
-        doc["network"]["rssi"] = WiFiManager::getInstance().getCurrentRSSI();
-        doc["network"]["ip"] = WiFi.localIP().toString();
-        doc["network"]["gateway"] = WiFi.gatewayIP().toString();
-        doc["network"]["subnet"] = WiFi.subnetMask().toString();
-        doc["network"]["dns"] = WiFi.dnsIP().toString();
+        doc["connected"] = true;
+        doc["ssid"] = WiFiManager::getInstance().getCurrentSSID();
+        doc["rssi"] = WiFiManager::getInstance().getCurrentRSSI();
+        doc["ip"] = WiFi.localIP().toString();
+        doc["gateway"] = WiFi.gatewayIP().toString();
+        doc["subnet"] = WiFi.subnetMask().toString();
+        doc["dns"] = WiFi.dnsIP().toString();
     } else {
-        doc["network"]["connected"] = false;
+        doc["connected"] = false;
     }
     
     if (WiFiManager::getInstance().isAPMode()) {
-        doc["network"]["apMode"] = true;
-        doc["network"]["apSSID"] = WiFiManager::getInstance().getAPSSID();
-        doc["network"]["apIP"] = WiFiManager::getInstance().getAPIP().toString();
+        doc["apMode"] = true;
+        doc["apSSID"] = WiFiManager::getInstance().getAPSSID();
+        doc["apIP"] = WiFiManager::getInstance().getAPIP().toString();
     } else {
-        doc["network"]["apMode"] = false;
+        doc["apMode"] = false;
     }
     
+    out.print(",\"network\":");
+    serializeJson(doc, out);
+    doc.clear();
+    
     // Component status
-    doc["components"]["wifi"] = true;
-    doc["components"]["spiffs"] = _spiffsInitialized;
-    doc["components"]["display"] = DisplayManager::getInstance().isInitialized();
-    doc["components"]["buzzer"] = BuzzerManager::getInstance().isEnabled();
-    doc["components"]["leds"] = LEDManager::getInstance().isEnabled();
-    doc["components"]["battery"] = BatteryManager::getInstance().isInitialized();
-    doc["components"]["time"] = TimeManager::getInstance().isSynced();
+    doc["wifi"] = true;
+    doc["spiffs"] = _spiffsInitialized;
+    doc["display"] = DisplayManager::getInstance().isInitialized();
+    doc["buzzer"] = BuzzerManager::getInstance().isEnabled();
+    doc["leds"] = LEDManager::getInstance().isEnabled();
+    doc["battery"] = BatteryManager::getInstance().isInitialized();
+    doc["time"] = TimeManager::getInstance().isSynced();
+    
+    out.print(",\"components\":");
+    serializeJson(doc, out);
+    out.print('}');
+    out.end();
+}
+
+// Endpoint Metrics Handler: bytes and time per streamed endpoint
+void WebInterface::handleEndpointMetrics() {
+    if (!checkAuth()) return;
     
-    String response;
-    serializeJson(doc, response);
-    _server.send(200, "application/json", response);
+    ResponseWriter out(_server, nullptr);
+    ResponseWriter::printMetricsJSON(out);
+    out.end();
+}
+
+// Metrics Handler: registry plus values read at scrape time, Prometheus text format
+void WebInterface::handleMetrics() {
+    if (!checkAuth()) return;
+    
+    ResponseWriter out(_server, "/api/metrics");
+    out.begin(200, "text/plain; version=0.0.4");
+    
+    MetricsRegistry::getInstance().printPrometheus(out);
+    
+    // Heap, internal RAM and PSRAM
+    static const char* const HEAP_LABELS[] = {"pool=\"internal\"", "pool=\"psram\""};
+    static const uint32_t HEAP_CAPS[] = {MALLOC_CAP_INTERNAL, MALLOC_CAP_SPIRAM};
+    MetricsRegistry::printHeader(out, "heap_free_bytes", "Free heap", "gauge");
+    for (int i = 0; i < 2; i++) {
+        MetricsRegistry::printSample(out, "heap_free_bytes", HEAP_LABELS[i],
+                                     heap_caps_get_free_size(HEAP_CAPS[i]));
+    }
+    MetricsRegistry::printHeader(out, "heap_min_free_bytes", "Lowest free heap since boot", "gauge");
+    for (int i = 0; i < 2; i++) {
+        MetricsRegistry::printSample(out, "heap_min_free_bytes", HEAP_LABELS[i],
+                                     heap_caps_get_minimum_free_size(HEAP_CAPS[i]));
+    }
+    MetricsRegistry::printHeader(out, "heap_largest_block_bytes", "Largest free block", "gauge");
+    for (int i = 0; i < 2; i++) {
+        MetricsRegistry::printSample(out, "heap_largest_block_bytes", HEAP_LABELS[i],
+                                     heap_caps_get_largest_free_block(HEAP_CAPS[i]));
+    }
+    
+    // Scheduler tasks
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    static const char* const TASK_METRICS[][2] = {
+        {"task_stack_free_bytes", "Lowest free stack of the task"},
+        {"task_runs_total", "Task runs"},
+        {"task_overruns_total", "Runs that exceeded the deadline"},
+        {"task_missed_releases_total", "Periods skipped because the task was late"}
+    };
+    for (int m = 0; m < 4; m++) {
+        MetricsRegistry::printHeader(out, TASK_METRICS[m][0], TASK_METRICS[m][1], m ? "counter" : "gauge");
+        for (int i = 0; i < scheduler.getTaskCount(); i++) {
+            const SchedulerTaskStats* stats = scheduler.getTaskStats(i);
+            if (!stats) continue;
+            
+            char labels[METRICS_LABEL_LENGTH];
+            snprintf(labels, sizeof(labels), "task=\"%s\"", scheduler.getTaskName(i));
+            uint32_t values[] = {scheduler.getStackFree(i), stats->runs, stats->overruns, stats->missedReleases};
+            MetricsRegistry::printSample(out, TASK_METRICS[m][0], labels, values[m]);
+        }
+    }
+    
+    // Streamed endpoints
+    static const char* const ENDPOINT_METRICS[][2] = {
+        {"http_requests_total", "Responses per endpoint"},
+        {"http_response_bytes_total", "Bytes sent per endpoint"},
+        {"http_response_seconds_total", "Time spent per endpoint"}
+    };
+    for (int m = 0; m < 3; m++) {
+        MetricsRegistry::printHeader(out, ENDPOINT_METRICS[m][0], ENDPOINT_METRICS[m][1], "counter");
+        for (int i = 0; i < ResponseWriter::getEndpointCount(); i++) {
+            const EndpointMetrics* endpoint = ResponseWriter::getEndpointMetrics(i);
+            
+            char labels[METRICS_LABEL_LENGTH + 16];
+            snprintf(labels, sizeof(labels), "endpoint=\"%s\"", endpoint->endpoint);
+            double values[] = {(double)endpoint->requests, (double)endpoint->bytesSent,
+                               endpoint->totalTimeUs / 1000000.0};
+            MetricsRegistry::printSample(out, ENDPOINT_METRICS[m][0], labels, values[m]);
+        }
+    }
+    
+    // Push channel
+    MetricsRegistry::printHeader(out, "push_clients", "Connected push clients", "gauge");
+    MetricsRegistry::printSample(out, "push_clients", nullptr, _pushServer.connectedClients());
+    MetricsRegistry::printHeader(out, "push_messages_total", "Push frames sent", "counter");
+    MetricsRegistry::printSample(out, "push_messages_total", nullptr, _push.messagesSent);
+    MetricsRegistry::printHeader(out, "push_bytes_total", "Push bytes sent", "counter");
+    MetricsRegistry::printSample(out, "push_bytes_total", nullptr, _push.bytesSent);
+    
+    // Data pipeline
+    MetricsRegistry::printHeader(out, "position_events_total", "Position change events published", "counter");
+    MetricsRegistry::printSample(out, "position_events_total", nullptr,
+                                 PositionEvents::getInstance().getPublishedCount());
+    MetricsRegistry::printHeader(out, "snapshots_skipped_total", "Snapshot publishes skipped, buffers busy", "counter");
+    MetricsRegistry::printSample(out, "snapshots_skipped_total", nullptr,
+                                 DataManager::getInstance().getSnapshotsSkipped());
+    
+    // LAN fan-out
+    LanStats lan = LanFanout::getInstance().getStats();
+    static const char* const LAN_METRICS[][2] = {
+        {"lan_frames_sent_total", "Fan-out datagrams sent"},
+        {"lan_bytes_sent_total", "Fan-out bytes sent"},
+        {"lan_frames_received_total", "Fan-out datagrams accepted"},
+        {"lan_frames_rejected_total", "Fan-out datagrams with a wrong version, group or tag"},
+        {"lan_snapshots_applied_total", "Leader snapshots applied"},
+        {"lan_deltas_applied_total", "Leader deltas applied"},
+        {"lan_resync_requests_total", "Snapshots requested after a missed delta"},
+        {"lan_leader_changes_total", "Leaders followed since boot"},
+        {"lan_fallbacks_total", "Direct fetches resumed after the leader went silent"}
+    };
+    uint32_t lanValues[] = {lan.framesSent, lan.bytesSent, lan.framesReceived, lan.framesRejected,
+                            lan.snapshotsApplied, lan.deltasApplied, lan.resyncRequests,
+                            lan.leaderChanges, lan.fallbacks};
+    for (int m = 0; m < 9; m++) {
+        MetricsRegistry::printHeader(out, LAN_METRICS[m][0], LAN_METRICS[m][1], "counter");
+        MetricsRegistry::printSample(out, LAN_METRICS[m][0], nullptr, lanValues[m]);
+    }
+    MetricsRegistry::printHeader(out, "lan_following", "Fed by a LAN leader instead of fetching", "gauge");
+    MetricsRegistry::printSample(out, "lan_following", nullptr,
+                                 LanFanout::getInstance().getState() == LAN_STATE_FOLLOWING);
+    
+    // Position pool, shared by the portfolios
+    DataManager& data = DataManager::getInstance();
+    const PositionPool& pool = data.getPool();
+    MetricsRegistry::printHeader(out, "position_pool_slots", "Position pool size", "gauge");
+    MetricsRegistry::printSample(out, "position_pool_slots", nullptr, pool.getSize());
+    MetricsRegistry::printHeader(out, "position_pool_reserved_slots", "Position slots reserved per portfolio", "gauge");
+    for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+        if (!data.isPortfolioActive(i)) continue;
+        
+        char labels[METRICS_LABEL_LENGTH];
+        snprintf(labels, sizeof(labels), "mode=\"%s\"", data.getPortfolioTag(i));
+        MetricsRegistry::printSample(out, "position_pool_reserved_slots", labels, pool.getCapacity(i));
+    }
+    
+    // Settings storage
+    ConfigStorageStats config = ConfigManager::getInstance().getStats();
+    MetricsRegistry::printHeader(out, "config_commits_total", "NVS commits", "counter");
+    MetricsRegistry::printSample(out, "config_commits_total", nullptr, config.commits);
+    MetricsRegistry::printHeader(out, "config_keys_written_total", "Keys written to NVS", "counter");
+    MetricsRegistry::printSample(out, "config_keys_written_total", nullptr, config.keysWritten);
+    MetricsRegistry::printHeader(out, "config_pending_keys", "Dirty keys awaiting commit", "gauge");
+    MetricsRegistry::printSample(out, "config_pending_keys", nullptr, config.pendingKeys);
+    
+    // Device
+    MetricsRegistry::printHeader(out, "battery_volts", "Battery voltage", "gauge");
+    MetricsRegistry::printSample(out, "battery_volts", nullptr, BatteryManager::getInstance().getVoltage());
+    MetricsRegistry::printHeader(out, "battery_percent", "Battery charge", "gauge");
+    MetricsRegistry::printSample(out, "battery_percent", nullptr, BatteryManager::getInstance().getPercentage());
+    // Cycle arenas
+    static const char* const ARENA_LABELS[ARENA_COUNT] = {"arena=\"fetch\"", "arena=\"web\""};
+    MetricsRegistry::printHeader(out, "arena_peak_bytes", "Highest arena use within one cycle", "gauge");
+    for (int i = 0; i < ARENA_COUNT; i++) {
+        MetricsRegistry::printSample(out, "arena_peak_bytes", ARENA_LABELS[i],
+                                     CycleArena::get((CycleArenaId)i).getStats().peak);
+    }
+    MetricsRegistry::printHeader(out, "arena_overflows_total", "Arena allocations served by the heap", "counter");
+    for (int i = 0; i < ARENA_COUNT; i++) {
+        MetricsRegistry::printSample(out, "arena_overflows_total", ARENA_LABELS[i],
+                                     CycleArena::get((CycleArenaId)i).getStats().overflows);
+    }
+    
+    MetricsRegistry::printHeader(out, "uptime_seconds", "Time since boot", "counter");
+    MetricsRegistry::printSample(out, "uptime_seconds", nullptr, millis() / 1000);
+    
+    out.end();
 }
 
 // WiFi Scan Handler
@@ -403,21 +789,25 @@ void WebInterface::handleWiFiScan() {
     WiFiManager::getInstance().scanNetworks(true);
     auto networks = WiFiManager::getInstance().getScannedNetworks();
     
-    DynamicJsonDocument doc(4096);
-    JsonArray array = doc.to<JsonArray>();
+    ResponseWriter out(_server, "/api/wifi/scan");
+    StaticJsonDocument<256> doc;
+    bool first = true;
     
+    out.print('[');
     for (const auto& net : networks) {
-        JsonObject obj = array.createNestedObject();
-        obj["ssid"] = net.ssid;
-        obj["rssi"] = net.rssi;
-        obj["secured"] = net.encrypted;
-        obj["saved"] = net.saved;
-        obj["autoConnect"] = net.autoConnect;
+        doc.clear();
+        doc["ssid"] = net.ssid;
+        doc["rssi"] = net.rssi;
+        doc["secured"] = net.encrypted;
+        doc["saved"] = net.saved;
+        doc["autoConnect"] = net.autoConnect;
+        
+        if (!first) out.print(',');
+        serializeJson(doc, out);
+        first = false;
     }
-    
-    String response;
-    serializeJson(doc, response);
-    _server.send(200, "application/json", response);
+    out.print(']');
+    out.end();
 }
 
 // WiFi Connect Handler
@@ -429,7 +819,7 @@ void WebInterface::handleWiFiConnect() {
         return;
     }
     
-    DynamicJsonDocument doc(512);
+    ArenaJsonDocument doc(512, ArenaAllocator(ARENA_WEB));
     DeserializationError error = deserializeJson(doc, _server.arg("plain"));
     
     if (error) {
@@ -461,98 +851,374 @@ void WebInterface::handleWiFiConnect() {
     }
 }
 
+// Position and summary fields shared by the REST and push endpoints
+static void summaryToJSON(const PortfolioTotals& summary, JsonDocument& doc) {
+    doc["totalInvestment"] = summary.totalInvestment;
+    doc["totalCurrentValue"] = summary.totalCurrentValue;
+    doc["totalPnl"] = summary.totalPnl;
+    doc["totalPnlPercent"] = summary.totalPnlPercent;
+    doc["totalPositions"] = summary.totalPositions;
+    doc["longPositions"] = summary.longPositions;
+    doc["shortPositions"] = summary.shortPositions;
+    doc["winningPositions"] = summary.winningPositions;
+    doc["losingPositions"] = summary.losingPositions;
+    doc["maxDrawdown"] = summary.maxDrawdown;
+    doc["sharpeRatio"] = summary.sharpeRatio;
+    doc["volatility"] = summary.volatility;
+}
+
+static void positionToJSON(const PositionRecord& pos, JsonDocument& doc) {
+    doc["symbol"] = pos.symbol;
+    doc["changePercent"] = pos.changePercent;
+    doc["pnlValue"] = pos.pnlValue;
+    doc["quantity"] = pos.quantity;
+    doc["entryPrice"] = pos.entryPrice;
+    doc["currentPrice"] = pos.currentPrice;
+    doc["isLong"] = pos.isLong;
+    doc["alerted"] = pos.alerted;
+    doc["severeAlerted"] = pos.severeAlerted;
+    doc["lastAlertTime"] = pos.lastAlertTime;
+}
+
+static void alertToJSON(const AlertRecord& alert, JsonDocument& doc) {
+    char percent[NUMBER_TEXT_LENGTH];
+    NumberFormat::format(percent, sizeof(percent), alert.changePercent, NumberSpecs::RATIO);
+    
+    doc["mode"] = DataManager::getInstance().getPortfolioTag(alert.portfolio);
+    doc["symbol"] = alert.symbol;
+    doc["pnlPercent"] = alert.changePercent;
+    doc["alertPrice"] = alert.price;
+    doc["isLong"] = alert.isLong;
+    doc["isSevere"] = alert.isSevere;
+    doc["isProfit"] = alert.type == ALERT_EXIT_PROFIT;
+    doc["alertTime"] = alert.alertTime;
+    doc["message"] = String(AlertManager::getAlertTitle(alert.type)) + " " + percent;
+}
+
+// MessagePack form: fixed-order arrays instead of maps
+//   summary:  totalInvestment, totalCurrentValue, totalPnl, totalPnlPercent, totalPositions,
+//             longPositions, shortPositions, winningPositions, losingPositions,
+//             maxDrawdown, sharpeRatio, volatility
+//   position: symbol, changePercent, pnlValue, quantity, entryPrice, currentPrice,
+//             flags (1 isLong, 2 alerted, 4 severeAlerted), lastAlertTime
+static void summaryToArray(const PortfolioTotals& summary, JsonDocument& doc) {
+    JsonArray values = doc.to<JsonArray>();
+    values.add(summary.totalInvestment);
+    values.add(summary.totalCurrentValue);
+    values.add(summary.totalPnl);
+    values.add(summary.totalPnlPercent);
+    values.add(summary.totalPositions);
+    values.add(summary.longPositions);
+    values.add(summary.shortPositions);
+    values.add(summary.winningPositions);
+    values.add(summary.losingPositions);
+    values.add(summary.maxDrawdown);
+    values.add(summary.sharpeRatio);
+    values.add(summary.volatility);
+}
+
+static void positionToArray(const PositionRecord& pos, JsonDocument& doc) {
+    JsonArray values = doc.to<JsonArray>();
+    values.add(pos.symbol);
+    values.add(pos.changePercent);
+    values.add(pos.pnlValue);
+    values.add(pos.quantity);
+    values.add(pos.entryPrice);
+    values.add(pos.currentPrice);
+    values.add(pos.isLong | (pos.alerted << 1) | (pos.severeAlerted << 2));
+    values.add(pos.lastAlertTime);
+}
+
+// Container headers for MessagePack bodies streamed element by element
+static void msgpackMap(Print& out, uint8_t size) {
+    out.write((uint8_t)(0x80 | size));         // fixmap, size < 16
+}
+
+static void msgpackArray(Print& out, uint16_t size) {
+    if (size < 16) {
+        out.write((uint8_t)(0x90 | size));
+    } else {
+        out.write((uint8_t)0xdc);
+        out.write((uint8_t)(size >> 8));
+        out.write((uint8_t)size);
+    }
+}
+
+static void msgpackString(Print& out, const char* text) {
+    size_t len = strnlen(text, 255);
+    if (len < 32) {
+        out.write((uint8_t)(0xa0 | len));
+    } else {
+        out.write((uint8_t)0xd9);
+        out.write((uint8_t)len);
+    }
+    out.write((const uint8_t*)text, len);
+}
+
+static bool acceptsMsgPack(WebServer& server) {
+    return server.header("Accept").indexOf("msgpack") >= 0;
+}
+
 // Data Positions Handler
 void WebInterface::handleDataPositions() {
     if (!checkAuth()) return;
     
-    String mode = _server.arg("mode");
-    bool exitMode = (mode == "exit");
+    uint8_t portfolio = DataManager::getInstance().findPortfolio(_server.arg("mode"));
     
-    auto positions = DataManager::getInstance().getPositions(exitMode);
-    auto summary = DataManager::getInstance().getSummary(exitMode);
+    // Ordering comes from the ranking index: ?sort=change|pnl&order=worst|best&limit=N
+    RankKey key = _server.arg("sort") == "pnl" ? RANK_BY_PNL_VALUE : RANK_BY_CHANGE_PERCENT;
+    bool worstFirst = _server.arg("order") != "best";
+    int limit = RANKING_MAX_POSITIONS;
+    if (_server.hasArg("limit")) {
+        limit = constrain(_server.arg("limit").toInt(), 0, RANKING_MAX_POSITIONS);
+    }
     
-    DynamicJsonDocument doc(8192);
+    // A consistent generation for the whole response, without blocking the parser
+    SnapshotReader snapshot(portfolio);
+    if (!snapshot.isValid()) {
+        _server.send(503, "application/json", "{\"error\":\"Data not available\"}");
+        return;
+    }
+    
+    // The generation changes with every parse, so it doubles as the ETag
+    bool msgpack = acceptsMsgPack(_server);
+    uint32_t etag = snapshot->generation ^ _bootTag ^ (msgpack ? ETAG_MSGPACK_SALT : 0);
+    _server.sendHeader("Vary", "Accept");
+    if (sendNotModified(_server, etag, false)) return;
+    
+    uint8_t indices[RANKING_MAX_POSITIONS];
+    int count = snapshot->ranking.top(key, worstFirst, indices, limit);
+    const PortfolioTotals& summary = snapshot->summary;
+    
+    // One small document per object keeps memory flat for any position count
+    ResponseWriter out(_server, "/api/data/positions");
+    StaticJsonDocument<384> doc;
+    
+    if (msgpack) {
+        out.begin(200, "application/msgpack");
+        msgpackMap(out, 2);
+        msgpackString(out, "summary");
+        summaryToArray(summary, doc);
+        serializeMsgPack(doc, out);
+        
+        msgpackString(out, "positions");
+        msgpackArray(out, count);
+        for (int i = 0; i < count; i++) {
+            positionToArray(snapshot->positions[indices[i]], doc);
+            serializeMsgPack(doc, out);
+        }
+        out.end();
+        return;
+    }
     
     // Summary
-    JsonObject summaryObj = doc.createNestedObject("summary");
-    summaryObj["totalInvestment"] = summary.totalInvestment;
-    summaryObj["totalCurrentValue"] = summary.totalCurrentValue;
-    summaryObj["totalPnl"] = summary.totalPnl;
-    summaryObj["totalPnlPercent"] = summary.totalPnlPercent;
-    summaryObj["totalPositions"] = summary.totalPositions;
-    summaryObj["longPositions"] = summary.longPositions;
-    summaryObj["shortPositions"] = summary.shortPositions;
-    summaryObj["winningPositions"] = summary.winningPositions;
-    summaryObj["losingPositions"] = summary.losingPositions;
+    summaryToJSON(summary, doc);
+    
+    out.print("{\"summary\":");
+    serializeJson(doc, out);
     
     // Positions
-    JsonArray positionsArray = doc.createNestedArray("positions");
+    out.print(",\"positions\":[");
+    for (int i = 0; i < count; i++) {
+        doc.clear();
+        positionToJSON(snapshot->positions[indices[i]], doc);
+        
+        if (i > 0) out.print(',');
+        serializeJson(doc, out);
+    }
+    out.print("]}");
+    out.end();
+}
+
+// ===== HISTORY STREAMING =====
+// State of one /api/history response: the current downsampling bucket
+struct HistoryStream {
+    ResponseWriter* out;
+    uint16_t symbolId;
+    const char* symbol;         // Matched by name when the symbol is not interned
+    uint32_t from;
+    uint32_t bucketSpan;
+    uint32_t bucket;
+    bool bucketOpen;
+    HistoryRecord minRecord;
+    HistoryRecord maxRecord;
+    int samples;
+    int points;
+};
+
+static void historyWritePoint(HistoryStream& stream, const HistoryRecord& record) {
+    char point[64];
+    int len = snprintf(point, sizeof(point), "%s[%lu,%.8g,%.2f]",
+                       stream.points > 0 ? "," : "", (unsigned long)record.timestamp,
+                       record.price, record.pnlValue);
+    stream.out->write((const uint8_t*)point, len);
+    stream.points++;
+}
+
+static void historyCloseBucket(HistoryStream& stream) {
+    if (!stream.bucketOpen) return;
+    
+    // Both extremes of the bucket survive, in time order
+    const HistoryRecord& first = stream.minRecord.timestamp <= stream.maxRecord.timestamp ?
+                                 stream.minRecord : stream.maxRecord;
+    const HistoryRecord& second = &first == &stream.minRecord ? stream.maxRecord : stream.minRecord;
+    
+    historyWritePoint(stream, first);
+    if (second.timestamp != first.timestamp) {
+        historyWritePoint(stream, second);
+    }
+    stream.bucketOpen = false;
+}
+
+static bool historyCollect(const HistoryRecord& record, void* context) {
+    HistoryStream& stream = *static_cast<HistoryStream*>(context);
     
-    for (const auto& pos : positions) {
-        JsonObject posObj = positionsArray.createNestedObject();
-        posObj["symbol"] = pos.symbol;
-        posObj["changePercent"] = pos.changePercent;
-        posObj["pnlValue"] = pos.pnlValue;
-        posObj["quantity"] = pos.quantity;
-        posObj["entryPrice"] = pos.entryPrice;
-        posObj["currentPrice"] = pos.currentPrice;
-        posObj["isLong"] = pos.isLong;
-        posObj["alerted"] = pos.alerted;
-        posObj["severeAlerted"] = pos.severeAlerted;
-        posObj["lastAlertTime"] = pos.lastAlertTime;
+    if (stream.symbolId != SYMBOL_ID_NONE) {
+        if (record.symbolId != stream.symbolId) return true;
+    } else if (strcmp(record.symbol, stream.symbol) != 0) {
+        return true;
     }
     
-    String response;
-    serializeJson(doc, response);
-    _server.send(200, "application/json", response);
+    uint32_t bucket = (record.timestamp - stream.from) / stream.bucketSpan;
+    if (!stream.bucketOpen || bucket != stream.bucket) {
+        historyCloseBucket(stream);
+        stream.bucket = bucket;
+        stream.bucketOpen = true;
+        stream.minRecord = record;
+        stream.maxRecord = record;
+    } else if (record.price < stream.minRecord.price) {
+        stream.minRecord = record;
+    } else if (record.price > stream.maxRecord.price) {
+        stream.maxRecord = record;
+    }
+    
+    stream.samples++;
+    return true;
+}
+
+static bool isValidSymbol(const String& symbol) {
+    if (symbol.isEmpty() || symbol.length() >= SYMBOL_NAME_LENGTH) return false;
+    
+    for (size_t i = 0; i < symbol.length(); i++) {
+        char c = symbol[i];
+        if (!isalnum(c) && c != '_' && c != '-') return false;
+    }
+    return true;
+}
+
+// History Handler: GET /api/history?symbol=&mode=entry|exit&from=&to=&points=
+// from/to are Unix seconds. The series is min/max downsampled to at most
+// `points` samples and streamed with chunked encoding, so memory use does
+// not depend on the size of the range.
+void WebInterface::handleHistory() {
+    if (!checkAuth()) return;
+    
+    String symbol = _server.arg("symbol");
+    if (!isValidSymbol(symbol)) {
+        _server.send(400, "application/json", "{\"error\":\"Invalid symbol\"}");
+        return;
+    }
+    
+    DataManager& data = DataManager::getInstance();
+    uint8_t portfolio = data.findPortfolio(_server.arg("mode"));
+    TimeSeriesLog& log = data.getHistoryLog(portfolio);
+    if (!log.isReady()) {
+        _server.send(503, "application/json", "{\"error\":\"History unavailable\"}");
+        return;
+    }
+    
+    uint32_t to = _server.hasArg("to") ? strtoul(_server.arg("to").c_str(), nullptr, 10) : time(nullptr);
+    uint32_t from = to > HISTORY_DEFAULT_SPAN ? to - HISTORY_DEFAULT_SPAN : 0;
+    if (_server.hasArg("from")) {
+        from = strtoul(_server.arg("from").c_str(), nullptr, 10);
+    }
+    if (from > to) {
+        _server.send(400, "application/json", "{\"error\":\"Invalid range\"}");
+        return;
+    }
+    
+    int points = HISTORY_DEFAULT_POINTS;
+    if (_server.hasArg("points")) {
+        points = constrain(_server.arg("points").toInt(), 2, HISTORY_MAX_POINTS);
+    }
+    
+    // Each bucket contributes its min and max sample
+    ResponseWriter out(_server, "/api/history");
+    HistoryStream stream;
+    stream.out = &out;
+    stream.symbolId = SymbolTable::getInstance().find(symbol.c_str());
+    stream.symbol = symbol.c_str();
+    stream.from = from;
+    stream.bucketSpan = (to - from) / (points / 2) + 1;
+    stream.bucketOpen = false;
+    stream.samples = 0;
+    stream.points = 0;
+    
+    char text[128];
+    int len = snprintf(text, sizeof(text),
+                       "{\"symbol\":\"%s\",\"mode\":\"%s\",\"from\":%lu,\"to\":%lu,"
+                       "\"bucketSeconds\":%lu,\"data\":[",
+                       stream.symbol, data.getPortfolioTag(portfolio), (unsigned long)from,
+                       (unsigned long)to, (unsigned long)stream.bucketSpan);
+    out.write((const uint8_t*)text, len);
+    
+    log.query(from, to, historyCollect, &stream);
+    historyCloseBucket(stream);
+    
+    len = snprintf(text, sizeof(text), "],\"samples\":%d,\"points\":%d}",
+                   stream.samples, stream.points);
+    out.write((const uint8_t*)text, len);
+    out.end();
 }
 
 // Alert Status Handler
 void WebInterface::handleAlertsStatus() {
     if (!checkAuth()) return;
     
-    DynamicJsonDocument doc(1024);
-    
-    // Entry alerts
-    JsonObject entryAlerts = doc.createNestedObject("entry");
-    auto entryAlertHistory = AlertManager::getInstance().getAlertHistory(false);
-    
-    JsonArray entryArray = entryAlerts.createNestedArray("active");
-    for (const auto& alert : entryAlertHistory) {
-        if (!alert.acknowledged && (millis() - alert.alertTime < 3600000)) { // Last hour
-            JsonObject alertObj = entryArray.createNestedObject();
-            alertObj["symbol"] = alert.symbol;
-            alertObj["pnlPercent"] = alert.pnlPercent;
-            alertObj["alertPrice"] = alert.alertPrice;
-            alertObj["isLong"] = alert.isLong;
-            alertObj["isSevere"] = alert.isSevere;
-            alertObj["alertTime"] = alert.alertTime;
-            alertObj["message"] = alert.message;
-        }
-    }
-    entryAlerts["count"] = entryArray.size();
-    
-    // Exit alerts
-    JsonObject exitAlerts = doc.createNestedObject("exit");
-    auto exitAlertHistory = AlertManager::getInstance().getAlertHistory(true);
-    
-    JsonArray exitArray = exitAlerts.createNestedArray("active");
-    for (const auto& alert : exitAlertHistory) {
-        if (!alert.acknowledged && (millis() - alert.alertTime < 3600000)) {
-            JsonObject alertObj = exitArray.createNestedObject();
-            alertObj["symbol"] = alert.symbol;
-            alertObj["pnlPercent"] = alert.pnlPercent;
-            alertObj["alertPrice"] = alert.alertPrice;
-            alertObj["isProfit"] = alert.isProfit;
-            alertObj["alertTime"] = alert.alertTime;
-            alertObj["message"] = alert.message;
+    ResponseWriter out(_server, "/api/alerts/status");
+    StaticJsonDocument<384> doc;
+    
+    // Only the web task reads the history, so one copy buffer serves
+    static AlertRecord alerts[ALERT_HISTORY_SIZE];
+    int alertCount = _alerts ? _alerts->getAlertsSince(0, alerts, ALERT_HISTORY_SIZE) : 0;
+    
+    // Alerts of the last hour, grouped by alert style
+    for (int style = 0; style < 2; style++) {
+        int count = 0;
+        
+        out.print(style == 0 ? "{\"entry\":{\"active\":[" : "},\"exit\":{\"active\":[");
+        for (int i = 0; i < alertCount; i++) {
+            const AlertRecord& alert = alerts[i];
+            if (alert.isExitMode != (style == 1) || millis() - alert.alertTime >= 3600000) continue;
+            
+            doc.clear();
+            alertToJSON(alert, doc);
+            if (count > 0) out.print(',');
+            serializeJson(doc, out);
+            count++;
         }
+        out.print("],\"count\":");
+        out.print(count);
     }
-    exitAlerts["count"] = exitArray.size();
+    out.print("}}");
+    out.end();
+}
+
+// Device Status Handler: buzzer, LED and battery state in one response
+void WebInterface::handleDeviceStatus() {
+    if (!checkAuth()) return;
     
-    String response;
-    serializeJson(doc, response);
-    _server.send(200, "application/json", response);
+    ResponseWriter out(_server, "/api/device/status");
+    out.print("{\"buzzer\":");
+    BuzzerManager::getInstance().printStatusJSON(out);
+    out.print(",\"leds\":");
+    LEDManager::getInstance().printStatusJSON(out);
+    out.print(",\"battery\":");
+    BatteryManager::getInstance().printStatusJSON(out);
+    out.print(",\"storage\":");
+    ConfigManager::getInstance().printStatusJSON(out);
+    out.print('}');
+    out.end();
 }
 
 // Buzzer Control Handler
@@ -596,30 +1262,55 @@ void WebInterface::handleSettingsGet() {
     String section = _server.arg("section");
     
     if (section == "all") {
-        String settings = ConfigManager::getInstance().getAllSettingsJSON();
-        _server.send(200, "application/json", settings);
+        ResponseWriter out(_server, "/api/settings/get");
+        out.print(ConfigManager::getInstance().getAllSettingsJSON());
+        out.end();
     }
     else if (section == "wifi") {
-        DynamicJsonDocument doc(1024);
+        StaticJsonDocument<256> doc;
         doc["ssid"] = ConfigManager::getInstance().getWiFiSSID();
         doc["apEnabled"] = ConfigManager::getInstance().getAPEnabled();
         doc["autoConnect"] = ConfigManager::getInstance().getWiFiAutoConnect();
         
-        String response;
-        serializeJson(doc, response);
-        _server.send(200, "application/json", response);
+        sendDocument(_server, "/api/settings/get", doc);
+    }
+    else if (section == "portfolios") {
+        StaticJsonDocument<1024> doc;
+        JsonArray portfolios = doc.to<JsonArray>();
+        for (uint8_t i = 0; i < PORTFOLIO_MAX; i++) {
+            PortfolioConfig config;
+            ConfigManager::getInstance().getPortfolioConfig(i, config);
+            
+            JsonObject item = portfolios.createNestedObject();
+            item["mode"] = DataManager::getInstance().getPortfolioTag(i);
+            item["name"] = config.name;
+            item["exitAlerts"] = config.exitAlerts;
+            item["refreshInterval"] = config.refreshInterval;
+            item["priority"] = config.priority;
+        }
+        
+        sendDocument(_server, "/api/settings/get", doc);
+    }
+    else if (section == "lan") {
+        LanFanout& lan = LanFanout::getInstance();
+        StaticJsonDocument<256> doc;
+        doc["role"] = LanFanout::getRoleName(lan.getRole());
+        doc["state"] = LanFanout::getStateName(lan.getState());
+        doc["deviceId"] = String(lan.getDeviceId(), HEX);
+        doc["leaderId"] = lan.getLeaderId() ? String(lan.getLeaderId(), HEX) : String();
+        doc["dataAge"] = lan.getDataAge();
+        
+        sendDocument(_server, "/api/settings/get", doc);
     }
     else if (section == "alerts") {
-        DynamicJsonDocument doc(512);
+        StaticJsonDocument<256> doc;
         doc["alertThreshold"] = ConfigManager::getInstance().getAlertThreshold();
         doc["severeThreshold"] = ConfigManager::getInstance().getSevereThreshold();
         doc["portfolioThreshold"] = ConfigManager::getInstance().getPortfolioThreshold();
         doc["buzzerVolume"] = ConfigManager::getInstance().getBuzzerVolume();
         doc["buzzerEnabled"] = ConfigManager::getInstance().getBuzzerEnabled();
         
-        String response;
-        serializeJson(doc, response);
-        _server.send(200, "application/json", response);
+        sendDocument(_server, "/api/settings/get", doc);
     }
     else {
         _server.send(400, "application/json", "{\"error\":\"Invalid section\"}");
@@ -635,7 +1326,7 @@ void WebInterface::handleSettingsSave() {
         return;
     }
     
-    DynamicJsonDocument doc(2048);
+    ArenaJsonDocument doc(2048, ArenaAllocator(ARENA_WEB));
     DeserializationError error = deserializeJson(doc, _server.arg("plain"));
     
     if (error) {
@@ -644,6 +1335,7 @@ void WebInterface::handleSettingsSave() {
     }
     
     // Save all settings from JSON
+    bool portfoliosChanged = false;
     if (doc.containsKey("wifi")) {
         JsonObject wifi = doc["wifi"];
         if (wifi.containsKey("ssid")) ConfigManager::getInstance().setWiFiSSID(wifi["ssid"].as<String>());
@@ -659,6 +1351,25 @@ void WebInterface::handleSettingsSave() {
         if (api.containsKey("password")) ConfigManager::getInstance().setAPIPassword(api["password"].as<String>());
         if (api.containsKey("entryPortfolio")) ConfigManager::getInstance().setEntryPortfolio(api["entryPortfolio"].as<String>());
         if (api.containsKey("exitPortfolio")) ConfigManager::getInstance().setExitPortfolio(api["exitPortfolio"].as<String>());
+        portfoliosChanged = api.containsKey("entryPortfolio") || api.containsKey("exitPortfolio");
+    }
+    
+    // Rows in table order: [{"name":..,"exitAlerts":..,"refreshInterval":..,"priority":..}, ..]
+    if (doc.containsKey("portfolios")) {
+        JsonArray portfolios = doc["portfolios"];
+        uint8_t index = 0;
+        for (JsonObject item : portfolios) {
+            if (index >= PORTFOLIO_MAX) break;
+            
+            PortfolioConfig config;
+            ConfigManager::getInstance().getPortfolioConfig(index, config);
+            if (item.containsKey("name")) strlcpy(config.name, item["name"] | "", sizeof(config.name));
+            if (item.containsKey("exitAlerts")) config.exitAlerts = item["exitAlerts"];
+            if (item.containsKey("refreshInterval")) config.refreshInterval = item["refreshInterval"];
+            if (item.containsKey("priority")) config.priority = item["priority"];
+            ConfigManager::getInstance().setPortfolioConfig(index++, config);
+        }
+        portfoliosChanged = true;
     }
     
     if (doc.containsKey("alerts")) {
@@ -670,35 +1381,68 @@ void WebInterface::handleSettingsSave() {
         if (alerts.containsKey("buzzerEnabled")) ConfigManager::getInstance().setBuzzerEnabled(alerts["buzzerEnabled"].as<bool>());
     }
     
+    // {"lan":{"role":"off"|"auto"|"leader"|"follower"}}; applied on the next update
+    if (doc.containsKey("lan")) {
+        JsonObject lan = doc["lan"];
+        LanRole role = LanFanout::findRole(lan["role"] | "");
+        if (role != LAN_ROLE_COUNT) LanFanout::getInstance().setRole(role);
+    }
+    
+    // Applied by the fetch task before its next cycle
+    if (portfoliosChanged) {
+        DataManager::getInstance().requestPortfolioReload();
+    }
+    
     // Save other sections similarly...
     
+    // Only changed keys are written, in one background commit once the
+    // edits settle; a burst of slider moves costs a single flash write
     ConfigManager::getInstance().save();
     
     _server.send(200, "application/json", "{\"success\":true}");
 }
 
 // Battery Status Handler
+static void powerToJSON(PowerManager& power, JsonObject obj) {
+    obj["enabled"] = power.isEnabled();
+    obj["on_battery"] = power.isOnBattery();
+    obj["state"] = power.getStateName(power.getState());
+    obj["light_sleep"] = power.isLightSleepSupported();
+    obj["fetch_interval"] = power.getFetchInterval();
+    obj["volatility"] = power.getVolatility();
+    
+    // Current per state is a fixed estimate, not a measurement
+    JsonObject states = obj.createNestedObject("states");
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        PowerState state = (PowerState)i;
+        JsonObject entry = states.createNestedObject(power.getStateName(state));
+        entry["estimated_ma"] = power.getStateCurrent(state);
+        entry["time_ms"] = power.getStateTime(state);
+    }
+    obj["average_ma"] = power.getAverageCurrent();
+    obj["estimated_runtime_h"] = power.getEstimatedRuntime();
+}
+
 void WebInterface::handleBatteryStatus() {
     if (!checkAuth()) return;
     
-    DynamicJsonDocument doc(512);
+    StaticJsonDocument<1024> doc;
     
     doc["voltage"] = BatteryManager::getInstance().getVoltage();
     doc["percentage"] = BatteryManager::getInstance().getPercentage();
     doc["charging"] = BatteryManager::getInstance().isCharging();
     doc["health"] = BatteryManager::getInstance().getHealth();
     doc["status"] = BatteryManager::getInstance().getStatusString();
+    powerToJSON(PowerManager::getInstance(), doc.createNestedObject("power"));
     
-    String response;
-    serializeJson(doc, response);
-    _server.send(200, "application/json", response);
+    sendDocument(_server, "/api/battery/status", doc);
 }
 
 // Time Current Handler
 void WebInterface::handleTimeCurrent() {
     if (!checkAuth()) return;
     
-    DynamicJsonDocument doc(512);
+    StaticJsonDocument<384> doc;
     
     doc["timestamp"] = TimeManager::getInstance().getTimestamp();
     doc["formatted"] = TimeManager::getInstance().getFormattedTime();
@@ -706,9 +1450,7 @@ void WebInterface::handleTimeCurrent() {
     doc["synced"] = TimeManager::getInstance().isSynced();
     doc["timezone"] = TimeManager::getInstance().getTimezone();
     
-    String response;
-    serializeJson(doc, response);
-    _server.send(200, "application/json", response);
+    sendDocument(_server, "/api/time/current", doc);
 }
 
 // System Update Handler
@@ -734,6 +1476,7 @@ void WebInterface::handleSystemRestart() {
     if (!checkAuth()) return;
     
     _server.send(200, "application/json", "{\"success\":true, \"message\":\"Restarting...\"}");
+    ConfigManager::getInstance().flush();
     delay(1000);
     ESP.restart();
 }
@@ -767,127 +1510,270 @@ void WebInterface::handleNotFound() {
     _server.send(404, "text/plain", message);
 }
 
-// ===== UTILITY FUNCTIONS =====
-String WebInterface::generateDashboardHTML() {
-    // This function generates dynamic dashboard HTML
-    // In practice, you would use template files from SPIFFS
-    
-    String html = R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Portfolio Monitor Dashboard</title>
-    <link rel="stylesheet" href="/styles.css">
-    <script src="/script.js"></script>
-</head>
-<body>
-    <div class="container">
-        <header>
-            <h1>Portfolio Monitor Dashboard</h1>
-            <div class="status-bar">
-                <span id="wifi-status">Connecting...</span>
-                <span id="battery-status">100%</span>
-                <span id="time">00:00:00</span>
-            </div>
-        </header>
-        
-        <main>
-            <div class="dashboard-grid">
-                <div class="card">
-                    <h2>Entry Mode</h2>
-                    <div class="stats" id="entry-stats">
-                        Loading...
-                    </div>
-                </div>
-                
-                <div class="card">
-                    <h2>Exit Mode</h2>
-                    <div class="stats" id="exit-stats">
-                        Loading...
-                    </div>
-                </div>
-                
-                <div class="card">
-                    <h2>Alerts</h2>
-                    <div class="alerts" id="alerts-list">
-                        No active alerts
-                    </div>
-                </div>
-                
-                <div class="card">
-                    <h2>Quick Actions</h2>
-                    <div class="actions">
-                        <button onclick="refreshData()">Refresh Data</button>
-                        <button onclick="testAlerts()">Test Alerts</button>
-                        <button onclick="openSettings()">Settings</button>
-                    </div>
-                </div>
-            </div>
-        </main>
+// ===== PUSH CHANNEL =====
+static void handlePushEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX) return;
+    PushClient& client = _push.clients[num];
+    
+    switch (type) {
+        case WStype_CONNECTED:
+            // payload is the request URL
+            client.connected = true;
+            client.msgpack = payload && strstr((const char*)payload, "format=msgpack") != nullptr;
+            client.snapshotPending = true;
+            client.alertSequence = _alerts ? _alerts->getAlertSequence() : 0;
+            memset(client.baseline, 0, sizeof(client.baseline));
+            if (client.sentHash) {
+                memset(client.sentHash, 0, PORTFOLIO_MAX * SYMBOL_TABLE_CAPACITY * sizeof(uint32_t));
+            }
+            break;
+        case WStype_DISCONNECTED:
+            client.connected = false;
+            break;
+        default:
+            // Clients only listen
+            break;
+    }
+}
+
+static uint32_t hashPosition(const PositionRecord& pos) {
+    // FNV-1a over the fields a dashboard shows
+    const float values[5] = {pos.changePercent, pos.pnlValue, pos.quantity,
+                             pos.entryPrice, pos.currentPrice};
+    const uint8_t flags = pos.isLong | (pos.alerted << 1) | (pos.severeAlerted << 2);
+    
+    uint32_t h = 2166136261u;
+    const uint8_t* bytes = (const uint8_t*)values;
+    for (size_t i = 0; i < sizeof(values); i++) {
+        h = (h ^ bytes[i]) * 16777619u;
+    }
+    h = (h ^ flags) * 16777619u;
+    return h ? h : 1;
+}
+
+// Positions of one portfolio that differ from a client's baseline
+struct PushDelta {
+    uint8_t changed[RANKING_MAX_POSITIONS];     // Position indexes
+    int changedCount;
+    uint16_t removed[RANKING_MAX_POSITIONS];    // Symbol IDs
+    int removedCount;
+};
+
+static void collectDelta(PushClient& client, const PortfolioSnapshot& snapshot, uint8_t portfolio,
+                         bool full, PushDelta& delta) {
+    const PositionRecord* positions = snapshot.positions;
+    int count = min(snapshot.count, RANKING_MAX_POSITIONS);
+    uint32_t* sentHash = client.sentHash + portfolio * SYMBOL_TABLE_CAPACITY;
+    uint32_t& baseline = client.baseline[portfolio];
+    
+    // One generation behind: only the snapshot's changed set can differ
+    bool incremental = !full && baseline != 0 && baseline + 1 == snapshot.generation;
+    baseline = snapshot.generation;
+    
+    uint32_t seen[SYMBOL_TABLE_CAPACITY / 32];
+    memset(seen, 0, sizeof(seen));
+    delta.changedCount = 0;
+    delta.removedCount = 0;
+    
+    for (int i = 0; i < count; i++) {
+        uint16_t id = positions[i].symbolId;
         
-        <footer>
-            <p>Portfolio Monitor v4.5.3 | ESP32-WROVER-E</p>
-        </footer>
-    </div>
-    
-    <script>
-        // JavaScript for dynamic updates
-        function updateDashboard() {
-            fetch('/api/data/summary')
-                .then(response => response.json())
-                .then(data => {
-                    // Update UI with data
-                    document.getElementById('entry-stats').innerHTML = 
-                        `Positions: ${data.entry.totalPositions}<br>
-                         P/L: ${data.entry.totalPnlPercent.toFixed(2)}%<br>
-                         Value: $${data.entry.totalCurrentValue.toFixed(2)}`;
-                    
-                    document.getElementById('exit-stats').innerHTML = 
-                        `Positions: ${data.exit.totalPositions}<br>
-                         P/L: ${data.exit.totalPnlPercent.toFixed(2)}%<br>
-                         Value: $${data.exit.totalCurrentValue.toFixed(2)}`;
-                });
+        // Positions without an ID cannot be tracked and are always sent
+        if (id != SYMBOL_ID_NONE) {
+            seen[id / 32] |= 1UL << (id % 32);
+            if (incremental && !(snapshot.changed[id / 32] & (1UL << (id % 32)))) continue;
             
-            fetch('/api/alerts/status')
-                .then(response => response.json())
-                .then(data => {
-                    // Update alerts
-                    let alertsHtml = '';
-                    if (data.entry.count > 0 || data.exit.count > 0) {
-                        alertsHtml = '<ul>';
-                        data.entry.active.forEach(alert => {
-                            alertsHtml += `<li>${alert.symbol}: ${alert.message}</li>`;
-                        });
-                        data.exit.active.forEach(alert => {
-                            alertsHtml += `<li>${alert.symbol}: ${alert.message}</li>`;
-                        });
-                        alertsHtml += '</ul>';
-                    } else {
-                        alertsHtml = 'No active alerts';
-                    }
-                    document.getElementById('alerts-list').innerHTML = alertsHtml;
-                });
-            
-            fetch('/api/system/status')
-                .then(response => response.json())
-                .then(data => {
-                    // Update status bar
-                    document.getElementById('wifi-status').textContent = 
-                        data.network.connected ? 'WiFi Connected' : 'WiFi Disconnected';
-                });
+            uint32_t h = hashPosition(positions[i]);
+            if (!full && sentHash[id] == h) continue;
+            sentHash[id] = h;
+        }
+        delta.changed[delta.changedCount++] = i;
+    }
+    
+    // Symbols the client has but that are gone now
+    for (int id = 0; id < SYMBOL_TABLE_CAPACITY && delta.removedCount < RANKING_MAX_POSITIONS; id++) {
+        if (sentHash[id] == 0 || (seen[id / 32] & (1UL << (id % 32)))) continue;
+        sentHash[id] = 0;
+        delta.removed[delta.removedCount++] = id;
+    }
+}
+
+static void writePositionsMessage(bool msgpack, const PortfolioSnapshot& snapshot, const char* mode,
+                                  bool full, const PushDelta& delta) {
+    const PositionRecord* positions = snapshot.positions;
+    const char* type = full ? "snapshot" : "delta";
+    StaticJsonDocument<384> doc;
+    
+    _pushBuffer.reset();
+    
+    if (msgpack) {
+        msgpackMap(_pushBuffer, 5);
+        msgpackString(_pushBuffer, "type");
+        msgpackString(_pushBuffer, type);
+        msgpackString(_pushBuffer, "mode");
+        msgpackString(_pushBuffer, mode);
+        
+        msgpackString(_pushBuffer, "summary");
+        summaryToArray(snapshot.summary, doc);
+        serializeMsgPack(doc, _pushBuffer);
+        
+        msgpackString(_pushBuffer, "positions");
+        msgpackArray(_pushBuffer, delta.changedCount);
+        for (int i = 0; i < delta.changedCount; i++) {
+            positionToArray(positions[delta.changed[i]], doc);
+            serializeMsgPack(doc, _pushBuffer);
+        }
+        
+        msgpackString(_pushBuffer, "removed");
+        msgpackArray(_pushBuffer, delta.removedCount);
+        for (int i = 0; i < delta.removedCount; i++) {
+            msgpackString(_pushBuffer, SymbolTable::getInstance().getName(delta.removed[i]));
+        }
+        return;
+    }
+    
+    _pushBuffer.print("{\"type\":\"");
+    _pushBuffer.print(type);
+    _pushBuffer.print("\",\"mode\":\"");
+    _pushBuffer.print(mode);
+    _pushBuffer.print("\",\"summary\":");
+    summaryToJSON(snapshot.summary, doc);
+    serializeJson(doc, _pushBuffer);
+    
+    _pushBuffer.print(",\"positions\":[");
+    for (int i = 0; i < delta.changedCount; i++) {
+        doc.clear();
+        positionToJSON(positions[delta.changed[i]], doc);
+        if (i > 0) _pushBuffer.print(',');
+        serializeJson(doc, _pushBuffer);
+    }
+    
+    _pushBuffer.print("],\"removed\":[");
+    for (int i = 0; i < delta.removedCount; i++) {
+        if (i > 0) _pushBuffer.print(',');
+        _pushBuffer.print('"');
+        _pushBuffer.print(SymbolTable::getInstance().getName(delta.removed[i]));
+        _pushBuffer.print('"');
+    }
+    _pushBuffer.print("]}");
+}
+
+// Alerts raised after the last one this client received; false if none
+static bool writeAlertsMessage(PushClient& client) {
+    static AlertRecord alerts[ALERT_HISTORY_SIZE];
+    int count = _alerts->getAlertsSince(client.alertSequence, alerts, ALERT_HISTORY_SIZE);
+    if (count == 0) return false;
+    
+    StaticJsonDocument<384> doc;
+    
+    _pushBuffer.reset();
+    if (client.msgpack) {
+        msgpackMap(_pushBuffer, 2);
+        msgpackString(_pushBuffer, "type");
+        msgpackString(_pushBuffer, "alerts");
+        msgpackString(_pushBuffer, "alerts");
+        msgpackArray(_pushBuffer, count);
+    } else {
+        _pushBuffer.print("{\"type\":\"alerts\",\"alerts\":[");
+    }
+    
+    for (int i = 0; i < count; i++) {
+        doc.clear();
+        alertToJSON(alerts[i], doc);
+        
+        if (client.msgpack) {
+            serializeMsgPack(doc, _pushBuffer);
+        } else {
+            if (i > 0) _pushBuffer.print(',');
+            serializeJson(doc, _pushBuffer);
         }
+    }
+    if (!client.msgpack) _pushBuffer.print("]}");
+    
+    client.alertSequence = alerts[count - 1].sequence;
+    return true;
+}
+
+static void sendPushBuffer(uint8_t num, const PushClient& client) {
+    if (_pushBuffer.overflow) {
+        Serial.println("Push message exceeds buffer, skipped");
+        return;
+    }
+    
+    if (client.msgpack) {
+        _pushServer.sendBIN(num, (const uint8_t*)_pushBuffer.data, _pushBuffer.length);
+    } else {
+        _pushServer.sendTXT(num, _pushBuffer.data, _pushBuffer.length);
+    }
+    _push.messagesSent++;
+    _push.bytesSent += _pushBuffer.length;
+}
+
+static void pushAlerts() {
+    if (!_alerts) return;
+    
+    uint32_t sequence = _alerts->getAlertSequence();
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        PushClient& client = _push.clients[num];
+        if (!client.connected || client.alertSequence == sequence) continue;
         
-        // Update every 10 seconds
-        setInterval(updateDashboard, 10000);
-        updateDashboard(); // Initial update
-    </script>
-</body>
-</html>
-)rawliteral";
+        if (writeAlertsMessage(client)) sendPushBuffer(num, client);
+    }
+}
+
+static void pushUpdates() {
+    if (!_pushBuffer.data) return;
+    
+    // Alerts go out as soon as they are raised, changed data or not
+    pushAlerts();
+    
+    bool pending = false;
+    bool connected = false;
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        connected |= _push.clients[i].connected && _push.clients[i].sentHash;
+        pending |= _push.clients[i].connected && _push.clients[i].snapshotPending;
+    }
+    
+    DataManager& data = DataManager::getInstance();
+    bool changed[PORTFOLIO_MAX];
+    bool dataChanged = false;
+    for (uint8_t p = 0; p < PORTFOLIO_MAX; p++) {
+        changed[p] = data.isPortfolioActive(p) && data.getGeneration(p) != _push.lastGeneration[p];
+        dataChanged |= changed[p];
+    }
+    if (!connected || (!dataChanged && !pending)) return;
+    
+    // Decided once, so every portfolio of this round goes to the same clients
+    bool send[WEBSOCKETS_SERVER_CLIENT_MAX];
+    bool full[WEBSOCKETS_SERVER_CLIENT_MAX];
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        PushClient& client = _push.clients[num];
+        full[num] = client.snapshotPending;
+        send[num] = client.connected && client.sentHash && (full[num] || dataChanged);
+        if (send[num]) client.snapshotPending = false;
+    }
+    
+    static PushDelta delta;
     
-    return html;
+    // One pinned snapshot at a time: no lock, and the parser is never held up
+    for (uint8_t p = 0; p < PORTFOLIO_MAX; p++) {
+        if (!data.isPortfolioActive(p)) continue;
+        
+        SnapshotReader snapshot(p);
+        if (!snapshot.isValid()) continue;
+        _push.lastGeneration[p] = snapshot->generation;
+        
+        for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+            if (!send[num] || (!full[num] && !changed[p])) continue;
+            PushClient& client = _push.clients[num];
+            
+            collectDelta(client, *snapshot, p, full[num], delta);
+            if (!full[num] && delta.changedCount == 0 && delta.removedCount == 0) continue;
+            
+            writePositionsMessage(client.msgpack, *snapshot, data.getPortfolioTag(p), full[num], delta);
+            sendPushBuffer(num, client);
+        }
+    }
 }
 
 // ===== STATIC ACCESS =====
@@ -898,4 +1784,11 @@ WebInterface& WebInterface::getInstance() {
 
 void WebInterface::handleClient() {
     _server.handleClient();
+    _pushServer.loop();
+    
+    // An open dashboard counts as web UI activity
+    if (_pushServer.connectedClients() > 0) {
+        PowerManager::getInstance().noteActivity();
+    }
+    pushUpdates();
 }
\ No newline at end of file
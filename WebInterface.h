@@ -9,7 +9,7 @@
 class WiFiManager;
 class DisplayManager;
 class BuzzerManager;
-class CryptoData;
+class AlertManager;
 struct SystemState;
 struct SystemSettings;
 
@@ -22,7 +22,6 @@ private:
     WiFiManager* wifiMgr;
     DisplayManager* displayMgr;
     BuzzerManager* buzzerMgr;
-    CryptoData* cryptoData;
     SystemState* systemState;
     
     // Server state
@@ -78,8 +77,8 @@ public:
     // ===== INITIALIZATION =====
     void init(SystemSettings& settings, WiFiManager& wifiMgr,
               DisplayManager& displayMgr, BuzzerManager& buzzerMgr,
-              CryptoData& cryptoData, SystemState& systemState,
-              int port = 80);
+              SystemState& systemState, int port = 80);
+    void attachAlerts(AlertManager& alerts);
     bool isInitialized() const;
     void enableAuthentication(const String& username, const String& password);
     void disableAuthentication();
@@ -307,12 +306,6 @@ inline bool WebInterface::isInitialized() const {
     return initialized;
 }
 
-inline void WebInterface::handleClient() {
-    if (initialized) {
-        server.handleClient();
-    }
-}
-
 inline void WebInterface::enableAuthentication(const String& username, 
                                               const String& password) {
     authEnabled = true;
@@ -17,6 +17,10 @@
 #define DNS_PORT 53
 #define AP_CHANNEL 1
 #define AP_MAX_CONNECTIONS 4
+#define FAST_CONNECT_TIMEOUT 3000       // Known BSSID and channel; no scan
+#define FAST_CONNECT_MAGIC 0x57494649
+#define CONNECT_POLL_INTERVAL 50
+#define SCAN_DWELL_TIME 120             // ms per channel, keeps STA off-channel briefly
 
 // ===== STATIC VARIABLES =====
 DNSServer WiFiManager::_dnsServer;
@@ -38,6 +42,84 @@ IPAddress WiFiManager::_apIP(192, 168, 4, 1);
 IPAddress WiFiManager::_apGateway(192, 168, 4, 1);
 IPAddress WiFiManager::_apSubnet(255, 255, 255, 0);
 
+// ===== FAST RECONNECT STATE =====
+// Last successful association. The RTC copy survives software resets and
+// deep sleep; the NVS copy survives power loss.
+struct FastConnectRecord {
+    uint32_t magic;
+    char ssid[33];
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+};
+
+static RTC_NOINIT_ATTR FastConnectRecord _fastRecord;
+static bool _fastReconnectPending = false;
+static unsigned long _lastConnectDuration = 0;
+static bool _lastConnectFast = false;
+
+static bool loadFastRecord() {
+    if (_fastRecord.magic == FAST_CONNECT_MAGIC && _fastRecord.ssid[0]) return true;
+    
+    ConfigManager& config = ConfigManager::getInstance();
+    String ssid = config.getString("fast_ssid", "");
+    String bssid = config.getString("fast_bssid", "");
+    if (ssid.isEmpty() || bssid.length() != 12) return false;
+    
+    memset(&_fastRecord, 0, sizeof(_fastRecord));
+    strlcpy(_fastRecord.ssid, ssid.c_str(), sizeof(_fastRecord.ssid));
+    for (int i = 0; i < 6; i++) {
+        _fastRecord.bssid[i] = strtoul(bssid.substring(i * 2, i * 2 + 2).c_str(), nullptr, 16);
+    }
+    _fastRecord.channel = config.getUChar("fast_channel", 0);
+    _fastRecord.ip = config.getUInt("fast_ip", 0);
+    _fastRecord.gateway = config.getUInt("fast_gateway", 0);
+    _fastRecord.subnet = config.getUInt("fast_subnet", 0);
+    _fastRecord.dns = config.getUInt("fast_dns", 0);
+    _fastRecord.magic = FAST_CONNECT_MAGIC;
+    
+    return _fastRecord.channel != 0;
+}
+
+static void storeFastRecord(const String& ssid) {
+    FastConnectRecord record;
+    memset(&record, 0, sizeof(record));
+    record.magic = FAST_CONNECT_MAGIC;
+    strlcpy(record.ssid, ssid.c_str(), sizeof(record.ssid));
+    uint8_t* bssid = WiFi.BSSID();
+    if (bssid) memcpy(record.bssid, bssid, sizeof(record.bssid));
+    record.channel = WiFi.channel();
+    record.ip = (uint32_t)WiFi.localIP();
+    record.gateway = (uint32_t)WiFi.gatewayIP();
+    record.subnet = (uint32_t)WiFi.subnetMask();
+    record.dns = (uint32_t)WiFi.dnsIP();
+    
+    // Reconnects to the same AP do not touch flash
+    if (memcmp(&record, &_fastRecord, sizeof(record)) == 0) return;
+    _fastRecord = record;
+    
+    char hex[13];
+    snprintf(hex, sizeof(hex), "%02x%02x%02x%02x%02x%02x", record.bssid[0], record.bssid[1],
+             record.bssid[2], record.bssid[3], record.bssid[4], record.bssid[5]);
+    
+    ConfigManager& config = ConfigManager::getInstance();
+    config.putString("fast_ssid", record.ssid);
+    config.putString("fast_bssid", hex);
+    config.putUChar("fast_channel", record.channel);
+    config.putUInt("fast_ip", record.ip);
+    config.putUInt("fast_gateway", record.gateway);
+    config.putUInt("fast_subnet", record.subnet);
+    config.putUInt("fast_dns", record.dns);
+}
+
+static void clearFastRecord() {
+    _fastRecord.magic = 0;
+    ConfigManager::getInstance().putString("fast_ssid", "");
+}
+
 // ===== INITIALIZATION =====
 bool WiFiManager::begin(bool enableCaptivePortal) {
     Serial.println("Initializing WiFi Manager...");
@@ -57,16 +139,17 @@ bool WiFiManager::begin(bool enableCaptivePortal) {
     _state = WIFI_STATE_DISCONNECTED;
     _apEnabled = ConfigManager::getInstance().getBool("ap_enabled", true);
     
-    // Start in AP mode initially for configuration
-    if (_apEnabled) {
-        startAPMode();
-    }
-    
-    // Try to connect to saved networks if any
+    // Try to connect to saved networks if any; the cached association
+    // usually gets the uplink up before a scan would have finished
     if (_savedNetworks.size() > 0) {
         connectToBestNetwork();
     }
     
+    // AP for configuration; runs alongside STA once connected
+    if (_apEnabled && WiFi.status() != WL_CONNECTED) {
+        startAPMode();
+    }
+    
     // Setup web server
     setupWebServer();
     
@@ -103,9 +186,23 @@ void WiFiManager::update() {
     // Check WiFi status
     checkConnectionStatus();
     
+    // Collect background scan results
+    int found = WiFi.scanComplete();
+    if (found >= 0) {
+        processScanResults(found);
+    }
+    
+    // Link dropped: retry the same AP right away instead of waiting for
+    // the reconnect interval
+    if (_fastReconnectPending && _state == WIFI_STATE_DISCONNECTED) {
+        _fastReconnectPending = false;
+        if (!tryFastConnect()) {
+            _lastConnectionAttempt = currentTime - RECONNECT_INTERVAL;
+        }
+    }
+    
     // Auto-reconnect logic
     if (_state == WIFI_STATE_DISCONNECTED && 
-        _apEnabled && 
         _savedNetworks.size() > 0 &&
         (currentTime - _lastConnectionAttempt > RECONNECT_INTERVAL)) {
         
@@ -122,9 +219,9 @@ void WiFiManager::update() {
         }
     }
     
-    // Periodic network scan
+    // Periodic network scan; never disconnects STA
     if (currentTime - _lastScanTime > WIFI_SCAN_INTERVAL) {
-        scanNetworks(false); // Non-blocking scan
+        scanNetworks(false);
     }
 }
 
@@ -220,8 +317,15 @@ bool WiFiManager::connectToBestNetwork() {
         return false;
     }
     
-    // Scan for available networks first
-    scanNetworks(true);
+    // Last association first; needs no scan
+    if (tryFastConnect()) {
+        return true;
+    }
+    
+    // Recent background results are as good as a new scan
+    if (_scannedNetworks.empty() || millis() - _lastScanTime > WIFI_SCAN_INTERVAL) {
+        scanNetworks(true);
+    }
     
     // Find best available network
     WiFiNetwork* bestNet = nullptr;
@@ -346,38 +450,39 @@ bool WiFiManager::startAPSTA() {
 }
 
 // ===== SCANNING =====
+// The station is never disconnected for a scan. Blocking scans are only
+// done while STA has no link; otherwise the scan runs in the background
+// and update() collects the results.
 void WiFiManager::scanNetworks(bool blocking) {
-    if (blocking) {
+    if (blocking && WiFi.status() != WL_CONNECTED) {
         performScan();
-    } else {
-        // Start async scan
-        WiFi.scanNetworks(true);
-        _lastScanTime = millis();
+        return;
     }
+    
+    if (WiFi.scanComplete() == WIFI_SCAN_RUNNING) return;
+    
+    WiFi.scanNetworks(true, true, false, SCAN_DWELL_TIME);
+    _lastScanTime = millis();
 }
 
 void WiFiManager::performScan() {
     Serial.println("Scanning for WiFi networks...");
+    processScanResults(WiFi.scanNetworks(false, true, false, SCAN_DWELL_TIME));
+}
+
+void WiFiManager::processScanResults(int numNetworks) {
+    _lastScanTime = millis();
     
-    // Disconnect during scan for better results
-    bool wasConnected = (WiFi.status() == WL_CONNECTED);
-    if (wasConnected) {
-        WiFi.disconnect(false);
-        delay(100);
-    }
-    
-    // Perform scan
-    int numNetworks = WiFi.scanNetworks(false, true);
-    
-    // Reconnect if we were connected
-    if (wasConnected) {
-        WiFi.reconnect();
+    if (numNetworks < 0) {
+        WiFi.scanDelete();
+        return;
     }
     
     _scannedNetworks.clear();
     
     if (numNetworks == 0) {
         Serial.println("No networks found");
+        WiFi.scanDelete();
         return;
     }
     
@@ -432,9 +537,10 @@ bool WiFiManager::connectToWiFi(WiFiNetwork& network) {
     Serial.println(network.ssid);
     Serial.println("========================================");
     
-    // Disconnect first
-    WiFi.disconnect(true);
-    delay(500);
+    // Leave an established link only when switching networks
+    if (WiFi.status() == WL_CONNECTED && WiFi.SSID() != network.ssid) {
+        WiFi.disconnect(false);
+    }
     
     // Set mode
     if (_apEnabled) {
@@ -455,54 +561,8 @@ bool WiFiManager::connectToWiFi(WiFiNetwork& network) {
     _lastConnectionAttempt = millis();
     _state = WIFI_STATE_CONNECTING;
     
-    // Wait for connection
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 40) {
-        delay(500);
-        attempts++;
-        
-        Serial.print(".");
-        
-        // Timeout check
-        if (millis() - _connectionStartTime > CONNECTION_TIMEOUT) {
-            Serial.println("\nConnection timeout");
-            network.connectionAttempts++;
-            _state = WIFI_STATE_DISCONNECTED;
-            return false;
-        }
-    }
-    
-    if (WiFi.status() == WL_CONNECTED) {
-        // Success
-        _state = WIFI_STATE_CONNECTED;
-        _currentSSID = network.ssid;
-        _currentRSSI = WiFi.RSSI();
-        network.lastConnected = millis();
-        network.connectionAttempts++;
-        network.rssi = _currentRSSI;
-        
-        // Update AP mode if needed
-        if (_apEnabled) {
-            startAPSTA();
-        }
-        
-        // Setup mDNS
-        setupMDNS();
-        
-        Serial.println("\n✅ CONNECTED!");
-        Serial.print("  IP Address: ");
-        Serial.println(WiFi.localIP().toString());
-        Serial.print("  Gateway: ");
-        Serial.println(WiFi.gatewayIP().toString());
-        Serial.print("  RSSI: ");
-        Serial.print(_currentRSSI);
-        Serial.println(" dBm");
-        Serial.print("  Channel: ");
-        Serial.println(WiFi.channel());
-        
-        saveNetworks();
-        _reconnectAttempts = 0;
-        
+    if (waitForConnection(CONNECTION_TIMEOUT)) {
+        onConnected(network, false);
         return true;
     } else {
         // Failed
@@ -519,6 +579,115 @@ bool WiFiManager::connectToWiFi(WiFiNetwork& network) {
     }
 }
 
+bool WiFiManager::tryFastConnect() {
+    if (!loadFastRecord()) return false;
+    
+    WiFiNetwork* network = nullptr;
+    for (auto& net : _savedNetworks) {
+        if (net.ssid == _fastRecord.ssid) {
+            network = &net;
+            break;
+        }
+    }
+    if (!network || !network->autoConnect) return false;
+    
+    Serial.print("Fast reconnect to ");
+    Serial.print(network->ssid);
+    Serial.print(" on channel ");
+    Serial.println(_fastRecord.channel);
+    
+    if (_apEnabled) {
+        WiFi.mode(WIFI_AP_STA);
+    } else {
+        WiFi.mode(WIFI_STA);
+    }
+    WiFi.setAutoReconnect(true);
+    WiFi.persistent(false);
+    WiFi.setSleep(false);
+    
+    // Reusing the last lease also skips DHCP; opt-in, the lease may have moved
+    bool staticIP = ConfigManager::getInstance().getBool("fast_static_ip", false) &&
+                    _fastRecord.ip != 0;
+    if (staticIP) {
+        WiFi.config(IPAddress(_fastRecord.ip), IPAddress(_fastRecord.gateway),
+                    IPAddress(_fastRecord.subnet), IPAddress(_fastRecord.dns));
+    }
+    
+    // Known channel and BSSID: no scan before association
+    WiFi.begin(network->ssid.c_str(), network->password.c_str(),
+               _fastRecord.channel, _fastRecord.bssid);
+    
+    _connectionStartTime = millis();
+    _lastConnectionAttempt = millis();
+    _state = WIFI_STATE_CONNECTING;
+    
+    if (waitForConnection(FAST_CONNECT_TIMEOUT)) {
+        onConnected(*network, true);
+        return true;
+    }
+    
+    // AP moved or changed channel; the full path scans again
+    Serial.println("Fast reconnect failed");
+    clearFastRecord();
+    if (staticIP) {
+        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    }
+    WiFi.disconnect(false);
+    _state = WIFI_STATE_DISCONNECTED;
+    return false;
+}
+
+bool WiFiManager::waitForConnection(unsigned long timeout) {
+    while (millis() - _connectionStartTime < timeout) {
+        wl_status_t status = WiFi.status();
+        if (status == WL_CONNECTED) return true;
+        if (status == WL_CONNECT_FAILED) break;
+        delay(CONNECT_POLL_INTERVAL);
+    }
+    
+    Serial.println("Connection timeout");
+    return false;
+}
+
+void WiFiManager::onConnected(WiFiNetwork& network, bool fast) {
+    _state = WIFI_STATE_CONNECTED;
+    _currentSSID = network.ssid;
+    _currentRSSI = WiFi.RSSI();
+    _lastConnectDuration = millis() - _connectionStartTime;
+    _lastConnectFast = fast;
+    _fastReconnectPending = false;
+    network.lastConnected = millis();
+    network.connectionAttempts++;
+    network.rssi = _currentRSSI;
+    
+    storeFastRecord(network.ssid);
+    
+    // Update AP mode if needed
+    if (_apEnabled) {
+        startAPSTA();
+    }
+    
+    // Setup mDNS
+    setupMDNS();
+    
+    Serial.println("\n✅ CONNECTED!");
+    Serial.print("  IP Address: ");
+    Serial.println(WiFi.localIP().toString());
+    Serial.print("  Gateway: ");
+    Serial.println(WiFi.gatewayIP().toString());
+    Serial.print("  RSSI: ");
+    Serial.print(_currentRSSI);
+    Serial.println(" dBm");
+    Serial.print("  Channel: ");
+    Serial.println(WiFi.channel());
+    Serial.print("  Time: ");
+    Serial.print(_lastConnectDuration);
+    Serial.println(fast ? " ms (fast path)" : " ms");
+    
+    saveNetworks();
+    _reconnectAttempts = 0;
+}
+
 void WiFiManager::disconnect() {
     Serial.println("Disconnecting from WiFi...");
     WiFi.disconnect(true);
@@ -544,6 +713,8 @@ void WiFiManager::checkConnectionStatus() {
                 if (_state != WIFI_STATE_CONNECTED) {
                     _state = WIFI_STATE_CONNECTED;
                     _currentRSSI = WiFi.RSSI();
+                    _fastReconnectPending = false;
+                    storeFastRecord(WiFi.SSID());
                     Serial.println("WiFi connection established");
                 }
                 break;
@@ -553,10 +724,9 @@ void WiFiManager::checkConnectionStatus() {
                     _state = WIFI_STATE_DISCONNECTED;
                     Serial.println("WiFi connection lost");
                     
-                    // Start AP if enabled
-                    if (_apEnabled && _state != WIFI_STATE_AP_MODE) {
-                        startAPMode();
-                    }
+                    // STA stays up for the fast reconnect; an enabled AP
+                    // keeps running next to it
+                    _fastReconnectPending = true;
                 }
                 break;
                 
@@ -612,7 +782,8 @@ bool WiFiManager::isCaptivePortalRequest() {
 
 // ===== WEB HANDLERS =====
 void WiFiManager::handleScanRequest() {
-    performScan();
+    // Cached results while connected; the refresh runs in the background
+    scanNetworks(true);
     
     DynamicJsonDocument doc(4096);
     JsonArray networks = doc.createNestedArray("networks");
@@ -682,6 +853,8 @@ void WiFiManager::handleStatusRequest() {
     doc["apIP"] = WiFi.softAPIP().toString();
     doc["apSSID"] = _apSSID;
     doc["mac"] = WiFi.macAddress();
+    doc["lastConnectMs"] = _lastConnectDuration;
+    doc["fastConnect"] = _lastConnectFast;
     
     String response;
     serializeJson(doc, response);
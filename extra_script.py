@@ -0,0 +1,145 @@
+"""
+Static asset pipeline for the web interface.
+
+data/ holds the editable sources. Before the filesystem image is built they
+are minified and gzipped into .pio/build/<env>/data, which becomes the
+directory uploadfs packs:
+
+  - .css/.js get content-hashed names (script.js -> script.3f2a9c1e.js.gz),
+    so the device can serve them with "Cache-Control: immutable"
+  - references in .html/.css files are rewritten to the hashed names
+  - everything compressible is stored only as <name>.gz; WebInterface
+    serves it with Content-Encoding: gzip
+
+Output is deterministic (gzip mtime 0), so unchanged sources produce an
+unchanged image and unchanged ETags.
+"""
+
+Import("env")
+
+import gzip
+import hashlib
+import os
+import re
+import shutil
+
+SOURCE_DIR = os.path.join(env.subst("$PROJECT_DIR"), "data")
+OUTPUT_DIR = os.path.join(env.subst("$PROJECT_BUILD_DIR"), env.subst("$PIOENV"), "data")
+
+HASHED_TYPES = (".css", ".js")
+REWRITE_TYPES = (".html", ".htm", ".css")
+COMPRESSED_TYPES = (".png", ".jpg", ".jpeg", ".gif", ".woff", ".woff2", ".gz")
+HASH_LENGTH = 8
+
+
+# ===== MINIFICATION =====
+# Deliberately conservative: whitespace and comments only, nothing that needs
+# a real parser to get right.
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    text = re.sub(r"\s*([{};,>])\s*", r"\1", text)
+    return text.replace(";}", "}").strip()
+
+
+def minify_js(text):
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def minify_html(text):
+    text = re.sub(r"<!--(?!\[if).*?-->", "", text, flags=re.S)
+    text = re.sub(r"<style>(.*?)</style>",
+                  lambda m: "<style>" + minify_css(m.group(1)) + "</style>", text, flags=re.S)
+    return minify_js(text)
+
+
+MINIFIERS = {
+    ".css": minify_css,
+    ".js": minify_js,
+    ".html": minify_html,
+    ".htm": minify_html,
+}
+
+
+# ===== PIPELINE =====
+def hashed_name(rel_path, content):
+    digest = hashlib.sha1(content).hexdigest()[:HASH_LENGTH]
+    base, ext = os.path.splitext(rel_path)
+    return "%s.%s%s" % (base, digest, ext)
+
+
+def rewrite_references(text, renames):
+    for original, renamed in renames.items():
+        # Match "script.js", '/script.js' and url(script.js) but not myscript.js
+        pattern = r"(?<=[\"'(/=])" + re.escape(original) + r"(?=[\"')?#])"
+        text = re.sub(pattern, renamed, text)
+    return text
+
+
+def write_output(rel_path, content):
+    target = os.path.join(OUTPUT_DIR, rel_path)
+    os.makedirs(os.path.dirname(target), exist_ok=True)
+
+    if rel_path.lower().endswith(COMPRESSED_TYPES):
+        with open(target, "wb") as f:
+            f.write(content)
+        return len(content)
+
+    with open(target + ".gz", "wb") as raw:
+        with gzip.GzipFile(filename="", mode="wb", fileobj=raw, compresslevel=9, mtime=0) as f:
+            f.write(content)
+        return raw.tell()
+
+
+def build_assets():
+    sources = {}
+    for root, _, files in os.walk(SOURCE_DIR):
+        for name in sorted(files):
+            path = os.path.join(root, name)
+            rel_path = os.path.relpath(path, SOURCE_DIR).replace(os.sep, "/")
+            with open(path, "rb") as f:
+                sources[rel_path] = f.read()
+
+    def minified(rel_path, content):
+        minifier = MINIFIERS.get(os.path.splitext(rel_path)[1].lower())
+        if not minifier:
+            return content
+        text = content.decode("utf-8").replace("\r\n", "\n")
+        return minifier(text).encode("utf-8")
+
+    # Scripts, then stylesheets, then pages, so every reference is rewritten
+    # to a name that is already final
+    order = {".js": 0, ".css": 1}
+    renames = {}
+    outputs = {}
+    for rel_path in sorted(sources, key=lambda p: (order.get(os.path.splitext(p)[1].lower(), 2), p)):
+        content = minified(rel_path, sources[rel_path])
+        if rel_path.lower().endswith(REWRITE_TYPES):
+            content = rewrite_references(content.decode("utf-8"), renames).encode("utf-8")
+        if rel_path.lower().endswith(HASHED_TYPES):
+            renamed = hashed_name(rel_path, content)
+            renames[rel_path] = renamed
+            rel_path = renamed
+        outputs[rel_path] = content
+
+    shutil.rmtree(OUTPUT_DIR, ignore_errors=True)
+    os.makedirs(OUTPUT_DIR)
+
+    total_source = sum(len(c) for c in sources.values())
+    total_output = 0
+    for rel_path, content in sorted(outputs.items()):
+        total_output += write_output(rel_path, content)
+
+    print("Web assets: %d files, %d -> %d bytes" % (len(outputs), total_source, total_output))
+
+
+if os.path.isdir(SOURCE_DIR):
+    build_assets()
+    env.Replace(PROJECT_DATA_DIR=OUTPUT_DIR)
@@ -0,0 +1,106 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+// Host stand-in for the Arduino-ESP32 core, covering what the modules of the
+// native environment use. The host build is single threaded, has no pins and
+// takes its time from the host clock.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define PI 3.1415926535897932384626433832795
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define F(text) (text)
+
+#define NATIVE_CPU_MHZ 240              // Reported core clock; cycle counts follow micros()
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::min;
+using std::max;
+
+// ===== TIMING =====
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// ===== PINS =====
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ===== CHIP =====
+uint32_t esp_random();
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+inline bool psramFound() { return true; }
+inline uint32_t getCpuFrequencyMhz() { return NATIVE_CPU_MHZ; }
+
+// glibc before 2.38 has no strlcpy
+size_t nativeStrlcpy(char* dst, const char* src, size_t size);
+#define strlcpy nativeStrlcpy
+
+class EspClass {
+public:
+    uint32_t getCycleCount();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getPsramSize();
+    uint32_t getFreePsram();
+    void restart();
+};
+extern EspClass ESP;
+
+// ===== SERIAL =====
+// Output goes to stdout; there is nothing to read
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) {}
+    void end() {}
+    operator bool() const { return true; }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    void flush() override;
+    using Print::write;
+};
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef NATIVE_FS_H
+#define NATIVE_FS_H
+
+#include "Arduino.h"
+
+// Arduino FS types for the host. No filesystem is mounted, so every File is
+// closed: opens fail and modules take their "storage unavailable" paths.
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2,
+};
+
+class File : public Stream {
+public:
+    File() {}
+
+    operator bool() const { return false; }
+    bool isDirectory() const { return false; }
+    File openNextFile(const char* mode = FILE_READ) { return File(); }
+    const char* name() const { return ""; }
+    const char* path() const { return ""; }
+    size_t size() const { return 0; }
+    size_t position() const { return 0; }
+    bool seek(uint32_t position, SeekMode mode = SeekSet) { return false; }
+    void close() {}
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t read(uint8_t* buffer, size_t size) { return 0; }
+    size_t write(uint8_t c) override { return 0; }
+    size_t write(const uint8_t* buffer, size_t size) override { return 0; }
+    using Print::write;
+};
+
+namespace fs {
+
+class FS {
+public:
+    File open(const char* path, const char* mode = FILE_READ, bool create = false) { return File(); }
+    File open(const String& path, const char* mode = FILE_READ, bool create = false) { return File(); }
+    bool exists(const char* path) { return false; }
+    bool exists(const String& path) { return false; }
+    bool remove(const char* path) { return false; }
+    bool remove(const String& path) { return false; }
+    bool rename(const char* from, const char* to) { return false; }
+    bool mkdir(const char* path) { return false; }
+    bool mkdir(const String& path) { return false; }
+    bool rmdir(const char* path) { return false; }
+};
+
+}  // namespace fs
+
+#endif
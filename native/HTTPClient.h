@@ -0,0 +1,49 @@
+#ifndef NATIVE_HTTP_CLIENT_H
+#define NATIVE_HTTP_CLIENT_H
+
+#include "WiFi.h"
+
+// Arduino HTTPClient for the host. Requests fail before they connect, so
+// APIManager reports "connection refused" and the replay never waits on it.
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum {
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_UNAUTHORIZED = 401,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+} t_http_codes;
+
+class HTTPClient {
+public:
+    bool begin(WiFiClient& client, const String& url) { return false; }
+    bool begin(const String& url) { return false; }
+    void end() {}
+    bool connected() { return false; }
+
+    void setReuse(bool reuse) {}
+    void setTimeout(uint16_t timeout) {}
+    void setConnectTimeout(int32_t timeout) {}
+    void addHeader(const String& name, const String& value) {}
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {}
+    String header(const char* name) { return String(); }
+    bool hasHeader(const char* name) { return false; }
+
+    int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int POST(const String& payload) { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int getSize() { return -1; }
+    String getString() { return String(); }
+    WiFiClient& getStream() { return _client; }
+
+    static String errorToString(int error) { return String("connection refused"); }
+
+private:
+    WiFiClient _client;
+};
+
+#endif
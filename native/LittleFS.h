@@ -0,0 +1,21 @@
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+
+#include "FS.h"
+
+// There is no history partition on the host; begin() always fails
+class LittleFSFS : public fs::FS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char* partitionLabel = "spiffs") {
+        return false;
+    }
+    void end() {}
+    bool format() { return false; }
+    size_t totalBytes() { return 0; }
+    size_t usedBytes() { return 0; }
+};
+
+extern LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,533 @@
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <chrono>
+#include <new>
+#include <random>
+#include <stdarg.h>
+#include <ctype.h>
+#include <thread>
+
+// Host runtime behind the native headers: clock, counted heap, Serial and the
+// Arduino String/Print/Stream implementations.
+
+EspClass ESP;
+HardwareSerial Serial;
+WiFiClass WiFi;
+LittleFSFS LittleFS;
+
+// ===== TIMING =====
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long millis() {
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)esp_timer_get_time();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {}
+
+// ===== CHIP =====
+uint32_t esp_random() {
+    // Fixed seed so replays generate the same payloads on every run
+    static std::mt19937 generator(0x5EED);
+    return generator();
+}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+    time_t now = time(nullptr);
+    return localtime_r(&now, info) != nullptr;
+}
+
+size_t nativeStrlcpy(char* dst, const char* src, size_t size) {
+    size_t length = strlen(src);
+    if (size) {
+        size_t copy = length < size - 1 ? length : size - 1;
+        memcpy(dst, src, copy);
+        dst[copy] = '\0';
+    }
+    return length;
+}
+
+// ===== COUNTED HEAP =====
+// A header in front of each block records its size; 16 bytes keeps the
+// alignment malloc gives.
+struct BlockHeader {
+    size_t size;
+    size_t reserved;
+};
+
+static size_t heapAllocated = 0;
+static size_t heapBlocks = 0;
+static size_t heapMinimumFree = NATIVE_HEAP_SIZE;
+static size_t heapLocalMinimum = NATIVE_HEAP_SIZE;
+static bool heapMonitoring = false;
+
+static size_t heapFree() {
+    return NATIVE_HEAP_SIZE - heapAllocated;
+}
+
+static void heapNoteUse() {
+    size_t free = heapFree();
+    if (free < heapMinimumFree) heapMinimumFree = free;
+    if (free < heapLocalMinimum) heapLocalMinimum = free;
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    if (size > heapFree()) return nullptr;
+    BlockHeader* header = (BlockHeader*)malloc(sizeof(BlockHeader) + size);
+    if (!header) return nullptr;
+    header->size = size;
+    heapAllocated += size;
+    heapBlocks++;
+    heapNoteUse();
+    return header + 1;
+}
+
+void* heap_caps_calloc(size_t count, size_t size, uint32_t caps) {
+    if (size && count > SIZE_MAX / size) return nullptr;
+    void* ptr = heap_caps_malloc(count * size, caps);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+    if (!ptr) return heap_caps_malloc(size, caps);
+    if (!size) {
+        heap_caps_free(ptr);
+        return nullptr;
+    }
+
+    BlockHeader* header = (BlockHeader*)ptr - 1;
+    size_t oldSize = header->size;
+    if (size > oldSize && size - oldSize > heapFree()) return nullptr;
+
+    BlockHeader* moved = (BlockHeader*)realloc(header, sizeof(BlockHeader) + size);
+    if (!moved) return nullptr;
+    moved->size = size;
+    heapAllocated = heapAllocated - oldSize + size;
+    heapNoteUse();
+    return moved + 1;
+}
+
+void heap_caps_free(void* ptr) {
+    if (!ptr) return;
+    BlockHeader* header = (BlockHeader*)ptr - 1;
+    heapAllocated -= header->size;
+    heapBlocks--;
+    free(header);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return heapFree();
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return heapMonitoring ? heapLocalMinimum : heapMinimumFree;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return heapFree();
+}
+
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t caps) {
+    info->total_free_bytes = heapFree();
+    info->total_allocated_bytes = heapAllocated;
+    info->largest_free_block = heapFree();
+    info->minimum_free_bytes = heap_caps_get_minimum_free_size(caps);
+    info->allocated_blocks = heapBlocks;
+    info->free_blocks = 1;
+    info->total_blocks = heapBlocks + 1;
+}
+
+esp_err_t heap_caps_monitor_local_minimum_free_size_start(void) {
+    heapLocalMinimum = heapFree();
+    heapMonitoring = true;
+    return ESP_OK;
+}
+
+esp_err_t heap_caps_monitor_local_minimum_free_size_stop(void) {
+    heapMonitoring = false;
+    return ESP_OK;
+}
+
+// Every new/delete goes through the counted heap as well
+void* operator new(size_t size) {
+    void* ptr = heap_caps_malloc(size ? size : 1, MALLOC_CAP_DEFAULT);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return heap_caps_malloc(size ? size : 1, MALLOC_CAP_DEFAULT);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return heap_caps_malloc(size ? size : 1, MALLOC_CAP_DEFAULT);
+}
+
+void operator delete(void* ptr) noexcept { heap_caps_free(ptr); }
+void operator delete[](void* ptr) noexcept { heap_caps_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { heap_caps_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { heap_caps_free(ptr); }
+
+uint32_t EspClass::getCycleCount() { return (uint32_t)(esp_timer_get_time() * NATIVE_CPU_MHZ); }
+uint32_t EspClass::getFreeHeap() { return heapFree(); }
+uint32_t EspClass::getMinFreeHeap() { return heapMinimumFree; }
+uint32_t EspClass::getMaxAllocHeap() { return heapFree(); }
+uint32_t EspClass::getPsramSize() { return NATIVE_HEAP_SIZE; }
+uint32_t EspClass::getFreePsram() { return heapFree(); }
+void EspClass::restart() { exit(0); }
+
+// ===== FREERTOS =====
+struct NativeSemaphore {
+    int unused;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return new NativeSemaphore();
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+// ===== SERIAL =====
+size_t HardwareSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+// ===== PRINT =====
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (!write(*buffer++)) break;
+        n++;
+    }
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char stackBuffer[64];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+    va_end(args);
+    if (length < 0) return 0;
+    if ((size_t)length < sizeof(stackBuffer)) return write((const uint8_t*)stackBuffer, length);
+
+    char* buffer = (char*)malloc(length + 1);
+    if (!buffer) return 0;
+    va_start(args, format);
+    vsnprintf(buffer, length + 1, format, args);
+    va_end(args);
+    size_t n = write((const uint8_t*)buffer, length);
+    free(buffer);
+    return n;
+}
+
+size_t Print::printNumber(unsigned long long value, int base, bool negative) {
+    char buffer[8 * sizeof(value) + 2];
+    char* p = &buffer[sizeof(buffer) - 1];
+    *p = '\0';
+    if (base < 2) base = 10;
+    do {
+        int digit = value % base;
+        *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+        value /= base;
+    } while (value);
+    if (negative) *--p = '-';
+    return write(p);
+}
+
+size_t Print::print(const String& text) { return write((const uint8_t*)text.c_str(), text.length()); }
+size_t Print::print(const char text[]) { return write(text); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print((unsigned long long)value, base); }
+size_t Print::print(int value, int base) { return print((long long)value, base); }
+size_t Print::print(unsigned int value, int base) { return print((unsigned long long)value, base); }
+size_t Print::print(long value, int base) { return print((long long)value, base); }
+size_t Print::print(unsigned long value, int base) { return print((unsigned long long)value, base); }
+
+size_t Print::print(long long value, int base) {
+    if (base == 10 && value < 0) return printNumber(0ULL - (unsigned long long)value, 10, true);
+    return printNumber((unsigned long long)value, base, false);
+}
+
+size_t Print::print(unsigned long long value, int base) {
+    return printNumber(value, base, false);
+}
+
+size_t Print::print(double value, int digits) {
+    if (isnan(value)) return print("nan");
+    if (isinf(value)) return print("inf");
+    return printf("%.*f", digits, value);
+}
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const String& text) { return print(text) + println(); }
+size_t Print::println(const char text[]) { return print(text) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char value, int base) { return print(value, base) + println(); }
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Print::println(long long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long long value, int base) { return print(value, base) + println(); }
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
+
+// ===== STREAM =====
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0) break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0 || c == terminator) break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String text;
+    int c;
+    while ((c = read()) >= 0) text.concat((char)c);
+    return text;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String text;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) text.concat((char)c);
+    return text;
+}
+
+// ===== STRING =====
+static std::string formatInteger(unsigned long long value, unsigned char base, bool negative) {
+    char buffer[8 * sizeof(value) + 2];
+    char* p = &buffer[sizeof(buffer) - 1];
+    *p = '\0';
+    if (base < 2) base = 10;
+    do {
+        int digit = value % base;
+        *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+    } while (value);
+    if (negative) *--p = '-';
+    return p;
+}
+
+static std::string formatSigned(long long value, unsigned char base) {
+    if (value < 0) return formatInteger(0ULL - (unsigned long long)value, base, true);
+    return formatInteger((unsigned long long)value, base, false);
+}
+
+static std::string formatFloat(double value, unsigned int decimalPlaces) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimalPlaces, value);
+    return buffer;
+}
+
+String::String(unsigned char value, unsigned char base) : _text(formatInteger(value, base, false)) {}
+String::String(int value, unsigned char base) : _text(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : _text(formatInteger(value, base, false)) {}
+String::String(long value, unsigned char base) : _text(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : _text(formatInteger(value, base, false)) {}
+String::String(long long value, unsigned char base) : _text(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : _text(formatInteger(value, base, false)) {}
+String::String(float value, unsigned int decimalPlaces) : _text(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned int decimalPlaces) : _text(formatFloat(value, decimalPlaces)) {}
+
+String& String::operator=(const char* text) {
+    _text = text ? text : "";
+    return *this;
+}
+
+bool String::reserve(unsigned int size) {
+    _text.reserve(size);
+    return true;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < _text.size() ? _text[index] : '\0';
+}
+
+void String::setCharAt(unsigned int index, char c) {
+    if (index < _text.size()) _text[index] = c;
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= _text.size()) {
+        dummy = '\0';
+        return dummy;
+    }
+    return _text[index];
+}
+
+bool String::concat(const String& other) {
+    _text += other._text;
+    return true;
+}
+
+bool String::concat(const char* text) {
+    if (!text) return false;
+    _text += text;
+    return true;
+}
+
+bool String::concat(const char* text, unsigned int length) {
+    if (!text) return false;
+    _text.append(text, length);
+    return true;
+}
+
+bool String::concat(char c) {
+    _text += c;
+    return true;
+}
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (_text.size() != other._text.size()) return false;
+    for (size_t i = 0; i < _text.size(); i++) {
+        if (tolower((unsigned char)_text[i]) != tolower((unsigned char)other._text[i])) return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return _text.compare(0, prefix._text.size(), prefix._text) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return _text.size() >= suffix._text.size() &&
+           _text.compare(_text.size() - suffix._text.size(), suffix._text.size(), suffix._text) == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t found = _text.find(c, from);
+    return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::indexOf(const String& text, unsigned int from) const {
+    size_t found = _text.find(text._text, from);
+    return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::lastIndexOf(char c) const {
+    size_t found = _text.rfind(c);
+    return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::lastIndexOf(const String& text) const {
+    size_t found = _text.rfind(text._text);
+    return found == std::string::npos ? -1 : (int)found;
+}
+
+String String::substring(unsigned int from) const {
+    return substring(from, _text.size());
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _text.size()) return String();
+    if (to > _text.size()) to = _text.size();
+    return String(_text.c_str() + from, to - from);
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find._text.empty()) return;
+    size_t at = 0;
+    while ((at = _text.find(find._text, at)) != std::string::npos) {
+        _text.replace(at, find._text.size(), replacement._text);
+        at += replacement._text.size();
+    }
+}
+
+void String::remove(unsigned int index) {
+    if (index < _text.size()) _text.erase(index);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < _text.size()) _text.erase(index, count);
+}
+
+void String::toLowerCase() {
+    for (char& c : _text) c = tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (char& c : _text) c = toupper((unsigned char)c);
+}
+
+void String::trim() {
+    size_t begin = 0;
+    size_t end = _text.size();
+    while (begin < end && isspace((unsigned char)_text[begin])) begin++;
+    while (end > begin && isspace((unsigned char)_text[end - 1])) end--;
+    _text = _text.substr(begin, end - begin);
+}
+
+long String::toInt() const { return atol(_text.c_str()); }
+float String::toFloat() const { return (float)atof(_text.c_str()); }
+double String::toDouble() const { return atof(_text.c_str()); }
+
+String operator+(const String& left, const String& right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+String operator+(const String& left, const char* right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+String operator+(const char* left, const String& right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+String operator+(const String& left, char right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
@@ -0,0 +1,90 @@
+#include "../APIManager.h"
+#include "../BuzzerManager.h"
+
+// Stand-ins for the modules the native env leaves out. The replay hands its
+// payloads to parsePortfolioStream itself, so the network side only has to
+// report that it is offline; alerts still reach the buzzer, which is silent.
+
+// ===== API MANAGER =====
+APIManager::APIManager() :
+    settings(nullptr),
+    timeout(APIConfig::DEFAULT_TIMEOUT),
+    retryCount(APIConfig::DEFAULT_RETRY_COUNT),
+    useHTTPS(APIConfig::DEFAULT_USE_HTTPS),
+    verifySSL(APIConfig::DEFAULT_VERIFY_SSL),
+    requestInProgress(false),
+    requestStartTime(0),
+    _notModifiedCount(0),
+    _deltaCount(0),
+    _deltaEnabled(false),
+    lastErrorCode(0) {
+}
+
+APIManager::~APIManager() {
+}
+
+APIManager& APIManager::getInstance() {
+    static APIManager instance;
+    return instance;
+}
+
+bool APIManager::begin() {
+    return true;
+}
+
+bool APIManager::fetchPortfolioStream(const String& portfolioName, uint8_t portfolio,
+                                      APIStreamHandler handler, APIResponseInfo* responseInfo) {
+    setError(HTTPC_ERROR_NOT_CONNECTED, "offline");
+    if (responseInfo) {
+        responseInfo->httpCode = HTTPC_ERROR_NOT_CONNECTED;
+        responseInfo->error = lastErrorMessage;
+    }
+    return false;
+}
+
+bool APIManager::fetchPortfolios(const std::vector<String>& portfolioNames,
+                                 APIStreamHandler handler, APIResponseInfo* responseInfo) {
+    return fetchPortfolioStream(String(), 0, handler, responseInfo);
+}
+
+void APIManager::clearValidators(uint8_t portfolio) {
+    if (portfolio >= VALIDATOR_COUNT) return;
+    _validators[portfolio].etag = "";
+    _validators[portfolio].lastModified = "";
+    _validators[portfolio].version = "";
+}
+
+void APIManager::setError(int code, const String& message) {
+    lastErrorCode = code;
+    lastErrorMessage = message;
+}
+
+// ===== BUZZER MANAGER =====
+BuzzerManager::BuzzerManager(int buzzerPin) :
+    pin(buzzerPin),
+    frequency(0),
+    volume(DEFAULT_VOLUME),
+    enabled(false),
+    isPlaying(false),
+    toneStartTime(0),
+    currentToneIndex(0),
+    currentSequence(nullptr),
+    sequenceLength(0),
+    totalPlayTime(0),
+    totalTonesPlayed(0) {
+}
+
+BuzzerManager::~BuzzerManager() {
+}
+
+void BuzzerManager::playAlert(bool isLong, bool isSevere) {
+    totalTonesPlayed++;
+}
+
+void BuzzerManager::playPortfolioAlert() {
+    totalTonesPlayed++;
+}
+
+void BuzzerManager::playExitAlert(bool isProfit) {
+    totalTonesPlayed++;
+}
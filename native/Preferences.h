@@ -0,0 +1,81 @@
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+#include "Arduino.h"
+#include "nvs.h"
+
+// Arduino Preferences over the host's in-memory NVS
+class Preferences {
+public:
+    Preferences() : _handle(0), _started(false), _readOnly(false) {}
+
+    bool begin(const char* name, bool readOnly = false) {
+        if (_started) return false;
+        _readOnly = readOnly;
+        _started = nvs_open(name, readOnly ? NVS_READONLY : NVS_READWRITE, &_handle) == ESP_OK;
+        return _started;
+    }
+
+    void end() { _started = false; }
+    bool clear() { return writable() && nvs_erase_all(_handle) == ESP_OK; }
+    bool remove(const char* key) { return writable() && nvs_erase_key(_handle, key) == ESP_OK; }
+
+    bool isKey(const char* key) {
+        size_t length = 0;
+        return _started && nvs_get_blob(_handle, key, nullptr, &length) == ESP_OK;
+    }
+
+    size_t putUChar(const char* key, uint8_t value) { return put(key, value); }
+    size_t putInt(const char* key, int32_t value) { return put(key, value); }
+    size_t putUInt(const char* key, uint32_t value) { return put(key, value); }
+    size_t putLong(const char* key, int32_t value) { return put(key, value); }
+    size_t putULong(const char* key, uint32_t value) { return put(key, value); }
+    size_t putFloat(const char* key, float value) { return put(key, value); }
+    size_t putDouble(const char* key, double value) { return put(key, value); }
+    size_t putBool(const char* key, bool value) { return put(key, (uint8_t)value); }
+
+    size_t putString(const char* key, const char* value) {
+        return writable() && nvs_set_str(_handle, key, value) == ESP_OK ? strlen(value) : 0;
+    }
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) { return get(key, defaultValue); }
+    int32_t getInt(const char* key, int32_t defaultValue = 0) { return get(key, defaultValue); }
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) { return get(key, defaultValue); }
+    int32_t getLong(const char* key, int32_t defaultValue = 0) { return get(key, defaultValue); }
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) { return get(key, defaultValue); }
+    float getFloat(const char* key, float defaultValue = NAN) { return get(key, defaultValue); }
+    double getDouble(const char* key, double defaultValue = NAN) { return get(key, defaultValue); }
+    bool getBool(const char* key, bool defaultValue = false) { return get(key, (uint8_t)defaultValue); }
+
+    String getString(const char* key, const String& defaultValue = String()) {
+        char value[256];
+        size_t length = sizeof(value);
+        if (!_started || nvs_get_str(_handle, key, value, &length) != ESP_OK) return defaultValue;
+        return String(value);
+    }
+
+private:
+    bool writable() const { return _started && !_readOnly; }
+
+    template <typename T>
+    size_t put(const char* key, T value) {
+        return writable() && nvs_set_blob(_handle, key, &value, sizeof(value)) == ESP_OK ? sizeof(value) : 0;
+    }
+
+    template <typename T>
+    T get(const char* key, T defaultValue) {
+        T value;
+        size_t length = sizeof(value);
+        if (!_started || nvs_get_blob(_handle, key, &value, &length) != ESP_OK || length != sizeof(value)) {
+            return defaultValue;
+        }
+        return value;
+    }
+
+    nvs_handle_t _handle;
+    bool _started;
+    bool _readOnly;
+};
+
+#endif
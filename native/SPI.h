@@ -0,0 +1,6 @@
+#ifndef NATIVE_SPI_H
+#define NATIVE_SPI_H
+
+// No bus on the host; TFT_eSPI draws nowhere
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef NATIVE_TFT_ESPI_H
+#define NATIVE_TFT_ESPI_H
+
+#include "Arduino.h"
+
+// Headless TFT_eSPI. The panel draws nowhere and DMA is never available; a
+// sprite keeps a real 16-bit buffer from the heap and fills rectangles into it,
+// so the frame-buffer path allocates and touches memory like the device does.
+// Text is measured for the cursor but not rasterised.
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_DARKGREY    0x7BEF
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+
+#define TFT_WIDTH 240
+#define TFT_HEIGHT 320
+
+#define PSRAM_ENABLE 3
+
+class TFT_eSPI : public Print {
+public:
+    TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT) : _width(w), _height(h) {}
+
+    void init() {}
+    void begin() {}
+    void setRotation(uint8_t rotation) {
+        if ((rotation & 1) != (_rotation & 1)) {
+            int16_t swap = _width;
+            _width = _height;
+            _height = swap;
+        }
+        _rotation = rotation;
+    }
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+
+    // ===== DRAWING =====
+    virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {}
+    virtual void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {}
+    virtual void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { fillRect(x, y, 1, h, color); }
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+        drawFastHLine(x, y, w, color);
+        drawFastHLine(x, y + h - 1, w, color);
+        drawFastVLine(x, y, h, color);
+        drawFastVLine(x + w - 1, y, h, color);
+    }
+
+    // ===== TEXT =====
+    void setTextColor(uint16_t color) { _textColor = color; }
+    void setTextColor(uint16_t color, uint16_t background, bool fill = false) { _textColor = color; }
+    void setTextSize(uint8_t size) { _textSize = size ? size : 1; }
+    void setTextWrap(bool wrapX, bool wrapY = false) {}
+    void setCursor(int16_t x, int16_t y) {
+        _cursorX = x;
+        _cursorY = y;
+    }
+    int16_t getCursorX() const { return _cursorX; }
+    int16_t getCursorY() const { return _cursorY; }
+
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            _cursorX = 0;
+            _cursorY += 8 * _textSize;
+        } else {
+            _cursorX += 6 * _textSize;
+        }
+        return 1;
+    }
+    using Print::write;
+
+    // ===== VIEWPORT =====
+    void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true) {}
+    void resetViewport() {}
+
+    // ===== PUSH =====
+    void startWrite() {}
+    void endWrite() {}
+    void setSwapBytes(bool swap) {}
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {}
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr) {}
+    bool initDMA(bool ctrlCS = false) { return false; }
+    void dmaWait() {}
+
+protected:
+    int16_t _width;
+    int16_t _height;
+    uint8_t _rotation = 0;
+    uint16_t _textColor = TFT_WHITE;
+    uint8_t _textSize = 1;
+    int16_t _cursorX = 0;
+    int16_t _cursorY = 0;
+};
+
+class TFT_eSprite : public TFT_eSPI {
+public:
+    explicit TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(0, 0) {}
+    ~TFT_eSprite() { deleteSprite(); }
+
+    void setColorDepth(int8_t depth) {}
+    void setAttribute(uint8_t id, uint8_t value) {}
+
+    void* createSprite(int16_t w, int16_t h) {
+        if (_pixels) return _pixels;
+        _pixels = (uint16_t*)heap_caps_calloc((size_t)w * h, sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+        if (_pixels) {
+            _width = w;
+            _height = h;
+        }
+        return _pixels;
+    }
+    void deleteSprite() {
+        heap_caps_free(_pixels);
+        _pixels = nullptr;
+        _width = 0;
+        _height = 0;
+    }
+    void* getPointer() { return _pixels; }
+    bool created() const { return _pixels != nullptr; }
+
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override {
+        if (!_pixels) return;
+        int32_t x1 = std::min<int32_t>(x + w, _width);
+        int32_t y1 = std::min<int32_t>(y + h, _height);
+        x = std::max<int32_t>(x, 0);
+        y = std::max<int32_t>(y, 0);
+        for (int32_t row = y; row < y1; row++) {
+            for (int32_t col = x; col < x1; col++) {
+                _pixels[row * _width + col] = (uint16_t)color;
+            }
+        }
+    }
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) override {
+        fillRect(x, y, w, 1, color);
+    }
+
+private:
+    uint16_t* _pixels = nullptr;
+};
+
+#endif
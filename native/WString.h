@@ -0,0 +1,121 @@
+#ifndef NATIVE_WSTRING_H
+#define NATIVE_WSTRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <type_traits>
+
+// Arduino String over std::string. Its buffer comes from operator new, so the
+// host heap counts String allocations like the device heap does.
+class String {
+public:
+    String(const char* text = "") : _text(text ? text : "") {}
+    String(const char* text, size_t length) : _text(text ? text : "", text ? length : 0) {}
+    String(const String& other) = default;
+    String(String&& other) = default;
+    explicit String(char c) : _text(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    String& operator=(const String& other) = default;
+    String& operator=(String&& other) = default;
+    String& operator=(const char* text);
+
+    // ===== ACCESS =====
+    const char* c_str() const { return _text.c_str(); }
+    unsigned int length() const { return _text.length(); }
+    bool isEmpty() const { return _text.empty(); }
+    bool reserve(unsigned int size);
+    void clear() { _text.clear(); }
+    char charAt(unsigned int index) const;
+    void setCharAt(unsigned int index, char c);
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index);
+
+    // ===== APPEND =====
+    bool concat(const String& other);
+    bool concat(const char* text);
+    bool concat(const char* text, unsigned int length);
+    bool concat(char c);
+    template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    bool concat(T value) { return concat(String(value)); }
+
+    template <typename T>
+    String& operator+=(const T& value) {
+        concat(value);
+        return *this;
+    }
+    String& operator+=(const char* text) {
+        concat(text);
+        return *this;
+    }
+
+    // ===== COMPARISON =====
+    bool equals(const String& other) const { return _text == other._text; }
+    bool equals(const char* text) const { return _text == (text ? text : ""); }
+    bool equalsIgnoreCase(const String& other) const;
+    bool startsWith(const String& prefix) const;
+    bool endsWith(const String& suffix) const;
+    int compareTo(const String& other) const { return _text.compare(other._text); }
+    bool operator==(const String& other) const { return equals(other); }
+    bool operator==(const char* text) const { return equals(text); }
+    bool operator!=(const String& other) const { return !equals(other); }
+    bool operator!=(const char* text) const { return !equals(text); }
+    bool operator<(const String& other) const { return _text < other._text; }
+
+    // ===== SEARCH =====
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String& text, unsigned int from = 0) const;
+    int lastIndexOf(char c) const;
+    int lastIndexOf(const String& text) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+
+    // ===== MODIFICATION =====
+    void replace(const String& find, const String& replacement);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    // ===== CONVERSION =====
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+private:
+    std::string _text;
+};
+
+// Type of string concatenations in the Arduino core; ArduinoJson adapts it by name
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String& text) : String(text) {}
+    StringSumHelper(const char* text) : String(text) {}
+};
+
+String operator+(const String& left, const String& right);
+String operator+(const String& left, const char* right);
+String operator+(const char* left, const String& right);
+String operator+(const String& left, char right);
+
+template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+String operator+(const String& left, T right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+inline bool operator==(const char* left, const String& right) { return right == left; }
+inline bool operator!=(const char* left, const String& right) { return right != left; }
+
+#endif
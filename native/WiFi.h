@@ -0,0 +1,53 @@
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+#include "Arduino.h"
+
+// The host has no radio: the station never connects and there is no signal
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum {
+    WIFI_MODE_NULL = 0,
+    WIFI_MODE_STA,
+    WIFI_MODE_AP,
+    WIFI_MODE_APSTA,
+} wifi_mode_t;
+
+// Client side of a TCP connection; connect() always fails
+class WiFiClient : public Stream {
+public:
+    virtual ~WiFiClient() {}
+
+    virtual int connect(const char* host, uint16_t port) { return 0; }
+    virtual void stop() {}
+    virtual uint8_t connected() { return 0; }
+    operator bool() { return connected(); }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override { return 0; }
+    size_t write(const uint8_t* buffer, size_t size) override { return 0; }
+    using Print::write;
+};
+
+class WiFiClass {
+public:
+    wl_status_t status() { return WL_DISCONNECTED; }
+    bool isConnected() { return false; }
+    wifi_mode_t getMode() { return WIFI_MODE_NULL; }
+    int8_t RSSI() { return 0; }
+    String SSID() { return String(); }
+};
+
+extern WiFiClass WiFi;
+
+#endif
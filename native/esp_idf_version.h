@@ -0,0 +1,8 @@
+#ifndef NATIVE_ESP_IDF_VERSION_H
+#define NATIVE_ESP_IDF_VERSION_H
+
+// The host heap tracks its local minimum, so it reports as an IDF with the monitor
+#define ESP_IDF_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(5, 1, 0)
+
+#endif
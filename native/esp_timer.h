@@ -0,0 +1,35 @@
+#ifndef NATIVE_ESP_TIMER_H
+#define NATIVE_ESP_TIMER_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_err.h"
+
+// Microseconds since start, from the host's monotonic clock. The host build
+// has no timer task, so creating a timer fails and nothing is ever scheduled.
+
+typedef struct NativeTimer* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+
+typedef enum {
+    ESP_TIMER_TASK,
+} esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void* arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char* name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+int64_t esp_timer_get_time(void);
+
+inline esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+inline esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) { return ESP_ERR_INVALID_STATE; }
+inline esp_err_t esp_timer_stop(esp_timer_handle_t timer) { return ESP_ERR_INVALID_STATE; }
+inline esp_err_t esp_timer_delete(esp_timer_handle_t timer) { return ESP_ERR_INVALID_STATE; }
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef NATIVE_SEMPHR_H
+#define NATIVE_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+// A single-threaded host never contends, so a mutex is only a handle
+typedef struct NativeSemaphore* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    return semaphore ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return semaphore ? pdTRUE : pdFALSE;
+}
+
+#endif
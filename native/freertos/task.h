@@ -0,0 +1,24 @@
+#ifndef NATIVE_TASK_H
+#define NATIVE_TASK_H
+
+#include "FreeRTOS.h"
+
+// Task creation always fails on the host; callers fall back to running inline
+inline BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth,
+                              void* param, UBaseType_t priority, TaskHandle_t* handle) {
+    if (handle) *handle = nullptr;
+    return pdFAIL;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth,
+                                          void* param, UBaseType_t priority, TaskHandle_t* handle,
+                                          BaseType_t core) {
+    return xTaskCreate(task, name, stackDepth, param, priority, handle);
+}
+
+inline void xTaskNotifyGive(TaskHandle_t task) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) { return 0; }
+inline void vTaskDelay(TickType_t ticks) {}
+inline void vTaskDelete(TaskHandle_t task) {}
+
+#endif
@@ -0,0 +1,41 @@
+#include <Arduino.h>
+#include "../SystemConfig.h"
+#include "../DisplayManager.h"
+#include "../AlertManager.h"
+#include "../BuzzerManager.h"
+#include "../ConfigManager.h"
+#include "../DataManager.h"
+#include "../CycleArena.h"
+#include "../PipelineBenchmark.h"
+
+// Host entry point of the native env: the sketch's bench path without the
+// radio, LEDs or scheduler. Same replay, same BENCH lines on stdout.
+
+DisplayManager displayMgr;
+AlertManager alertMgr;
+BuzzerManager buzzerMgr;
+SystemSettings settings;
+
+static void benchmarkRender(void* context) {
+    // Replayed parses are published like fetched ones, so the ticker draws them
+    displayMgr.updateTickerScreen();
+}
+
+int main() {
+    displayMgr.init(settings.displayBrightness, settings.displayRotation);
+    displayMgr.setFrameBufferEnabled(settings.displayFrameBuffer);
+    
+    ConfigManager::getInstance().begin();
+    DataManager::getInstance().begin();
+    alertMgr.init(settings, buzzerMgr, displayMgr);
+    
+    CycleArena::get(ARENA_FETCH).begin(ARENA_FETCH_SIZE);
+    CycleArena::get(ARENA_WEB).begin(ARENA_WEB_SIZE);
+    
+    PipelineBenchmark benchmark;
+    benchmark.setRenderStage(benchmarkRender, nullptr);
+    benchmark.run();
+    
+    Serial.flush();
+    return 0;
+}
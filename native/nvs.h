@@ -0,0 +1,116 @@
+#ifndef NATIVE_NVS_H
+#define NATIVE_NVS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include "esp_err.h"
+
+// In-memory NVS for the host: values live until the process exits. Each
+// handle is one namespace; commits succeed and write nothing.
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE,
+} nvs_open_mode_t;
+
+struct NativeNvs {
+    std::map<std::string, uint32_t> namespaces;
+    std::map<std::string, std::string> values;      // "<handle>/<key>" -> raw bytes
+
+    static NativeNvs& get() {
+        static NativeNvs nvs;
+        return nvs;
+    }
+
+    static std::string slot(nvs_handle_t handle, const char* key) {
+        return std::to_string(handle) + "/" + key;
+    }
+
+    esp_err_t set(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+        values[slot(handle, key)] = std::string((const char*)value, length);
+        return ESP_OK;
+    }
+
+    esp_err_t get(nvs_handle_t handle, const char* key, void* value, size_t* length, bool exact) {
+        auto it = values.find(slot(handle, key));
+        if (it == values.end()) return ESP_ERR_NVS_NOT_FOUND;
+        if (!value) {
+            *length = it->second.size();
+            return ESP_OK;
+        }
+        if (exact ? *length != it->second.size() : *length < it->second.size()) {
+            return ESP_ERR_NVS_INVALID_LENGTH;
+        }
+        memcpy(value, it->second.data(), it->second.size());
+        *length = it->second.size();
+        return ESP_OK;
+    }
+};
+
+inline esp_err_t nvs_open(const char* name, nvs_open_mode_t mode, nvs_handle_t* handle) {
+    NativeNvs& nvs = NativeNvs::get();
+    auto it = nvs.namespaces.find(name);
+    if (it == nvs.namespaces.end()) {
+        it = nvs.namespaces.emplace(name, nvs.namespaces.size() + 1).first;
+    }
+    *handle = it->second;
+    return ESP_OK;
+}
+
+inline void nvs_close(nvs_handle_t handle) {}
+inline esp_err_t nvs_commit(nvs_handle_t handle) { return ESP_OK; }
+
+inline esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+    return NativeNvs::get().values.erase(NativeNvs::slot(handle, key)) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+inline esp_err_t nvs_erase_all(nvs_handle_t handle) {
+    NativeNvs& nvs = NativeNvs::get();
+    std::string prefix = std::to_string(handle) + "/";
+    for (auto it = nvs.values.begin(); it != nvs.values.end();) {
+        it = it->first.compare(0, prefix.size(), prefix) == 0 ? nvs.values.erase(it) : ++it;
+    }
+    return ESP_OK;
+}
+
+#define NATIVE_NVS_SCALAR(suffix, type)                                                        \
+    inline esp_err_t nvs_set_##suffix(nvs_handle_t handle, const char* key, type value) {     \
+        return NativeNvs::get().set(handle, key, &value, sizeof(value));                       \
+    }                                                                                          \
+    inline esp_err_t nvs_get_##suffix(nvs_handle_t handle, const char* key, type* value) {    \
+        size_t length = sizeof(type);                                                          \
+        return NativeNvs::get().get(handle, key, value, &length, true);                        \
+    }
+
+NATIVE_NVS_SCALAR(i8, int8_t)
+NATIVE_NVS_SCALAR(u8, uint8_t)
+NATIVE_NVS_SCALAR(i16, int16_t)
+NATIVE_NVS_SCALAR(u16, uint16_t)
+NATIVE_NVS_SCALAR(i32, int32_t)
+NATIVE_NVS_SCALAR(u32, uint32_t)
+NATIVE_NVS_SCALAR(i64, int64_t)
+NATIVE_NVS_SCALAR(u64, uint64_t)
+
+#undef NATIVE_NVS_SCALAR
+
+inline esp_err_t nvs_set_str(nvs_handle_t handle, const char* key, const char* value) {
+    return NativeNvs::get().set(handle, key, value, strlen(value) + 1);
+}
+
+inline esp_err_t nvs_get_str(nvs_handle_t handle, const char* key, char* value, size_t* length) {
+    return NativeNvs::get().get(handle, key, value, length, false);
+}
+
+inline esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    return NativeNvs::get().set(handle, key, value, length);
+}
+
+inline esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* value, size_t* length) {
+    return NativeNvs::get().get(handle, key, value, length, false);
+}
+
+#endif